@@ -0,0 +1,185 @@
+/**
+ * @file   bench_encryption.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018-2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * Benchmark the overhead of AES-256-GCM encryption on dense and sparse 2D
+ * reads. The same data is written to an unencrypted and an encrypted array
+ * of each kind, and each array is read in full several times. The time of
+ * each read and the overhead of the encrypted reads over the plain ones are
+ * reported; the TileDB statistics gathered during the encrypted reads are
+ * dumped to stderr, including the decryption throughput and whether the CPU
+ * provides hardware AES.
+ */
+
+#include <tiledb/tiledb>
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+#include "benchmark.h"
+
+using namespace tiledb;
+
+class Benchmark : public BenchmarkBase {
+ protected:
+  virtual void setup() {
+    std::vector<int> data(array_rows * array_cols);
+    std::vector<uint32_t> coords(2 * data.size());
+    for (uint64_t i = 0; i < data.size(); i++) {
+      data[i] = i;
+      coords[2 * i] = i / array_cols + 1;
+      coords[2 * i + 1] = i % array_cols + 1;
+    }
+
+    for (bool encrypted : {false, true}) {
+      create_array(TILEDB_DENSE, encrypted);
+      Array dense = open_array(TILEDB_DENSE, encrypted, TILEDB_WRITE);
+      Query dense_query(ctx_, dense);
+      dense_query.set_subarray({1u, array_rows, 1u, array_cols})
+          .set_layout(TILEDB_ROW_MAJOR)
+          .set_buffer("a", data);
+      dense_query.submit();
+      dense.close();
+
+      create_array(TILEDB_SPARSE, encrypted);
+      Array sparse = open_array(TILEDB_SPARSE, encrypted, TILEDB_WRITE);
+      Query sparse_query(ctx_, sparse);
+      sparse_query.set_layout(TILEDB_UNORDERED)
+          .set_buffer("a", data)
+          .set_coordinates(coords);
+      sparse_query.submit();
+      sparse.close();
+    }
+  }
+
+  virtual void teardown() {
+    VFS vfs(ctx_);
+    for (auto type : {TILEDB_DENSE, TILEDB_SPARSE}) {
+      for (bool encrypted : {false, true}) {
+        auto uri = array_uri(type, encrypted);
+        if (vfs.is_dir(uri))
+          vfs.remove_dir(uri);
+      }
+    }
+  }
+
+  virtual void pre_run() {
+    data_.resize(array_rows * array_cols);
+    coords_.resize(2 * data_.size());
+  }
+
+  virtual void run() {
+    for (auto type : {TILEDB_DENSE, TILEDB_SPARSE}) {
+      uint64_t plain_ms = read_array(type, false);
+      Stats::enable();
+      uint64_t encrypted_ms = read_array(type, true);
+      Stats::disable();
+      std::cout << "{ \"phase\": \"run\", \"array\": \""
+                << (type == TILEDB_DENSE ? "dense" : "sparse")
+                << "\", \"plain_ms\": " << plain_ms
+                << ", \"encrypted_ms\": " << encrypted_ms
+                << ", \"overhead_pct\": "
+                << (plain_ms > 0 ? 100.0 * (double(encrypted_ms) - plain_ms) /
+                                       plain_ms :
+                                   0.0)
+                << " }\n";
+    }
+    Stats::dump(stderr);
+    Stats::reset();
+  }
+
+ private:
+  const std::string array_uri_ = "bench_array";
+  const unsigned array_rows = 2000, array_cols = 2000;
+  const unsigned tile_rows = 100, tile_cols = 100;
+  const uint64_t sparse_capacity = 10000;
+  const unsigned num_reads = 5;
+  const std::string key_ = "0123456789abcdeF0123456789abcdeF";
+
+  Context ctx_;
+  std::vector<int> data_;
+  std::vector<uint32_t> coords_;
+
+  std::string array_uri(tiledb_array_type_t type, bool encrypted) const {
+    return array_uri_ + (type == TILEDB_DENSE ? "_dense" : "_sparse") +
+           (encrypted ? "_encrypted" : "_plain");
+  }
+
+  void create_array(tiledb_array_type_t type, bool encrypted) {
+    ArraySchema schema(ctx_, type);
+    Domain domain(ctx_);
+    domain.add_dimension(
+        Dimension::create<uint32_t>(ctx_, "d1", {{1, array_rows}}, tile_rows));
+    domain.add_dimension(
+        Dimension::create<uint32_t>(ctx_, "d2", {{1, array_cols}}, tile_cols));
+    schema.set_domain(domain);
+    if (type == TILEDB_SPARSE)
+      schema.set_capacity(sparse_capacity);
+    schema.add_attribute(Attribute::create<int32_t>(ctx_, "a"));
+
+    auto uri = array_uri(type, encrypted);
+    if (encrypted)
+      Array::create(uri, schema, TILEDB_AES_256_GCM, key_);
+    else
+      Array::create(uri, schema);
+  }
+
+  Array open_array(
+      tiledb_array_type_t type,
+      bool encrypted,
+      tiledb_query_type_t query_type) {
+    auto uri = array_uri(type, encrypted);
+    if (encrypted)
+      return Array(ctx_, uri, query_type, TILEDB_AES_256_GCM, key_);
+    return Array(ctx_, uri, query_type);
+  }
+
+  /** Reads the whole array `num_reads` times, returning the total time. */
+  uint64_t read_array(tiledb_array_type_t type, bool encrypted) {
+    Array array = open_array(type, encrypted, TILEDB_READ);
+    auto t0 = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < num_reads; i++) {
+      Query query(ctx_, array);
+      query.set_subarray({1u, array_rows, 1u, array_cols})
+          .set_layout(TILEDB_ROW_MAJOR)
+          .set_buffer("a", data_);
+      if (type == TILEDB_SPARSE)
+        query.set_coordinates(coords_);
+      query.submit();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    array.close();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0)
+        .count();
+  }
+};
+
+int main(int argc, char** argv) {
+  Benchmark bench;
+  return bench.main(argc, argv);
+}
@@ -0,0 +1,163 @@
+/**
+ * @file   bench_filter_kernels.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018-2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Micro-benchmark of the kernels of the bit width reduction and positive
+ * delta filters. Each kernel is run repeatedly over a cache-resident tile of
+ * int32 and int64 values, in windows of the filters' default sizes, once per
+ * instruction set supported by the machine (the scalar one being the
+ * baseline). The kernels are not
+ * part of the TileDB API, so they are compiled into this program directly.
+ */
+
+#include "tiledb/sm/filter/filter_kernels.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+#include "benchmark.h"
+
+using namespace tiledb::sm::filter_kernels;
+
+class Benchmark : public BenchmarkBase {
+ protected:
+  virtual void run() {
+    for (auto isa : {KernelIsa::SCALAR, KernelIsa::SSE4_1, KernelIsa::AVX2}) {
+      if (!isa_supported(isa))
+        continue;
+      run_type<int32_t, int8_t>(isa, "int32");
+      run_type<int64_t, int16_t>(isa, "int64");
+    }
+  }
+
+ private:
+  const uint64_t data_bytes = 256 * 1024;
+  const unsigned passes = 256, repetitions = 5;
+
+  /** Default window sizes (in bytes) of the two filters. */
+  const uint64_t bit_width_window = 256, delta_window = 1024;
+
+  static const char* isa_name(KernelIsa isa) {
+    switch (isa) {
+      case KernelIsa::SSE4_1:
+        return "sse4.1";
+      case KernelIsa::AVX2:
+        return "avx2";
+      default:
+        return "scalar";
+    }
+  }
+
+  /**
+   * Runs all kernels on values of type T, narrowed to type U by the bit width
+   * reduction kernels.
+   */
+  template <typename T, typename U>
+  void run_type(KernelIsa isa, const char* type_name) {
+    const uint64_t num = data_bytes / sizeof(T);
+    std::vector<T> values(num), deltas(num), restored(num);
+    std::vector<U> narrowed(num);
+    uint64_t seed = 1;
+    T value = 0;
+    for (uint64_t i = 0; i < num; i++) {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      value += static_cast<T>((seed >> 33) % 64);
+      values[i] = value;
+    }
+
+    // Bit width reduction: the min/max of each window, then narrowing.
+    const uint64_t bw_nelts = bit_width_window / sizeof(T);
+    time(isa, type_name, "bit_width_forward", [&]() {
+      for (uint64_t i = 0; i < num; i += bw_nelts) {
+        T min, max;
+        uint64_t n = std::min(bw_nelts, num - i);
+        min_max(values.data() + i, n, &min, &max, isa);
+        narrow(values.data() + i, n, min, narrowed.data() + i, isa);
+      }
+    });
+    time(isa, type_name, "bit_width_reverse", [&]() {
+      for (uint64_t i = 0; i < num; i += bw_nelts) {
+        uint64_t n = std::min(bw_nelts, num - i);
+        widen(narrowed.data() + i, n, values[i], restored.data() + i, isa);
+      }
+    });
+
+    // Positive delta: encoding and decoding each window.
+    const uint64_t delta_nelts = delta_window / sizeof(T);
+    time(isa, type_name, "positive_delta_forward", [&]() {
+      for (uint64_t i = 0; i < num; i += delta_nelts) {
+        uint64_t n = std::min(delta_nelts, num - i);
+        delta_encode(
+            values.data() + i, n, values[i], deltas.data() + i, isa);
+      }
+    });
+    time(isa, type_name, "positive_delta_reverse", [&]() {
+      for (uint64_t i = 0; i < num; i += delta_nelts) {
+        uint64_t n = std::min(delta_nelts, num - i);
+        delta_decode(
+            deltas.data() + i, n, values[i], restored.data() + i, isa);
+      }
+    });
+    if (std::memcmp(restored.data(), values.data(), data_bytes) != 0)
+      std::cerr << "Decoded values differ from the original ones\n";
+  }
+
+  /**
+   * Prints in JSON the best time of `repetitions` runs, each calling `f`
+   * `passes` times.
+   */
+  void time(
+      KernelIsa isa,
+      const char* type_name,
+      const char* kernel,
+      const std::function<void()>& f) {
+    uint64_t best_us = UINT64_MAX;
+    for (unsigned r = 0; r < repetitions; r++) {
+      auto t0 = std::chrono::steady_clock::now();
+      for (unsigned p = 0; p < passes; p++)
+        f();
+      auto t1 = std::chrono::steady_clock::now();
+      uint64_t us =
+          std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0)
+              .count();
+      best_us = std::min(best_us, us);
+    }
+    std::cout << "{ \"phase\": \"run\", \"kernel\": \"" << kernel
+              << "\", \"type\": \"" << type_name << "\", \"isa\": \""
+              << isa_name(isa) << "\", \"us\": " << best_us << " }\n";
+  }
+};
+
+int main(int argc, char** argv) {
+  Benchmark bench;
+  return bench.main(argc, argv);
+}
@@ -0,0 +1,174 @@
+/**
+ * @file   bench_float_codec.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018-2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Benchmark of the float plane filter against a byteshuffle + zstd filter
+ * list on real-valued sensor data. For float32 and float64 attributes, each
+ * filter list writes and reads back a dense 1D array, reporting the best
+ * write and read times and the compression ratio.
+ */
+
+#include <tiledb/tiledb>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+#include "benchmark.h"
+
+using namespace tiledb;
+
+class Benchmark : public BenchmarkBase {
+ protected:
+  virtual void teardown() {
+    VFS vfs(ctx_);
+    if (vfs.is_dir(array_uri_))
+      vfs.remove_dir(array_uri_);
+  }
+
+  virtual void run() {
+    run_type<float>("float32");
+    run_type<double>("float64");
+  }
+
+ private:
+  const std::string array_uri_ = "bench_array";
+  const uint64_t cell_num = 8 * 1000 * 1000, tile_cell_num = 100 * 1000;
+  const unsigned repetitions = 5;
+
+  Context ctx_;
+
+  /**
+   * Returns the values of a simulated sensor with a resolution of 0.01: a
+   * daily cycle plus a random walk and measurement noise.
+   */
+  template <typename T>
+  std::vector<T> sensor_data() const {
+    const double pi = 3.14159265358979;
+    std::vector<T> data(cell_num);
+    uint64_t seed = 1;
+    double walk = 0;
+    for (uint64_t i = 0; i < cell_num; i++) {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      double uniform = (seed >> 11) * (1.0 / 9007199254740992.0);
+      walk += (uniform - 0.5) * 0.01;
+      double noise = ((seed >> 3) % 5) * 0.01;
+      double cycle = std::sin(i * 2 * pi / 86400);
+      double value = 15.0 + 5.0 * cycle + walk + noise;
+      data[i] = static_cast<T>(std::round(value * 100) / 100);
+    }
+    return data;
+  }
+
+  /** Runs the benchmark for both filter lists on values of type T. */
+  template <typename T>
+  void run_type(const char* type_name) {
+    auto data = sensor_data<T>();
+
+    FilterList shuffle_zstd(ctx_);
+    shuffle_zstd.add_filter({ctx_, TILEDB_FILTER_BYTESHUFFLE})
+        .add_filter({ctx_, TILEDB_FILTER_ZSTD});
+    run_filters<T>(type_name, "byteshuffle+zstd", shuffle_zstd, data);
+
+    FilterList float_plane(ctx_);
+    float_plane.add_filter({ctx_, TILEDB_FILTER_FLOAT_PLANE});
+    run_filters<T>(type_name, "float_plane", float_plane, data);
+  }
+
+  /**
+   * Writes `data` to an array with the given attribute filter list and reads
+   * it back, `repetitions` times each.
+   */
+  template <typename T>
+  void run_filters(
+      const char* type_name,
+      const char* filters_name,
+      const FilterList& filters,
+      std::vector<T>& data) {
+    uint64_t write_ms = UINT64_MAX, read_ms = UINT64_MAX, array_bytes = 0;
+    std::vector<T> read_data(cell_num);
+    VFS vfs(ctx_);
+    for (unsigned r = 0; r < repetitions; r++) {
+      teardown();
+      ArraySchema schema(ctx_, TILEDB_DENSE);
+      Domain domain(ctx_);
+      domain.add_dimension(Dimension::create<uint64_t>(
+          ctx_, "d", {{1, cell_num}}, tile_cell_num));
+      schema.set_domain(domain);
+      schema.add_attribute(Attribute::create<T>(ctx_, "a", filters));
+      Array::create(array_uri_, schema);
+
+      write_ms = std::min(write_ms, time_ms([&]() {
+        Array array(ctx_, array_uri_, TILEDB_WRITE);
+        Query query(ctx_, array, TILEDB_WRITE);
+        query.set_subarray<uint64_t>({1, cell_num})
+            .set_layout(TILEDB_ROW_MAJOR)
+            .set_buffer("a", data);
+        query.submit();
+        array.close();
+      }));
+      array_bytes = vfs.dir_size(array_uri_);
+
+      read_ms = std::min(read_ms, time_ms([&]() {
+        Array array(ctx_, array_uri_, TILEDB_READ);
+        Query query(ctx_, array, TILEDB_READ);
+        query.set_subarray<uint64_t>({1, cell_num})
+            .set_layout(TILEDB_ROW_MAJOR)
+            .set_buffer("a", read_data);
+        query.submit();
+        array.close();
+      }));
+    }
+
+    if (read_data != data)
+      std::cerr << "Read values differ from the written ones\n";
+    std::cout << "{ \"phase\": \"run\", \"type\": \"" << type_name
+              << "\", \"filters\": \"" << filters_name
+              << "\", \"write_ms\": " << write_ms
+              << ", \"read_ms\": " << read_ms
+              << ", \"bytes\": " << array_bytes << ", \"ratio\": "
+              << double(cell_num * sizeof(T)) / array_bytes << " }\n";
+  }
+
+  /** Returns the time in milliseconds taken by `f`. */
+  static uint64_t time_ms(const std::function<void()>& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0)
+        .count();
+  }
+};
+
+int main(int argc, char** argv) {
+  Benchmark bench;
+  return bench.main(argc, argv);
+}
@@ -0,0 +1,164 @@
+/**
+ * @file   bench_tile_cache_scaling.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2018-2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Benchmark the scaling of concurrent reads served from the tile cache. A
+ * dense 2D array with small tiles is read once to populate the tile cache,
+ * then an increasing number of threads issue single-tile reads against a
+ * shared context. The total time for each thread count is reported; with a
+ * scalable tile cache, the time should stay roughly flat as threads are
+ * added, up to the number of cores.
+ */
+
+#include <tiledb/tiledb>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "benchmark.h"
+
+using namespace tiledb;
+
+class Benchmark : public BenchmarkBase {
+ public:
+  Benchmark()
+      : ctx_(make_config()) {
+  }
+
+ protected:
+  virtual void setup() {
+    ArraySchema schema(ctx_, TILEDB_DENSE);
+    Domain domain(ctx_);
+    domain.add_dimension(
+        Dimension::create<uint32_t>(ctx_, "d1", {{1, array_rows}}, tile_rows));
+    domain.add_dimension(
+        Dimension::create<uint32_t>(ctx_, "d2", {{1, array_cols}}, tile_cols));
+    schema.set_domain(domain);
+    schema.add_attribute(Attribute::create<int32_t>(ctx_, "a"));
+    Array::create(array_uri_, schema);
+
+    std::vector<int> data(array_rows * array_cols);
+    for (uint64_t i = 0; i < data.size(); i++) {
+      data[i] = i;
+    }
+    Array array(ctx_, array_uri_, TILEDB_WRITE);
+    Query query(ctx_, array);
+    query.set_subarray({1u, array_rows, 1u, array_cols})
+        .set_layout(TILEDB_ROW_MAJOR)
+        .set_buffer("a", data);
+    query.submit();
+    array.close();
+  }
+
+  virtual void teardown() {
+    VFS vfs(ctx_);
+    if (vfs.is_dir(array_uri_))
+      vfs.remove_dir(array_uri_);
+  }
+
+  virtual void pre_run() {
+    // Populate the tile cache with the whole array.
+    std::vector<int> data(array_rows * array_cols);
+    Array array(ctx_, array_uri_, TILEDB_READ);
+    Query query(ctx_, array);
+    query.set_subarray({1u, array_rows, 1u, array_cols})
+        .set_layout(TILEDB_ROW_MAJOR)
+        .set_buffer("a", data);
+    query.submit();
+    array.close();
+  }
+
+  virtual void run() {
+    unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned num_threads = 1;; num_threads *= 2) {
+      num_threads = std::min(num_threads, max_threads);
+      run_threads(num_threads);
+      if (num_threads == max_threads)
+        break;
+    }
+  }
+
+ private:
+  const std::string array_uri_ = "bench_array";
+  const unsigned array_rows = 1000, array_cols = 1000;
+  const unsigned tile_rows = 10, tile_cols = 10;
+  const unsigned reads_per_thread = 2000;
+
+  Context ctx_;
+
+  static Config make_config() {
+    Config config;
+    config["sm.tile_cache_size"] = "100000000";
+    config["sm.num_reader_threads"] = "1";
+    return config;
+  }
+
+  /** Each thread reads `reads_per_thread` random tiles. */
+  void run_threads(unsigned num_threads) {
+    Array array(ctx_, array_uri_, TILEDB_READ);
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < num_threads; t++) {
+      threads.emplace_back([&, t]() {
+        std::vector<int> data(tile_rows * tile_cols);
+        uint64_t seed = t + 1;
+        for (unsigned i = 0; i < reads_per_thread; i++) {
+          seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+          uint32_t tile = (seed >> 33) % ((array_rows / tile_rows) *
+                                          (array_cols / tile_cols));
+          uint32_t row = (tile / (array_cols / tile_cols)) * tile_rows + 1;
+          uint32_t col = (tile % (array_cols / tile_cols)) * tile_cols + 1;
+          Query query(ctx_, array);
+          query
+              .set_subarray(
+                  {row, row + tile_rows - 1, col, col + tile_cols - 1})
+              .set_layout(TILEDB_ROW_MAJOR)
+              .set_buffer("a", data);
+          query.submit();
+        }
+      });
+    }
+    for (auto& thread : threads)
+      thread.join();
+    auto t1 = std::chrono::steady_clock::now();
+    array.close();
+
+    uint64_t ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+    std::cout << "{ \"phase\": \"run\", \"threads\": " << num_threads
+              << ", \"reads\": " << num_threads * reads_per_thread
+              << ", \"ms\": " << ms << " }\n";
+  }
+};
+
+int main(int argc, char** argv) {
+  Benchmark bench;
+  return bench.main(argc, argv);
+}
@@ -194,7 +194,12 @@ void check_save_to_file() {
   ss << "sm.check_coord_oob true\n";
   ss << "sm.check_global_order true\n";
   ss << "sm.consolidation.amplification 1\n";
+  ss << "sm.consolidation.auto false\n";
+  ss << "sm.consolidation.auto_frag_num 32\n";
+  ss << "sm.consolidation.auto_interval_ms 1000\n";
+  ss << "sm.consolidation.auto_io_budget 0\n";
   ss << "sm.consolidation.buffer_size 50000000\n";
+  ss << "sm.consolidation.mode fragments\n";
   ss << "sm.consolidation.step_max_frags 4294967295\n";
   ss << "sm.consolidation.step_min_frags 4294967295\n";
   ss << "sm.consolidation.step_size_ratio 0\n";
@@ -207,7 +212,12 @@ void check_save_to_file() {
   ss << "sm.num_reader_threads 1\n";
   ss << "sm.num_tbb_threads -1\n";
   ss << "sm.num_writer_threads 1\n";
+  ss << "sm.tile_cache_decoded_ratio 1\n";
+  ss << "sm.tile_cache_policy lru\n";
   ss << "sm.tile_cache_size 10000000\n";
+  ss << "vfs.file.enable_io_uring false\n";
+  ss << "vfs.file.enable_mmap false\n";
+  ss << "vfs.file.max_open_handles 128\n";
   ss << "vfs.file.max_parallel_ops " << std::thread::hardware_concurrency()
      << "\n";
   ss << "vfs.min_batch_gap 512000\n";
@@ -342,6 +352,32 @@ TEST_CASE("C API: Test config", "[capi], [config]") {
       "[TileDB::Utils] Error: Failed to convert string '100000000000000000000' "
       "to uint64_t; Value out of range");
   tiledb_error_free(&error);
+
+  // Check tile cache policy
+  rc = tiledb_config_set(config, "sm.tile_cache_policy", "lfu", &error);
+  CHECK(rc == TILEDB_ERR);
+  CHECK(error != nullptr);
+  check_error(
+      error,
+      "[TileDB::Config] Error: Cannot set parameter; Invalid tile cache "
+      "policy");
+  tiledb_error_free(&error);
+  rc = tiledb_config_set(config, "sm.tile_cache_policy", "wtinylfu", &error);
+  CHECK(rc == TILEDB_OK);
+  CHECK(error == nullptr);
+
+  // Check tile cache decoded ratio
+  rc = tiledb_config_set(config, "sm.tile_cache_decoded_ratio", "1.5", &error);
+  CHECK(rc == TILEDB_ERR);
+  CHECK(error != nullptr);
+  check_error(
+      error,
+      "[TileDB::Config] Error: Cannot set parameter; Tile cache decoded "
+      "ratio must be in [0, 1]");
+  tiledb_error_free(&error);
+  rc = tiledb_config_set(config, "sm.tile_cache_decoded_ratio", "0.5", &error);
+  CHECK(rc == TILEDB_OK);
+  CHECK(error == nullptr);
   tiledb_config_free(&config);
 }
 
@@ -373,6 +409,8 @@ TEST_CASE("C API: Test config iter", "[capi], [config]") {
   all_param_values["sm.check_coord_oob"] = "true";
   all_param_values["sm.check_global_order"] = "true";
   all_param_values["sm.tile_cache_size"] = "100";
+  all_param_values["sm.tile_cache_policy"] = "lru";
+  all_param_values["sm.tile_cache_decoded_ratio"] = "1";
   all_param_values["sm.memory_budget"] = "5368709120";
   all_param_values["sm.memory_budget_var"] = "10737418240";
   all_param_values["sm.enable_signal_handlers"] = "true";
@@ -386,6 +424,11 @@ TEST_CASE("C API: Test config iter", "[capi], [config]") {
   all_param_values["sm.consolidation.step_max_frags"] = "4294967295";
   all_param_values["sm.consolidation.buffer_size"] = "50000000";
   all_param_values["sm.consolidation.step_size_ratio"] = "0";
+  all_param_values["sm.consolidation.mode"] = "fragments";
+  all_param_values["sm.consolidation.auto"] = "false";
+  all_param_values["sm.consolidation.auto_frag_num"] = "32";
+  all_param_values["sm.consolidation.auto_interval_ms"] = "1000";
+  all_param_values["sm.consolidation.auto_io_budget"] = "0";
   all_param_values["vfs.num_threads"] =
       std::to_string(std::thread::hardware_concurrency());
   all_param_values["vfs.min_batch_gap"] = "512000";
@@ -393,6 +436,9 @@ TEST_CASE("C API: Test config iter", "[capi], [config]") {
   all_param_values["vfs.min_parallel_size"] = "10485760";
   all_param_values["vfs.file.max_parallel_ops"] =
       std::to_string(std::thread::hardware_concurrency());
+  all_param_values["vfs.file.max_open_handles"] = "128";
+  all_param_values["vfs.file.enable_io_uring"] = "false";
+  all_param_values["vfs.file.enable_mmap"] = "false";
   all_param_values["vfs.s3.scheme"] = "https";
   all_param_values["vfs.s3.region"] = "us-east-1";
   all_param_values["vfs.s3.aws_access_key_id"] = "";
@@ -424,6 +470,9 @@ TEST_CASE("C API: Test config iter", "[capi], [config]") {
   vfs_param_values["min_parallel_size"] = "10485760";
   vfs_param_values["file.max_parallel_ops"] =
       std::to_string(std::thread::hardware_concurrency());
+  vfs_param_values["file.max_open_handles"] = "128";
+  vfs_param_values["file.enable_io_uring"] = "false";
+  vfs_param_values["file.enable_mmap"] = "false";
   vfs_param_values["s3.scheme"] = "https";
   vfs_param_values["s3.region"] = "us-east-1";
   vfs_param_values["s3.aws_access_key_id"] = "";
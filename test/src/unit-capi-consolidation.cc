@@ -33,10 +33,15 @@
 #include "catch.hpp"
 #include "test/src/helpers.h"
 #include "tiledb/sm/c_api/tiledb.h"
+#include "tiledb/sm/misc/stats.h"
 
+#include <algorithm>
+#include <chrono>
 #include <climits>
 #include <cstring>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 /** Tests for C API consolidation. */
 struct ConsolidationFx {
@@ -77,6 +82,7 @@ struct ConsolidationFx {
   void write_dense_unordered();
   void write_sparse_full();
   void write_sparse_unordered();
+  void write_sparse_row(uint64_t row);
   void write_kv_keys_abc();
   void write_kv_keys_acd();
   void read_dense_vector();
@@ -92,10 +98,12 @@ struct ConsolidationFx {
   void read_dense_subarray_unordered_full();
   void read_sparse_full_unordered();
   void read_sparse_unordered_full();
+  void read_sparse_rows(const std::vector<uint64_t>& rows);
   void read_kv_keys_abc_acd();
   void read_kv_keys_acd_abc();
   void consolidate_dense();
   void consolidate_sparse();
+  void consolidate_sparse_fragment_meta();
   void consolidate_kv();
   void remove_dense_vector();
   void remove_dense_array();
@@ -1692,6 +1700,86 @@ void ConsolidationFx::write_sparse_unordered() {
   tiledb_query_free(&query);
 }
 
+void ConsolidationFx::write_sparse_row(uint64_t row) {
+  // Prepare cell buffers for cells (row, 1), (row, 2) and (row, 3), which
+  // span two space tiles. The cell values are derived from the row.
+  int buffer_a1[3];
+  uint64_t buffer_a2[3];
+  char buffer_var_a2[6];
+  float buffer_a3[6];
+  uint64_t buffer_coords[6];
+  for (uint64_t i = 0; i < 3; ++i) {
+    buffer_a1[i] = (int)(10 * row + i);
+    buffer_a2[i] = 2 * i;
+    buffer_var_a2[2 * i] = buffer_var_a2[2 * i + 1] = (char)('a' + row + i);
+    buffer_a3[2 * i] = buffer_a1[i] + 0.1f;
+    buffer_a3[2 * i + 1] = buffer_a1[i] + 0.2f;
+    buffer_coords[2 * i] = row;
+    buffer_coords[2 * i + 1] = i + 1;
+  }
+  uint64_t buffer_sizes[] = {sizeof(buffer_a1),
+                             sizeof(buffer_a2),
+                             sizeof(buffer_var_a2),
+                             sizeof(buffer_a3),
+                             sizeof(buffer_coords)};
+
+  // Open array
+  tiledb_array_t* array;
+  int rc = tiledb_array_alloc(ctx_, SPARSE_ARRAY_NAME, &array);
+  CHECK(rc == TILEDB_OK);
+  if (encryption_type_ == TILEDB_NO_ENCRYPTION) {
+    rc = tiledb_array_open(ctx_, array, TILEDB_WRITE);
+  } else {
+    rc = tiledb_array_open_with_key(
+        ctx_,
+        array,
+        TILEDB_WRITE,
+        encryption_type_,
+        encryption_key_,
+        (uint32_t)strlen(encryption_key_));
+  }
+  REQUIRE(rc == TILEDB_OK);
+
+  // Create query
+  tiledb_query_t* query;
+  rc = tiledb_query_alloc(ctx_, array, TILEDB_WRITE, &query);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_query_set_layout(ctx_, query, TILEDB_GLOBAL_ORDER);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffer(ctx_, query, "a1", buffer_a1, &buffer_sizes[0]);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffer_var(
+      ctx_,
+      query,
+      "a2",
+      buffer_a2,
+      &buffer_sizes[1],
+      buffer_var_a2,
+      &buffer_sizes[2]);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffer(ctx_, query, "a3", buffer_a3, &buffer_sizes[3]);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffer(
+      ctx_, query, TILEDB_COORDS, buffer_coords, &buffer_sizes[4]);
+  CHECK(rc == TILEDB_OK);
+
+  // Submit query
+  rc = tiledb_query_submit(ctx_, query);
+  CHECK(rc == TILEDB_OK);
+
+  // Finalize query
+  rc = tiledb_query_finalize(ctx_, query);
+  CHECK(rc == TILEDB_OK);
+
+  // Close array
+  rc = tiledb_array_close(ctx_, array);
+  CHECK(rc == TILEDB_OK);
+
+  // Clean up
+  tiledb_array_free(&array);
+  tiledb_query_free(&query);
+}
+
 void ConsolidationFx::write_kv_keys_abc() {
   tiledb_kv_t* kv;
   int rc = tiledb_kv_alloc(ctx_, KV_NAME, &kv);
@@ -2838,6 +2926,128 @@ void ConsolidationFx::read_sparse_unordered_full() {
   free(buffer_coords);
 }
 
+void ConsolidationFx::read_sparse_rows(const std::vector<uint64_t>& rows) {
+  // Get the cells written by `write_sparse_row` for each row in the global
+  // order, i.e., sorted on the 2x2 space tile and then on the coordinates
+  std::vector<std::pair<uint64_t, uint64_t>> cells;
+  for (auto row : rows) {
+    for (uint64_t i = 0; i < 3; ++i)
+      cells.emplace_back(row, i);
+  }
+  std::sort(
+      cells.begin(),
+      cells.end(),
+      [](const std::pair<uint64_t, uint64_t>& a,
+         const std::pair<uint64_t, uint64_t>& b) {
+        auto tile_a = std::make_pair((a.first - 1) / 2, a.second / 2);
+        auto tile_b = std::make_pair((b.first - 1) / 2, b.second / 2);
+        return tile_a < tile_b || (tile_a == tile_b && a < b);
+      });
+
+  // Correct buffers
+  std::vector<int> c_buffer_a1;
+  std::vector<uint64_t> c_buffer_a2_off;
+  std::string c_buffer_a2_val;
+  std::vector<float> c_buffer_a3;
+  std::vector<uint64_t> c_buffer_coords;
+  for (const auto& cell : cells) {
+    auto row = cell.first;
+    auto i = cell.second;
+    c_buffer_a1.push_back((int)(10 * row + i));
+    c_buffer_a2_off.push_back(c_buffer_a2_val.size());
+    c_buffer_a2_val.append(2, (char)('a' + row + i));
+    c_buffer_a3.push_back(c_buffer_a1.back() + 0.1f);
+    c_buffer_a3.push_back(c_buffer_a1.back() + 0.2f);
+    c_buffer_coords.push_back(row);
+    c_buffer_coords.push_back(i + 1);
+  }
+
+  // Open array
+  tiledb_array_t* array;
+  int rc = tiledb_array_alloc(ctx_, SPARSE_ARRAY_NAME, &array);
+  CHECK(rc == TILEDB_OK);
+  if (encryption_type_ == TILEDB_NO_ENCRYPTION) {
+    rc = tiledb_array_open(ctx_, array, TILEDB_READ);
+  } else {
+    rc = tiledb_array_open_with_key(
+        ctx_,
+        array,
+        TILEDB_READ,
+        encryption_type_,
+        encryption_key_,
+        (uint32_t)strlen(encryption_key_));
+  }
+  REQUIRE(rc == TILEDB_OK);
+
+  // Prepare cell buffers, large enough for the whole array
+  std::vector<int> buffer_a1(16);
+  std::vector<uint64_t> buffer_a2_off(16);
+  std::vector<char> buffer_a2_val(32);
+  std::vector<float> buffer_a3(32);
+  std::vector<uint64_t> buffer_coords(32);
+  uint64_t buffer_a1_size = buffer_a1.size() * sizeof(int);
+  uint64_t buffer_a2_off_size = buffer_a2_off.size() * sizeof(uint64_t);
+  uint64_t buffer_a2_val_size = buffer_a2_val.size();
+  uint64_t buffer_a3_size = buffer_a3.size() * sizeof(float);
+  uint64_t buffer_coords_size = buffer_coords.size() * sizeof(uint64_t);
+
+  // Create query
+  uint64_t subarray[] = {1, 4, 1, 4};
+  tiledb_query_t* query;
+  rc = tiledb_query_alloc(ctx_, array, TILEDB_READ, &query);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_query_set_layout(ctx_, query, TILEDB_GLOBAL_ORDER);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_query_set_subarray(ctx_, query, subarray);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffer(
+      ctx_, query, "a1", &buffer_a1[0], &buffer_a1_size);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffer_var(
+      ctx_,
+      query,
+      "a2",
+      &buffer_a2_off[0],
+      &buffer_a2_off_size,
+      &buffer_a2_val[0],
+      &buffer_a2_val_size);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffer(
+      ctx_, query, "a3", &buffer_a3[0], &buffer_a3_size);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffer(
+      ctx_, query, TILEDB_COORDS, &buffer_coords[0], &buffer_coords_size);
+  CHECK(rc == TILEDB_OK);
+
+  // Submit query
+  rc = tiledb_query_submit(ctx_, query);
+  CHECK(rc == TILEDB_OK);
+
+  // Finalize query
+  rc = tiledb_query_finalize(ctx_, query);
+  CHECK(rc == TILEDB_OK);
+
+  // Check buffers
+  buffer_a1.resize(buffer_a1_size / sizeof(int));
+  buffer_a2_off.resize(buffer_a2_off_size / sizeof(uint64_t));
+  buffer_a3.resize(buffer_a3_size / sizeof(float));
+  buffer_coords.resize(buffer_coords_size / sizeof(uint64_t));
+  CHECK(buffer_a1 == c_buffer_a1);
+  CHECK(buffer_a2_off == c_buffer_a2_off);
+  CHECK(
+      std::string(&buffer_a2_val[0], buffer_a2_val_size) == c_buffer_a2_val);
+  CHECK(buffer_a3 == c_buffer_a3);
+  CHECK(buffer_coords == c_buffer_coords);
+
+  // Close array
+  rc = tiledb_array_close(ctx_, array);
+  CHECK(rc == TILEDB_OK);
+
+  // Clean up
+  tiledb_array_free(&array);
+  tiledb_query_free(&query);
+}
+
 void ConsolidationFx::read_kv_keys_abc_acd() {
   // Open key-value store
   tiledb_kv_t* kv;
@@ -3008,6 +3218,32 @@ void ConsolidationFx::consolidate_sparse() {
   REQUIRE(rc == TILEDB_OK);
 }
 
+void ConsolidationFx::consolidate_sparse_fragment_meta() {
+  tiledb_config_t* config = nullptr;
+  tiledb_error_t* error = nullptr;
+  REQUIRE(tiledb_config_alloc(&config, &error) == TILEDB_OK);
+  REQUIRE(error == nullptr);
+  int rc = tiledb_config_set(
+      config, "sm.consolidation.mode", "fragment_meta", &error);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(error == nullptr);
+
+  if (encryption_type_ == TILEDB_NO_ENCRYPTION) {
+    rc = tiledb_array_consolidate(ctx_, SPARSE_ARRAY_NAME, config);
+  } else {
+    rc = tiledb_array_consolidate_with_key(
+        ctx_,
+        SPARSE_ARRAY_NAME,
+        encryption_type_,
+        encryption_key_,
+        (uint32_t)strlen(encryption_key_),
+        config);
+  }
+  REQUIRE(rc == TILEDB_OK);
+
+  tiledb_config_free(&config);
+}
+
 void ConsolidationFx::consolidate_kv() {
   int rc;
   if (encryption_type_ == TILEDB_NO_ENCRYPTION) {
@@ -3099,6 +3335,40 @@ TEST_CASE_METHOD(
   remove_dense_array();
 }
 
+TEST_CASE_METHOD(
+    ConsolidationFx,
+    "C API: Test consolidation, dense, multiple chunks",
+    "[capi], [consolidation], [dense-consolidation], [double-buffering]") {
+  remove_dense_array();
+  create_dense_array();
+  tiledb::sm::stats::all_stats.set_enabled(true);
+  tiledb::sm::stats::all_stats.reset();
+
+  write_dense_full();
+  write_dense_subarray();
+  write_dense_unordered();
+
+  // The cells are copied in chunks of a few tiles, each read while the
+  // previous one is written
+  tiledb_config_t* config = nullptr;
+  tiledb_error_t* error = nullptr;
+  REQUIRE(tiledb_config_alloc(&config, &error) == TILEDB_OK);
+  REQUIRE(error == nullptr);
+  int rc =
+      tiledb_config_set(config, "sm.consolidation.buffer_size", "64", &error);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(error == nullptr);
+  rc = tiledb_array_consolidate(ctx_, DENSE_ARRAY_NAME, config);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_config_free(&config);
+
+  CHECK(tiledb::sm::stats::all_stats.counter_consolidator_num_copy_chunks > 1);
+  read_dense_full_subarray_unordered();
+
+  tiledb::sm::stats::all_stats.set_enabled(false);
+  remove_dense_array();
+}
+
 TEST_CASE_METHOD(
     ConsolidationFx,
     "C API: Test consolidation, sparse",
@@ -3134,6 +3404,274 @@ TEST_CASE_METHOD(
   remove_sparse_array();
 }
 
+TEST_CASE_METHOD(
+    ConsolidationFx,
+    "C API: Test consolidation, sparse, tile copy",
+    "[capi], [consolidation], [sparse-consolidation], [tile-copy]") {
+  remove_sparse_array();
+  tiledb::sm::stats::all_stats.set_enabled(true);
+  tiledb::sm::stats::all_stats.reset();
+
+  // Each row is written in two data tiles, of two cells and one cell
+  // respectively (the array capacity is 2)
+  SECTION("- disjoint fragments") {
+    create_sparse_array();
+    write_sparse_row(3);
+    write_sparse_row(1);
+    consolidate_sparse();
+    CHECK(
+        tiledb::sm::stats::all_stats.counter_consolidator_num_tile_copy_steps ==
+        1);
+    CHECK(
+        tiledb::sm::stats::all_stats.counter_consolidator_num_tiles_copied ==
+        4);
+    read_sparse_rows({1, 3});
+  }
+
+  SECTION("- disjoint fragments (encrypted)") {
+    encryption_type_ = TILEDB_AES_256_GCM;
+    encryption_key_ = "0123456789abcdeF0123456789abcdeF";
+    create_sparse_array();
+    write_sparse_row(1);
+    write_sparse_row(3);
+    consolidate_sparse();
+    CHECK(
+        tiledb::sm::stats::all_stats.counter_consolidator_num_tile_copy_steps ==
+        1);
+    read_sparse_rows({1, 3});
+  }
+
+  SECTION("- interleaving fragments") {
+    // Rows 1 and 2 share the same space tiles
+    create_sparse_array();
+    write_sparse_row(1);
+    write_sparse_row(2);
+    consolidate_sparse();
+    CHECK(
+        tiledb::sm::stats::all_stats.counter_consolidator_num_tile_copy_steps ==
+        0);
+    read_sparse_rows({1, 2});
+  }
+
+  tiledb::sm::stats::all_stats.set_enabled(false);
+  remove_sparse_array();
+}
+
+TEST_CASE_METHOD(
+    ConsolidationFx,
+    "C API: Test consolidation, sparse, merge",
+    "[capi], [consolidation], [sparse-consolidation], [merge]") {
+  remove_sparse_array();
+  create_sparse_array();
+  tiledb::sm::stats::all_stats.set_enabled(true);
+  tiledb::sm::stats::all_stats.reset();
+
+  // The two fragments share cells (3, 3) and (3, 4)
+  write_sparse_full();
+  write_sparse_unordered();
+
+  SECTION("- default buffer size") {
+    consolidate_sparse();
+  }
+
+  SECTION("- small buffer size") {
+    // The cursors of the two fragments get buffers smaller than a tile,
+    // and the consolidated cells are written in several chunks
+    tiledb_config_t* config = nullptr;
+    tiledb_error_t* error = nullptr;
+    REQUIRE(tiledb_config_alloc(&config, &error) == TILEDB_OK);
+    REQUIRE(error == nullptr);
+    int rc = tiledb_config_set(
+        config, "sm.consolidation.buffer_size", "100", &error);
+    REQUIRE(rc == TILEDB_OK);
+    REQUIRE(error == nullptr);
+    rc = tiledb_array_consolidate(ctx_, SPARSE_ARRAY_NAME, config);
+    REQUIRE(rc == TILEDB_OK);
+    tiledb_config_free(&config);
+  }
+
+  CHECK(
+      tiledb::sm::stats::all_stats.counter_consolidator_num_merge_steps == 1);
+  CHECK(
+      tiledb::sm::stats::all_stats.counter_consolidator_num_cells_merged ==
+      10);
+  CHECK(
+      tiledb::sm::stats::all_stats.counter_consolidator_num_cells_deduped ==
+      2);
+  read_sparse_full_unordered();
+
+  tiledb::sm::stats::all_stats.set_enabled(false);
+  remove_sparse_array();
+}
+
+TEST_CASE_METHOD(
+    ConsolidationFx,
+    "C API: Test consolidation, sparse, merge overlapping fragments",
+    "[capi], [consolidation], [sparse-consolidation], [merge]") {
+  remove_sparse_array();
+  create_sparse_array();
+  tiledb::sm::stats::all_stats.set_enabled(true);
+  tiledb::sm::stats::all_stats.reset();
+
+  // The merged fragment must be stored and the old fragments deleted
+  write_sparse_full();
+  write_sparse_unordered();
+  consolidate_sparse();
+  get_dir_num_struct data = {ctx_, vfs_, 0};
+  int rc = tiledb_vfs_ls(ctx_, vfs_, SPARSE_ARRAY_NAME, &get_dir_num, &data);
+  CHECK(rc == TILEDB_OK);
+  CHECK(data.dir_num == 1);
+  read_sparse_full_unordered();
+
+  // The consolidated fragment is merged again with a new overlapping one
+  write_sparse_unordered();
+  consolidate_sparse();
+  data.dir_num = 0;
+  rc = tiledb_vfs_ls(ctx_, vfs_, SPARSE_ARRAY_NAME, &get_dir_num, &data);
+  CHECK(rc == TILEDB_OK);
+  CHECK(data.dir_num == 1);
+  CHECK(
+      tiledb::sm::stats::all_stats.counter_consolidator_num_merge_steps == 2);
+  read_sparse_full_unordered();
+
+  tiledb::sm::stats::all_stats.set_enabled(false);
+  remove_sparse_array();
+}
+
+TEST_CASE_METHOD(
+    ConsolidationFx,
+    "C API: Test consolidation, background",
+    "[capi], [consolidation], [sparse-consolidation], [auto-consolidation]") {
+  remove_sparse_array();
+
+  // Replace the context with one consolidating the arrays it writes
+  tiledb_config_t* config = nullptr;
+  tiledb_error_t* error = nullptr;
+  REQUIRE(tiledb_config_alloc(&config, &error) == TILEDB_OK);
+  REQUIRE(error == nullptr);
+  int rc = tiledb_config_set(config, "sm.consolidation.auto", "true", &error);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(error == nullptr);
+  rc = tiledb_config_set(config, "sm.consolidation.auto_frag_num", "3", &error);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(error == nullptr);
+  rc = tiledb_config_set(
+      config, "sm.consolidation.auto_interval_ms", "10", &error);
+  REQUIRE(rc == TILEDB_OK);
+  REQUIRE(error == nullptr);
+  tiledb_vfs_free(&vfs_);
+  tiledb_ctx_free(&ctx_);
+  REQUIRE(tiledb_ctx_alloc(config, &ctx_) == TILEDB_OK);
+  REQUIRE(tiledb_vfs_alloc(ctx_, nullptr, &vfs_) == TILEDB_OK);
+  tiledb_config_free(&config);
+
+  // Keep the array open for writes, so that it stays checked for
+  // background consolidation
+  create_sparse_array();
+  tiledb_array_t* array;
+  rc = tiledb_array_alloc(ctx_, SPARSE_ARRAY_NAME, &array);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_open(ctx_, array, TILEDB_WRITE);
+  REQUIRE(rc == TILEDB_OK);
+  write_sparse_row(1);
+  write_sparse_row(3);
+  write_sparse_row(2);
+
+  // Wait until the three fragments get consolidated into one
+  get_dir_num_struct data = {ctx_, vfs_, 0};
+  for (int i = 0; i < 1000; ++i) {
+    data.dir_num = 0;
+    rc = tiledb_vfs_ls(ctx_, vfs_, SPARSE_ARRAY_NAME, &get_dir_num, &data);
+    CHECK(rc == TILEDB_OK);
+    if (data.dir_num == 1)
+      break;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  CHECK(data.dir_num == 1);
+  rc = tiledb_array_close(ctx_, array);
+  CHECK(rc == TILEDB_OK);
+  tiledb_array_free(&array);
+  read_sparse_rows({1, 2, 3});
+
+  remove_sparse_array();
+}
+
+TEST_CASE_METHOD(
+    ConsolidationFx,
+    "C API: Test consolidation, fragment metadata",
+    "[capi], [consolidation], [sparse-consolidation], [fragment-meta]") {
+  remove_sparse_array();
+  tiledb::sm::stats::all_stats.set_enabled(true);
+  tiledb::sm::stats::all_stats.reset();
+
+  SECTION("- unencrypted") {
+  }
+
+  SECTION("- encrypted") {
+    encryption_type_ = TILEDB_AES_256_GCM;
+    encryption_key_ = "0123456789abcdeF0123456789abcdeF";
+  }
+
+  create_sparse_array();
+  write_sparse_row(1);
+  write_sparse_row(3);
+  consolidate_sparse_fragment_meta();
+  CHECK(
+      tiledb::sm::stats::all_stats
+          .counter_consolidator_num_fragment_meta_packed == 2);
+  std::string meta_file =
+      std::string(SPARSE_ARRAY_NAME) + "/__fragment_meta.tdb";
+  int is_file = 0;
+  int rc = tiledb_vfs_is_file(ctx_, vfs_, meta_file.c_str(), &is_file);
+  CHECK(rc == TILEDB_OK);
+  CHECK(is_file);
+
+  // The two fragments are loaded from the consolidated fragment metadata
+  read_sparse_rows({1, 3});
+  CHECK(
+      tiledb::sm::stats::all_stats.counter_fragment_metadata_num_consolidated ==
+      2);
+
+  // A fragment written later is loaded individually
+  write_sparse_row(2);
+  read_sparse_rows({1, 2, 3});
+  CHECK(
+      tiledb::sm::stats::all_stats.counter_fragment_metadata_num_consolidated ==
+      4);
+
+  // Consolidating the fragments writes the consolidated fragment metadata
+  // again, for the single remaining fragment
+  consolidate_sparse();
+  CHECK(
+      tiledb::sm::stats::all_stats
+          .counter_consolidator_num_fragment_meta_packed == 3);
+  rc = tiledb_vfs_is_file(ctx_, vfs_, meta_file.c_str(), &is_file);
+  CHECK(rc == TILEDB_OK);
+  CHECK(is_file);
+  read_sparse_rows({1, 2, 3});
+
+  // A corrupt consolidated fragment metadata file is ignored, and the
+  // fragment is loaded individually
+  tiledb_vfs_fh_t* fh;
+  rc = tiledb_vfs_open(ctx_, vfs_, meta_file.c_str(), TILEDB_VFS_WRITE, &fh);
+  REQUIRE(rc == TILEDB_OK);
+  const char garbage[] = "not a fragment metadata file";
+  rc = tiledb_vfs_write(ctx_, fh, garbage, sizeof(garbage));
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_vfs_close(ctx_, fh);
+  CHECK(rc == TILEDB_OK);
+  tiledb_vfs_fh_free(&fh);
+  uint64_t num_consolidated =
+      tiledb::sm::stats::all_stats.counter_fragment_metadata_num_consolidated;
+  read_sparse_rows({1, 2, 3});
+  CHECK(
+      tiledb::sm::stats::all_stats.counter_fragment_metadata_num_consolidated ==
+      num_consolidated);
+
+  tiledb::sm::stats::all_stats.set_enabled(false);
+  remove_sparse_array();
+}
+
 TEST_CASE_METHOD(
     ConsolidationFx,
     "C API: Test consolidation, KV",
@@ -102,12 +102,17 @@ TEST_CASE("C API: Test enum values", "[capi], [enums]") {
   REQUIRE(TILEDB_FILTER_BITSHUFFLE == 8);
   REQUIRE(TILEDB_FILTER_BYTESHUFFLE == 9);
   REQUIRE(TILEDB_FILTER_POSITIVE_DELTA == 10);
+  REQUIRE(TILEDB_FILTER_PFOR == 12);
+  REQUIRE(TILEDB_FILTER_FLOAT_PLANE == 13);
+  REQUIRE(TILEDB_FILTER_DICTIONARY == 14);
+  REQUIRE(TILEDB_FILTER_ADAPTIVE == 15);
   REQUIRE((uint8_t)FilterType::INTERNAL_FILTER_AES_256_GCM == 11);
 
   /** Filter option */
   REQUIRE(TILEDB_COMPRESSION_LEVEL == 0);
   REQUIRE(TILEDB_BIT_WIDTH_MAX_WINDOW == 1);
   REQUIRE(TILEDB_POSITIVE_DELTA_MAX_WINDOW == 2);
+  REQUIRE(TILEDB_ADAPTIVE_DECODE_WEIGHT == 3);
 
   /** Encryption type */
   REQUIRE(TILEDB_NO_ENCRYPTION == 0);
@@ -128,4 +133,23 @@ TEST_CASE("C API: Test enum values", "[capi], [enums]") {
   REQUIRE(TILEDB_VFS_READ == 0);
   REQUIRE(TILEDB_VFS_WRITE == 1);
   REQUIRE(TILEDB_VFS_APPEND == 2);
+
+  /** Query condition operator */
+  REQUIRE(TILEDB_LT == 0);
+  REQUIRE(TILEDB_LE == 1);
+  REQUIRE(TILEDB_GT == 2);
+  REQUIRE(TILEDB_GE == 3);
+  REQUIRE(TILEDB_EQ == 4);
+  REQUIRE(TILEDB_NE == 5);
+
+  /** Query condition combination operator */
+  REQUIRE(TILEDB_AND == 0);
+  REQUIRE(TILEDB_OR == 1);
+
+  /** Aggregate operator */
+  REQUIRE(TILEDB_COUNT == 0);
+  REQUIRE(TILEDB_SUM == 1);
+  REQUIRE(TILEDB_MIN == 2);
+  REQUIRE(TILEDB_MAX == 3);
+  REQUIRE(TILEDB_MEAN == 4);
 }
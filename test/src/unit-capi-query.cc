@@ -568,3 +568,184 @@ TEST_CASE_METHOD(
   tiledb_array_free(&array);
   remove_temp_dir(temp_dir);
 }
+
+TEST_CASE_METHOD(
+    QueryFx,
+    "C API: Test query condition",
+    "[capi], [query], [query-condition]") {
+  std::string temp_dir = FILE_URI_PREFIX + FILE_TEMP_DIR;
+  std::string array_name = temp_dir + "query_condition";
+  create_temp_dir(temp_dir);
+  create_array(array_name);
+
+  // Initialize and combine conditions
+  int32_t value = 5;
+  tiledb_query_condition_t* cond1;
+  int rc = tiledb_query_condition_alloc(ctx_, &cond1);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_query_condition_t* cond2;
+  rc = tiledb_query_condition_alloc(ctx_, &cond2);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_query_condition_t* combined;
+  rc = tiledb_query_condition_combine(ctx_, cond1, cond2, TILEDB_OR, &combined);
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_query_condition_init(
+      ctx_, cond1, "", &value, sizeof(value), TILEDB_LT);
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_query_condition_init(
+      ctx_, cond1, "a2", &value, sizeof(value), TILEDB_LT);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_query_condition_init(
+      ctx_, cond1, "a2", &value, sizeof(value), TILEDB_GE);
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_query_condition_init(
+      ctx_, cond2, "foo", &value, sizeof(value), TILEDB_EQ);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_query_condition_combine(ctx_, cond1, cond2, TILEDB_OR, &combined);
+  CHECK(rc == TILEDB_OK);
+
+  tiledb_array_t* array;
+  rc = tiledb_array_alloc(ctx_, array_name.c_str(), &array);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_open(ctx_, array, TILEDB_READ);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_query_t* query;
+  rc = tiledb_query_alloc(ctx_, array, TILEDB_READ, &query);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Var-sized and non-existent attributes are rejected
+  rc = tiledb_query_set_condition(ctx_, query, cond1);
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_query_set_condition(ctx_, query, cond2);
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_query_set_condition(ctx_, query, combined);
+  CHECK(rc == TILEDB_ERR);
+
+  rc = tiledb_array_close(ctx_, array);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_query_free(&query);
+
+  // Conditions are not applicable to writes
+  rc = tiledb_array_open(ctx_, array, TILEDB_WRITE);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_alloc(ctx_, array, TILEDB_WRITE, &query);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_condition(ctx_, query, cond1);
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_array_close(ctx_, array);
+  REQUIRE(rc == TILEDB_OK);
+
+  tiledb_query_condition_free(&cond1);
+  tiledb_query_condition_free(&cond2);
+  tiledb_query_condition_free(&combined);
+  CHECK(combined == nullptr);
+  tiledb_query_free(&query);
+  tiledb_array_free(&array);
+  remove_temp_dir(temp_dir);
+}
+
+TEST_CASE_METHOD(
+    QueryFx,
+    "C API: Test query aggregates",
+    "[capi], [query], [aggregate]") {
+  std::string temp_dir = FILE_URI_PREFIX + FILE_TEMP_DIR;
+  std::string array_name = temp_dir + "query_aggregate";
+  create_temp_dir(temp_dir);
+  create_array(array_name);
+
+  // Write a 2x2 subarray
+  tiledb_array_t* array;
+  int rc = tiledb_array_alloc(ctx_, array_name.c_str(), &array);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_open(ctx_, array, TILEDB_WRITE);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_query_t* query;
+  rc = tiledb_query_alloc(ctx_, array, TILEDB_WRITE, &query);
+  REQUIRE(rc == TILEDB_OK);
+  uint64_t subarray[] = {1, 2, 1, 2};
+  int a1[] = {1, 2, 3, 4};
+  uint64_t a1_size = sizeof(a1);
+  uint64_t a2_off[] = {0, 4, 8, 12};
+  uint64_t a2_off_size = sizeof(a2_off);
+  int a2_val[] = {1, 2, 3, 4};
+  uint64_t a2_val_size = sizeof(a2_val);
+  rc = tiledb_query_set_subarray(ctx_, query, subarray);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffer(ctx_, query, "", a1, &a1_size);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_set_buffer_var(
+      ctx_, query, "a2", a2_off, &a2_off_size, a2_val, &a2_val_size);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_submit(ctx_, query);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_array_close(ctx_, array);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_query_free(&query);
+
+  rc = tiledb_array_open(ctx_, array, TILEDB_READ);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_alloc(ctx_, array, TILEDB_READ, &query);
+  REQUIRE(rc == TILEDB_OK);
+
+  // Non-existent attributes are rejected, and so are the var-sized ones
+  // except for counting
+  rc = tiledb_query_add_aggregate(ctx_, query, "foo", TILEDB_COUNT);
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_query_add_aggregate(ctx_, query, "a2", TILEDB_SUM);
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_query_add_aggregate(ctx_, query, "a2", TILEDB_COUNT);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_query_add_aggregate(ctx_, query, "", TILEDB_SUM);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_query_add_aggregate(ctx_, query, "", TILEDB_MAX);
+  CHECK(rc == TILEDB_OK);
+  rc = tiledb_query_add_aggregate(ctx_, query, "", TILEDB_MEAN);
+  CHECK(rc == TILEDB_OK);
+
+  // The results are available once the query completes
+  uint64_t count = 0;
+  rc = tiledb_query_get_aggregate(ctx_, query, "a2", TILEDB_COUNT, &count);
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_query_submit(ctx_, query);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_query_status_t status;
+  rc = tiledb_query_get_status(ctx_, query, &status);
+  REQUIRE(rc == TILEDB_OK);
+  CHECK(status == TILEDB_COMPLETED);
+
+  int64_t sum = 0;
+  int32_t max = 0;
+  double mean = 0;
+  rc = tiledb_query_get_aggregate(ctx_, query, "a2", TILEDB_COUNT, &count);
+  CHECK(rc == TILEDB_OK);
+  CHECK(count == 4);
+  rc = tiledb_query_get_aggregate(ctx_, query, "", TILEDB_SUM, &sum);
+  CHECK(rc == TILEDB_OK);
+  CHECK(sum == 10);
+  rc = tiledb_query_get_aggregate(ctx_, query, "", TILEDB_MAX, &max);
+  CHECK(rc == TILEDB_OK);
+  CHECK(max == 4);
+  rc = tiledb_query_get_aggregate(ctx_, query, "", TILEDB_MEAN, &mean);
+  CHECK(rc == TILEDB_OK);
+  CHECK(mean == 2.5);
+  rc = tiledb_query_get_aggregate(ctx_, query, "", TILEDB_MIN, &max);
+  CHECK(rc == TILEDB_ERR);
+
+  rc = tiledb_array_close(ctx_, array);
+  REQUIRE(rc == TILEDB_OK);
+  tiledb_query_free(&query);
+
+  // Aggregates are not applicable to writes
+  rc = tiledb_array_open(ctx_, array, TILEDB_WRITE);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_alloc(ctx_, array, TILEDB_WRITE, &query);
+  REQUIRE(rc == TILEDB_OK);
+  rc = tiledb_query_add_aggregate(ctx_, query, "", TILEDB_COUNT);
+  CHECK(rc == TILEDB_ERR);
+  rc = tiledb_array_close(ctx_, array);
+  REQUIRE(rc == TILEDB_OK);
+
+  tiledb_query_free(&query);
+  tiledb_array_free(&array);
+  remove_temp_dir(temp_dir);
+}
@@ -0,0 +1,306 @@
+/**
+ * @file   unit-cppapi-aggregate.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2019 TileDB Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the C++ API for aggregate queries.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/cpp_api/tiledb"
+#include "tiledb/sm/misc/stats.h"
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+using namespace tiledb;
+
+namespace {
+
+/**
+ * Creates a 4x4 sparse array with capacity 2. The first fragment holds 8
+ * cells with `a = i` and `b = 0.5 * i`, two per data tile. The second
+ * fragment overwrites cell (0, 0) with `a = 10, b = 100` and adds cell
+ * (3, 0) with `a = -5, b = NaN`, in a single tile overlapping the first two
+ * tiles of the first fragment.
+ */
+void create_sparse_aggregate_array(
+    const Context& ctx, const std::string& array_name) {
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "rows", {{0, 3}}, 2))
+      .add_dimension(Dimension::create<int>(ctx, "cols", {{0, 3}}, 2));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain)
+      .set_order({{TILEDB_ROW_MAJOR, TILEDB_ROW_MAJOR}})
+      .set_capacity(2);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  schema.add_attribute(Attribute::create<float>(ctx, "b"));
+  schema.add_attribute(Attribute::create<std::string>(ctx, "c"));
+  Array::create(array_name, schema);
+
+  std::vector<int> coords = {0, 0, 0, 1, 1, 0, 1, 1, 2, 2, 2, 3, 3, 2, 3, 3};
+  std::vector<int> a = {0, 1, 2, 3, 4, 5, 6, 7};
+  std::vector<float> b = {0, 0.5f, 1, 1.5f, 2, 2.5f, 3, 3.5f};
+  std::vector<uint64_t> c_off = {0, 1, 2, 3, 4, 5, 6, 7};
+  std::string c_val = "abcdefgh";
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array);
+  query.set_coordinates(coords)
+      .set_layout(TILEDB_UNORDERED)
+      .set_buffer("a", a)
+      .set_buffer("b", b)
+      .set_buffer("c", c_off, c_val);
+  query.submit();
+  array.close();
+
+  // Make sure the second fragment gets a later timestamp
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  coords = {0, 0, 3, 0};
+  a = {10, -5};
+  b = {100, std::numeric_limits<float>::quiet_NaN()};
+  c_off = {0, 1};
+  c_val = "xy";
+  array.open(TILEDB_WRITE);
+  Query query_2(ctx, array);
+  query_2.set_coordinates(coords)
+      .set_layout(TILEDB_UNORDERED)
+      .set_buffer("a", a)
+      .set_buffer("b", b)
+      .set_buffer("c", c_off, c_val);
+  query_2.submit();
+  array.close();
+}
+
+/**
+ * Creates a 4x4 dense array with 2x2 tiles. The first fragment writes
+ * `a = 1, ..., 8` to rows 0-1, and the second overwrites cells (0, 0) and
+ * (0, 1) with `a = 100, 200`.
+ */
+void create_dense_aggregate_array(
+    const Context& ctx, const std::string& array_name) {
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "rows", {{0, 3}}, 2))
+      .add_dimension(Dimension::create<int>(ctx, "cols", {{0, 3}}, 2));
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain).set_order({{TILEDB_ROW_MAJOR, TILEDB_ROW_MAJOR}});
+  schema.add_attribute(Attribute::create<int64_t>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  std::vector<int64_t> a = {1, 2, 3, 4, 5, 6, 7, 8};
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array);
+  query.set_subarray<int>({0, 1, 0, 3})
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer("a", a);
+  query.submit();
+  array.close();
+
+  // Make sure the second fragment gets a later timestamp
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  a = {100, 200};
+  array.open(TILEDB_WRITE);
+  Query query_2(ctx, array);
+  query_2.set_subarray<int>({0, 0, 0, 1})
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer("a", a);
+  query_2.submit();
+  array.close();
+}
+
+}  // namespace
+
+TEST_CASE(
+    "C++ API: Test sparse aggregates", "[cppapi], [sparse], [aggregate]") {
+  const std::string array_name = "cpp_unit_array_aggregate";
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+  create_sparse_aggregate_array(ctx, array_name);
+
+  auto& stats = tiledb::sm::stats::all_stats;
+  stats.set_enabled(true);
+  stats.reset();
+
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array);
+  query.set_subarray<int>({0, 3, 0, 3})
+      .add_aggregate("c", TILEDB_COUNT)
+      .add_aggregate("a", TILEDB_SUM)
+      .add_aggregate("a", TILEDB_MIN)
+      .add_aggregate("a", TILEDB_MAX)
+      .add_aggregate("a", TILEDB_MEAN)
+      .add_aggregate("b", TILEDB_MIN)
+      .add_aggregate("b", TILEDB_MAX)
+      .add_aggregate("b", TILEDB_SUM);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+
+  // The overwritten cell (0, 0) of the first fragment is excluded
+  CHECK(query.get_aggregate<uint64_t>("c", TILEDB_COUNT) == 9);
+  CHECK(query.get_aggregate<int64_t>("a", TILEDB_SUM) == 33);
+  CHECK(query.get_aggregate<int>("a", TILEDB_MIN) == -5);
+  CHECK(query.get_aggregate<int>("a", TILEDB_MAX) == 10);
+  CHECK(query.get_aggregate<double>("a", TILEDB_MEAN) == 33.0 / 9);
+
+  // NaN values are skipped by MIN and MAX, but not by SUM
+  CHECK(query.get_aggregate<float>("b", TILEDB_MIN) == 0.5f);
+  CHECK(query.get_aggregate<float>("b", TILEDB_MAX) == 100);
+  CHECK(std::isnan(query.get_aggregate<double>("b", TILEDB_SUM)));
+
+  // The tiles of the first fragment that do not overlap the second one are
+  // aggregated from their tile metadata, without being read
+  uint64_t aggregated = stats.counter_reader_num_tiles_aggregated_from_metadata;
+  CHECK(aggregated == 2);
+  stats.set_enabled(false);
+
+  // A result type of the wrong size is rejected
+  CHECK_THROWS(query.get_aggregate<int>("a", TILEDB_SUM));
+  CHECK_THROWS(query.get_aggregate<int64_t>("a", TILEDB_MIN));
+
+  // A partial subarray, with a query condition
+  Query query_2(ctx, array);
+  query_2.set_subarray<int>({0, 1, 0, 3})
+      .set_condition(QueryCondition::create(ctx, "a", 2, TILEDB_GE))
+      .add_aggregate("a", TILEDB_COUNT)
+      .add_aggregate("a", TILEDB_SUM);
+  REQUIRE(query_2.submit() == Query::Status::COMPLETE);
+  CHECK(query_2.get_aggregate<uint64_t>("a", TILEDB_COUNT) == 3);
+  CHECK(query_2.get_aggregate<int64_t>("a", TILEDB_SUM) == 15);
+
+  // A subarray without cells
+  Query query_3(ctx, array);
+  query_3.set_subarray<int>({0, 1, 2, 3})
+      .add_aggregate("a", TILEDB_COUNT)
+      .add_aggregate("a", TILEDB_MIN)
+      .add_aggregate("a", TILEDB_MEAN);
+  REQUIRE(query_3.submit() == Query::Status::COMPLETE);
+  CHECK(query_3.get_aggregate<uint64_t>("a", TILEDB_COUNT) == 0);
+  CHECK(std::isnan(query_3.get_aggregate<double>("a", TILEDB_MEAN)));
+  CHECK_THROWS(query_3.get_aggregate<int>("a", TILEDB_MIN));
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test sparse aggregates with a small memory budget",
+    "[cppapi], [sparse], [aggregate]") {
+  const std::string array_name = "cpp_unit_array_aggregate";
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+  create_sparse_aggregate_array(ctx, array_name);
+
+  // The subarray is split in many partitions, all processed by a single
+  // submission
+  Config config;
+  config["sm.memory_budget"] = "16";
+  Context ctx_2(config);
+  Array array(ctx_2, array_name, TILEDB_READ);
+  Query query(ctx_2, array);
+  query.set_subarray<int>({0, 3, 0, 3})
+      .add_aggregate("a", TILEDB_COUNT)
+      .add_aggregate("a", TILEDB_SUM)
+      .add_aggregate("b", TILEDB_MAX);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  CHECK(query.get_aggregate<uint64_t>("a", TILEDB_COUNT) == 9);
+  CHECK(query.get_aggregate<int64_t>("a", TILEDB_SUM) == 33);
+  CHECK(query.get_aggregate<float>("b", TILEDB_MAX) == 100);
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE("C++ API: Test dense aggregates", "[cppapi], [dense], [aggregate]") {
+  const std::string array_name = "cpp_unit_array_aggregate";
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+  create_dense_aggregate_array(ctx, array_name);
+
+  // Only the non-empty cells are aggregated
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array);
+  query.set_subarray<int>({0, 3, 0, 3})
+      .set_layout(TILEDB_ROW_MAJOR)
+      .add_aggregate("a", TILEDB_COUNT)
+      .add_aggregate("a", TILEDB_SUM)
+      .add_aggregate("a", TILEDB_MIN)
+      .add_aggregate("a", TILEDB_MAX);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  CHECK(query.get_aggregate<uint64_t>("a", TILEDB_COUNT) == 8);
+  CHECK(query.get_aggregate<int64_t>("a", TILEDB_SUM) == 333);
+  CHECK(query.get_aggregate<int64_t>("a", TILEDB_MIN) == 3);
+  CHECK(query.get_aggregate<int64_t>("a", TILEDB_MAX) == 200);
+
+  Query query_2(ctx, array);
+  query_2.set_subarray<int>({0, 1, 1, 2})
+      .add_aggregate("a", TILEDB_COUNT)
+      .add_aggregate("a", TILEDB_MEAN);
+  REQUIRE(query_2.submit() == Query::Status::COMPLETE);
+  CHECK(query_2.get_aggregate<uint64_t>("a", TILEDB_COUNT) == 4);
+  CHECK(query_2.get_aggregate<double>("a", TILEDB_MEAN) == 54);
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE("C++ API: Test aggregate errors", "[cppapi], [aggregate]") {
+  const std::string array_name = "cpp_unit_array_aggregate";
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+  create_sparse_aggregate_array(ctx, array_name);
+
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array);
+
+  // Only counting is applicable to var-sized attributes
+  CHECK_THROWS(query.add_aggregate("c", TILEDB_SUM));
+  CHECK_THROWS(query.add_aggregate("foo", TILEDB_COUNT));
+
+  // Aggregates and buffers are exclusive
+  std::vector<int> a(16);
+  query.set_subarray<int>({0, 3, 0, 3})
+      .add_aggregate("a", TILEDB_SUM)
+      .set_buffer("a", a);
+  CHECK_THROWS(query.submit());
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
@@ -32,6 +32,7 @@
 
 #include "catch.hpp"
 #include "tiledb/sm/cpp_api/tiledb"
+#include "tiledb/sm/misc/stats.h"
 #include "tiledb/sm/misc/utils.h"
 
 using namespace tiledb;
@@ -972,3 +973,304 @@ TEST_CASE(
   if (vfs.is_dir(array_name))
     vfs.remove_dir(array_name);
 }
+
+TEST_CASE(
+    "C++ API: Read with memory-mapped fragment files",
+    "[cppapi], [dense], [mmap]") {
+  const std::string array_name = "cpp_unit_array";
+  Config config;
+  config["vfs.file.enable_mmap"] = "true";
+  Context ctx(config);
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create, with an unfiltered attribute and a compressed one
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "rows", {{0, 3}}, 2))
+      .add_dimension(Dimension::create<int>(ctx, "cols", {{0, 3}}, 2));
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain).set_order({{TILEDB_ROW_MAJOR, TILEDB_ROW_MAJOR}});
+  FilterList filters(ctx);
+  filters.add_filter({ctx, TILEDB_FILTER_GZIP});
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  schema.add_attribute(
+      Attribute::create<int>(ctx, "b").set_filter_list(filters));
+  Array::create(array_name, schema);
+
+  // Write
+  std::vector<int> a_w(16), b_w(16);
+  for (int i = 0; i < 16; i++) {
+    a_w[i] = i;
+    b_w[i] = 100 + i;
+  }
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_subarray({0, 3, 0, 3})
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer("a", a_w)
+      .set_buffer("b", b_w);
+  query_w.submit();
+  array_w.close();
+
+  // Read
+  tiledb::sm::stats::all_stats.set_enabled(true);
+  tiledb::sm::stats::all_stats.reset();
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array);
+  std::vector<int> a_r(16), b_r(16);
+  query.set_subarray({0, 3, 0, 3})
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer("a", a_r)
+      .set_buffer("b", b_r);
+  query.submit();
+  array.close();
+  CHECK(a_r == a_w);
+  CHECK(b_r == b_w);
+
+  // Only the 4 unfiltered tiles are used in place
+  CHECK(tiledb::sm::stats::all_stats.counter_reader_num_tiles_mapped == 4);
+  CHECK(tiledb::sm::stats::all_stats.counter_vfs_posix_mmap_num_files > 0);
+  tiledb::sm::stats::all_stats.set_enabled(false);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Read without populating the tile cache",
+    "[cppapi], [dense], [tile-cache]") {
+  const std::string array_name = "cpp_unit_array";
+  Config config;
+  config["sm.tile_cache_policy"] = "2q";
+  Context ctx(config);
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "rows", {{0, 3}}, 2))
+      .add_dimension(Dimension::create<int>(ctx, "cols", {{0, 3}}, 2));
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain).set_order({{TILEDB_ROW_MAJOR, TILEDB_ROW_MAJOR}});
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  // Write
+  std::vector<int> a_w(16);
+  for (int i = 0; i < 16; i++)
+    a_w[i] = i;
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_subarray({0, 3, 0, 3})
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer("a", a_w);
+  REQUIRE_THROWS(query_w.set_tile_cache_populate(false));
+  query_w.submit();
+  array_w.close();
+
+  auto read = [&](bool populate) {
+    Array array(ctx, array_name, TILEDB_READ);
+    Query query(ctx, array);
+    std::vector<int> a_r(16);
+    query.set_subarray({0, 3, 0, 3})
+        .set_layout(TILEDB_ROW_MAJOR)
+        .set_tile_cache_populate(populate)
+        .set_buffer("a", a_r);
+    query.submit();
+    array.close();
+    CHECK(a_r == a_w);
+  };
+
+  tiledb::sm::stats::all_stats.set_enabled(true);
+  tiledb::sm::stats::all_stats.reset();
+  auto& stats = tiledb::sm::stats::all_stats;
+
+  // Reads that do not populate the cache leave it empty
+  read(false);
+  read(false);
+  CHECK(stats.counter_cache_tile_inserts == 0);
+  CHECK(stats.counter_cache_tile_read_hits == 0);
+
+  // A regular read populates it, and later reads are served from it
+  read(true);
+  CHECK(stats.counter_cache_tile_inserts == 4);
+  read(false);
+  CHECK(stats.counter_cache_tile_read_hits == 4);
+  CHECK(stats.counter_cache_tile_inserts == 4);
+  tiledb::sm::stats::all_stats.set_enabled(false);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Read from the decoded and filtered tile cache tiers",
+    "[cppapi], [dense], [tile-cache]") {
+  const std::string array_name = "cpp_unit_array";
+  std::string decoded_ratio;
+  SECTION("- Decoded tiles only") {
+    decoded_ratio = "1";
+  }
+  SECTION("- Decoded and filtered tiles") {
+    decoded_ratio = "0.5";
+  }
+  SECTION("- Filtered tiles only") {
+    decoded_ratio = "0";
+  }
+  Config config;
+  config["sm.tile_cache_decoded_ratio"] = decoded_ratio;
+  Context ctx(config);
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create, with a compressed attribute
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "rows", {{0, 3}}, 2))
+      .add_dimension(Dimension::create<int>(ctx, "cols", {{0, 3}}, 2));
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain).set_order({{TILEDB_ROW_MAJOR, TILEDB_ROW_MAJOR}});
+  FilterList filters(ctx);
+  filters.add_filter({ctx, TILEDB_FILTER_GZIP});
+  schema.add_attribute(
+      Attribute::create<int>(ctx, "a").set_filter_list(filters));
+  Array::create(array_name, schema);
+
+  // Write
+  std::vector<int> a_w(16);
+  for (int i = 0; i < 16; i++)
+    a_w[i] = i;
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_subarray({0, 3, 0, 3})
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer("a", a_w);
+  query_w.submit();
+  array_w.close();
+
+  auto read = [&]() {
+    Array array(ctx, array_name, TILEDB_READ);
+    Query query(ctx, array);
+    std::vector<int> a_r(16);
+    query.set_subarray({0, 3, 0, 3})
+        .set_layout(TILEDB_ROW_MAJOR)
+        .set_buffer("a", a_r);
+    query.submit();
+    array.close();
+    CHECK(a_r == a_w);
+  };
+
+  tiledb::sm::stats::all_stats.set_enabled(true);
+  tiledb::sm::stats::all_stats.reset();
+  auto& stats = tiledb::sm::stats::all_stats;
+
+  // The first read populates the cache tiers, the second reads from them
+  // without any I/O
+  read();
+  uint64_t bytes_read = stats.counter_reader_num_tile_bytes_read;
+  CHECK(bytes_read > 0);
+  read();
+  CHECK(stats.counter_reader_num_tile_bytes_read == bytes_read);
+  if (decoded_ratio == "0") {
+    CHECK(stats.counter_reader_attr_tile_cache_hits == 0);
+    CHECK(stats.counter_reader_attr_tile_filtered_cache_hits == 4);
+    CHECK(stats.counter_cache_tile_decode_ns_saved == 0);
+  } else {
+    CHECK(stats.counter_reader_attr_tile_cache_hits == 4);
+    CHECK(stats.counter_reader_attr_tile_filtered_cache_hits == 0);
+    CHECK(stats.counter_cache_tile_decode_ns_saved > 0);
+  }
+  tiledb::sm::stats::all_stats.set_enabled(false);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Unordered write streaming many tiles",
+    "[cppapi], [sparse], [unordered-write]") {
+  const std::string array_name = "cpp_unit_array";
+  bool dedup = false;
+  SECTION("- No duplicates") {
+    dedup = false;
+  }
+  SECTION("- Deduplicated coordinates") {
+    dedup = true;
+  }
+  Config config;
+  config["sm.dedup_coords"] = dedup ? "true" : "false";
+  Context ctx(config);
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create, with a small capacity so that the write spans many tiles
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d", {{0, 999}}, 1000));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(7);
+  FilterList filters(ctx);
+  filters.add_filter({ctx, TILEDB_FILTER_ZSTD});
+  schema.add_attribute(
+      Attribute::create<int>(ctx, "a").set_filter_list(filters));
+  schema.add_attribute(Attribute::create<std::string>(ctx, "b"));
+  Array::create(array_name, schema);
+
+  // Write the cells in reverse order, duplicating every fifth cell
+  std::vector<int> coords_w, a_w;
+  std::vector<uint64_t> b_off_w;
+  std::string b_val_w;
+  for (int i = 99; i >= 0; i--) {
+    int copies = (dedup && i % 5 == 0) ? 2 : 1;
+    for (int c = 0; c < copies; c++) {
+      coords_w.push_back(i);
+      a_w.push_back(i);
+      b_off_w.push_back(b_val_w.size());
+      b_val_w += std::string(i % 3 + 1, 'a' + i % 26);
+    }
+  }
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_layout(TILEDB_UNORDERED)
+      .set_coordinates(coords_w)
+      .set_buffer("a", a_w)
+      .set_buffer("b", b_off_w, b_val_w);
+  REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+  array_w.close();
+
+  // Read back in global order
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array);
+  std::vector<int> coords(100), a(100);
+  std::vector<uint64_t> b_off(100);
+  std::string b_val;
+  b_val.resize(b_val_w.size());
+  query.set_subarray({0, 999})
+      .set_layout(TILEDB_GLOBAL_ORDER)
+      .set_coordinates(coords)
+      .set_buffer("a", a)
+      .set_buffer("b", b_off, b_val);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  auto result_elts = query.result_buffer_elements();
+  REQUIRE(result_elts[TILEDB_COORDS].second == 100);
+  REQUIRE(result_elts["b"].first == 100);
+  b_val.resize(result_elts["b"].second);
+  std::string b_val_expected;
+  for (int i = 0; i < 100; i++) {
+    CHECK(coords[i] == i);
+    CHECK(a[i] == i);
+    CHECK(b_off[i] == b_val_expected.size());
+    b_val_expected += std::string(i % 3 + 1, 'a' + i % 26);
+  }
+  CHECK(b_val == b_val_expected);
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
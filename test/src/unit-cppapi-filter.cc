@@ -33,6 +33,8 @@
 #include "catch.hpp"
 #include "tiledb/sm/cpp_api/tiledb"
 
+#include <random>
+
 static void check_filters(
     const tiledb::FilterList& answer, const tiledb::FilterList& check) {
   REQUIRE(check.nfilters() == answer.nfilters());
@@ -160,6 +162,7 @@ TEST_CASE("C++ API: Filter lists on array", "[cppapi], [filter]") {
 
   FilterList offsets_filters(ctx);
   offsets_filters.add_filter({ctx, TILEDB_FILTER_POSITIVE_DELTA})
+      .add_filter({ctx, TILEDB_FILTER_PFOR})
       .add_filter({ctx, TILEDB_FILTER_BYTESHUFFLE})
       .add_filter({ctx, TILEDB_FILTER_LZ4});
   schema.set_coords_filter_list(a1_filters)
@@ -222,3 +225,304 @@ TEST_CASE("C++ API: Filter lists on array", "[cppapi], [filter]") {
   if (vfs.is_dir(array_name))
     vfs.remove_dir(array_name);
 }
+
+TEST_CASE("C++ API: Float plane filter on array", "[cppapi], [filter]") {
+  using namespace tiledb;
+  Context ctx;
+  VFS vfs(ctx);
+  std::string array_name = "cpp_unit_array";
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create schema with a float plane filter on a float attribute
+  Filter f(ctx, TILEDB_FILTER_FLOAT_PLANE);
+  int32_t get_level;
+  f.get_option(TILEDB_COMPRESSION_LEVEL, &get_level);
+  REQUIRE(get_level == 1);
+  f.set_option(TILEDB_COMPRESSION_LEVEL, 3);
+  FilterList a1_filters(ctx);
+  a1_filters.add_filter(f);
+
+  auto a1 = Attribute::create<double>(ctx, "a1");
+  a1.set_filter_list(a1_filters);
+
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d1", {{0, 999}}, 100));
+
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain);
+  schema.add_attribute(a1);
+  Array::create(array_name, schema);
+
+  // Write to array
+  std::vector<double> a1_data(1000);
+  for (size_t i = 0; i < a1_data.size(); i++)
+    a1_data[i] = 10.0 + 0.125 * (i % 50);
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array);
+  query.set_subarray<int>({0, 999})
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer("a1", a1_data);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  array.close();
+
+  // Read back
+  array.open(TILEDB_READ);
+  std::vector<double> a1_read(1000);
+  Query query_r(ctx, array);
+  query_r.set_subarray<int>({0, 999})
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer("a1", a1_read);
+  REQUIRE(query_r.submit() == Query::Status::COMPLETE);
+  REQUIRE(a1_read == a1_data);
+
+  // Check the filter options are persisted
+  auto filter_r = array.schema().attribute("a1").filter_list().filter(0);
+  REQUIRE(filter_r.filter_type() == TILEDB_FILTER_FLOAT_PLANE);
+  filter_r.get_option(TILEDB_COMPRESSION_LEVEL, &get_level);
+  REQUIRE(get_level == 3);
+  array.close();
+
+  // Clean up
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE("C++ API: Dictionary filter on array", "[cppapi], [filter]") {
+  using namespace tiledb;
+  Context ctx;
+  VFS vfs(ctx);
+  std::string array_name = "cpp_unit_array";
+  const std::vector<std::string> labels = {"red", "green", "blue", "yellow"};
+  std::vector<uint64_t> label_off(1000);
+  std::string label_val;
+  for (size_t i = 0; i < label_off.size(); i++) {
+    label_off[i] = label_val.size();
+    label_val += labels[(i / 7) % labels.size()];
+  }
+
+  // Write the same labels with and without the filter
+  uint64_t var_file_size[2] = {0, 0};
+  for (int dictionary = 0; dictionary < 2; dictionary++) {
+    if (vfs.is_dir(array_name))
+      vfs.remove_dir(array_name);
+
+    FilterList a1_filters(ctx);
+    if (dictionary)
+      a1_filters.add_filter({ctx, TILEDB_FILTER_DICTIONARY});
+    auto a1 = Attribute::create<std::string>(ctx, "a1");
+    a1.set_filter_list(a1_filters);
+
+    Domain domain(ctx);
+    domain.add_dimension(Dimension::create<int>(ctx, "d1", {{0, 999}}, 100));
+    ArraySchema schema(ctx, TILEDB_DENSE);
+    schema.set_domain(domain);
+    schema.add_attribute(a1);
+    Array::create(array_name, schema);
+
+    Array array(ctx, array_name, TILEDB_WRITE);
+    Query query(ctx, array);
+    query.set_subarray<int>({0, 999})
+        .set_layout(TILEDB_ROW_MAJOR)
+        .set_buffer("a1", label_off, label_val);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    array.close();
+
+    // Read back a subarray crossing tiles
+    array.open(TILEDB_READ);
+    std::vector<uint64_t> off_read(500);
+    std::string val_read;
+    val_read.resize(label_val.size());
+    Query query_r(ctx, array);
+    query_r.set_subarray<int>({250, 749})
+        .set_layout(TILEDB_ROW_MAJOR)
+        .set_buffer("a1", off_read, val_read);
+    REQUIRE(query_r.submit() == Query::Status::COMPLETE);
+    auto result_elts = query_r.result_buffer_elements();
+    REQUIRE(result_elts["a1"].first == 500);
+    uint64_t begin = label_off[250], end = label_off[750];
+    REQUIRE(result_elts["a1"].second == end - begin);
+    CHECK(
+        val_read.substr(0, end - begin) ==
+        label_val.substr(begin, end - begin));
+    for (size_t i = 0; i < off_read.size(); i++)
+      CHECK(off_read[i] == label_off[250 + i] - begin);
+    array.close();
+
+    // Get the size of the var file of the fragment
+    for (const auto& uri : vfs.ls(array_name)) {
+      if (vfs.is_dir(uri))
+        var_file_size[dictionary] = vfs.file_size(uri + "/a1_var.tdb");
+    }
+  }
+
+  // The codes take a byte per cell, less than the labels
+  REQUIRE(var_file_size[1] > 0);
+  CHECK(var_file_size[1] < var_file_size[0] / 2);
+
+  // Clean up
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE("C++ API: Compression dictionary on array", "[cppapi], [filter]") {
+  using namespace tiledb;
+  Context ctx;
+  VFS vfs(ctx);
+  std::string array_name = "cpp_unit_array";
+
+  // Small tiles of similar records
+  std::vector<uint64_t> rec_off(1000);
+  std::string rec_val;
+  for (size_t i = 0; i < rec_off.size(); i++) {
+    rec_off[i] = rec_val.size();
+    rec_val += "{\"id\":" + std::to_string(i) + ",\"status\":\"" +
+               (i % 3 == 0 ? "active" : "inactive") + "\"}";
+  }
+  std::vector<uint64_t> sample_sizes;
+  for (size_t i = 0; i + 1 < rec_off.size(); i++)
+    sample_sizes.push_back(rec_off[i + 1] - rec_off[i]);
+
+  // Write the same records with and without a dictionary
+  uint64_t var_file_size[2] = {0, 0};
+  for (int dictionary = 0; dictionary < 2; dictionary++) {
+    if (vfs.is_dir(array_name))
+      vfs.remove_dir(array_name);
+
+    Filter zstd(ctx, TILEDB_FILTER_ZSTD);
+    if (dictionary)
+      zstd.train_compression_dictionary(rec_val.data(), sample_sizes, 1024);
+    FilterList a1_filters(ctx);
+    a1_filters.add_filter(zstd);
+    auto a1 = Attribute::create<std::string>(ctx, "a1");
+    a1.set_filter_list(a1_filters);
+
+    Domain domain(ctx);
+    domain.add_dimension(Dimension::create<int>(ctx, "d1", {{0, 999}}, 10));
+    ArraySchema schema(ctx, TILEDB_DENSE);
+    schema.set_domain(domain);
+    schema.add_attribute(a1);
+    Array::create(array_name, schema);
+
+    Array array(ctx, array_name, TILEDB_WRITE);
+    Query query(ctx, array);
+    query.set_subarray<int>({0, 999})
+        .set_layout(TILEDB_ROW_MAJOR)
+        .set_buffer("a1", rec_off, rec_val);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    array.close();
+
+    // The dictionary is stored in the schema
+    array.open(TILEDB_READ);
+    auto loaded = array.schema().attribute("a1").filter_list().filter(0);
+    CHECK(loaded.compression_dictionary() == zstd.compression_dictionary());
+    CHECK(loaded.compression_dictionary().empty() == !dictionary);
+
+    std::vector<uint64_t> off_read(rec_off.size());
+    std::string val_read;
+    val_read.resize(rec_val.size());
+    Query query_r(ctx, array);
+    query_r.set_subarray<int>({0, 999})
+        .set_layout(TILEDB_ROW_MAJOR)
+        .set_buffer("a1", off_read, val_read);
+    REQUIRE(query_r.submit() == Query::Status::COMPLETE);
+    CHECK(off_read == rec_off);
+    CHECK(val_read == rec_val);
+    array.close();
+
+    // Get the size of the var file of the fragment
+    for (const auto& uri : vfs.ls(array_name)) {
+      if (vfs.is_dir(uri))
+        var_file_size[dictionary] = vfs.file_size(uri + "/a1_var.tdb");
+    }
+  }
+
+  REQUIRE(var_file_size[1] > 0);
+  CHECK(var_file_size[1] < var_file_size[0]);
+
+  // Only ZSTD supports dictionaries
+  Filter lz4(ctx, TILEDB_FILTER_LZ4);
+  std::vector<uint8_t> dict(100, 1);
+  CHECK_THROWS(lz4.set_compression_dictionary(dict));
+  CHECK_THROWS(Filter(ctx, TILEDB_FILTER_BITSHUFFLE).compression_dictionary());
+
+  // Clean up
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE("C++ API: Adaptive filter on array", "[cppapi], [filter]") {
+  using namespace tiledb;
+  Context ctx;
+  VFS vfs(ctx);
+  std::string array_name = "cpp_unit_array";
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create schema with an adaptive filter
+  Filter f(ctx, TILEDB_FILTER_ADAPTIVE);
+  uint32_t get_weight;
+  f.get_option(TILEDB_ADAPTIVE_DECODE_WEIGHT, &get_weight);
+  REQUIRE(get_weight == 10);
+  f.set_option(TILEDB_ADAPTIVE_DECODE_WEIGHT, (uint32_t)30);
+  CHECK_THROWS(f.set_option(TILEDB_ADAPTIVE_DECODE_WEIGHT, (uint32_t)101));
+  CHECK_THROWS(f.set_option(TILEDB_ADAPTIVE_DECODE_WEIGHT, 30));
+  FilterList a1_filters(ctx);
+  a1_filters.add_filter(f);
+
+  auto a1 = Attribute::create<int64_t>(ctx, "a1");
+  a1.set_filter_list(a1_filters);
+
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "d1", {{0, 9999}}, 1000));
+
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain);
+  schema.add_attribute(a1);
+  Array::create(array_name, schema);
+
+  // Write tiles of random and of repetitive values
+  std::mt19937_64 gen(7);
+  std::vector<int64_t> a1_data(10000);
+  for (size_t i = 0; i < a1_data.size(); i++)
+    a1_data[i] = (i / 1000) % 2 == 0 ? (int64_t)gen() : (int64_t)(i % 10);
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array);
+  query.set_subarray<int>({0, 9999})
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer("a1", a1_data);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  array.close();
+
+  // Read back
+  array.open(TILEDB_READ);
+  std::vector<int64_t> a1_read(10000);
+  Query query_r(ctx, array);
+  query_r.set_subarray<int>({0, 9999})
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer("a1", a1_read);
+  REQUIRE(query_r.submit() == Query::Status::COMPLETE);
+  REQUIRE(a1_read == a1_data);
+
+  // Check the filter options are persisted
+  auto filter_r = array.schema().attribute("a1").filter_list().filter(0);
+  REQUIRE(filter_r.filter_type() == TILEDB_FILTER_ADAPTIVE);
+  filter_r.get_option(TILEDB_ADAPTIVE_DECODE_WEIGHT, &get_weight);
+  REQUIRE(get_weight == 30);
+  array.close();
+
+  // Only the random tiles are stored raw
+  uint64_t file_size = 0;
+  for (const auto& uri : vfs.ls(array_name)) {
+    if (vfs.is_dir(uri))
+      file_size = vfs.file_size(uri + "/a1.tdb");
+  }
+  CHECK(file_size > 5000 * sizeof(int64_t));
+  CHECK(file_size < 6000 * sizeof(int64_t));
+
+  // Clean up
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
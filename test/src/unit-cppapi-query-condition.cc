@@ -0,0 +1,466 @@
+/**
+ * @file   unit-cppapi-query-condition.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2019 TileDB Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the C++ API for query conditions.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/array/array.h"
+#include "tiledb/sm/c_api/tiledb_struct_def.h"
+#include "tiledb/sm/cpp_api/tiledb"
+#include "tiledb/sm/fragment/fragment_metadata.h"
+#include "tiledb/sm/misc/stats.h"
+
+#include <cmath>
+#include <limits>
+
+using namespace tiledb;
+
+namespace {
+
+/**
+ * Creates a 4x4 sparse array with capacity 2, and writes 8 cells with
+ * `a = i` and `b = 0.5 * i`, so that each data tile holds two cells.
+ */
+void create_query_condition_array(
+    const Context& ctx, const std::string& array_name) {
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "rows", {{0, 3}}, 2))
+      .add_dimension(Dimension::create<int>(ctx, "cols", {{0, 3}}, 2));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain)
+      .set_order({{TILEDB_ROW_MAJOR, TILEDB_ROW_MAJOR}})
+      .set_capacity(2);
+  FilterList filters(ctx);
+  filters.add_filter({ctx, TILEDB_FILTER_GZIP});
+  schema.add_attribute(
+      Attribute::create<int>(ctx, "a").set_filter_list(filters));
+  schema.add_attribute(Attribute::create<float>(ctx, "b"));
+  schema.add_attribute(Attribute::create<std::string>(ctx, "c"));
+  Array::create(array_name, schema);
+
+  std::vector<int> coords = {0, 0, 0, 1, 1, 0, 1, 1, 2, 2, 2, 3, 3, 2, 3, 3};
+  std::vector<int> a = {0, 1, 2, 3, 4, 5, 6, 7};
+  std::vector<float> b = {0, 0.5f, 1, 1.5f, 2, 2.5f, 3, 3.5f};
+  std::vector<uint64_t> c_off = {0, 1, 2, 3, 4, 5, 6, 7};
+  std::string c_val = "abcdefgh";
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array);
+  query.set_coordinates(coords)
+      .set_layout(TILEDB_UNORDERED)
+      .set_buffer("a", a)
+      .set_buffer("b", b)
+      .set_buffer("c", c_off, c_val);
+  query.submit();
+  array.close();
+}
+
+}  // namespace
+
+TEST_CASE(
+    "C++ API: Test query condition",
+    "[cppapi], [sparse], [query-condition]") {
+  const std::string array_name = "cpp_unit_array_query_condition";
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+  create_query_condition_array(ctx, array_name);
+
+  QueryCondition cond(ctx);
+  std::vector<int> expected_a;
+  uint64_t expected_pruned = 0;
+  SECTION("- Single comparison") {
+    cond = QueryCondition::create(ctx, "a", 3, TILEDB_LT);
+    expected_a = {0, 1, 2};
+    expected_pruned = 2;
+  }
+  SECTION("- Conjunction on two attributes") {
+    cond = QueryCondition::create(ctx, "a", 2, TILEDB_GE)
+               .combine(
+                   QueryCondition::create(ctx, "b", 3.0f, TILEDB_LT),
+                   TILEDB_AND);
+    expected_a = {2, 3, 4, 5};
+    expected_pruned = 2;
+  }
+  SECTION("- Disjunction") {
+    cond = QueryCondition::create(ctx, "a", 0, TILEDB_EQ)
+               .combine(
+                   QueryCondition::create(ctx, "a", 7, TILEDB_EQ), TILEDB_OR);
+    expected_a = {0, 7};
+    expected_pruned = 2;
+  }
+  SECTION("- Nested conditions") {
+    auto ne = QueryCondition::create(ctx, "a", 3, TILEDB_NE)
+                  .combine(
+                      QueryCondition::create(ctx, "a", 4, TILEDB_NE),
+                      TILEDB_AND);
+    cond = ne.combine(
+                 QueryCondition::create(ctx, "b", 0.0f, TILEDB_GT), TILEDB_AND)
+               .combine(
+                   QueryCondition::create(ctx, "b", 0.5f, TILEDB_LE),
+                   TILEDB_OR);
+    expected_a = {0, 1, 2, 5, 6, 7};
+    expected_pruned = 0;
+  }
+  SECTION("- No results") {
+    cond = QueryCondition::create(ctx, "a", 100, TILEDB_GT);
+    expected_pruned = 4;
+  }
+
+  for (auto subarray_object : {false, true}) {
+    auto& stats = tiledb::sm::stats::all_stats;
+    stats.set_enabled(true);
+    stats.reset();
+
+    Array array(ctx, array_name, TILEDB_READ);
+    Query query(ctx, array);
+    int range[] = {0, 3};
+    Subarray subarray(ctx, array, TILEDB_UNORDERED);
+    if (subarray_object) {
+      subarray.add_range(0, range);
+      subarray.add_range(1, range);
+      query.set_subarray(subarray);
+    } else {
+      query.set_subarray<int>({0, 3, 0, 3});
+    }
+    std::vector<int> a(8), coords(16);
+    std::vector<float> b(8);
+    std::vector<uint64_t> c_off(8);
+    std::string c_val;
+    c_val.resize(8);
+    query.set_layout(TILEDB_ROW_MAJOR)
+        .set_coordinates(coords)
+        .set_buffer("a", a)
+        .set_buffer("b", b)
+        .set_buffer("c", c_off, c_val)
+        .set_condition(cond);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+
+    // Only the tiles holding results are read for the attributes the
+    // condition does not refer to
+    uint64_t pruned = stats.counter_reader_num_tiles_pruned_by_condition;
+    CHECK(pruned == expected_pruned);
+
+    // Here every tile without results is ruled out by its min/max values
+    // before being read
+    pruned = stats.counter_reader_num_tiles_pruned_by_tile_metadata;
+    CHECK(pruned == expected_pruned);
+    stats.set_enabled(false);
+
+    auto result_elts = query.result_buffer_elements();
+    REQUIRE(result_elts["a"].second == expected_a.size());
+    REQUIRE(result_elts["b"].second == expected_a.size());
+    REQUIRE(result_elts["c"].second == expected_a.size());
+    for (size_t i = 0; i < expected_a.size(); i++) {
+      CHECK(a[i] == expected_a[i]);
+      CHECK(b[i] == 0.5f * expected_a[i]);
+      CHECK(c_val[i] == 'a' + expected_a[i]);
+    }
+    array.close();
+  }
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test query condition errors",
+    "[cppapi], [query-condition]") {
+  const std::string array_name = "cpp_unit_array_query_condition";
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+  create_query_condition_array(ctx, array_name);
+
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array);
+
+  // Unknown attributes, ordered comparisons on var-sized attributes, and
+  // mismatching value types
+  REQUIRE_THROWS(
+      query.set_condition(QueryCondition::create(ctx, "foo", 1, TILEDB_LT)));
+  REQUIRE_THROWS(
+      query.set_condition(QueryCondition::create(ctx, "c", 'a', TILEDB_LT)));
+  REQUIRE_NOTHROW(query.set_condition(
+      QueryCondition::create(ctx, "c", std::string("a"), TILEDB_EQ)));
+  REQUIRE_THROWS(
+      query.set_condition(QueryCondition::create(ctx, "a", 1.0, TILEDB_LT)));
+  REQUIRE_THROWS(query.set_condition(QueryCondition(ctx)));
+  REQUIRE_NOTHROW(
+      query.set_condition(QueryCondition::create(ctx, "a", 1, TILEDB_LT)));
+  array.close();
+
+  // Conditions are not applicable to writes
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  REQUIRE_THROWS(
+      query_w.set_condition(QueryCondition::create(ctx, "a", 1, TILEDB_LT)));
+  array_w.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test query condition on var-sized strings",
+    "[cppapi], [sparse], [query-condition], [dictionary]") {
+  const std::string array_name = "cpp_unit_array_query_condition";
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create a sparse array with a low-cardinality string attribute, encoded
+  // with a dictionary or not
+  const int cell_num = 1000;
+  FilterList filters(ctx);
+  SECTION("- Dictionary-encoded") {
+    filters.add_filter({ctx, TILEDB_FILTER_DICTIONARY});
+  }
+  SECTION("- Not encoded") {
+  }
+  filters.add_filter({ctx, TILEDB_FILTER_ZSTD});
+  Domain domain(ctx);
+  domain.add_dimension(
+      Dimension::create<int>(ctx, "d", {{0, cell_num - 1}}, 100));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(100);
+  schema.add_attribute(Attribute::create<int>(ctx, "a"));
+  schema.add_attribute(
+      Attribute::create<std::string>(ctx, "label").set_filter_list(filters));
+  Array::create(array_name, schema);
+
+  // Write `a = i` and `label = labels[i % 4]`
+  const std::vector<std::string> labels = {"red", "green", "blue", "yellow"};
+  std::vector<int> coords(cell_num), a(cell_num);
+  std::vector<uint64_t> label_off(cell_num);
+  std::string label_val;
+  for (int i = 0; i < cell_num; ++i) {
+    coords[i] = a[i] = i;
+    label_off[i] = label_val.size();
+    label_val += labels[i % 4];
+  }
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_coordinates(coords)
+      .set_layout(TILEDB_UNORDERED)
+      .set_buffer("a", a)
+      .set_buffer("label", label_off, label_val);
+  REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+  array_w.close();
+
+  // Read with conditions on the labels
+  Array array(ctx, array_name, TILEDB_READ);
+  for (int q = 0; q < 2; ++q) {
+    auto cond = QueryCondition::create(
+        ctx, "label", std::string("blue"), q == 0 ? TILEDB_EQ : TILEDB_NE);
+    if (q == 1)
+      cond = cond.combine(
+          QueryCondition::create(ctx, "a", 100, TILEDB_LT), TILEDB_AND);
+    std::vector<int> expected_a;
+    for (int i = 0; i < cell_num; ++i) {
+      if (q == 0 ? i % 4 == 2 : i % 4 != 2 && i < 100)
+        expected_a.push_back(i);
+    }
+
+    std::vector<int> a_r(cell_num);
+    std::vector<uint64_t> label_off_r(cell_num);
+    std::string label_val_r;
+    label_val_r.resize(label_val.size());
+    Query query(ctx, array);
+    query.set_subarray<int>({0, cell_num - 1})
+        .set_layout(TILEDB_GLOBAL_ORDER)
+        .set_buffer("a", a_r)
+        .set_buffer("label", label_off_r, label_val_r)
+        .set_condition(cond);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+
+    auto result_elts = query.result_buffer_elements();
+    REQUIRE(result_elts["a"].second == expected_a.size());
+    REQUIRE(result_elts["label"].first == expected_a.size());
+    uint64_t label_size = result_elts["label"].second;
+    for (size_t i = 0; i < expected_a.size(); ++i) {
+      CHECK(a_r[i] == expected_a[i]);
+      uint64_t end =
+          i + 1 < expected_a.size() ? label_off_r[i + 1] : label_size;
+      CHECK(
+          label_val_r.substr(label_off_r[i], end - label_off_r[i]) ==
+          labels[expected_a[i] % 4]);
+    }
+  }
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test tile metadata", "[cppapi], [sparse], [tile-metadata]") {
+  const std::string array_name = "cpp_unit_array_tile_metadata";
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+  create_query_condition_array(ctx, array_name);
+
+  // Write a second fragment with a NaN value in its last tile
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  std::vector<int> coords = {0, 2, 0, 3, 1, 2};
+  std::vector<int> a = {-1, -2, 10};
+  std::vector<float> b = {1, 2, std::numeric_limits<float>::quiet_NaN()};
+  std::vector<uint64_t> c_off = {0, 1, 2};
+  std::string c_val = "xyz";
+  query_w.set_coordinates(coords)
+      .set_layout(TILEDB_UNORDERED)
+      .set_buffer("a", a)
+      .set_buffer("b", b)
+      .set_buffer("c", c_off, c_val);
+  query_w.submit();
+  array_w.close();
+
+  Array array(ctx, array_name, TILEDB_READ);
+  auto sm_array = array.ptr()->array_;
+  auto fragments = sm_array->fragment_metadata();
+  REQUIRE(fragments.size() == 2);
+  const auto& key = *sm_array->encryption_key();
+
+  // Only the attributes with a single numeric value per cell have tile
+  // metadata
+  auto meta = fragments[0];
+  CHECK(meta->has_tile_metadata("a"));
+  CHECK(meta->has_tile_metadata("b"));
+  CHECK(!meta->has_tile_metadata("c"));
+  CHECK(!meta->has_tile_metadata(tiledb::sm::constants::coords));
+  const void *min, *max, *sum;
+  CHECK(!meta->tile_metadata(key, "c", 0, &min, &max, &sum).ok());
+  CHECK(!meta->tile_metadata(key, "a", 4, &min, &max, &sum).ok());
+
+  // Each tile of the first fragment holds `a = {2t, 2t + 1}`
+  for (uint64_t t = 0; t < 4; ++t) {
+    REQUIRE(meta->tile_metadata(key, "a", t, &min, &max, &sum).ok());
+    CHECK(*(const int*)min == (int)(2 * t));
+    CHECK(*(const int*)max == (int)(2 * t + 1));
+    CHECK(*(const int64_t*)sum == (int64_t)(4 * t + 1));
+    REQUIRE(meta->tile_metadata(key, "b", t, &min, &max, &sum).ok());
+    CHECK(*(const float*)min == t);
+    CHECK(*(const float*)max == t + 0.5f);
+    CHECK(*(const double*)sum == 2 * t + 0.5);
+  }
+
+  // The second fragment holds `a = {-1, -2}` and `a = {10}`
+  meta = fragments[1];
+  REQUIRE(meta->tile_metadata(key, "a", 0, &min, &max, &sum).ok());
+  CHECK(*(const int*)min == -2);
+  CHECK(*(const int*)max == -1);
+  CHECK(*(const int64_t*)sum == -3);
+  REQUIRE(meta->tile_metadata(key, "a", 1, &min, &max, &sum).ok());
+  CHECK(*(const int*)min == 10);
+  CHECK(*(const int*)max == 10);
+  CHECK(*(const int64_t*)sum == 10);
+  REQUIRE(meta->tile_metadata(key, "b", 0, &min, &max, &sum).ok());
+  CHECK(*(const float*)min == 1);
+  CHECK(*(const float*)max == 2);
+  REQUIRE(meta->tile_metadata(key, "b", 1, &min, &max, &sum).ok());
+  CHECK(std::isnan(*(const float*)min));
+  CHECK(std::isnan(*(const float*)max));
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test tile metadata pruning with overwritten cells",
+    "[cppapi], [sparse], [tile-metadata]") {
+  const std::string array_name = "cpp_unit_array_tile_metadata";
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+  create_query_condition_array(ctx, array_name);
+
+  // Overwrite cell (0, 0) (`a = 0`) and add cell (3, 0)
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  std::vector<int> coords = {0, 0, 3, 0};
+  std::vector<int> a = {100, 200};
+  std::vector<float> b = {50, 100};
+  std::vector<uint64_t> c_off = {0, 1};
+  std::string c_val = "yz";
+  query_w.set_coordinates(coords)
+      .set_layout(TILEDB_UNORDERED)
+      .set_buffer("a", a)
+      .set_buffer("b", b)
+      .set_buffer("c", c_off, c_val);
+  query_w.submit();
+  array_w.close();
+
+  for (auto subarray_object : {false, true}) {
+    auto& stats = tiledb::sm::stats::all_stats;
+    stats.set_enabled(true);
+    stats.reset();
+
+    Array array(ctx, array_name, TILEDB_READ);
+    Query query(ctx, array);
+    int range[] = {0, 3};
+    Subarray subarray(ctx, array, TILEDB_UNORDERED);
+    if (subarray_object) {
+      subarray.add_range(0, range);
+      subarray.add_range(1, range);
+      query.set_subarray(subarray);
+    } else {
+      query.set_subarray<int>({0, 3, 0, 3});
+    }
+
+    // The tile of the second fragment cannot be skipped, as it overwrites
+    // a cell satisfying the condition. The last three tiles of the first
+    // fragment are skipped.
+    std::vector<int> a_r(10);
+    std::vector<int> coords_r(20);
+    query.set_layout(TILEDB_ROW_MAJOR)
+        .set_coordinates(coords_r)
+        .set_buffer("a", a_r)
+        .set_condition(QueryCondition::create(ctx, "a", 2, TILEDB_LT));
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    uint64_t pruned = stats.counter_reader_num_tiles_pruned_by_tile_metadata;
+    CHECK(pruned == 3);
+    stats.set_enabled(false);
+
+    auto result_elts = query.result_buffer_elements();
+    REQUIRE(result_elts["a"].second == 1);
+    CHECK(a_r[0] == 1);
+    array.close();
+  }
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
@@ -32,6 +32,7 @@
 
 #include "catch.hpp"
 #include "tiledb/sm/cpp_api/tiledb"
+#include "tiledb/sm/misc/stats.h"
 #include "tiledb/sm/misc/utils.h"
 
 using namespace tiledb;
@@ -375,3 +376,115 @@ TEST_CASE(
   if (vfs.is_dir(array_name))
     vfs.remove_dir(array_name);
 }
+
+TEST_CASE(
+    "C++ API: Test subarray (pipelined attribute reads)",
+    "[cppapi], [sparse], [cppapi-subarray], [pipelined-reads]") {
+  const std::string array_name = "cpp_unit_array";
+  std::string memory_budget;
+  uint64_t expected_prefetches = 0;
+  SECTION("- All attributes prefetched") {
+    memory_budget = "5368709120";
+    expected_prefetches = 3;
+  }
+  SECTION("- Prefetching limited by the memory budget") {
+    // The coordinate tiles take 64 bytes, the tiles of "a" and "b" 32 bytes
+    // each and the offset tiles of "c" 64 bytes, so only "b" can be read
+    // along with "a"
+    memory_budget = "80";
+    expected_prefetches = 1;
+  }
+  Config config;
+  config["sm.memory_budget"] = memory_budget;
+  Context ctx(config);
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int>(ctx, "rows", {{0, 3}}, 2))
+      .add_dimension(Dimension::create<int>(ctx, "cols", {{0, 3}}, 2));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain)
+      .set_order({{TILEDB_ROW_MAJOR, TILEDB_ROW_MAJOR}})
+      .set_capacity(2);
+  FilterList filters(ctx);
+  filters.add_filter({ctx, TILEDB_FILTER_GZIP});
+  schema.add_attribute(
+      Attribute::create<int>(ctx, "a").set_filter_list(filters));
+  schema.add_attribute(Attribute::create<int>(ctx, "b"));
+  schema.add_attribute(
+      Attribute::create<std::string>(ctx, "c").set_filter_list(filters));
+  Array::create(array_name, schema);
+
+  // Write two fragments
+  std::vector<int> coords_w = {
+      0, 0, 0, 1, 1, 0, 1, 1, 2, 2, 2, 3, 3, 2, 3, 3};
+  std::vector<std::string> c_w = {
+      "a", "bb", "ccc", "dddd", "e", "ff", "ggg", "hhhh"};
+  for (int f = 0; f < 2; f++) {
+    std::vector<int> coords(
+        coords_w.begin() + 8 * f, coords_w.begin() + 8 * (f + 1));
+    std::vector<int> a, b;
+    std::vector<uint64_t> c_off;
+    std::string c_val;
+    for (int i = 4 * f; i < 4 * (f + 1); i++) {
+      a.push_back(i);
+      b.push_back(10 * i);
+      c_off.push_back(c_val.size());
+      c_val += c_w[i];
+    }
+    Array array_w(ctx, array_name, TILEDB_WRITE);
+    Query query_w(ctx, array_w);
+    query_w.set_coordinates(coords)
+        .set_layout(TILEDB_UNORDERED)
+        .set_buffer("a", a)
+        .set_buffer("b", b)
+        .set_buffer("c", c_off, c_val);
+    query_w.submit();
+    query_w.finalize();
+    array_w.close();
+  }
+
+  tiledb::sm::stats::all_stats.set_enabled(true);
+  tiledb::sm::stats::all_stats.reset();
+
+  // Read all attributes
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array);
+  int range[] = {0, 3};
+  Subarray subarray(ctx, array, TILEDB_UNORDERED);
+  subarray.add_range(0, range);
+  subarray.add_range(1, range);
+  std::vector<int> a(8), b(8), coords(16);
+  std::vector<uint64_t> c_off(8);
+  std::string c_val;
+  c_val.resize(20);
+  query.set_subarray(subarray)
+      .set_layout(TILEDB_ROW_MAJOR)
+      .set_coordinates(coords)
+      .set_buffer("a", a)
+      .set_buffer("b", b)
+      .set_buffer("c", c_off, c_val);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  CHECK(
+      tiledb::sm::stats::all_stats.counter_reader_num_attr_prefetches ==
+      expected_prefetches);
+  tiledb::sm::stats::all_stats.set_enabled(false);
+
+  auto result_elts = query.result_buffer_elements();
+  REQUIRE(result_elts["a"].second == 8);
+  REQUIRE(result_elts["c"].second == 20);
+  CHECK(coords == coords_w);
+  for (int i = 0; i < 8; i++) {
+    CHECK(a[i] == i);
+    CHECK(b[i] == 10 * i);
+  }
+  CHECK(c_val == "abbcccddddeffggghhhh");
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
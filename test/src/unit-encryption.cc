@@ -33,6 +33,7 @@
 
 #include "tiledb/sm/buffer/preallocated_buffer.h"
 #include "tiledb/sm/encryption/encryption.h"
+#include "tiledb/sm/misc/stats.h"
 
 #include <catch.hpp>
 #include <iostream>
@@ -499,3 +500,68 @@ TEST_CASE("Encryption: Test AES-256-GCM", "[encryption], [aes]") {
     }
   }
 }
+
+TEST_CASE(
+    "Encryption: Test AES-256-GCM context reuse", "[encryption], [aes]") {
+  unsigned nelts = 1000;
+  Buffer input;
+  REQUIRE(input.realloc(nelts * sizeof(unsigned)).ok());
+  for (unsigned i = 0; i < nelts; i++)
+    REQUIRE(input.write(&i, sizeof(unsigned)).ok());
+  ConstBuffer input_cb(&input);
+
+  char key_bytes1[] = "0123456789abcdeF0123456789abcdeF";
+  char key_bytes2[] = "fEdcba9876543210fEdcba9876543210";
+  ConstBuffer key1(key_bytes1, sizeof(key_bytes1) - 1);
+  ConstBuffer key2(key_bytes2, sizeof(key_bytes2) - 1);
+
+  stats::all_stats.set_enabled(true);
+  stats::all_stats.reset();
+
+  // Alternate between repeated and changing keys. The contexts of this
+  // thread are reused throughout, whatever key they were last used with.
+  const unsigned num_rounds = 8;
+  ConstBuffer* keys[num_rounds] = {
+      &key1, &key1, &key2, &key2, &key1, &key2, &key1, &key1};
+  for (unsigned r = 0; r < num_rounds; r++) {
+    Buffer encrypted;
+    char tag_array[16], iv_array[12];
+    PreallocatedBuffer output_iv(&iv_array[0], sizeof(iv_array));
+    PreallocatedBuffer output_tag(&tag_array[0], sizeof(tag_array));
+    REQUIRE(
+        Encryption::encrypt_aes256gcm(
+            keys[r], nullptr, &input_cb, &encrypted, &output_iv, &output_tag)
+            .ok());
+
+    // Decrypting with the other key fails, and does not affect the next
+    // decryption.
+    Buffer decrypted;
+    ConstBuffer iv(output_iv.data(), output_iv.size());
+    ConstBuffer tag(output_tag.data(), output_tag.size());
+    ConstBuffer encrypted_cb(&encrypted);
+    ConstBuffer* other_key = keys[r] == &key1 ? &key2 : &key1;
+    CHECK(!Encryption::decrypt_aes256gcm(
+               other_key, &iv, &tag, &encrypted_cb, &decrypted)
+               .ok());
+    decrypted.reset_offset();
+    decrypted.reset_size();
+    REQUIRE(Encryption::decrypt_aes256gcm(
+                keys[r], &iv, &tag, &encrypted_cb, &decrypted)
+                .ok());
+    REQUIRE(decrypted.size() == input.size());
+    for (unsigned i = 0; i < nelts; i++)
+      REQUIRE(decrypted.value<unsigned>(i * sizeof(unsigned)) == i);
+  }
+
+  // At most one encryption and one decryption context were created.
+  CHECK(stats::all_stats.counter_encryption_num_contexts_created <= 2);
+  CHECK(
+      stats::all_stats.counter_encryption_num_bytes_encrypted ==
+      num_rounds * input.size());
+  CHECK(
+      stats::all_stats.counter_encryption_num_bytes_decrypted ==
+      2 * num_rounds * input.size());
+
+  stats::all_stats.reset();
+  stats::all_stats.set_enabled(false);
+}
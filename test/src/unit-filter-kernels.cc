@@ -0,0 +1,167 @@
+/**
+ * @file unit-filter-kernels.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2019 TileDB, Inc.
+ * @copyright Copyright (c) 2016 MIT and Intel Corporation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the kernels of the bit width reduction and positive delta filters.
+ */
+
+#include "tiledb/sm/filter/filter_kernels.h"
+
+#include <catch.hpp>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace tiledb::sm;
+using namespace tiledb::sm::filter_kernels;
+
+/** The instruction sets supported by the machine running the tests. */
+static std::vector<KernelIsa> supported_isas() {
+  std::vector<KernelIsa> isas;
+  for (auto isa : {KernelIsa::SCALAR, KernelIsa::SSE4_1, KernelIsa::AVX2}) {
+    if (isa_supported(isa))
+      isas.push_back(isa);
+  }
+  return isas;
+}
+
+/** Returns `num` random values within `[lo, hi]`. */
+template <typename T>
+static std::vector<T> random_values(uint64_t num, T lo, T hi) {
+  typedef typename std::
+      conditional<std::is_signed<T>::value, int64_t, uint64_t>::type Wide;
+  std::mt19937_64 gen(num);
+  std::uniform_int_distribution<Wide> dist(lo, hi);
+  std::vector<T> values(num);
+  for (auto& v : values)
+    v = static_cast<T>(dist(gen));
+  return values;
+}
+
+template <typename T>
+static void check_min_max() {
+  for (uint64_t num : {1, 7, 16, 33, 257, 1000}) {
+    auto values = random_values<T>(
+        num, std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max());
+    T expected_min = values[0], expected_max = values[0];
+    for (auto v : values) {
+      expected_min = std::min(expected_min, v);
+      expected_max = std::max(expected_max, v);
+    }
+    for (auto isa : supported_isas()) {
+      T min, max;
+      min_max(values.data(), num, &min, &max, isa);
+      CHECK(min == expected_min);
+      CHECK(max == expected_max);
+    }
+  }
+}
+
+template <typename T, typename U>
+static void check_narrow_widen() {
+  for (uint64_t num : {1, 7, 16, 33, 257, 1000}) {
+    T offset = std::numeric_limits<U>::lowest() / 2;
+    auto values = random_values<T>(
+        num, offset, offset + std::numeric_limits<U>::max());
+    for (auto isa : supported_isas()) {
+      std::vector<U> narrowed(num);
+      std::vector<T> widened(num);
+      narrow(values.data(), num, offset, narrowed.data(), isa);
+      for (uint64_t i = 0; i < num; i++)
+        CHECK(narrowed[i] == static_cast<U>(values[i] - offset));
+      widen(narrowed.data(), num, offset, widened.data(), isa);
+      CHECK(widened == values);
+    }
+  }
+}
+
+template <typename T>
+static void check_delta() {
+  for (uint64_t num : {1, 7, 16, 33, 257, 1000}) {
+    // Wrapping deltas are decoded back to the original values.
+    auto values = random_values<T>(
+        num, std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max());
+    std::vector<T> sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+    for (auto isa : supported_isas()) {
+      std::vector<T> deltas(num), decoded(num);
+      CHECK(delta_encode(sorted.data(), num, sorted[0], deltas.data(), isa));
+      CHECK(deltas[0] == 0);
+      delta_decode(deltas.data(), num, sorted[0], decoded.data(), isa);
+      CHECK(decoded == sorted);
+
+      CHECK(
+          delta_encode(values.data(), num, values[0], deltas.data(), isa) ==
+          std::is_sorted(values.begin(), values.end()));
+      delta_decode(deltas.data(), num, values[0], decoded.data(), isa);
+      CHECK(decoded == values);
+    }
+  }
+}
+
+TEST_CASE("Filter kernels: Test min/max", "[filter], [filter-kernels]") {
+  check_min_max<int8_t>();
+  check_min_max<uint8_t>();
+  check_min_max<int16_t>();
+  check_min_max<uint16_t>();
+  check_min_max<int32_t>();
+  check_min_max<uint32_t>();
+  check_min_max<int64_t>();
+  check_min_max<uint64_t>();
+}
+
+TEST_CASE(
+    "Filter kernels: Test narrow and widen", "[filter], [filter-kernels]") {
+  check_narrow_widen<int16_t, int8_t>();
+  check_narrow_widen<int32_t, int8_t>();
+  check_narrow_widen<int32_t, int16_t>();
+  check_narrow_widen<int64_t, int8_t>();
+  check_narrow_widen<int64_t, int16_t>();
+  check_narrow_widen<int64_t, int32_t>();
+  check_narrow_widen<uint16_t, uint8_t>();
+  check_narrow_widen<uint32_t, uint8_t>();
+  check_narrow_widen<uint32_t, uint16_t>();
+  check_narrow_widen<uint64_t, uint8_t>();
+  check_narrow_widen<uint64_t, uint16_t>();
+  check_narrow_widen<uint64_t, uint32_t>();
+}
+
+TEST_CASE(
+    "Filter kernels: Test delta encoding and decoding",
+    "[filter], [filter-kernels]") {
+  check_delta<int8_t>();
+  check_delta<uint8_t>();
+  check_delta<int16_t>();
+  check_delta<uint16_t>();
+  check_delta<int32_t>();
+  check_delta<uint32_t>();
+  check_delta<int64_t>();
+  check_delta<uint64_t>();
+}
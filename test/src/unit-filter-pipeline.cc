@@ -33,19 +33,28 @@
 
 #include "tiledb/sm/array_schema/array_schema.h"
 #include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/filter/adaptive_filter.h"
 #include "tiledb/sm/filter/bit_width_reduction_filter.h"
 #include "tiledb/sm/filter/bitshuffle_filter.h"
 #include "tiledb/sm/filter/byteshuffle_filter.h"
 #include "tiledb/sm/filter/compression_filter.h"
+#include "tiledb/sm/filter/dictionary_filter.h"
 #include "tiledb/sm/filter/encryption_aes256gcm_filter.h"
 #include "tiledb/sm/filter/filter_pipeline.h"
+#include "tiledb/sm/filter/float_plane_filter.h"
+#include "tiledb/sm/filter/pfor_filter.h"
 #include "tiledb/sm/filter/positive_delta_filter.h"
+#include "tiledb/sm/misc/stats.h"
 #include "tiledb/sm/tile/tile.h"
 
 #include <catch.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <functional>
 #include <iostream>
 #include <random>
+#include <string>
 
 using namespace tiledb::sm;
 
@@ -825,6 +834,90 @@ TEST_CASE("Filter: Test compression", "[filter], [compression]") {
   }
 }
 
+TEST_CASE(
+    "Filter: Test compression dictionary", "[filter], [compression]") {
+  // Small chunks of similar records, which compress poorly on their own
+  const uint64_t nrecords = 2000;
+  std::string records;
+  for (uint64_t i = 0; i < nrecords; i++)
+    records += "{\"id\":" + std::to_string(i) + ",\"status\":\"" +
+               (i % 3 == 0 ? "active" : "inactive") + "\",\"region\":\"" +
+               (i % 2 == 0 ? "eu-west" : "us-east") + "\"}";
+  const uint64_t chunk_size = 512;
+
+  // Train a dictionary on chunk-sized samples of the data
+  std::vector<uint64_t> sample_sizes(records.size() / chunk_size, chunk_size);
+  CompressionFilter trained(Compressor::ZSTD, -1);
+  REQUIRE(trained.train_dictionary(records.data(), sample_sizes, 4096).ok());
+  REQUIRE(trained.dictionary() != nullptr);
+  CHECK(trained.dictionary()->data().size() <= 4096);
+
+  auto compressed_size = [&](const CompressionFilter& filter) {
+    Buffer buff;
+    CHECK(buff.write(records.data(), records.size()).ok());
+    Tile tile(Datatype::STRING_ASCII, sizeof(char), 0, &buff, false);
+    FilterPipeline pipeline;
+    pipeline.set_max_chunk_size(chunk_size);
+    CHECK(pipeline.add_filter(filter).ok());
+    CHECK(pipeline.run_forward(&tile).ok());
+    uint64_t size = tile.buffer()->size();
+    CHECK(pipeline.run_reverse(&tile).ok());
+    REQUIRE(tile.buffer()->size() == records.size());
+    CHECK(std::memcmp(buff.data(), records.data(), records.size()) == 0);
+    return size;
+  };
+
+  SECTION("- Round trip") {
+    CompressionFilter plain(Compressor::ZSTD, -1);
+    CHECK(compressed_size(trained) < compressed_size(plain) * 2 / 3);
+  }
+
+  SECTION("- Serialization") {
+    Buffer buff;
+    REQUIRE(trained.serialize(&buff).ok());
+    ConstBuffer cbuff(&buff);
+    Filter* filter = nullptr;
+    REQUIRE(Filter::deserialize(&cbuff, &filter).ok());
+    CHECK(cbuff.end());
+    auto deserialized = dynamic_cast<CompressionFilter*>(filter);
+    REQUIRE(deserialized != nullptr);
+    REQUIRE(deserialized->dictionary() != nullptr);
+    CHECK(
+        deserialized->dictionary()->data() == trained.dictionary()->data());
+    CHECK(compressed_size(*deserialized) == compressed_size(trained));
+    delete filter;
+
+    // Filters without a dictionary keep the original metadata
+    CHECK(trained.set_dictionary(nullptr, 0).ok());
+    CHECK(trained.dictionary() == nullptr);
+    Buffer plain_buff;
+    REQUIRE(trained.serialize(&plain_buff).ok());
+    CHECK(
+        plain_buff.size() ==
+        sizeof(uint8_t) + sizeof(uint32_t) + sizeof(uint8_t) +
+            sizeof(int32_t));
+  }
+
+  SECTION("- Unsupported compressor") {
+    CompressionFilter lz4(Compressor::LZ4, -1);
+    CHECK(!lz4.train_dictionary(records.data(), sample_sizes, 4096).ok());
+    CHECK(!lz4.set_dictionary(records.data(), 100).ok());
+  }
+
+  SECTION("- Context reuse") {
+    // The contexts are created once per thread, not once per chunk
+    auto& stats = tiledb::sm::stats::all_stats;
+    stats.set_enabled(true);
+    compressed_size(trained);
+    stats.reset();
+    compressed_size(trained);
+    CHECK(
+        stats.counter_compressor_num_contexts_created <
+        records.size() / chunk_size);
+    stats.set_enabled(false);
+  }
+}
+
 TEST_CASE("Filter: Test pseudo-checksum", "[filter]") {
   // Set up test data
   const uint64_t nelts = 100;
@@ -1077,10 +1170,14 @@ TEST_CASE("Filter: Test random pipeline", "[filter]") {
       []() { return new Add1InPlace(); },
       []() { return new Add1OutOfPlace(); },
       []() { return new Add1IncludingMetadataFilter(); },
+      []() { return new AdaptiveFilter(); },
       []() { return new BitWidthReductionFilter(); },
       []() { return new BitshuffleFilter(); },
       []() { return new ByteshuffleFilter(); },
       []() { return new CompressionFilter(Compressor::BZIP2, -1); },
+      []() { return new DictionaryFilter(); },
+      []() { return new FloatPlaneFilter(); },
+      []() { return new PFORFilter(); },
       []() { return new PseudoChecksumFilter(); },
       [&encryption_key]() {
         return new EncryptionAES256GCMFilter(encryption_key);
@@ -1335,6 +1432,367 @@ TEST_CASE("Filter: Test positive-delta encoding", "[filter]") {
   }
 }
 
+/**
+ * Runs the input values through a pipeline with the input filter and back,
+ * checking that their bits are restored. Returns the size of the filtered
+ * tile.
+ */
+template <typename T>
+static uint64_t check_round_trip(
+    const Filter& filter, Datatype type, const std::vector<T>& values) {
+  Buffer buff;
+  CHECK(buff.write(values.data(), values.size() * sizeof(T)).ok());
+  Tile tile(type, sizeof(T), 0, &buff, false);
+
+  FilterPipeline pipeline;
+  CHECK(pipeline.add_filter(filter).ok());
+  CHECK(pipeline.run_forward(&tile).ok());
+  uint64_t filtered_size = buff.size();
+
+  CHECK(pipeline.run_reverse(&tile).ok());
+  REQUIRE(tile.buffer()->size() == values.size() * sizeof(T));
+  CHECK(
+      std::memcmp(
+          tile.buffer()->data(), values.data(), values.size() * sizeof(T)) ==
+      0);
+
+  return filtered_size;
+}
+
+TEST_CASE("Filter: Test PFOR", "[filter], [pfor]") {
+  const uint64_t nelts = 1000;
+  std::random_device rd;
+  auto seed = rd();
+  std::mt19937_64 gen(seed);
+  INFO("Random element seed: " << seed);
+
+  SECTION("- Sequential values") {
+    // Each block of 128 values is packed with 7 bits per value.
+    std::vector<uint64_t> values(nelts);
+    for (uint64_t i = 0; i < nelts; i++)
+      values[i] = 1000000 + i;
+    auto filtered_size =
+        check_round_trip(PFORFilter(), Datatype::UINT64, values);
+    CHECK(filtered_size < nelts * sizeof(uint64_t) / 7);
+  }
+
+  SECTION("- Constant values") {
+    std::vector<int32_t> values(nelts, -7);
+    auto filtered_size =
+        check_round_trip(PFORFilter(), Datatype::INT32, values);
+    CHECK(filtered_size < nelts);
+  }
+
+  SECTION("- Exceptions") {
+    // Small values with a few outliers, which are patched in as exceptions
+    // instead of widening their blocks.
+    std::uniform_int_distribution<int32_t> rng(0, 15);
+    std::vector<int32_t> values(nelts);
+    for (uint64_t i = 0; i < nelts; i++)
+      values[i] = (i % 100 == 3) ? std::numeric_limits<int32_t>::max() - 1 :
+                                   rng(gen);
+    auto filtered_size =
+        check_round_trip(PFORFilter(), Datatype::INT32, values);
+    CHECK(filtered_size < nelts * sizeof(int32_t) / 4);
+  }
+
+  SECTION("- Random values of all types") {
+    std::uniform_int_distribution<int64_t> rng(
+        std::numeric_limits<int64_t>::lowest(),
+        std::numeric_limits<int64_t>::max());
+    std::vector<int8_t> int8_values;
+    std::vector<uint8_t> uint8_values;
+    std::vector<int16_t> int16_values;
+    std::vector<uint16_t> uint16_values;
+    std::vector<int32_t> int32_values;
+    std::vector<uint32_t> uint32_values;
+    std::vector<int64_t> int64_values;
+    std::vector<uint64_t> uint64_values;
+    for (uint64_t i = 0; i < nelts + 1; i++) {
+      auto value = rng(gen);
+      int8_values.push_back((int8_t)value);
+      uint8_values.push_back((uint8_t)value);
+      int16_values.push_back((int16_t)value);
+      uint16_values.push_back((uint16_t)value);
+      int32_values.push_back((int32_t)value);
+      uint32_values.push_back((uint32_t)value);
+      int64_values.push_back(value);
+      uint64_values.push_back((uint64_t)value);
+    }
+    check_round_trip(PFORFilter(), Datatype::INT8, int8_values);
+    check_round_trip(PFORFilter(), Datatype::UINT8, uint8_values);
+    check_round_trip(PFORFilter(), Datatype::INT16, int16_values);
+    check_round_trip(PFORFilter(), Datatype::UINT16, uint16_values);
+    check_round_trip(PFORFilter(), Datatype::INT32, int32_values);
+    check_round_trip(PFORFilter(), Datatype::UINT32, uint32_values);
+    check_round_trip(PFORFilter(), Datatype::INT64, int64_values);
+    check_round_trip(PFORFilter(), Datatype::UINT64, uint64_values);
+  }
+
+  SECTION("- Non-integer values are not encoded") {
+    std::vector<double> values(nelts);
+    for (uint64_t i = 0; i < nelts; i++)
+      values[i] = 0.5 * i;
+    check_round_trip(PFORFilter(), Datatype::FLOAT64, values);
+  }
+}
+
+TEST_CASE("Filter: Test float plane", "[filter], [float-plane]") {
+  const uint64_t nelts = 1000;
+  std::random_device rd;
+  auto seed = rd();
+  std::mt19937_64 gen(seed);
+  INFO("Random element seed: " << seed);
+
+  SECTION("- Slowly varying values") {
+    // A sensor signal with a resolution of 1/64: neighboring values differ
+    // in a few bits of the mantissa.
+    std::vector<double> values(nelts);
+    for (uint64_t i = 0; i < nelts; i++)
+      values[i] = 20.0 + std::round(64 * std::sin(i / 100.0)) / 64;
+    auto filtered_size =
+        check_round_trip(FloatPlaneFilter(), Datatype::FLOAT64, values);
+    CHECK(filtered_size < nelts * sizeof(double) / 6);
+  }
+
+  SECTION("- Constant values") {
+    std::vector<float> values(nelts, -2.5f);
+    auto filtered_size =
+        check_round_trip(FloatPlaneFilter(), Datatype::FLOAT32, values);
+    CHECK(filtered_size < 64);
+  }
+
+  SECTION("- Noisy values") {
+    // The low mantissa bytes are random and stored raw, but the sign and
+    // exponent bytes are still compressed.
+    std::normal_distribution<float> rng(100.0f, 1.0f);
+    std::vector<float> values(nelts);
+    for (uint64_t i = 0; i < nelts; i++)
+      values[i] = rng(gen);
+    auto filtered_size =
+        check_round_trip(FloatPlaneFilter(), Datatype::FLOAT32, values);
+    CHECK(filtered_size < nelts * sizeof(float));
+  }
+
+  SECTION("- Random bits") {
+    // Includes NaNs, infinities and denormals, which must round-trip
+    // bit-exactly.
+    std::uniform_int_distribution<uint64_t> rng;
+    std::vector<float> float_values(nelts + 1);
+    std::vector<double> double_values(nelts + 1);
+    for (uint64_t i = 0; i < nelts + 1; i++) {
+      uint64_t bits = rng(gen);
+      auto low_bits = static_cast<uint32_t>(bits);
+      std::memcpy(&float_values[i], &low_bits, sizeof(float));
+      std::memcpy(&double_values[i], &bits, sizeof(double));
+    }
+    check_round_trip(FloatPlaneFilter(), Datatype::FLOAT32, float_values);
+    check_round_trip(FloatPlaneFilter(), Datatype::FLOAT64, double_values);
+  }
+
+  SECTION("- Non-float values are not encoded") {
+    std::vector<uint64_t> values(nelts);
+    for (uint64_t i = 0; i < nelts; i++)
+      values[i] = i;
+    check_round_trip(FloatPlaneFilter(), Datatype::UINT64, values);
+  }
+
+  SECTION("- Multiple chunks") {
+    // Each chunk is encoded separately.
+    std::vector<double> values(nelts);
+    for (uint64_t i = 0; i < nelts; i++)
+      values[i] = 0.25 * (i % 37);
+    Buffer buff;
+    CHECK(buff.write(values.data(), nelts * sizeof(double)).ok());
+    Tile tile(Datatype::FLOAT64, sizeof(double), 0, &buff, false);
+
+    FilterPipeline pipeline;
+    pipeline.set_max_chunk_size(1000);
+    CHECK(pipeline.add_filter(FloatPlaneFilter(5)).ok());
+    CHECK(pipeline.run_forward(&tile).ok());
+    CHECK(buff.size() < nelts * sizeof(double));
+    CHECK(pipeline.run_reverse(&tile).ok());
+    REQUIRE(tile.buffer()->size() == nelts * sizeof(double));
+    CHECK(
+        std::memcmp(
+            tile.buffer()->data(), values.data(), nelts * sizeof(double)) ==
+        0);
+  }
+}
+
+/**
+ * Runs the var tile of the input strings through a pipeline with a dictionary
+ * filter and back, checks the cells read through a `VarTileView`, and
+ * returns the number of dictionary values (0 if the tile is stored raw).
+ */
+static uint64_t check_dictionary_round_trip(
+    const std::vector<std::string>& values, uint64_t* unfiltered_size) {
+  Buffer offsets_buff, var_buff;
+  for (const auto& value : values) {
+    uint64_t offset = var_buff.size();
+    CHECK(offsets_buff.write(&offset, sizeof(uint64_t)).ok());
+    CHECK(var_buff.write(value.data(), value.size()).ok());
+  }
+  Tile offsets_tile(
+      Datatype::UINT64, sizeof(uint64_t), 0, &offsets_buff, false);
+  Tile var_tile(Datatype::STRING_ASCII, sizeof(char), 0, &var_buff, false);
+
+  FilterPipeline pipeline;
+  CHECK(pipeline.add_filter(DictionaryFilter()).ok());
+  CHECK(pipeline.add_filter(CompressionFilter(Compressor::ZSTD, -1)).ok());
+  CHECK(pipeline.run_forward(&var_tile, &offsets_tile).ok());
+  CHECK(pipeline.run_reverse(&var_tile).ok());
+  *unfiltered_size = var_tile.size();
+
+  DictionaryFilter::VarTileView cells;
+  REQUIRE(cells.init(&offsets_tile, &var_tile, true).ok());
+  REQUIRE(cells.cell_num() == values.size());
+  for (uint64_t i = 0; i < values.size(); i++) {
+    uint64_t size;
+    auto data = cells.cell(i, &size);
+    REQUIRE(std::string((const char*)data, size) == values[i]);
+  }
+
+  return cells.dictionary() ? cells.entry_num() : 0;
+}
+
+TEST_CASE("Filter: Test dictionary", "[filter], [dictionary]") {
+  const uint64_t nelts = 1000;
+  const std::vector<std::string> labels = {"red", "green", "", "blue"};
+  std::vector<std::string> values(nelts);
+  uint64_t raw_size = 0, unfiltered_size;
+
+  SECTION("- Low cardinality") {
+    for (uint64_t i = 0; i < nelts; i++) {
+      values[i] = labels[i % labels.size()];
+      raw_size += values[i].size();
+    }
+    auto entry_num = check_dictionary_round_trip(values, &unfiltered_size);
+    CHECK(entry_num == labels.size());
+    CHECK(unfiltered_size < raw_size / 2);
+  }
+
+  SECTION("- Two-byte codes") {
+    values.clear();
+    for (uint64_t i = 0; i < 100 * nelts; i++) {
+      values.push_back("label_" + std::to_string(i % 300));
+      raw_size += values.back().size();
+    }
+    auto entry_num = check_dictionary_round_trip(values, &unfiltered_size);
+    CHECK(entry_num == 300);
+    CHECK(unfiltered_size < raw_size / 4);
+  }
+
+  SECTION("- Unique values") {
+    // The dictionary would not be smaller, so the values are stored raw
+    for (uint64_t i = 0; i < nelts; i++) {
+      values[i] = "id_" + std::to_string(i);
+      raw_size += values[i].size();
+    }
+    auto entry_num = check_dictionary_round_trip(values, &unfiltered_size);
+    CHECK(entry_num == 0);
+    CHECK(unfiltered_size == DictionaryFilter::HEADER_SIZE + raw_size);
+  }
+
+  SECTION("- Fixed-sized tile") {
+    // Without an offsets tile, the filter passes the data through
+    Buffer buff;
+    for (uint64_t i = 0; i < nelts; i++)
+      CHECK(buff.write(&i, sizeof(uint64_t)).ok());
+    Tile tile(Datatype::UINT64, sizeof(uint64_t), 0, &buff, false);
+    FilterPipeline pipeline;
+    CHECK(pipeline.add_filter(DictionaryFilter()).ok());
+    CHECK(pipeline.run_forward(&tile).ok());
+    CHECK(pipeline.run_reverse(&tile).ok());
+    REQUIRE(tile.size() == nelts * sizeof(uint64_t));
+    for (uint64_t i = 0; i < nelts; i++)
+      CHECK(buff.value<uint64_t>(i * sizeof(uint64_t)) == i);
+  }
+}
+
+TEST_CASE("Filter: Test adaptive", "[filter], [adaptive]") {
+  typedef AdaptiveFilter::Codec Codec;
+  std::mt19937_64 gen(0xadab7);
+  const uint64_t nelts = 20000;
+  std::vector<uint64_t> values(nelts);
+  Datatype type = Datatype::UINT64;
+  std::vector<Codec> expected;
+  uint32_t decode_weight = 10;
+
+  SECTION("- Random") {
+    for (auto& v : values)
+      v = gen();
+    expected = {Codec::NONE};
+  }
+
+  SECTION("- Repetitive") {
+    for (uint64_t i = 0; i < nelts; i++)
+      values[i] = (i / 8) % 16;
+    expected = {Codec::BYTESHUFFLE_ZSTD};
+  }
+
+  SECTION("- Quadratic") {
+    for (uint64_t i = 0; i < nelts; i++)
+      values[i] = 1000000 + 7 * i * i;
+    expected = {Codec::DOUBLE_DELTA};
+  }
+
+  SECTION("- Linear floats") {
+    // Double-delta is not tried on floats
+    type = Datatype::FLOAT64;
+    for (uint64_t i = 0; i < nelts; i++) {
+      double v = 1000 + i * 0.25;
+      std::memcpy(&values[i], &v, sizeof(double));
+    }
+    expected = {Codec::ZSTD, Codec::BYTESHUFFLE_ZSTD};
+  }
+
+  SECTION("- Decode speed only") {
+    for (uint64_t i = 0; i < nelts; i++)
+      values[i] = (i / 8) % 16;
+    decode_weight = 100;
+    expected = {Codec::NONE};
+  }
+
+  SECTION("- Decode speed weighted") {
+    for (uint64_t i = 0; i < nelts; i++)
+      values[i] = (i / 8) % 16;
+    decode_weight = 60;
+    expected = {Codec::LZ4};
+  }
+
+  AdaptiveFilter filter;
+  CHECK(filter.set_decode_weight(decode_weight).ok());
+  CHECK(!filter.set_decode_weight(101).ok());
+
+  // Check the selection on the sample of the whole input
+  ConstBuffer input(values.data(), nelts * sizeof(uint64_t));
+  Codec codec;
+  REQUIRE(filter.select_codec(input, type, &codec).ok());
+  CHECK(
+      std::find(expected.begin(), expected.end(), codec) != expected.end());
+
+  // Round trip through a pipeline, with parts small enough to be sampled
+  // whole
+  Buffer buff;
+  CHECK(buff.write(values.data(), nelts * sizeof(uint64_t)).ok());
+  Tile tile(type, sizeof(uint64_t), 0, &buff, false);
+  FilterPipeline pipeline;
+  pipeline.set_max_chunk_size(4096);
+  CHECK(pipeline.add_filter(filter).ok());
+  CHECK(pipeline.run_forward(&tile).ok());
+  if (codec == Codec::NONE)
+    CHECK(buff.size() > nelts * sizeof(uint64_t));
+  else
+    CHECK(buff.size() < nelts * sizeof(uint64_t) / 2);
+  CHECK(pipeline.run_reverse(&tile).ok());
+  REQUIRE(tile.buffer()->size() == nelts * sizeof(uint64_t));
+  CHECK(
+      std::memcmp(
+          tile.buffer()->data(), values.data(), nelts * sizeof(uint64_t)) ==
+      0);
+}
+
 TEST_CASE("Filter: Test bitshuffle", "[filter]") {
   // Set up test data
   const uint64_t nelts = 1000;
@@ -0,0 +1,287 @@
+/**
+ * @file unit-tile_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file unit-tests class TileCache.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/cache/tile_cache.h"
+#include "tiledb/sm/misc/constants.h"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace tiledb::sm;
+
+TEST_CASE("TileCache: Insert and read", "[tile_cache]") {
+  TileCache cache(10 * sizeof(int), 4);
+  CHECK(cache.shard_num() == 4);
+  CHECK(cache.max_size() == 10 * sizeof(int));
+
+  // Insert a null object
+  TileCacheKey k1 = {0, 0, 0};
+  CHECK(!cache.insert(k1, nullptr, sizeof(int)).ok());
+
+  // Insert an object larger than the cache size
+  int big[11] = {0};
+  CHECK(cache.insert(k1, big, sizeof(big)).ok());
+  CHECK(cache.size() == 0);
+  Buffer buff;
+  bool success;
+  CHECK(cache.read(k1, &buff, sizeof(int), &success).ok());
+  CHECK(!success);
+
+  // Insert and read back
+  int v1[3] = {1, 2, 3};
+  CHECK(cache.insert(k1, v1, sizeof(v1)).ok());
+  CHECK(cache.size() == sizeof(v1));
+  CHECK(cache.read(k1, &buff, sizeof(v1), &success).ok());
+  CHECK(success);
+  CHECK(buff.size() == sizeof(v1));
+  CHECK(!std::memcmp(buff.data(), v1, sizeof(v1)));
+
+  // Partial read
+  Buffer buff2;
+  CHECK(cache.read(k1, &buff2, sizeof(int), &success).ok());
+  CHECK(success);
+  CHECK(buff2.size() == sizeof(int));
+  CHECK(((int*)buff2.data())[0] == 1);
+
+  // Out of bounds read
+  Buffer buff3;
+  CHECK(!cache.read(k1, &buff3, sizeof(v1) + 1, &success).ok());
+  CHECK(!success);
+
+  // Keys differing in a single field are distinct
+  TileCacheKey k2 = {1, 0, 0}, k3 = {0, 1, 0}, k4 = {0, 0, 1};
+  for (const auto& k : {k2, k3, k4}) {
+    Buffer b;
+    CHECK(cache.read(k, &b, sizeof(int), &success).ok());
+    CHECK(!success);
+  }
+
+  // Inserting an existing key is a no-op
+  int v2[3] = {4, 5, 6};
+  CHECK(cache.insert(k1, v2, sizeof(v2)).ok());
+  Buffer buff4;
+  CHECK(cache.read(k1, &buff4, sizeof(v1), &success).ok());
+  CHECK(success);
+  CHECK(!std::memcmp(buff4.data(), v1, sizeof(v1)));
+  CHECK(cache.size() == sizeof(v1));
+
+  // Clear
+  cache.clear();
+  CHECK(cache.size() == 0);
+  CHECK(cache.read(k1, &buff4, sizeof(v1), &success).ok());
+  CHECK(!success);
+}
+
+TEST_CASE("TileCache: Eviction and shard stats", "[tile_cache]") {
+  const uint64_t max_size = 16 * sizeof(uint64_t);
+  TileCache cache(max_size, 3);
+  CHECK(cache.shard_num() == 4);
+
+  // Fill the cache well beyond its size
+  for (uint64_t i = 0; i < 100; ++i) {
+    uint64_t v[2] = {i, i};
+    CHECK(cache.insert({1, i * sizeof(v), 2}, v, sizeof(v)).ok());
+    CHECK(cache.size() <= max_size);
+  }
+  CHECK(cache.size() == max_size);
+
+  // Read all keys back
+  uint64_t hits = 0;
+  for (uint64_t i = 0; i < 100; ++i) {
+    Buffer buff;
+    bool success;
+    CHECK(cache.read({1, i * 2 * sizeof(uint64_t), 2}, &buff, 16, &success)
+              .ok());
+    if (success) {
+      ++hits;
+      CHECK(((uint64_t*)buff.data())[0] == i);
+    }
+  }
+  CHECK(hits == 8);
+
+  // The shard stats add up
+  TileCache::ShardStats total = {0, 0, 0, 0, 0};
+  for (unsigned s = 0; s < cache.shard_num(); ++s) {
+    auto stats = cache.shard_stats(s);
+    total.hits_ += stats.hits_;
+    total.misses_ += stats.misses_;
+    total.evictions_ += stats.evictions_;
+    total.item_num_ += stats.item_num_;
+    total.size_ += stats.size_;
+  }
+  CHECK(total.hits_ == 8);
+  CHECK(total.misses_ == 92);
+  CHECK(total.evictions_ == 92);
+  CHECK(total.item_num_ == 8);
+  CHECK(total.size_ == max_size);
+}
+
+TEST_CASE("TileCache: Fragment ids", "[tile_cache]") {
+  TileCache cache(100, 1);
+  auto id1 = cache.fragment_id("file:///array/__1");
+  auto id2 = cache.fragment_id("file:///array/__2");
+  CHECK(id1 != id2);
+  CHECK(cache.fragment_id("file:///array/__1") == id1);
+  CHECK(cache.fragment_id("file:///array/__2") == id2);
+  CHECK(id1 != constants::tile_cache_no_fragment_id);
+
+  // The ids do not depend on the state of the cache
+  TileCache other_cache(100, 1);
+  CHECK(other_cache.fragment_id("file:///array/__2") == id2);
+}
+
+TEST_CASE("TileCache: Concurrent inserts and reads", "[tile_cache]") {
+  const uint64_t max_size = 64 * sizeof(uint64_t);
+  TileCache cache(max_size, 8);
+  const unsigned num_threads = 8;
+  const uint64_t num_ops = 2000;
+
+  std::vector<std::thread> threads;
+  std::vector<int> errors(num_threads, 0);
+  for (unsigned t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (uint64_t i = 0; i < num_ops; ++i) {
+        uint64_t key = (i * 7 + t) % 256;
+        Buffer buff;
+        bool success;
+        if (!cache.read({0, key, 0}, &buff, sizeof(uint64_t), &success).ok())
+          ++errors[t];
+        if (success) {
+          if (((uint64_t*)buff.data())[0] != key)
+            ++errors[t];
+        } else if (!cache.insert({0, key, 0}, &key, sizeof(key)).ok()) {
+          ++errors[t];
+        }
+      }
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  for (auto e : errors)
+    CHECK(e == 0);
+  CHECK(cache.size() <= max_size);
+}
+
+namespace {
+
+/**
+ * Reads the input key from the cache, inserting it on a miss like the
+ * reader does. Returns `true` on a cache hit.
+ */
+bool access(TileCache* cache, uint64_t key) {
+  Buffer buff;
+  bool hit;
+  REQUIRE(cache->read({0, key, 0}, &buff, sizeof(key), &hit).ok());
+  if (!hit)
+    REQUIRE(cache->insert({0, key, 0}, &key, sizeof(key)).ok());
+  return hit;
+}
+
+/**
+ * Warms up the cache with a working set of hot keys that are accessed
+ * repeatedly, mixed with a few cold keys, then scans many cold keys once.
+ * Returns the number of hot keys that are still cached after the scan.
+ */
+uint64_t hot_keys_after_scan(TileCache::Policy policy) {
+  const uint64_t hot_num = 10;
+  TileCache cache(20 * sizeof(uint64_t), 1, policy);
+  uint64_t cold = 1000;
+  for (int round = 0; round < 30; ++round) {
+    for (uint64_t k = 0; k < hot_num; ++k)
+      access(&cache, k);
+    for (int i = 0; i < 4; ++i)
+      access(&cache, cold++);
+  }
+  for (int i = 0; i < 200; ++i)
+    access(&cache, cold++);
+
+  uint64_t hits = 0;
+  for (uint64_t k = 0; k < hot_num; ++k) {
+    Buffer buff;
+    bool hit;
+    REQUIRE(cache.read({0, k, 0}, &buff, sizeof(k), &hit).ok());
+    hits += hit;
+  }
+  CHECK(cache.size() <= cache.max_size());
+  return hits;
+}
+
+}  // namespace
+
+TEST_CASE("TileCache: Eviction policies", "[tile_cache]") {
+  TileCache::Policy policy;
+  CHECK(TileCache::policy_from_str("lru", &policy).ok());
+  CHECK(policy == TileCache::Policy::LRU);
+  CHECK(TileCache::policy_from_str("2q", &policy).ok());
+  CHECK(policy == TileCache::Policy::TWO_Q);
+  CHECK(TileCache::policy_from_str("wtinylfu", &policy).ok());
+  CHECK(policy == TileCache::Policy::W_TINY_LFU);
+  CHECK(!TileCache::policy_from_str("lfu", &policy).ok());
+
+  // A scan evicts the whole working set with LRU, but not with the
+  // scan-resistant policies
+  CHECK(hot_keys_after_scan(TileCache::Policy::LRU) == 0);
+  CHECK(hot_keys_after_scan(TileCache::Policy::TWO_Q) == 10);
+  CHECK(hot_keys_after_scan(TileCache::Policy::W_TINY_LFU) == 10);
+}
+
+TEST_CASE(
+    "TileCache: Concurrent accesses with all policies", "[tile_cache]") {
+  for (auto policy : {TileCache::Policy::LRU,
+                      TileCache::Policy::TWO_Q,
+                      TileCache::Policy::W_TINY_LFU}) {
+    const uint64_t max_size = 64 * sizeof(uint64_t);
+    TileCache cache(max_size, 4, policy);
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < 4; ++t) {
+      threads.emplace_back([&, t]() {
+        for (uint64_t i = 0; i < 2000; ++i) {
+          uint64_t key = (i % 8 == 0) ? 10000 + i * 4 + t : (i * 7 + t) % 48;
+          Buffer buff;
+          bool hit;
+          cache.read({0, key, 0}, &buff, sizeof(key), &hit);
+          if (!hit)
+            cache.insert({0, key, 0}, &key, sizeof(key));
+          else if (((uint64_t*)buff.data())[0] != key)
+            FAIL();
+        }
+      });
+    }
+    for (auto& thread : threads)
+      thread.join();
+    CHECK(cache.size() <= max_size);
+  }
+}
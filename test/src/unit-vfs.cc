@@ -62,6 +62,12 @@ TEST_CASE("VFS: Test read batching", "[vfs]") {
   REQUIRE(thread_pool.init(4).ok());
   std::vector<std::future<Status>> tasks;
 
+  // Batches with several regions are scattered with a single read.
+  auto num_reads = []() {
+    return stats::all_stats.vfs_read_call_count +
+           stats::all_stats.vfs_read_scatter_call_count;
+  };
+
   SECTION("- Default config") {
     // Check reading in one batch: single read operation.
     std::memset(data_read, 0, nelts * sizeof(uint32_t));
@@ -71,7 +77,7 @@ TEST_CASE("VFS: Test read batching", "[vfs]") {
     tasks.clear();
     for (unsigned i = 0; i < nelts; i++)
       REQUIRE(data_read[i] == i);
-    REQUIRE(stats::all_stats.vfs_read_call_count == 1);
+    REQUIRE(num_reads() == 1);
     REQUIRE(
         stats::all_stats.counter_vfs_read_total_bytes ==
         nelts * sizeof(uint32_t));
@@ -89,7 +95,7 @@ TEST_CASE("VFS: Test read batching", "[vfs]") {
     tasks.clear();
     REQUIRE(data_read[0] == 0);
     REQUIRE(data_read[1] == nelts - 1);
-    REQUIRE(stats::all_stats.vfs_read_call_count == 1);
+    REQUIRE(num_reads() == 1);
     REQUIRE(
         stats::all_stats.counter_vfs_read_total_bytes ==
         100 * sizeof(uint32_t));
@@ -107,7 +113,7 @@ TEST_CASE("VFS: Test read batching", "[vfs]") {
     tasks.clear();
     for (unsigned i = 0; i < nelts; i++)
       REQUIRE(data_read[i] == i);
-    REQUIRE(stats::all_stats.vfs_read_call_count == 1);
+    REQUIRE(num_reads() == 1);
     REQUIRE(
         stats::all_stats.counter_vfs_read_total_bytes ==
         nelts * sizeof(uint32_t));
@@ -129,7 +135,7 @@ TEST_CASE("VFS: Test read batching", "[vfs]") {
     tasks.clear();
     for (unsigned i = 0; i < nelts; i++)
       REQUIRE(data_read[i] == i);
-    REQUIRE(stats::all_stats.vfs_read_call_count == 1);
+    REQUIRE(num_reads() == 1);
     REQUIRE(
         stats::all_stats.counter_vfs_read_total_bytes ==
         nelts * sizeof(uint32_t));
@@ -147,7 +153,7 @@ TEST_CASE("VFS: Test read batching", "[vfs]") {
     tasks.clear();
     for (unsigned i = 0; i < nelts / 2; i++)
       REQUIRE(data_read[i] == 2 * i);
-    CHECK(stats::all_stats.vfs_read_call_count == nelts / 2);
+    CHECK(num_reads() == nelts / 2);
     CHECK(
         stats::all_stats.counter_vfs_read_total_bytes ==
         (nelts / 2) * sizeof(uint32_t));
@@ -165,7 +171,7 @@ TEST_CASE("VFS: Test read batching", "[vfs]") {
     tasks.clear();
     REQUIRE(data_read[0] == 0);
     REQUIRE(data_read[1] == nelts - 1);
-    REQUIRE(stats::all_stats.vfs_read_call_count == 2);
+    REQUIRE(num_reads() == 2);
     REQUIRE(
         stats::all_stats.counter_vfs_read_total_bytes == 2 * sizeof(uint32_t));
     REQUIRE(vfs->terminate().ok());
@@ -189,7 +195,7 @@ TEST_CASE("VFS: Test read batching", "[vfs]") {
     tasks.clear();
     for (unsigned i = 0; i < nelts; i++)
       REQUIRE(data_read[i] == i);
-    CHECK(stats::all_stats.vfs_read_call_count == 1);
+    CHECK(num_reads() == 1);
     CHECK(
         stats::all_stats.counter_vfs_read_total_bytes ==
         nelts * sizeof(uint32_t));
@@ -213,7 +219,7 @@ TEST_CASE("VFS: Test read batching", "[vfs]") {
     tasks.clear();
     for (unsigned i = 0; i < nelts; i++)
       REQUIRE(data_read[i] == i);
-    CHECK(stats::all_stats.vfs_read_call_count == 1);
+    CHECK(num_reads() == 1);
     CHECK(
         stats::all_stats.counter_vfs_read_total_bytes ==
         nelts * sizeof(uint32_t));
@@ -225,3 +231,311 @@ TEST_CASE("VFS: Test read batching", "[vfs]") {
 
   REQUIRE(vfs->terminate().ok());
 }
+
+TEST_CASE("VFS: Test scatter reads", "[vfs]") {
+  URI testfile("vfs_unit_test_data");
+  std::unique_ptr<VFS> vfs(new VFS);
+
+  bool exists = false;
+  REQUIRE(vfs->is_file(testfile, &exists).ok());
+  if (exists)
+    vfs->remove_file(testfile);
+
+  // Write some data.
+  const unsigned nelts = 10000;
+  std::vector<uint32_t> data_write(nelts), data_read(nelts);
+  for (unsigned i = 0; i < nelts; i++)
+    data_write[i] = i;
+  REQUIRE(
+      vfs->write(testfile, data_write.data(), nelts * sizeof(uint32_t)).ok());
+
+  // Enable stats.
+  stats::all_stats.set_enabled(true);
+  stats::all_stats.reset();
+
+  std::vector<std::tuple<uint64_t, void*, uint64_t>> batches;
+  ThreadPool thread_pool;
+  REQUIRE(thread_pool.init(4).ok());
+  std::vector<std::future<Status>> tasks;
+
+  SECTION("- Small and large gaps") {
+    // Regions of growing size separated by growing gaps, so that some gaps
+    // are larger than the scratch page.
+    unsigned offset = 0, len = 1, gap = 1, dest = 0;
+    std::vector<std::pair<unsigned, unsigned>> expected;
+    while (offset + len <= nelts) {
+      batches.emplace_back(
+          offset * sizeof(uint32_t), &data_read[dest], len * sizeof(uint32_t));
+      expected.emplace_back(dest, offset);
+      dest += len;
+      offset += len + gap;
+      len *= 2;
+      gap *= 3;
+    }
+    REQUIRE(vfs->read_all(testfile, batches, &thread_pool, &tasks).ok());
+    REQUIRE(thread_pool.wait_all(tasks).ok());
+    tasks.clear();
+    for (uint64_t r = 0; r < expected.size(); r++) {
+      unsigned nregion = 1u << r;
+      for (unsigned i = 0; i < nregion; i++)
+        REQUIRE(data_read[expected[r].first + i] == expected[r].second + i);
+    }
+    CHECK(stats::all_stats.vfs_read_call_count == 0);
+    CHECK(stats::all_stats.vfs_read_scatter_call_count == 1);
+  }
+
+  SECTION("- Overlapping regions") {
+    batches.emplace_back(0, &data_read[0], 10 * sizeof(uint32_t));
+    batches.emplace_back(
+        5 * sizeof(uint32_t), &data_read[10], 10 * sizeof(uint32_t));
+    REQUIRE(vfs->read_all(testfile, batches, &thread_pool, &tasks).ok());
+    REQUIRE(thread_pool.wait_all(tasks).ok());
+    tasks.clear();
+    for (unsigned i = 0; i < 10; i++) {
+      REQUIRE(data_read[i] == i);
+      REQUIRE(data_read[10 + i] == 5 + i);
+    }
+    CHECK(stats::all_stats.vfs_read_call_count == 1);
+    CHECK(stats::all_stats.vfs_read_scatter_call_count == 0);
+  }
+
+  SECTION("- Read past the end of the file") {
+    std::vector<std::pair<void*, uint64_t>> buffers;
+    buffers.emplace_back(nullptr, nelts * sizeof(uint32_t));
+    buffers.emplace_back(&data_read[0], sizeof(uint32_t));
+    CHECK(!vfs->read_scatter(testfile, 0, buffers).ok());
+  }
+
+  REQUIRE(vfs->remove_file(testfile).ok());
+  REQUIRE(vfs->terminate().ok());
+}
+
+#ifndef _WIN32
+TEST_CASE("VFS: Test POSIX open file cache", "[vfs]") {
+  URI testfile("vfs_unit_test_data");
+  std::unique_ptr<VFS> vfs(new VFS);
+
+  bool exists = false;
+  REQUIRE(vfs->is_file(testfile, &exists).ok());
+  if (exists)
+    vfs->remove_file(testfile);
+
+  // Write some data.
+  const unsigned nelts = 100;
+  uint32_t data_write[nelts], data_read[nelts];
+  for (unsigned i = 0; i < nelts; i++)
+    data_write[i] = i;
+  REQUIRE(vfs->write(testfile, data_write, nelts * sizeof(uint32_t)).ok());
+
+  // Enable stats.
+  stats::all_stats.set_enabled(true);
+  stats::all_stats.reset();
+
+  SECTION("- Default config") {
+    // The first read opens the file, the second one reuses it.
+    REQUIRE(vfs->read(testfile, 0, data_read, sizeof(uint32_t)).ok());
+    REQUIRE(data_read[0] == 0);
+    REQUIRE(vfs->read(testfile, 4, data_read, sizeof(uint32_t)).ok());
+    REQUIRE(data_read[0] == 1);
+    CHECK(stats::all_stats.counter_vfs_posix_open_file_cache_misses == 1);
+    CHECK(stats::all_stats.counter_vfs_posix_open_file_cache_hits == 1);
+
+    // Appending invalidates the cached file size.
+    REQUIRE(vfs->write(testfile, data_write, nelts * sizeof(uint32_t)).ok());
+    uint64_t last_offset = (2 * nelts - 1) * sizeof(uint32_t);
+    REQUIRE(vfs->read(testfile, last_offset, data_read, sizeof(uint32_t)).ok());
+    REQUIRE(data_read[0] == nelts - 1);
+    CHECK(stats::all_stats.counter_vfs_posix_open_file_cache_misses == 2);
+
+    // Removing the file invalidates the cached file.
+    REQUIRE(vfs->remove_file(testfile).ok());
+    CHECK(!vfs->read(testfile, 0, data_read, sizeof(uint32_t)).ok());
+  }
+
+  SECTION("- Caching disabled") {
+    Config::VFSParams vfs_params;
+    vfs_params.file_params_.max_open_handles_ = 0;
+    REQUIRE(vfs->init(vfs_params).ok());
+
+    for (unsigned i = 0; i < nelts; i++) {
+      REQUIRE(vfs->read(testfile, i * sizeof(uint32_t), data_read, 4).ok());
+      REQUIRE(data_read[0] == i);
+    }
+    CHECK(stats::all_stats.counter_vfs_posix_open_file_cache_misses == nelts);
+    CHECK(stats::all_stats.counter_vfs_posix_open_file_cache_hits == 0);
+  }
+
+  REQUIRE(vfs->is_file(testfile, &exists).ok());
+  if (exists)
+    REQUIRE(vfs->remove_file(testfile).ok());
+
+  REQUIRE(vfs->terminate().ok());
+}
+
+TEST_CASE("VFS: Test POSIX io_uring batched reads", "[vfs]") {
+  URI testfile("vfs_unit_test_data");
+  std::unique_ptr<VFS> vfs(new VFS);
+
+  bool exists = false;
+  REQUIRE(vfs->is_file(testfile, &exists).ok());
+  if (exists)
+    vfs->remove_file(testfile);
+
+  // Write some data.
+  const unsigned nelts = 100;
+  uint32_t data_write[nelts], data_read[nelts];
+  for (unsigned i = 0; i < nelts; i++)
+    data_write[i] = i;
+  REQUIRE(vfs->write(testfile, data_write, nelts * sizeof(uint32_t)).ok());
+
+  // Enable io_uring and disable batching, so that each region is a batch.
+  // If io_uring is not supported, the regular batched reads are used.
+  Config::VFSParams vfs_params;
+  vfs_params.file_params_.enable_io_uring_ = true;
+  vfs_params.min_batch_size_ = 0;
+  vfs_params.min_batch_gap_ = 0;
+  REQUIRE(vfs->init(vfs_params).ok());
+
+  // Enable stats.
+  stats::all_stats.set_enabled(true);
+  stats::all_stats.reset();
+
+  std::vector<std::tuple<uint64_t, void*, uint64_t>> batches;
+  ThreadPool thread_pool;
+  REQUIRE(thread_pool.init(4).ok());
+  std::vector<std::future<Status>> tasks;
+
+  // Read every other element, in reverse order.
+  std::memset(data_read, 0, nelts * sizeof(uint32_t));
+  for (unsigned i = 0; i < nelts / 2; i++)
+    batches.emplace_back(
+        (nelts - 2 - 2 * i) * sizeof(uint32_t),
+        &data_read[i],
+        sizeof(uint32_t));
+  REQUIRE(vfs->read_all(testfile, batches, &thread_pool, &tasks).ok());
+  REQUIRE(thread_pool.wait_all(tasks).ok());
+  tasks.clear();
+  for (unsigned i = 0; i < nelts / 2; i++)
+    REQUIRE(data_read[i] == nelts - 2 - 2 * i);
+  CHECK(
+      stats::all_stats.counter_vfs_read_total_bytes ==
+      (nelts / 2) * sizeof(uint32_t));
+  if (IOUring::is_supported()) {
+    CHECK(stats::all_stats.vfs_read_call_count == 0);
+    CHECK(stats::all_stats.counter_vfs_posix_io_uring_num_regions == nelts / 2);
+    CHECK(stats::all_stats.counter_vfs_posix_io_uring_num_submissions >= 1);
+  } else {
+    CHECK(stats::all_stats.vfs_read_call_count == nelts / 2);
+  }
+
+  // Reading past the end of the file fails.
+  batches.clear();
+  batches.emplace_back(nelts * sizeof(uint32_t), data_read, sizeof(uint32_t));
+  REQUIRE(vfs->read_all(testfile, batches, &thread_pool, &tasks).ok());
+  CHECK(!thread_pool.wait_all(tasks).ok());
+  tasks.clear();
+
+  REQUIRE(vfs->remove_file(testfile).ok());
+  REQUIRE(vfs->terminate().ok());
+}
+
+TEST_CASE("VFS: Test POSIX memory-mapped reads", "[vfs]") {
+  URI testfile("vfs_unit_test_data");
+  std::unique_ptr<VFS> vfs(new VFS);
+  Config::VFSParams vfs_params;
+  vfs_params.file_params_.enable_mmap_ = true;
+  REQUIRE(vfs->init(vfs_params).ok());
+
+  bool exists = false;
+  REQUIRE(vfs->is_file(testfile, &exists).ok());
+  if (exists)
+    vfs->remove_file(testfile);
+
+  // Write some data.
+  const unsigned nelts = 100;
+  uint32_t data_write[nelts], data_read[nelts];
+  for (unsigned i = 0; i < nelts; i++)
+    data_write[i] = i;
+  REQUIRE(vfs->write(testfile, data_write, nelts * sizeof(uint32_t)).ok());
+
+  // Enable stats.
+  stats::all_stats.set_enabled(true);
+  stats::all_stats.reset();
+
+  // Reads are served from the mapping.
+  REQUIRE(vfs->read(testfile, 4, data_read, 2 * sizeof(uint32_t)).ok());
+  CHECK(data_read[0] == 1);
+  CHECK(data_read[1] == 2);
+  CHECK(stats::all_stats.counter_vfs_posix_mmap_num_files == 1);
+  CHECK(stats::all_stats.counter_vfs_posix_mmap_num_reads == 1);
+
+  // Mapped regions point into the file.
+  const void* data = nullptr;
+  std::shared_ptr<void> owner;
+  REQUIRE(vfs->read_mapped(testfile, 40, 4, &data, &owner).ok());
+  REQUIRE(data != nullptr);
+  CHECK(*static_cast<const uint32_t*>(data) == 10);
+  CHECK(!vfs->read_mapped(testfile, 400, 4, &data, &owner).ok());
+
+  // The mapping held by `owner` outlives the removal of the file.
+  REQUIRE(vfs->read_mapped(testfile, 40, 4, &data, &owner).ok());
+  REQUIRE(vfs->remove_file(testfile).ok());
+  CHECK(*static_cast<const uint32_t*>(data) == 10);
+  owner.reset();
+  CHECK(!vfs->read(testfile, 0, data_read, sizeof(uint32_t)).ok());
+
+  REQUIRE(vfs->terminate().ok());
+}
+#endif
+
+TEST_CASE("VFS: Test concurrent writes at offsets", "[vfs]") {
+  URI testfile("vfs_unit_test_data");
+  std::unique_ptr<VFS> vfs(new VFS);
+  bool exists = false;
+  REQUIRE(vfs->is_file(testfile, &exists).ok());
+  if (exists)
+    vfs->remove_file(testfile);
+
+#ifdef _WIN32
+  CHECK(!vfs->supports_write_at(testfile));
+#else
+  REQUIRE(vfs->supports_write_at(testfile));
+  CHECK(!vfs->supports_write_at(URI("s3://bucket/file")));
+
+  // Write the chunks of the data out of order, in parallel
+  const unsigned nelts = 10000, nchunks = 16;
+  const unsigned chunk_nelts = nelts / nchunks;
+  std::vector<uint32_t> data_write(nelts), data_read(nelts);
+  for (unsigned i = 0; i < nelts; i++)
+    data_write[i] = i;
+  ThreadPool thread_pool;
+  REQUIRE(thread_pool.init(4).ok());
+  std::vector<std::future<Status>> tasks;
+  for (unsigned c = nchunks; c-- > 0;) {
+    tasks.push_back(thread_pool.enqueue([&, c]() {
+      return vfs->write_at(
+          testfile,
+          c * chunk_nelts * sizeof(uint32_t),
+          &data_write[c * chunk_nelts],
+          chunk_nelts * sizeof(uint32_t));
+    }));
+  }
+  REQUIRE(thread_pool.wait_all(tasks).ok());
+
+  uint64_t nbytes = 0;
+  REQUIRE(vfs->file_size(testfile, &nbytes).ok());
+  REQUIRE(nbytes == nelts * sizeof(uint32_t));
+  REQUIRE(vfs->read(testfile, 0, &data_read[0], nbytes).ok());
+  CHECK(data_read == data_write);
+
+  // Appending continues after the last chunk
+  uint32_t last = nelts;
+  REQUIRE(vfs->write(testfile, &last, sizeof(uint32_t)).ok());
+  REQUIRE(vfs->file_size(testfile, &nbytes).ok());
+  CHECK(nbytes == (nelts + 1) * sizeof(uint32_t));
+
+  REQUIRE(vfs->remove_file(testfile).ok());
+#endif
+
+  REQUIRE(vfs->terminate().ok());
+}
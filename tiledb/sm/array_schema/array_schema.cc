@@ -626,7 +626,7 @@ Status ArraySchema::set_domain(Domain* domain) {
     auto* filter = coords_filters_.get_filter<CompressionFilter>();
     assert(filter != nullptr);
     filter->set_compressor(constants::real_coords_compression);
-    filter->set_compression_level(-1);
+    RETURN_NOT_OK(filter->set_compression_level(-1));
   }
   return Status::Ok();
 }
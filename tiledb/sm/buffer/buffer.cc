@@ -277,6 +277,8 @@ Buffer& Buffer::operator=(const Buffer& buff) {
 
   if (!buff.owns_data_) {
     data_ = buff.data_;
+    size_ = buff.size_;
+    offset_ = buff.offset_;
   } else {
     if (buff.data() != nullptr)
       data_ = std::malloc(buff.alloced_size_);
@@ -275,6 +275,18 @@ inline int32_t sanity_check(
   return TILEDB_OK;
 }
 
+inline int32_t sanity_check(
+    tiledb_ctx_t* ctx, const tiledb_query_condition_t* cond) {
+  if (cond == nullptr || cond->query_condition_ == nullptr) {
+    auto st =
+        tiledb::sm::Status::Error("Invalid TileDB query condition object");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_ERR;
+  }
+  return TILEDB_OK;
+}
+
 inline int32_t sanity_check(
     tiledb_ctx_t* ctx, const tiledb_kv_schema_t* kv_schema) {
   if (kv_schema == nullptr || kv_schema->array_schema_ == nullptr) {
@@ -947,6 +959,90 @@ int32_t tiledb_filter_get_option(
   return TILEDB_OK;
 }
 
+/**
+ * Returns the compression filter wrapped by `filter`, or `nullptr` after
+ * saving an error if it is not a compression filter.
+ */
+inline tiledb::sm::CompressionFilter* compression_filter(
+    tiledb_ctx_t* ctx, tiledb_filter_t* filter) {
+  auto compression_filter =
+      dynamic_cast<tiledb::sm::CompressionFilter*>(filter->filter_);
+  if (compression_filter == nullptr) {
+    auto st = tiledb::sm::Status::FilterError(
+        "Cannot use compression dictionary; not a compression filter");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+  }
+  return compression_filter;
+}
+
+int32_t tiledb_filter_set_compression_dictionary(
+    tiledb_ctx_t* ctx,
+    tiledb_filter_t* filter,
+    const void* dictionary,
+    uint64_t dictionary_size) {
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, filter) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  auto compression = compression_filter(ctx, filter);
+  if (compression == nullptr)
+    return TILEDB_ERR;
+
+  if (SAVE_ERROR_CATCH(
+          ctx, compression->set_dictionary(dictionary, dictionary_size)))
+    return TILEDB_ERR;
+
+  // Success
+  return TILEDB_OK;
+}
+
+int32_t tiledb_filter_get_compression_dictionary(
+    tiledb_ctx_t* ctx,
+    tiledb_filter_t* filter,
+    const void** dictionary,
+    uint64_t* dictionary_size) {
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, filter) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  auto compression = compression_filter(ctx, filter);
+  if (compression == nullptr)
+    return TILEDB_ERR;
+
+  auto dict = compression->dictionary();
+  *dictionary = dict == nullptr ? nullptr : dict->data().data();
+  *dictionary_size = dict == nullptr ? 0 : dict->data().size();
+
+  // Success
+  return TILEDB_OK;
+}
+
+int32_t tiledb_filter_train_compression_dictionary(
+    tiledb_ctx_t* ctx,
+    tiledb_filter_t* filter,
+    const void* samples,
+    const uint64_t* sample_sizes,
+    uint64_t sample_num,
+    uint64_t dictionary_size) {
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, filter) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  auto compression = compression_filter(ctx, filter);
+  if (compression == nullptr)
+    return TILEDB_ERR;
+
+  std::vector<uint64_t> sizes(sample_sizes, sample_sizes + sample_num);
+  if (SAVE_ERROR_CATCH(
+          ctx,
+          compression->train_dictionary(samples, sizes, dictionary_size)))
+    return TILEDB_ERR;
+
+  // Success
+  return TILEDB_OK;
+}
+
 /* ********************************* */
 /*            FILTER LIST            */
 /* ********************************* */
@@ -2260,6 +2356,75 @@ int32_t tiledb_query_set_layout(
   return TILEDB_OK;
 }
 
+int32_t tiledb_query_set_tile_cache_populate(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, int32_t populate) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR || sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (SAVE_ERROR_CATCH(
+          ctx, query->query_->set_tile_cache_populate(populate != 0)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_query_set_condition(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const tiledb_query_condition_t* cond) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, query) == TILEDB_ERR ||
+      sanity_check(ctx, cond) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (SAVE_ERROR_CATCH(
+          ctx, query->query_->set_condition(*cond->query_condition_)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_query_add_aggregate(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* attribute,
+    tiledb_aggregate_op_t op) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (SAVE_ERROR_CATCH(
+          ctx,
+          query->query_->add_aggregate(
+              attribute, static_cast<tiledb::sm::AggregateOp>(op))))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_query_get_aggregate(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* attribute,
+    tiledb_aggregate_op_t op,
+    void* result) {
+  // Sanity check
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, query) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (SAVE_ERROR_CATCH(
+          ctx,
+          query->query_->get_aggregate(
+              attribute, static_cast<tiledb::sm::AggregateOp>(op), result)))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
 int32_t tiledb_query_finalize(tiledb_ctx_t* ctx, tiledb_query_t* query) {
   // Trivial case
   if (query == nullptr)
@@ -2975,6 +3140,109 @@ int32_t tiledb_subarray_get_est_result_size_var(
   return TILEDB_OK;
 }
 
+/* ****************************** */
+/*         QUERY CONDITION        */
+/* ****************************** */
+
+int32_t tiledb_query_condition_alloc(
+    tiledb_ctx_t* ctx, tiledb_query_condition_t** cond) {
+  if (sanity_check(ctx) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  // Create query condition struct
+  *cond = new (std::nothrow) tiledb_query_condition_t;
+  if (*cond == nullptr) {
+    auto st = tiledb::sm::Status::Error(
+        "Failed to create TileDB query condition object; Memory allocation "
+        "error");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_OOM;
+  }
+
+  // Create QueryCondition object
+  (*cond)->query_condition_ = new (std::nothrow) tiledb::sm::QueryCondition();
+  if ((*cond)->query_condition_ == nullptr) {
+    auto st = tiledb::sm::Status::Error(
+        "Failed to allocate TileDB query condition object");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    delete *cond;
+    *cond = nullptr;
+    return TILEDB_OOM;
+  }
+
+  // Success
+  return TILEDB_OK;
+}
+
+void tiledb_query_condition_free(tiledb_query_condition_t** cond) {
+  if (cond != nullptr && *cond != nullptr) {
+    delete (*cond)->query_condition_;
+    delete *cond;
+    *cond = nullptr;
+  }
+}
+
+int32_t tiledb_query_condition_init(
+    tiledb_ctx_t* ctx,
+    tiledb_query_condition_t* cond,
+    const char* attribute_name,
+    const void* value,
+    uint64_t value_size,
+    tiledb_query_condition_op_t op) {
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, cond) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (attribute_name == nullptr) {
+    auto st = tiledb::sm::Status::Error(
+        "Cannot initialize query condition; Invalid attribute name");
+    LOG_STATUS(st);
+    save_error(ctx, st);
+    return TILEDB_ERR;
+  }
+
+  if (SAVE_ERROR_CATCH(
+          ctx,
+          cond->query_condition_->init(
+              attribute_name,
+              value,
+              value_size,
+              static_cast<tiledb::sm::QueryConditionOp>(op))))
+    return TILEDB_ERR;
+
+  return TILEDB_OK;
+}
+
+int32_t tiledb_query_condition_combine(
+    tiledb_ctx_t* ctx,
+    const tiledb_query_condition_t* left_cond,
+    const tiledb_query_condition_t* right_cond,
+    tiledb_query_condition_combination_op_t combination_op,
+    tiledb_query_condition_t** combined_cond) {
+  if (sanity_check(ctx) == TILEDB_ERR ||
+      sanity_check(ctx, left_cond) == TILEDB_ERR ||
+      sanity_check(ctx, right_cond) == TILEDB_ERR)
+    return TILEDB_ERR;
+
+  if (tiledb_query_condition_alloc(ctx, combined_cond) != TILEDB_OK)
+    return TILEDB_ERR;
+
+  if (SAVE_ERROR_CATCH(
+          ctx,
+          left_cond->query_condition_->combine(
+              *right_cond->query_condition_,
+              static_cast<tiledb::sm::QueryConditionCombinationOp>(
+                  combination_op),
+              (*combined_cond)->query_condition_))) {
+    tiledb_query_condition_free(combined_cond);
+    return TILEDB_ERR;
+  }
+
+  return TILEDB_OK;
+}
+
 /* ****************************** */
 /*         OBJECT MANAGEMENT      */
 /* ****************************** */
@@ -150,6 +150,30 @@ typedef enum {
 #undef TILEDB_VFS_MODE_ENUM
 } tiledb_vfs_mode_t;
 
+/** Query condition comparison operator. */
+typedef enum {
+/** Helper macro for defining query condition operator enums. */
+#define TILEDB_QUERY_CONDITION_OP_ENUM(id) TILEDB_##id
+#include "tiledb_enum.h"
+#undef TILEDB_QUERY_CONDITION_OP_ENUM
+} tiledb_query_condition_op_t;
+
+/** Query condition combination operator. */
+typedef enum {
+/** Helper macro for defining query condition combination operator enums. */
+#define TILEDB_QUERY_CONDITION_COMBINATION_OP_ENUM(id) TILEDB_##id
+#include "tiledb_enum.h"
+#undef TILEDB_QUERY_CONDITION_COMBINATION_OP_ENUM
+} tiledb_query_condition_combination_op_t;
+
+/** Aggregate operator. */
+typedef enum {
+/** Helper macro for defining aggregate operator enums. */
+#define TILEDB_AGGREGATE_OP_ENUM(id) TILEDB_##id
+#include "tiledb_enum.h"
+#undef TILEDB_AGGREGATE_OP_ENUM
+} tiledb_aggregate_op_t;
+
 /* ****************************** */
 /*            CONSTANTS           */
 /* ****************************** */
@@ -262,6 +286,9 @@ typedef struct tiledb_query_t tiledb_query_t;
 /** A subarray object. */
 typedef struct tiledb_subarray_t tiledb_subarray_t;
 
+/** A query condition object. */
+typedef struct tiledb_query_condition_t tiledb_query_condition_t;
+
 /** A key-value store schema. */
 typedef struct tiledb_kv_schema_t tiledb_kv_schema_t;
 
@@ -532,6 +559,18 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  * - `sm.tile_cache_size` <br>
  *    The tile cache size in bytes. Any `uint64_t` value is acceptable. <br>
  *    **Default**: 10,000,000
+ * - `sm.tile_cache_policy` <br>
+ *    The tile cache eviction policy. `lru` evicts the least recently used
+ *    tiles. `2q` and `wtinylfu` (W-TinyLFU) only let tiles that are accessed
+ *    repeatedly displace the cached working set, so that large scans do not
+ *    flush the cache. <br>
+ *    **Default**: lru
+ * - `sm.tile_cache_decoded_ratio` <br>
+ *    The fraction of the tile cache that holds decoded (unfiltered) tiles,
+ *    in [0, 1]. The rest of the cache holds tiles as they are stored
+ *    (e.g., compressed), which avoids I/O on a hit but still requires
+ *    decoding the tile. <br>
+ *    **Default**: 1
  * - `sm.enable_signal_handlers` <br>
  *    Determines whether or not TileDB will install signal handlers. <br>
  *    **Default**: true
@@ -562,7 +601,9 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  *    **Default**: 1.0
  * - `sm.consolidation.buffer_size` <br>
  *    The size (in bytes) of the attribute buffers used during
- *    consolidation. <br>
+ *    consolidation. For sparse arrays, it is split among the fragments
+ *    being merged. For dense arrays, two sets of buffers are used, so
+ *    that reads overlap with writes. <br>
  *    **Default**: 50,000,000
  * - `sm.consolidation.steps` <br>
  *    The number of consolidation steps to be performed when executing
@@ -578,6 +619,35 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  *    The size ratio that two ("adjacent") fragments must satisfy to be
  *    considered for consolidation in a single step.<br>
  *    **Default**: 0.0
+ * - `sm.consolidation.mode` <br>
+ *    What gets consolidated. `fragments` merges the fragments of the
+ *    array. `fragment_meta` packs the basic metadata of all the fragments
+ *    into a single file, so that opening the array reads that file instead
+ *    of the metadata of each fragment. It is kept up to date by later
+ *    fragment consolidations, and fragments written after it are loaded
+ *    individually. <br>
+ *    **Default**: fragments
+ * - `sm.consolidation.auto` <br>
+ *    If `true`, the arrays open for writes are consolidated by a
+ *    background thread, whenever their number of fragments reaches
+ *    `sm.consolidation.auto_frag_num`. The other `sm.consolidation`
+ *    parameters select the fragments to consolidate. Background
+ *    consolidation never blocks the readers of an array. <br>
+ *    **Default**: false
+ * - `sm.consolidation.auto_frag_num` <br>
+ *    The number of fragments that triggers the background consolidation
+ *    of an array.<br>
+ *    **Default**: 32
+ * - `sm.consolidation.auto_interval_ms` <br>
+ *    The interval (in milliseconds) at which background consolidation
+ *    checks the number of fragments of the arrays. It is also the longest
+ *    time it waits for the readers of an array to close it, before
+ *    discarding the consolidated fragment and moving on.<br>
+ *    **Default**: 1000
+ * - `sm.consolidation.auto_io_budget` <br>
+ *    The maximum rate (in bytes per second) at which background
+ *    consolidation reads and writes fragments. 0 means no limit.<br>
+ *    **Default**: 0
  * - `sm.memory_budget` <br>
  *    The memory budget for tiles of fixed-sized attributes (or offsets for
  *    var-sized attributes) to be fetched during reads.<br>
@@ -605,6 +675,23 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  *    The maximum number of parallel operations on objects with `file:///`
  *    URIs. <br>
  *    **Default**: `vfs.num_threads`
+ * - `vfs.file.max_open_handles` <br>
+ *    The maximum number of read-only `file:///` handles (and file sizes)
+ *    that are kept open and reused across reads. The handles are closed
+ *    upon removing or moving the files. `0` disables the caching. <br>
+ *    **Default**: 128
+ * - `vfs.file.enable_io_uring` <br>
+ *    If `true`, the batched reads of a `file:///` object (e.g., the tiles
+ *    of a query) are submitted together through Linux io_uring, instead of
+ *    one `pread` per batch. Ignored if io_uring is not available. <br>
+ *    **Default**: false
+ * - `vfs.file.enable_mmap` <br>
+ *    If `true`, `file:///` objects are memory-mapped when first read (the
+ *    mapping is kept along with the open file handle) and reads are served
+ *    from the mapped pages. Unfiltered tiles are then used in place, without
+ *    any copy. This takes precedence over `vfs.file.enable_io_uring`. The
+ *    mapped files must not be truncated by other processes. <br>
+ *    **Default**: false
  * - `vfs.s3.region` <br>
  *    The S3 region, if S3 is enabled. <br>
  *    **Default**: us-east-1
@@ -1177,6 +1264,87 @@ TILEDB_EXPORT int32_t tiledb_filter_get_option(
     tiledb_filter_option_t option,
     void* value);
 
+/**
+ * Sets the dictionary a ZSTD compression filter compresses the data against.
+ * A dictionary holds samples of typical data, and improves the compression of
+ * small tiles that do not hold enough data to build a good dictionary on
+ * their own. The dictionary is stored in the array schema.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_filter_t* filter;
+ * tiledb_filter_alloc(ctx, TILEDB_FILTER_ZSTD, &filter);
+ * tiledb_filter_set_compression_dictionary(ctx, filter, dict, dict_size);
+ * tiledb_filter_free(&filter);
+ * @endcode
+ *
+ * @param ctx TileDB context.
+ * @param filter The target filter.
+ * @param dictionary The dictionary content.
+ * @param dictionary_size The size of `dictionary` in bytes. If `0`, the filter
+ *     stops using a dictionary.
+ * @return `TILEDB_OK` for success or `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_filter_set_compression_dictionary(
+    tiledb_ctx_t* ctx,
+    tiledb_filter_t* filter,
+    const void* dictionary,
+    uint64_t dictionary_size);
+
+/**
+ * Gets the dictionary of a compression filter.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * const void* dict;
+ * uint64_t dict_size;
+ * tiledb_filter_get_compression_dictionary(ctx, filter, &dict, &dict_size);
+ * @endcode
+ *
+ * @param ctx TileDB context.
+ * @param filter The target filter.
+ * @param dictionary Set to the dictionary content, owned by the filter, or
+ *     `NULL` if the filter does not use a dictionary.
+ * @param dictionary_size Set to the size of the dictionary in bytes.
+ * @return `TILEDB_OK` for success or `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_filter_get_compression_dictionary(
+    tiledb_ctx_t* ctx,
+    tiledb_filter_t* filter,
+    const void** dictionary,
+    uint64_t* dictionary_size);
+
+/**
+ * Trains a dictionary on samples of the data to be written (e.g., a few
+ * tiles' worth of attribute values), and sets it as the dictionary of a ZSTD
+ * compression filter.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * // `samples` holds 100 samples, whose sizes are in `sample_sizes`
+ * tiledb_filter_train_compression_dictionary(
+ *     ctx, filter, samples, sample_sizes, 100, 16 * 1024);
+ * @endcode
+ *
+ * @param ctx TileDB context.
+ * @param filter The target filter.
+ * @param samples The concatenated samples.
+ * @param sample_sizes The size in bytes of each sample.
+ * @param sample_num The number of samples.
+ * @param dictionary_size The maximum size of the dictionary in bytes.
+ * @return `TILEDB_OK` for success or `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_filter_train_compression_dictionary(
+    tiledb_ctx_t* ctx,
+    tiledb_filter_t* filter,
+    const void* samples,
+    const uint64_t* sample_sizes,
+    uint64_t sample_num,
+    uint64_t dictionary_size);
+
 /* ********************************* */
 /*            FILTER LIST            */
 /* ********************************* */
@@ -2641,6 +2809,124 @@ TILEDB_EXPORT int32_t tiledb_query_get_buffer_var(
 TILEDB_EXPORT int32_t tiledb_query_set_layout(
     tiledb_ctx_t* ctx, tiledb_query_t* query, tiledb_layout_t layout);
 
+/**
+ * Sets whether the tiles fetched by a read query are inserted into the tile
+ * cache. By default they are. Tiles that are already cached are served from
+ * the cache regardless. Disabling this is useful for bulk scans that touch
+ * many tiles once, so that they do not evict tiles that other queries read
+ * repeatedly.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_set_tile_cache_populate(ctx, query, 0);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The TileDB query. It must be a read query.
+ * @param populate If `0`, the fetched tiles are not cached.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_set_tile_cache_populate(
+    tiledb_ctx_t* ctx, tiledb_query_t* query, int32_t populate);
+
+/**
+ * Sets a condition on the attribute values of the cells to be read. Only
+ * the cells that satisfy the condition are returned. The condition is
+ * evaluated inside the reader, right after the tiles of the attributes it
+ * refers to are unfiltered, and the tiles of the other attributes that end
+ * up holding no result are never fetched.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_condition_t* cond;
+ * tiledb_query_condition_alloc(ctx, &cond);
+ * int32_t value = 5;
+ * tiledb_query_condition_init(ctx, cond, "a1", &value, sizeof(value),
+ *     TILEDB_LT);
+ * tiledb_query_set_condition(ctx, query, cond);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The TileDB query. It must be a read query on a sparse array.
+ * @param cond The condition to be set. It is copied into the query.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ *
+ * @note The condition may refer only to fixed-sized attributes with a
+ *     single value per cell.
+ */
+TILEDB_EXPORT int32_t tiledb_query_set_condition(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const tiledb_query_condition_t* cond);
+
+/**
+ * Adds an aggregate over the values of an attribute to a read query. The
+ * aggregates are computed inside the reader as it scans the tiles, so a
+ * read with aggregates sets no buffers and completes in a single
+ * submission. Its results are then retrieved with
+ * `tiledb_query_get_aggregate`.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_add_aggregate(ctx, query, "a1", TILEDB_SUM);
+ * tiledb_query_submit(ctx, query);
+ * int64_t sum;
+ * tiledb_query_get_aggregate(ctx, query, "a1", TILEDB_SUM, &sum);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The TileDB query. It must be a read query.
+ * @param attribute The aggregated attribute.
+ * @param op The aggregate operator.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ *
+ * @note Except for `TILEDB_COUNT`, the aggregated attribute must store a
+ *     single numeric value per cell. Only the non-empty cells are
+ *     aggregated, and the cells overwritten by newer fragments are
+ *     excluded.
+ */
+TILEDB_EXPORT int32_t tiledb_query_add_aggregate(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* attribute,
+    tiledb_aggregate_op_t op);
+
+/**
+ * Retrieves the result of an aggregate of a completed read query. The type
+ * of the result is:
+ *
+ * - `uint64_t` for `TILEDB_COUNT`.
+ * - `int64_t`, `uint64_t` or `double` for `TILEDB_SUM` on signed integer,
+ *   unsigned integer and real attributes respectively. The integer sums
+ *   wrap around on overflow.
+ * - The attribute type for `TILEDB_MIN` and `TILEDB_MAX`, which ignore NaN
+ *   values and fail if no value was aggregated.
+ * - `double` for `TILEDB_MEAN`, which is NaN if no value was aggregated.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * uint64_t count;
+ * tiledb_query_get_aggregate(ctx, query, "a1", TILEDB_COUNT, &count);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The TileDB query.
+ * @param attribute The aggregated attribute.
+ * @param op The aggregate operator.
+ * @param result The result to be retrieved.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_get_aggregate(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* attribute,
+    tiledb_aggregate_op_t op,
+    void* result);
+
 /**
  * Flushes all internal state of a query object and finalizes the query.
  * This is applicable only to global layout writes. It has no effect for
@@ -3613,6 +3899,98 @@ TILEDB_EXPORT int32_t tiledb_subarray_get_est_result_size_var(
     uint64_t* size_off,
     uint64_t* size_val);
 
+/* ********************************* */
+/*          QUERY CONDITION          */
+/* ********************************* */
+
+/**
+ * Allocates a TileDB query condition object.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_condition_t* cond;
+ * tiledb_query_condition_alloc(ctx, &cond);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param cond The query condition to be allocated.
+ * @return `TILEDB_OK` for success and `TILEDB_OOM` or `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_condition_alloc(
+    tiledb_ctx_t* ctx, tiledb_query_condition_t** cond);
+
+/**
+ * Frees a TileDB query condition object.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_condition_t* cond;
+ * tiledb_query_condition_alloc(ctx, &cond);
+ * tiledb_query_condition_free(&cond);
+ * @endcode
+ *
+ * @param cond The query condition to be freed.
+ */
+TILEDB_EXPORT void tiledb_query_condition_free(tiledb_query_condition_t** cond);
+
+/**
+ * Initializes a query condition as a comparison of the values of an
+ * attribute against a given value, i.e., `attribute op value`.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_condition_t* cond;
+ * tiledb_query_condition_alloc(ctx, &cond);
+ * float value = 0.5f;
+ * tiledb_query_condition_init(ctx, cond, "a2", &value, sizeof(value),
+ *     TILEDB_GE);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param cond The query condition to be initialized.
+ * @param attribute_name The name of the attribute to compare.
+ * @param value The value to compare against. It must have the type of the
+ *     attribute. Var-sized attributes (e.g., strings) are compared against
+ *     a whole cell value, and only with `TILEDB_EQ` or `TILEDB_NE`.
+ * @param value_size The size of `value` in bytes.
+ * @param op The comparison operator.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_condition_init(
+    tiledb_ctx_t* ctx,
+    tiledb_query_condition_t* cond,
+    const char* attribute_name,
+    const void* value,
+    uint64_t value_size,
+    tiledb_query_condition_op_t op);
+
+/**
+ * Combines two query conditions into a new one with a logical operator.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_condition_t* combined;
+ * tiledb_query_condition_combine(ctx, cond1, cond2, TILEDB_AND, &combined);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param left_cond The first query condition.
+ * @param right_cond The second query condition.
+ * @param combination_op The logical operator that combines the conditions.
+ * @param combined_cond The combined query condition to be allocated.
+ * @return `TILEDB_OK` for success and `TILEDB_OOM` or `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_condition_combine(
+    tiledb_ctx_t* ctx,
+    const tiledb_query_condition_t* left_cond,
+    const tiledb_query_condition_t* right_cond,
+    tiledb_query_condition_combination_op_t combination_op,
+    tiledb_query_condition_t** combined_cond);
+
 /* ********************************* */
 /*          OBJECT MANAGEMENT        */
 /* ********************************* */
@@ -131,6 +131,14 @@
     TILEDB_FILTER_TYPE_ENUM(FILTER_BYTESHUFFLE) = 9,
     /** Positive-delta encoding filter. */
     TILEDB_FILTER_TYPE_ENUM(FILTER_POSITIVE_DELTA) = 10,
+    /** Patched frame-of-reference bitpacking filter. */
+    TILEDB_FILTER_TYPE_ENUM(FILTER_PFOR) = 12,
+    /** XOR byte-plane compressor for floating-point values. */
+    TILEDB_FILTER_TYPE_ENUM(FILTER_FLOAT_PLANE) = 13,
+    /** Dictionary encoding filter for var-sized attributes. */
+    TILEDB_FILTER_TYPE_ENUM(FILTER_DICTIONARY) = 14,
+    /** Compressor selecting a codec per chunk. */
+    TILEDB_FILTER_TYPE_ENUM(FILTER_ADAPTIVE) = 15,
 #endif
 
 #ifdef TILEDB_FILTER_OPTION_ENUM
@@ -140,6 +148,8 @@
     TILEDB_FILTER_OPTION_ENUM(BIT_WIDTH_MAX_WINDOW) = 1,
     /** Max window length for positive-delta encoding. Type: `uint32_t`. */
     TILEDB_FILTER_OPTION_ENUM(POSITIVE_DELTA_MAX_WINDOW) = 2,
+    /** Weight of the decode cost for the adaptive filter. Type: `uint32_t`. */
+    TILEDB_FILTER_OPTION_ENUM(ADAPTIVE_DECODE_WEIGHT) = 3,
 #endif
 
 #ifdef TILEDB_ENCRYPTION_TYPE_ENUM
@@ -178,3 +188,38 @@
     /** Append mode */
     TILEDB_VFS_MODE_ENUM(VFS_APPEND) = 2,
 #endif
+
+#ifdef TILEDB_QUERY_CONDITION_OP_ENUM
+    /** Less than */
+    TILEDB_QUERY_CONDITION_OP_ENUM(LT) = 0,
+    /** Less than or equal to */
+    TILEDB_QUERY_CONDITION_OP_ENUM(LE) = 1,
+    /** Greater than */
+    TILEDB_QUERY_CONDITION_OP_ENUM(GT) = 2,
+    /** Greater than or equal to */
+    TILEDB_QUERY_CONDITION_OP_ENUM(GE) = 3,
+    /** Equal to */
+    TILEDB_QUERY_CONDITION_OP_ENUM(EQ) = 4,
+    /** Not equal to */
+    TILEDB_QUERY_CONDITION_OP_ENUM(NE) = 5,
+#endif
+
+#ifdef TILEDB_QUERY_CONDITION_COMBINATION_OP_ENUM
+    /** Logical AND */
+    TILEDB_QUERY_CONDITION_COMBINATION_OP_ENUM(AND) = 0,
+    /** Logical OR */
+    TILEDB_QUERY_CONDITION_COMBINATION_OP_ENUM(OR) = 1,
+#endif
+
+#ifdef TILEDB_AGGREGATE_OP_ENUM
+    /** Number of cells */
+    TILEDB_AGGREGATE_OP_ENUM(COUNT) = 0,
+    /** Sum of the cell values */
+    TILEDB_AGGREGATE_OP_ENUM(SUM) = 1,
+    /** Minimum cell value */
+    TILEDB_AGGREGATE_OP_ENUM(MIN) = 2,
+    /** Maximum cell value */
+    TILEDB_AGGREGATE_OP_ENUM(MAX) = 3,
+    /** Arithmetic mean of the cell values */
+    TILEDB_AGGREGATE_OP_ENUM(MEAN) = 4,
+#endif
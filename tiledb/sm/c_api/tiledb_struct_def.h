@@ -43,6 +43,7 @@
 #include "tiledb/sm/kv/kv_item.h"
 #include "tiledb/sm/kv/kv_iter.h"
 #include "tiledb/sm/query/query.h"
+#include "tiledb/sm/query/query_condition.h"
 #include "tiledb/sm/storage_manager/config.h"
 #include "tiledb/sm/storage_manager/config_iter.h"
 #include "tiledb/sm/storage_manager/context.h"
@@ -106,6 +107,10 @@ struct tiledb_subarray_t {
   tiledb::sm::Subarray* subarray_ = nullptr;
 };
 
+struct tiledb_query_condition_t {
+  tiledb::sm::QueryCondition* query_condition_ = nullptr;
+};
+
 struct tiledb_kv_schema_t {
   tiledb::sm::ArraySchema* array_schema_ = nullptr;
 };
@@ -0,0 +1,460 @@
+/**
+ * @file   tile_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class TileCache.
+ */
+
+#include "tiledb/sm/cache/tile_cache.h"
+#include "tiledb/sm/misc/constants.h"
+#include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/stats.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*       TileCacheKeyHasher       */
+/* ****************************** */
+
+size_t TileCacheKeyHasher::operator()(const TileCacheKey& key) const {
+  // Combine the key fields and finalize with the SplitMix64 mixer, so that
+  // both the low bits (used by the shard hash tables) and the high bits
+  // (used to select the shard) are well distributed.
+  uint64_t h = key.fragment_id_ * 0x9e3779b97f4a7c15ULL;
+  h ^= key.offset_ + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+  h ^= key.attribute_id_ + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+  h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+  h ^= h >> 31;
+  return static_cast<size_t>(h);
+}
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+TileCache::TileCache(uint64_t max_size, unsigned shard_num, Policy policy)
+    : evict_cursor_(0)
+    , max_size_(max_size)
+    , policy_(policy)
+    , size_(0) {
+  unsigned n = 1;
+  while (n < shard_num)
+    n <<= 1;
+  shard_capacity_ = max_size_ / n;
+  shards_.reserve(n);
+  for (unsigned i = 0; i < n; ++i) {
+    shards_.emplace_back(new Shard());
+    if (policy_ == Policy::W_TINY_LFU)
+      shards_.back()->sketch_.resize(
+          constants::tile_cache_sketch_depth *
+              constants::tile_cache_sketch_width,
+          0);
+  }
+}
+
+TileCache::~TileCache() {
+  clear();
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+void TileCache::clear() {
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard->mtx_);
+    size_ -= shard->size_;
+    shard->item_map_.clear();
+    for (unsigned i = 0; i < SEGMENT_NUM; ++i) {
+      shard->item_ll_[i].clear();
+      shard->segment_size_[i] = 0;
+    }
+    shard->ghost_map_.clear();
+    shard->ghost_ll_.clear();
+    shard->size_ = 0;
+  }
+}
+
+uint64_t TileCache::fragment_id(const std::string& fragment_uri) const {
+  uint64_t id = 14695981039346656037ULL;
+  for (auto c : fragment_uri) {
+    id ^= static_cast<uint8_t>(c);
+    id *= 1099511628211ULL;
+  }
+  return (id == constants::tile_cache_no_fragment_id) ? id - 1 : id;
+}
+
+Status TileCache::insert(
+    const TileCacheKey& key,
+    const void* data,
+    uint64_t size,
+    uint64_t decode_ns) {
+  // Do nothing if the object size is bigger than the cache maximum size, or
+  // if the fragment of the tile has no cache id
+  if (size > max_size_ ||
+      key.fragment_id_ == constants::tile_cache_no_fragment_id)
+    return Status::Ok();
+
+  if (data == nullptr)
+    return LOG_STATUS(Status::TileCacheError(
+        "Cannot insert into cache; Object cannot be null"));
+
+  // Do nothing if the key exists already, avoiding the copy below
+  {
+    auto s = shard(key);
+    std::lock_guard<std::mutex> lock(s->mtx_);
+    if (s->item_map_.find(key) != s->item_map_.end())
+      return Status::Ok();
+  }
+
+  // Copy the data before locking the shard
+  std::shared_ptr<uint8_t> object(
+      new (std::nothrow) uint8_t[size], std::default_delete<uint8_t[]>());
+  if (object == nullptr)
+    return LOG_STATUS(Status::TileCacheError(
+        "Cannot insert into cache; Object memory allocation failed"));
+  std::memcpy(object.get(), data, size);
+
+  {
+    auto s = shard(key);
+    std::lock_guard<std::mutex> lock(s->mtx_);
+    if (s->item_map_.find(key) != s->item_map_.end())
+      return Status::Ok();
+
+    // With 2Q, only items evicted from A1in recently enter the main list
+    auto segment = (policy_ == Policy::LRU) ? MAIN : NEW;
+    if (policy_ == Policy::TWO_Q) {
+      auto ghost_it = s->ghost_map_.find(key);
+      if (ghost_it != s->ghost_map_.end()) {
+        s->ghost_ll_.erase(ghost_it->second);
+        s->ghost_map_.erase(ghost_it);
+        segment = MAIN;
+      }
+    }
+
+    auto& ll = s->item_ll_[segment];
+    ll.push_back({key, std::move(object), size, decode_ns, segment});
+    s->item_map_[key] = std::prev(ll.end());
+    s->segment_size_[segment] += size;
+    s->size_ += size;
+    size_ += size;
+
+    // With W-TinyLFU, items overflowing the window enter the main list
+    // freely while the cache has room; once it is full, they must win an
+    // admission contest on eviction instead
+    if (policy_ == Policy::W_TINY_LFU) {
+      auto window_size = static_cast<uint64_t>(
+          constants::tile_cache_window_ratio * shard_capacity_);
+      auto& window_ll = s->item_ll_[NEW];
+      while (s->segment_size_[NEW] > window_size && window_ll.size() > 1 &&
+             size_ <= max_size_)
+        move(s, window_ll.begin(), MAIN);
+    }
+  }
+
+  STATS_COUNTER_ADD(cache_tile_inserts, 1);
+
+  // Evict without holding the shard lock, so that at most one shard is
+  // locked at any time
+  if (size_ > max_size_)
+    evict_to_fit();
+
+  return Status::Ok();
+}
+
+uint64_t TileCache::max_size() const {
+  return max_size_;
+}
+
+TileCache::Policy TileCache::policy() const {
+  return policy_;
+}
+
+Status TileCache::policy_from_str(
+    const std::string& policy_str, Policy* policy) {
+  if (policy_str == "lru")
+    *policy = Policy::LRU;
+  else if (policy_str == "2q")
+    *policy = Policy::TWO_Q;
+  else if (policy_str == "wtinylfu")
+    *policy = Policy::W_TINY_LFU;
+  else
+    return LOG_STATUS(Status::TileCacheError(
+        "Invalid tile cache policy '" + policy_str + "'"));
+
+  return Status::Ok();
+}
+
+Status TileCache::read(
+    const TileCacheKey& key, Buffer* buffer, uint64_t nbytes, bool* success) {
+  *success = false;
+  if (key.fragment_id_ == constants::tile_cache_no_fragment_id)
+    return Status::Ok();
+
+  std::shared_ptr<uint8_t> object;
+  uint64_t size;
+  {
+    auto s = shard(key);
+    std::lock_guard<std::mutex> lock(s->mtx_);
+    if (policy_ == Policy::W_TINY_LFU)
+      increment_frequency(s, TileCacheKeyHasher()(key));
+
+    auto it = s->item_map_.find(key);
+    if (it == s->item_map_.end()) {
+      ++s->misses_;
+      STATS_COUNTER_ADD(cache_tile_read_misses, 1);
+      return Status::Ok();
+    }
+
+    auto node = it->second;
+    touch(s, node);
+    object = node->data_;
+    size = node->size_;
+    ++s->hits_;
+    STATS_COUNTER_ADD(cache_tile_decode_ns_saved, node->decode_ns_);
+  }
+
+  STATS_COUNTER_ADD(cache_tile_read_hits, 1);
+
+  // Copy outside the lock; `object` keeps the data alive even if the item
+  // is evicted meanwhile
+  if (size < nbytes)
+    return LOG_STATUS(Status::TileCacheError(
+        "Failed to read item; Byte range out of bounds"));
+  RETURN_NOT_OK(buffer->write(object.get(), nbytes));
+  *success = true;
+
+  return Status::Ok();
+}
+
+unsigned TileCache::shard_num() const {
+  return static_cast<unsigned>(shards_.size());
+}
+
+TileCache::ShardStats TileCache::shard_stats(unsigned shard) const {
+  auto& s = shards_[shard];
+  std::lock_guard<std::mutex> lock(s->mtx_);
+  return {s->hits_,
+          s->misses_,
+          s->evictions_,
+          static_cast<uint64_t>(s->item_map_.size()),
+          s->size_};
+}
+
+uint64_t TileCache::size() const {
+  return size_;
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+bool TileCache::evict(Shard* shard) {
+  auto& new_ll = shard->item_ll_[NEW];
+  auto& main_ll = shard->item_ll_[MAIN];
+  auto& protected_ll = shard->item_ll_[PROTECTED];
+
+  switch (policy_) {
+    case Policy::LRU:
+      if (main_ll.empty())
+        return false;
+      evict(shard, main_ll.begin());
+      return true;
+
+    case Policy::TWO_Q: {
+      if (new_ll.empty() && main_ll.empty())
+        return false;
+
+      // Evict from Am unless A1in exceeds its share of the shard
+      auto in_size = static_cast<uint64_t>(
+          constants::tile_cache_2q_in_ratio * shard_capacity_);
+      if (new_ll.empty() ||
+          (shard->segment_size_[NEW] <= in_size && !main_ll.empty())) {
+        evict(shard, main_ll.begin());
+        return true;
+      }
+
+      // Remember the key of the evicted A1in item in A1out, which holds at
+      // most half as many keys as there are items in the shard
+      auto key = new_ll.front().key_;
+      evict(shard, new_ll.begin());
+      shard->ghost_ll_.push_back(key);
+      shard->ghost_map_[key] = std::prev(shard->ghost_ll_.end());
+      while (shard->ghost_ll_.size() > shard->item_map_.size() / 2 + 1) {
+        shard->ghost_map_.erase(shard->ghost_ll_.front());
+        shard->ghost_ll_.pop_front();
+      }
+      return true;
+    }
+
+    case Policy::W_TINY_LFU: {
+      auto victim = !main_ll.empty() ?
+                        main_ll.begin() :
+                        (!protected_ll.empty() ? protected_ll.begin() :
+                                                 protected_ll.end());
+      bool has_victim = victim != protected_ll.end();
+      auto window_size = static_cast<uint64_t>(
+          constants::tile_cache_window_ratio * shard_capacity_);
+      if (new_ll.empty() ||
+          (shard->segment_size_[NEW] <= window_size && has_victim)) {
+        if (!has_victim)
+          return false;
+        evict(shard, victim);
+        return true;
+      }
+
+      // The window is full: its least recently used item is admitted to the
+      // main list only if it is accessed more frequently than the main list
+      // victim
+      auto candidate = new_ll.begin();
+      if (!has_victim) {
+        evict(shard, candidate);
+        return true;
+      }
+      TileCacheKeyHasher hasher;
+      if (frequency(shard, hasher(candidate->key_)) >
+          frequency(shard, hasher(victim->key_))) {
+        evict(shard, victim);
+        move(shard, candidate, MAIN);
+      } else {
+        evict(shard, candidate);
+        STATS_COUNTER_ADD(cache_tile_admission_rejections, 1);
+      }
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void TileCache::evict(Shard* shard, std::list<Item>::iterator node) {
+  auto size = node->size_;
+  shard->segment_size_[node->segment_] -= size;
+  shard->size_ -= size;
+  size_ -= size;
+  ++shard->evictions_;
+  shard->item_map_.erase(node->key_);
+  shard->item_ll_[node->segment_].erase(node);
+
+  STATS_COUNTER_ADD(cache_tile_evictions, 1);
+}
+
+void TileCache::evict_to_fit() {
+  auto shard_num = shards_.size();
+  uint64_t empty_num = 0;
+  while (size_ > max_size_ && empty_num < shard_num) {
+    auto& s = shards_[evict_cursor_++ & (shard_num - 1)];
+    std::lock_guard<std::mutex> lock(s->mtx_);
+    if (evict(s.get()))
+      empty_num = 0;
+    else
+      ++empty_num;
+  }
+}
+
+uint8_t TileCache::frequency(const Shard* shard, uint64_t hash) const {
+  const uint64_t width = constants::tile_cache_sketch_width;
+  uint64_t lo = hash & 0xffffffff, hi = (hash >> 32) | 1;
+  uint8_t freq = UINT8_MAX;
+  for (uint64_t i = 0; i < constants::tile_cache_sketch_depth; ++i) {
+    auto c = shard->sketch_[i * width + ((lo + i * hi) & (width - 1))];
+    freq = std::min(freq, c);
+  }
+  return freq;
+}
+
+void TileCache::increment_frequency(Shard* shard, uint64_t hash) {
+  const uint64_t width = constants::tile_cache_sketch_width;
+  uint64_t lo = hash & 0xffffffff, hi = (hash >> 32) | 1;
+  for (uint64_t i = 0; i < constants::tile_cache_sketch_depth; ++i) {
+    auto& c = shard->sketch_[i * width + ((lo + i * hi) & (width - 1))];
+    if (c < 15)
+      ++c;
+  }
+
+  // Age the counters, so that the sketch follows changes in popularity
+  if (++shard->sketch_additions_ == 10 * width) {
+    for (auto& c : shard->sketch_)
+      c >>= 1;
+    shard->sketch_additions_ = 0;
+  }
+}
+
+void TileCache::move(
+    Shard* shard, std::list<Item>::iterator node, Segment segment) {
+  auto& from = shard->item_ll_[node->segment_];
+  auto& to = shard->item_ll_[segment];
+  shard->segment_size_[node->segment_] -= node->size_;
+  shard->segment_size_[segment] += node->size_;
+  node->segment_ = segment;
+  to.splice(to.end(), from, node);
+}
+
+void TileCache::touch(Shard* shard, std::list<Item>::iterator node) {
+  switch (policy_) {
+    case Policy::LRU:
+      move(shard, node, MAIN);
+      break;
+    case Policy::TWO_Q:
+      // A1in is a FIFO queue; hits only reorder Am
+      if (node->segment_ == MAIN)
+        move(shard, node, MAIN);
+      break;
+    case Policy::W_TINY_LFU: {
+      if (node->segment_ == NEW) {
+        move(shard, node, NEW);
+        break;
+      }
+
+      // Promote to the protected list, demoting its least recently used
+      // items to probation if it grows beyond its share of the shard
+      move(shard, node, PROTECTED);
+      auto protected_size = static_cast<uint64_t>(
+          constants::tile_cache_protected_ratio * shard_capacity_);
+      auto& protected_ll = shard->item_ll_[PROTECTED];
+      while (shard->segment_size_[PROTECTED] > protected_size &&
+             protected_ll.size() > 1)
+        move(shard, protected_ll.begin(), MAIN);
+      break;
+    }
+  }
+}
+
+TileCache::Shard* TileCache::shard(const TileCacheKey& key) const {
+  auto h = static_cast<uint64_t>(TileCacheKeyHasher()(key));
+  return shards_[(h >> 32) & (shards_.size() - 1)].get();
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,367 @@
+/**
+ * @file   tile_cache.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class TileCache.
+ */
+
+
+#ifndef TILEDB_TILE_CACHE_H
+#define TILEDB_TILE_CACHE_H
+
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/misc/status.h"
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * The key of a tile in the tile cache. The fragment is identified by the
+ * id derived from its URI by `TileCache::fragment_id`, and the attribute file
+ * by the attribute index in the fragment metadata and whether it is the
+ * var-sized values file.
+ */
+struct TileCacheKey {
+  /** The id of the fragment the tile belongs to. */
+  uint64_t fragment_id_;
+  /** The offset of the tile in the attribute file. */
+  uint64_t offset_;
+  /**
+   * The attribute file id, i.e., the attribute index shifted left by one,
+   * with the last bit set for the var-sized values file.
+   */
+  uint32_t attribute_id_;
+
+  /** Equality operator. */
+  bool operator==(const TileCacheKey& key) const {
+    return fragment_id_ == key.fragment_id_ && offset_ == key.offset_ &&
+           attribute_id_ == key.attribute_id_;
+  }
+};
+
+/** Hasher for `TileCacheKey`. */
+struct TileCacheKeyHasher {
+  /** Returns the hash of the input key. */
+  size_t operator()(const TileCacheKey& key) const;
+};
+
+/**
+ * A cache of (unfiltered) tiles, split into independently locked shards so
+ * that concurrent readers of different tiles rarely contend. A key is mapped
+ * to a shard by its hash, and each shard keeps its own hash table and
+ * eviction lists. The maximum size is enforced across all shards: when an
+ * insertion exceeds it, the shards are asked in a round-robin fashion to
+ * evict one item each, until the cache fits again.
+ *
+ * Each shard selects the item to evict according to the cache policy:
+ *
+ * - `LRU`: the least recently used item.
+ * - `TWO_Q`: new items enter a FIFO queue (A1in). When they are evicted from
+ *   it, their keys are remembered in a ghost queue (A1out), and only items
+ *   that are re-inserted while still in the ghost queue enter the main LRU
+ *   list (Am). Items that are accessed only once therefore never displace
+ *   the main list.
+ * - `W_TINY_LFU`: new items enter a small LRU window. When the window is
+ *   full, its least recently used item is admitted to the main segmented LRU
+ *   (probation and protected lists) only if it was accessed more frequently
+ *   than the item it would evict. Access frequencies are approximated per
+ *   shard with an aging count-min sketch.
+ *
+ * The cache stores copies of the inserted data. Reads copy the cached data
+ * out of the cache without holding the shard lock.
+ */
+class TileCache {
+ public:
+  /* ********************************* */
+  /*          TYPE DEFINITIONS         */
+  /* ********************************* */
+
+  /** The eviction policy. */
+  enum class Policy : uint8_t { LRU, TWO_Q, W_TINY_LFU };
+
+  /** Statistics of a cache shard. */
+  struct ShardStats {
+    /** The number of cache hits. */
+    uint64_t hits_;
+    /** The number of cache misses. */
+    uint64_t misses_;
+    /** The number of evicted items. */
+    uint64_t evictions_;
+    /** The number of items currently in the shard. */
+    uint64_t item_num_;
+    /** The current size of the shard in bytes. */
+    uint64_t size_;
+  };
+
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param max_size The maximum cache size in bytes.
+   * @param shard_num The number of shards. It is rounded up to a power of two.
+   * @param policy The eviction policy.
+   */
+  TileCache(
+      uint64_t max_size, unsigned shard_num, Policy policy = Policy::LRU);
+
+  /** Destructor. */
+  ~TileCache();
+
+  TileCache(const TileCache&) = delete;
+  TileCache& operator=(const TileCache&) = delete;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Clears the cache, deleting all cached items. */
+  void clear();
+
+  /**
+   * Returns the id of the fragment with the input URI, which is the 64-bit
+   * FNV-1a hash of the URI. No state is kept per fragment, so the ids of
+   * deleted fragments take no memory. The id is never
+   * `constants::tile_cache_no_fragment_id`.
+   */
+  uint64_t fragment_id(const std::string& fragment_uri) const;
+
+  /**
+   * Inserts a copy of the input data into the cache under the given key. If
+   * the key exists already or the data are larger than the maximum cache
+   * size, this is a no-op.
+   *
+   * @param key The key of the inserted object.
+   * @param data The data to be copied into the cache.
+   * @param size The size of the data.
+   * @param decode_ns The time in nanoseconds it took to produce the data
+   *     (e.g., to unfilter a tile). It is added to the
+   *     `cache_tile_decode_ns_saved` stat on every hit of the object.
+   * @return Status
+   */
+  Status insert(
+      const TileCacheKey& key,
+      const void* data,
+      uint64_t size,
+      uint64_t decode_ns = 0);
+
+  /** Returns the maximum size of the cache in bytes. */
+  uint64_t max_size() const;
+
+  /** Returns the eviction policy. */
+  Policy policy() const;
+
+  /**
+   * Parses an eviction policy from its configuration string (`lru`, `2q` or
+   * `wtinylfu`).
+   *
+   * @param policy_str The policy string.
+   * @param policy Set to the parsed policy.
+   * @return Status
+   */
+  static Status policy_from_str(const std::string& policy_str, Policy* policy);
+
+  /**
+   * Reads the first `nbytes` of the object cached under `key`, appending
+   * them to `buffer`.
+   *
+   * @param key The key of the object to be read.
+   * @param buffer The buffer to write into.
+   * @param nbytes The number of bytes to be read.
+   * @param success Set to `true` if the object is in the cache and `false`
+   *     otherwise.
+   * @return Status
+   */
+  Status read(
+      const TileCacheKey& key, Buffer* buffer, uint64_t nbytes, bool* success);
+
+  /** Returns the number of shards. */
+  unsigned shard_num() const;
+
+  /** Returns the statistics of the input shard. */
+  ShardStats shard_stats(unsigned shard) const;
+
+  /** Returns the current size of the cache in bytes. */
+  uint64_t size() const;
+
+ private:
+  /* ********************************* */
+  /*      PRIVATE TYPE DEFINITIONS     */
+  /* ********************************* */
+
+  /**
+   * The list of a shard an item is in. `NEW` holds the 2Q A1in queue and the
+   * W-TinyLFU window, `MAIN` holds the LRU list, the 2Q Am list and the
+   * W-TinyLFU probation list, and `PROTECTED` holds the W-TinyLFU protected
+   * list.
+   */
+  enum Segment : uint8_t { NEW = 0, MAIN = 1, PROTECTED = 2, SEGMENT_NUM = 3 };
+
+  /** A cached object. */
+  struct Item {
+    /** The object key. */
+    TileCacheKey key_;
+    /** The object data. */
+    std::shared_ptr<uint8_t> data_;
+    /** The object size. */
+    uint64_t size_;
+    /** The time in nanoseconds it took to produce the object. */
+    uint64_t decode_ns_;
+    /** The list the item is in. */
+    Segment segment_;
+  };
+
+  /** A cache shard. */
+  struct Shard {
+    /** Protects the members below. */
+    mutable std::mutex mtx_;
+    /**
+     * The cached items, one list per segment. The head of each list is the
+     * next item to leave it.
+     */
+    std::list<Item> item_ll_[SEGMENT_NUM];
+    /** The size in bytes of the items of each segment. */
+    uint64_t segment_size_[SEGMENT_NUM] = {0, 0, 0};
+    /** Maps a key to its node in `item_ll_`. */
+    std::unordered_map<
+        TileCacheKey,
+        std::list<Item>::iterator,
+        TileCacheKeyHasher>
+        item_map_;
+    /** The keys recently evicted from `NEW` (2Q only), oldest first. */
+    std::list<TileCacheKey> ghost_ll_;
+    /** Maps a key to its node in `ghost_ll_`. */
+    std::unordered_map<
+        TileCacheKey,
+        std::list<TileCacheKey>::iterator,
+        TileCacheKeyHasher>
+        ghost_map_;
+    /**
+     * The count-min sketch of the access frequencies (W-TinyLFU only), with
+     * `constants::tile_cache_sketch_depth` rows of 4-bit counters.
+     */
+    std::vector<uint8_t> sketch_;
+    /** The number of sketch increments since the counters were last aged. */
+    uint64_t sketch_additions_ = 0;
+    /** The size of the shard in bytes. */
+    uint64_t size_ = 0;
+    /** The number of cache hits. */
+    uint64_t hits_ = 0;
+    /** The number of cache misses. */
+    uint64_t misses_ = 0;
+    /** The number of evicted items. */
+    uint64_t evictions_ = 0;
+  };
+
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The next shard to evict from. */
+  std::atomic<uint64_t> evict_cursor_;
+
+  /** The maximum cache size. */
+  uint64_t max_size_;
+
+  /** The eviction policy. */
+  Policy policy_;
+
+  /**
+   * The nominal size of a shard, i.e., the maximum cache size divided by the
+   * number of shards. The policies size their segments relative to it.
+   */
+  uint64_t shard_capacity_;
+
+  /** The cache shards. */
+  std::vector<std::unique_ptr<Shard>> shards_;
+
+  /** The current cache size, across all shards. */
+  std::atomic<uint64_t> size_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /**
+   * Evicts one item from the input shard, chosen by the cache policy.
+   * Returns `false` if the shard is empty. The shard must be locked.
+   */
+  bool evict(Shard* shard);
+
+  /** Removes the input item from the shard. The shard must be locked. */
+  void evict(Shard* shard, std::list<Item>::iterator node);
+
+  /**
+   * Evicts items from the shards in a round-robin fashion, until the cache
+   * size drops to the maximum size.
+   */
+  void evict_to_fit();
+
+  /**
+   * Returns the estimated access frequency of the key with the input hash.
+   * The shard must be locked.
+   */
+  uint8_t frequency(const Shard* shard, uint64_t hash) const;
+
+  /**
+   * Increments the estimated access frequency of the key with the input
+   * hash, halving all counters once enough increments have been recorded.
+   * The shard must be locked.
+   */
+  void increment_frequency(Shard* shard, uint64_t hash);
+
+  /**
+   * Moves an item to the tail of a segment of its shard. The shard must be
+   * locked.
+   */
+  void move(Shard* shard, std::list<Item>::iterator node, Segment segment);
+
+  /**
+   * Updates the position of an item after a cache hit, according to the
+   * cache policy. The shard must be locked.
+   */
+  void touch(Shard* shard, std::list<Item>::iterator node);
+
+  /** Returns the shard the input key maps to. */
+  Shard* shard(const TileCacheKey& key) const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_TILE_CACHE_H
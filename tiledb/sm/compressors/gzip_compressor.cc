@@ -40,6 +40,101 @@
 namespace tiledb {
 namespace sm {
 
+namespace {
+
+/**
+ * The deflate and inflate streams of a thread. They are initialized on first
+ * use and reset between calls, which avoids reallocating their state (about
+ * 256KB for deflate) for every chunk.
+ */
+struct ThreadStreams {
+  /** The deflate stream. */
+  z_stream deflate_strm;
+
+  /** The inflate stream. */
+  z_stream inflate_strm;
+
+  /** Whether `deflate_strm` is initialized. */
+  bool deflate_init;
+
+  /** Whether `inflate_strm` is initialized. */
+  bool inflate_init;
+
+  /** The compression level `deflate_strm` is initialized with. */
+  int deflate_level;
+
+  ThreadStreams()
+      : deflate_init(false)
+      , inflate_init(false)
+      , deflate_level(0) {
+  }
+
+  ~ThreadStreams() {
+    if (deflate_init)
+      (void)deflateEnd(&deflate_strm);
+    if (inflate_init)
+      (void)inflateEnd(&inflate_strm);
+  }
+
+  /** Returns the deflate stream ready for a new input, or `nullptr`. */
+  z_stream* deflate_stream(int level) {
+    if (deflate_init && deflate_level != level) {
+      (void)deflateEnd(&deflate_strm);
+      deflate_init = false;
+    }
+
+    if (deflate_init) {
+      if (deflateReset(&deflate_strm) == Z_OK)
+        return &deflate_strm;
+      (void)deflateEnd(&deflate_strm);
+      deflate_init = false;
+    }
+
+    deflate_strm.zalloc = Z_NULL;
+    deflate_strm.zfree = Z_NULL;
+    deflate_strm.opaque = Z_NULL;
+    if (deflateInit(&deflate_strm, level) != Z_OK) {
+      (void)deflateEnd(&deflate_strm);
+      return nullptr;
+    }
+    deflate_init = true;
+    deflate_level = level;
+    STATS_COUNTER_ADD(compressor_num_contexts_created, 1);
+
+    return &deflate_strm;
+  }
+
+  /** Returns the inflate stream ready for a new input, or `nullptr`. */
+  z_stream* inflate_stream() {
+    if (inflate_init) {
+      if (inflateReset(&inflate_strm) == Z_OK)
+        return &inflate_strm;
+      (void)inflateEnd(&inflate_strm);
+      inflate_init = false;
+    }
+
+    inflate_strm.zalloc = Z_NULL;
+    inflate_strm.zfree = Z_NULL;
+    inflate_strm.opaque = Z_NULL;
+    inflate_strm.avail_in = 0;
+    inflate_strm.next_in = Z_NULL;
+    if (inflateInit(&inflate_strm) != Z_OK)
+      return nullptr;
+    inflate_init = true;
+    STATS_COUNTER_ADD(compressor_num_contexts_created, 1);
+
+    return &inflate_strm;
+  }
+};
+
+/** Returns the streams of the calling thread. */
+ThreadStreams& thread_streams() {
+  static thread_local ThreadStreams streams;
+  return streams;
+}
+
+}  // namespace
+
 Status GZip::compress(
     int level, ConstBuffer* input_buffer, Buffer* output_buffer) {
   STATS_FUNC_IN(compressor_gzip_compress);
@@ -49,36 +144,25 @@ Status GZip::compress(
     return LOG_STATUS(Status::CompressionError(
         "Failed compressing with GZip; invalid buffer format"));
 
-  int ret;
-  z_stream strm;
-
-  // Allocate deflate state
-  strm.zalloc = Z_NULL;
-  strm.zfree = Z_NULL;
-  strm.opaque = Z_NULL;
-  ret = deflateInit(&strm, level < 0 ? GZip::default_level() : level);
-
-  if (ret != Z_OK) {
-    (void)deflateEnd(&strm);
+  // Get deflate state
+  z_stream* strm = thread_streams().deflate_stream(
+      level < 0 ? GZip::default_level() : level);
+  if (strm == nullptr)
     return LOG_STATUS(Status::GZipError("Cannot compress with GZIP"));
-  }
 
   // Compress
-  strm.next_in = (unsigned char*)input_buffer->data();
-  strm.next_out = (unsigned char*)output_buffer->cur_data();
-  strm.avail_in = (uInt)input_buffer->size();
-  strm.avail_out = (uInt)output_buffer->free_space();
-  ret = deflate(&strm, Z_FINISH);
-
-  // Clean up
-  (void)deflateEnd(&strm);
+  strm->next_in = (unsigned char*)input_buffer->data();
+  strm->next_out = (unsigned char*)output_buffer->cur_data();
+  strm->avail_in = (uInt)input_buffer->size();
+  strm->avail_out = (uInt)output_buffer->free_space();
+  int ret = deflate(strm, Z_FINISH);
 
   // Return
-  if (ret == Z_STREAM_ERROR || strm.avail_in != 0)
+  if (ret == Z_STREAM_ERROR || strm->avail_in != 0)
     return LOG_STATUS(Status::GZipError("Cannot compress with GZIP"));
 
   // Set size of compressed data
-  uint64_t compressed_size = output_buffer->free_space() - strm.avail_out;
+  uint64_t compressed_size = output_buffer->free_space() - strm->avail_out;
   output_buffer->advance_size(compressed_size);
   output_buffer->advance_offset(compressed_size);
 
@@ -96,27 +180,17 @@ Status GZip::decompress(
     return LOG_STATUS(Status::CompressionError(
         "Failed decompressing with GZip; invalid buffer format"));
 
-  int ret;
-  z_stream strm;
-
-  // Allocate deflate state
-  strm.zalloc = Z_NULL;
-  strm.zfree = Z_NULL;
-  strm.opaque = Z_NULL;
-  strm.avail_in = 0;
-  strm.next_in = Z_NULL;
-  ret = inflateInit(&strm);
-
-  if (ret != Z_OK) {
+  // Get inflate state
+  z_stream* strm = thread_streams().inflate_stream();
+  if (strm == nullptr)
     return LOG_STATUS(Status::GZipError("Cannot decompress with GZIP"));
-  }
 
   // Decompress
-  strm.next_in = (unsigned char*)input_buffer->data();
-  strm.next_out = (unsigned char*)output_buffer->cur_data();
-  strm.avail_in = (uInt)input_buffer->size();
-  strm.avail_out = (uInt)output_buffer->free_space();
-  ret = inflate(&strm, Z_FINISH);
+  strm->next_in = (unsigned char*)input_buffer->data();
+  strm->next_out = (unsigned char*)output_buffer->cur_data();
+  strm->avail_in = (uInt)input_buffer->size();
+  strm->avail_out = (uInt)output_buffer->free_space();
+  int ret = inflate(strm, Z_FINISH);
 
   if (ret != Z_STREAM_END) {
     return LOG_STATUS(
@@ -124,12 +198,9 @@ Status GZip::decompress(
   }
 
   // Set size of decompressed data
-  uint64_t compressed_size = output_buffer->free_space() - strm.avail_out;
+  uint64_t compressed_size = output_buffer->free_space() - strm->avail_out;
   output_buffer->advance_offset(compressed_size);
 
-  // Clean up
-  (void)inflateEnd(&strm);
-
   // Success
   return Status::Ok();
 
@@ -34,12 +34,88 @@
 #include "tiledb/sm/misc/logger.h"
 #include "tiledb/sm/misc/stats.h"
 
+#include <zdict.h>
 #include <zstd.h>
 #include <iostream>
 
 namespace tiledb {
 namespace sm {
 
+namespace {
+
+/** Returns the compression context of the calling thread. */
+ZSTD_CCtx* thread_cctx() {
+  static thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> ctx(
+      nullptr, ZSTD_freeCCtx);
+  if (ctx == nullptr) {
+    ctx.reset(ZSTD_createCCtx());
+    if (ctx != nullptr) {
+      STATS_COUNTER_ADD(compressor_num_contexts_created, 1);
+    }
+  }
+  return ctx.get();
+}
+
+/** Returns the decompression context of the calling thread. */
+ZSTD_DCtx* thread_dctx() {
+  static thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> ctx(
+      nullptr, ZSTD_freeDCtx);
+  if (ctx == nullptr) {
+    ctx.reset(ZSTD_createDCtx());
+    if (ctx != nullptr) {
+      STATS_COUNTER_ADD(compressor_num_contexts_created, 1);
+    }
+  }
+  return ctx.get();
+}
+
+}  // namespace
+
+/* ****************************** */
+/*           DICTIONARY           */
+/* ****************************** */
+
+ZStd::Dictionary::Dictionary()
+    : cdict_(nullptr)
+    , ddict_(nullptr) {
+}
+
+ZStd::Dictionary::~Dictionary() {
+  ZSTD_freeCDict(cdict_);
+  ZSTD_freeDDict(ddict_);
+}
+
+Status ZStd::Dictionary::create(
+    const void* data,
+    uint64_t size,
+    int level,
+    std::shared_ptr<Dictionary>* dictionary) {
+  if (data == nullptr || size == 0)
+    return LOG_STATUS(Status::CompressionError(
+        "Cannot create ZStd dictionary; empty dictionary"));
+
+  std::shared_ptr<Dictionary> dict(new Dictionary());
+  auto bytes = static_cast<const uint8_t*>(data);
+  dict->data_.assign(bytes, bytes + size);
+  dict->cdict_ = ZSTD_createCDict(
+      dict->data_.data(), size, level < 0 ? ZStd::default_level() : level);
+  dict->ddict_ = ZSTD_createDDict(dict->data_.data(), size);
+  if (dict->cdict_ == nullptr || dict->ddict_ == nullptr)
+    return LOG_STATUS(Status::CompressionError(
+        "Cannot create ZStd dictionary; could not digest dictionary"));
+
+  *dictionary = dict;
+  return Status::Ok();
+}
+
+const std::vector<uint8_t>& ZStd::Dictionary::data() const {
+  return data_;
+}
+
+/* ****************************** */
+/*              API               */
+/* ****************************** */
+
 Status ZStd::compress(
     int level, ConstBuffer* input_buffer, Buffer* output_buffer) {
   STATS_FUNC_IN(compressor_zstd_compress);
@@ -49,16 +125,15 @@ Status ZStd::compress(
     return LOG_STATUS(Status::CompressionError(
         "Failed compressing with ZStd; invalid buffer format"));
 
-  // Create context
-  std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> ctx(
-      ZSTD_createCCtx(), ZSTD_freeCCtx);
-  if (ctx.get() == nullptr)
+  // Get context
+  ZSTD_CCtx* ctx = thread_cctx();
+  if (ctx == nullptr)
     return LOG_STATUS(Status::CompressionError(
         std::string("ZStd compression failed; could not allocate context.")));
 
   // Compress
   uint64_t zstd_ret = ZSTD_compressCCtx(
-      ctx.get(),
+      ctx,
       output_buffer->cur_data(),
       output_buffer->free_space(),
       input_buffer->data(),
@@ -81,6 +156,48 @@ Status ZStd::compress(
   STATS_FUNC_OUT(compressor_zstd_compress);
 }
 
+Status ZStd::compress(
+    const Dictionary& dictionary,
+    ConstBuffer* input_buffer,
+    Buffer* output_buffer) {
+  STATS_FUNC_IN(compressor_zstd_compress);
+
+  // Sanity check
+  if (input_buffer->data() == nullptr || output_buffer->data() == nullptr)
+    return LOG_STATUS(Status::CompressionError(
+        "Failed compressing with ZStd; invalid buffer format"));
+
+  // Get context
+  ZSTD_CCtx* ctx = thread_cctx();
+  if (ctx == nullptr)
+    return LOG_STATUS(Status::CompressionError(
+        std::string("ZStd compression failed; could not allocate context.")));
+
+  // Compress
+  uint64_t zstd_ret = ZSTD_compress_usingCDict(
+      ctx,
+      output_buffer->cur_data(),
+      output_buffer->free_space(),
+      input_buffer->data(),
+      input_buffer->size(),
+      dictionary.cdict_);
+
+  // Handle error
+  if (ZSTD_isError(zstd_ret) != 0) {
+    const char* msg = ZSTD_getErrorName(zstd_ret);
+    return LOG_STATUS(Status::CompressionError(
+        std::string("ZStd compression failed: ") + msg));
+  }
+
+  // Set size of compressed data
+  output_buffer->advance_size(zstd_ret);
+  output_buffer->advance_offset(zstd_ret);
+
+  return Status::Ok();
+
+  STATS_FUNC_OUT(compressor_zstd_compress);
+}
+
 Status ZStd::decompress(
     ConstBuffer* input_buffer, PreallocatedBuffer* output_buffer) {
   STATS_FUNC_IN(compressor_zstd_decompress);
@@ -90,16 +207,15 @@ Status ZStd::decompress(
     return LOG_STATUS(Status::CompressionError(
         "Failed decompressing with ZStd; invalid buffer format"));
 
-  // Create context
-  std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> ctx(
-      ZSTD_createDCtx(), ZSTD_freeDCtx);
-  if (ctx.get() == nullptr)
+  // Get context
+  ZSTD_DCtx* ctx = thread_dctx();
+  if (ctx == nullptr)
     return LOG_STATUS(Status::CompressionError(
         std::string("ZStd decompression failed; could not allocate context.")));
 
   // Decompress
   uint64_t zstd_ret = ZSTD_decompressDCtx(
-      ctx.get(),
+      ctx,
       output_buffer->cur_data(),
       output_buffer->free_space(),
       input_buffer->data(),
@@ -120,9 +236,80 @@ Status ZStd::decompress(
   STATS_FUNC_OUT(compressor_zstd_decompress);
 }
 
+Status ZStd::decompress(
+    const Dictionary& dictionary,
+    ConstBuffer* input_buffer,
+    PreallocatedBuffer* output_buffer) {
+  STATS_FUNC_IN(compressor_zstd_decompress);
+
+  // Sanity check
+  if (input_buffer->data() == nullptr || output_buffer->data() == nullptr)
+    return LOG_STATUS(Status::CompressionError(
+        "Failed decompressing with ZStd; invalid buffer format"));
+
+  // Get context
+  ZSTD_DCtx* ctx = thread_dctx();
+  if (ctx == nullptr)
+    return LOG_STATUS(Status::CompressionError(
+        std::string("ZStd decompression failed; could not allocate context.")));
+
+  // Decompress
+  uint64_t zstd_ret = ZSTD_decompress_usingDDict(
+      ctx,
+      output_buffer->cur_data(),
+      output_buffer->free_space(),
+      input_buffer->data(),
+      input_buffer->size(),
+      dictionary.ddict_);
+
+  // Check error
+  if (ZSTD_isError(zstd_ret) != 0) {
+    const char* msg = ZSTD_getErrorName(zstd_ret);
+    return LOG_STATUS(Status::CompressionError(
+        std::string("ZStd decompression failed: ") + msg));
+  }
+
+  // Set size decompressed data
+  output_buffer->advance_offset(zstd_ret);
+
+  return Status::Ok();
+
+  STATS_FUNC_OUT(compressor_zstd_decompress);
+}
+
 uint64_t ZStd::overhead(uint64_t nbytes) {
   return ZSTD_compressBound(nbytes) - nbytes;
 }
 
+Status ZStd::train_dictionary(
+    const void* samples,
+    const std::vector<uint64_t>& sample_sizes,
+    uint64_t max_size,
+    std::vector<uint8_t>* dictionary) {
+  if (samples == nullptr || sample_sizes.empty() || max_size == 0)
+    return LOG_STATUS(Status::CompressionError(
+        "Cannot train ZStd dictionary; no samples or empty capacity"));
+
+  std::vector<size_t> sizes(sample_sizes.begin(), sample_sizes.end());
+  dictionary->resize(max_size);
+  size_t zstd_ret = ZDICT_trainFromBuffer(
+      dictionary->data(),
+      max_size,
+      samples,
+      sizes.data(),
+      static_cast<unsigned>(sizes.size()));
+
+  // Check error
+  if (ZDICT_isError(zstd_ret) != 0) {
+    dictionary->clear();
+    const char* msg = ZDICT_getErrorName(zstd_ret);
+    return LOG_STATUS(Status::CompressionError(
+        std::string("ZStd dictionary training failed: ") + msg));
+  }
+
+  dictionary->resize(zstd_ret);
+  return Status::Ok();
+}
+
 }  // namespace sm
 }  // namespace tiledb
@@ -38,12 +38,68 @@
 #include "tiledb/sm/buffer/preallocated_buffer.h"
 #include "tiledb/sm/misc/status.h"
 
+#include <memory>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
 namespace tiledb {
 namespace sm {
 
-/** Handles compression/decompression with the zstd library. */
+/**
+ * Handles compression/decompression with the zstd library.
+ *
+ * The compression and decompression contexts are created once per thread and
+ * reused across calls, as creating a context costs about as much as
+ * compressing a small chunk.
+ */
 class ZStd {
  public:
+  /**
+   * A dictionary, i.e., samples of typical data that small inputs are
+   * compressed against. It is digested once for compressing at a given
+   * level and for decompressing, and can be shared across threads.
+   */
+  class Dictionary {
+   public:
+    /** Destructor. */
+    ~Dictionary();
+
+    /**
+     * Creates a dictionary.
+     *
+     * @param data The dictionary content.
+     * @param size The size of `data` in bytes.
+     * @param level The compression level to digest the dictionary for.
+     * @param dictionary Set to the new dictionary.
+     * @return Status
+     */
+    static Status create(
+        const void* data,
+        uint64_t size,
+        int level,
+        std::shared_ptr<Dictionary>* dictionary);
+
+    /** Returns the dictionary content. */
+    const std::vector<uint8_t>& data() const;
+
+   private:
+    /** Constructor. */
+    Dictionary();
+
+    /** The dictionary content. */
+    std::vector<uint8_t> data_;
+
+    /** The dictionary digested for compression. */
+    ZSTD_CDict_s* cdict_;
+
+    /** The dictionary digested for decompression. */
+    ZSTD_DDict_s* ddict_;
+
+    friend class ZStd;
+  };
+
   /**
    * Compression function.
    *
@@ -55,6 +111,20 @@ class ZStd {
   static Status compress(
       int level, ConstBuffer* input_buffer, Buffer* output_buffer);
 
+  /**
+   * Compression function using a dictionary, at the compression level the
+   * dictionary was created for.
+   *
+   * @param dictionary The dictionary.
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write to the compressed data.
+   * @return Status
+   */
+  static Status compress(
+      const Dictionary& dictionary,
+      ConstBuffer* input_buffer,
+      Buffer* output_buffer);
+
   /**
    * Decompression function.
    *
@@ -65,6 +135,19 @@ class ZStd {
   static Status decompress(
       ConstBuffer* input_buffer, PreallocatedBuffer* output_buffer);
 
+  /**
+   * Decompression function for data compressed with a dictionary.
+   *
+   * @param dictionary The dictionary the data was compressed with.
+   * @param input_buffer Input buffer to read from.
+   * @param output_buffer Output buffer to write the decompressed data to.
+   * @return Status
+   */
+  static Status decompress(
+      const Dictionary& dictionary,
+      ConstBuffer* input_buffer,
+      PreallocatedBuffer* output_buffer);
+
   /** Returns the default compression level. */
   static int default_level() {
     return 5;
@@ -72,6 +155,21 @@ class ZStd {
 
   /** Returns the compression overhead for the given input. */
   static uint64_t overhead(uint64_t nbytes);
+
+  /**
+   * Trains a dictionary on samples of the data to be compressed.
+   *
+   * @param samples The concatenated samples.
+   * @param sample_sizes The size in bytes of each sample.
+   * @param max_size The maximum size of the dictionary in bytes.
+   * @param dictionary Set to the content of the trained dictionary.
+   * @return Status
+   */
+  static Status train_dictionary(
+      const void* samples,
+      const std::vector<uint64_t>& sample_sizes,
+      uint64_t max_size,
+      std::vector<uint8_t>* dictionary);
 };
 
 }  // namespace sm
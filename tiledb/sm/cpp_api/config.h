@@ -245,6 +245,18 @@ class Config {
    * - `sm.tile_cache_size` <br>
    *    The tile cache size in bytes. Any `uint64_t` value is acceptable. <br>
    *    **Default**: 10,000,000
+   * - `sm.tile_cache_policy` <br>
+   *    The tile cache eviction policy. `lru` evicts the least recently used
+   *    tiles. `2q` and `wtinylfu` (W-TinyLFU) only let tiles that are accessed
+   *    repeatedly displace the cached working set, so that large scans do not
+   *    flush the cache. <br>
+   *    **Default**: lru
+   * - `sm.tile_cache_decoded_ratio` <br>
+   *    The fraction of the tile cache that holds decoded (unfiltered) tiles,
+   *    in [0, 1]. The rest of the cache holds tiles as they are stored
+   *    (e.g., compressed), which avoids I/O on a hit but still requires
+   *    decoding the tile. <br>
+   *    **Default**: 1
    * - `sm.array_schema_cache_size` <br>
    *    Array schema cache size in bytes. Any `uint64_t` value is acceptable.
    * <br>
@@ -284,7 +296,9 @@ class Config {
    *    **Default**: 1.0
    * - `sm.consolidation.buffer_size` <br>
    *    The size (in bytes) of the attribute buffers used during
-   *    consolidation. <br>
+   *    consolidation. For sparse arrays, it is split among the fragments
+   *    being merged. For dense arrays, two sets of buffers are used, so
+   *    that reads overlap with writes. <br>
    *    **Default**: 50,000,000
    * - `sm.consolidation.steps` <br>
    *    The number of consolidation steps to be performed when executing
@@ -300,6 +314,35 @@ class Config {
    *    The size ratio that two ("adjacent") fragments must satisfy to be
    *    considered for consolidation in a single step.<br>
    *    **Default**: 0.0
+   * - `sm.consolidation.mode` <br>
+   *    What gets consolidated. `fragments` merges the fragments of the
+   *    array. `fragment_meta` packs the basic metadata of all the fragments
+   *    into a single file, so that opening the array reads that file instead
+   *    of the metadata of each fragment. It is kept up to date by later
+   *    fragment consolidations, and fragments written after it are loaded
+   *    individually. <br>
+   *    **Default**: fragments
+   * - `sm.consolidation.auto` <br>
+   *    If `true`, the arrays open for writes are consolidated by a
+   *    background thread, whenever their number of fragments reaches
+   *    `sm.consolidation.auto_frag_num`. The other `sm.consolidation`
+   *    parameters select the fragments to consolidate. Background
+   *    consolidation never blocks the readers of an array. <br>
+   *    **Default**: false
+   * - `sm.consolidation.auto_frag_num` <br>
+   *    The number of fragments that triggers the background consolidation
+   *    of an array.<br>
+   *    **Default**: 32
+   * - `sm.consolidation.auto_interval_ms` <br>
+   *    The interval (in milliseconds) at which background consolidation
+   *    checks the number of fragments of the arrays. It is also the longest
+   *    time it waits for the readers of an array to close it, before
+   *    discarding the consolidated fragment and moving on.<br>
+   *    **Default**: 1000
+   * - `sm.consolidation.auto_io_budget` <br>
+   *    The maximum rate (in bytes per second) at which background
+   *    consolidation reads and writes fragments. 0 means no limit.<br>
+   *    **Default**: 0
    * - `sm.memory_budget` <br>
    *    The memory budget for tiles of fixed-sized attributes (or offsets for
    *    var-sized attributes) to be fetched during reads.<br>
@@ -327,6 +370,23 @@ class Config {
    *    The maximum number of parallel operations on objects with `file:///`
    *    URIs. <br>
    *    **Default**: `vfs.num_threads`
+   * - `vfs.file.max_open_handles` <br>
+   *    The maximum number of read-only `file:///` handles (and file sizes)
+   *    that are kept open and reused across reads. The handles are closed
+   *    upon removing or moving the files. `0` disables the caching. <br>
+   *    **Default**: 128
+   * - `vfs.file.enable_io_uring` <br>
+   *    If `true`, the batched reads of a `file:///` object (e.g., the tiles
+   *    of a query) are submitted together through Linux io_uring, instead of
+   *    one `pread` per batch. Ignored if io_uring is not available. <br>
+   *    **Default**: false
+   * - `vfs.file.enable_mmap` <br>
+   *    If `true`, `file:///` objects are memory-mapped when first read (the
+   *    mapping is kept along with the open file handle) and reads are served
+   *    from the mapped pages. Unfiltered tiles are then used in place, without
+   *    any copy. This takes precedence over `vfs.file.enable_io_uring`. The
+   *    mapped files must not be truncated by other processes. <br>
+   *    **Default**: false
    * - `vfs.s3.region` <br>
    *    The S3 region, if S3 is enabled. <br>
    *    **Default**: us-east-1
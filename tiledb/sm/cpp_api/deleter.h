@@ -126,6 +126,10 @@ class Deleter {
     tiledb_subarray_free(&p);
   }
 
+  void operator()(tiledb_query_condition_t* p) const {
+    tiledb_query_condition_free(&p);
+  }
+
  private:
   /* ********************************* */
   /*         PRIVATE ATTRIBUTES        */
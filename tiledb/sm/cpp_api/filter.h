@@ -37,6 +37,7 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 namespace tiledb {
 
@@ -231,6 +232,79 @@ class Filter {
         tiledb_filter_get_option(ctx, filter_.get(), option, value));
   }
 
+  /**
+   * Sets the dictionary a ZSTD compression filter compresses the data
+   * against, which improves the compression of small tiles. The dictionary
+   * is stored in the array schema.
+   *
+   * **Example:**
+   *
+   * @code{.cpp}
+   * tiledb::Filter f(ctx, TILEDB_FILTER_ZSTD);
+   * f.set_compression_dictionary(dict);
+   * @endcode
+   *
+   * @param dictionary The dictionary content. If empty, the filter stops
+   *     using a dictionary.
+   * @return Reference to this Filter
+   *
+   * @throws TileDBError if the filter is not a ZSTD compression filter.
+   */
+  Filter& set_compression_dictionary(const std::vector<uint8_t>& dictionary) {
+    auto& ctx = ctx_.get();
+    ctx.handle_error(tiledb_filter_set_compression_dictionary(
+        ctx, filter_.get(), dictionary.data(), dictionary.size()));
+    return *this;
+  }
+
+  /**
+   * Returns the dictionary of a compression filter, which is empty if the
+   * filter does not use a dictionary.
+   */
+  std::vector<uint8_t> compression_dictionary() const {
+    auto& ctx = ctx_.get();
+    const void* dictionary;
+    uint64_t dictionary_size;
+    ctx.handle_error(tiledb_filter_get_compression_dictionary(
+        ctx, filter_.get(), &dictionary, &dictionary_size));
+    auto data = static_cast<const uint8_t*>(dictionary);
+    return std::vector<uint8_t>(data, data + dictionary_size);
+  }
+
+  /**
+   * Trains a dictionary on samples of the data to be written, and sets it as
+   * the dictionary of a ZSTD compression filter.
+   *
+   * **Example:**
+   *
+   * @code{.cpp}
+   * tiledb::Filter f(ctx, TILEDB_FILTER_ZSTD);
+   * f.train_compression_dictionary(samples, sample_sizes, 16 * 1024);
+   * @endcode
+   *
+   * @param samples The concatenated samples.
+   * @param sample_sizes The size in bytes of each sample.
+   * @param dictionary_size The maximum size of the dictionary in bytes.
+   * @return Reference to this Filter
+   *
+   * @throws TileDBError if the filter is not a ZSTD compression filter or
+   *     the training fails, e.g., on too few samples.
+   */
+  Filter& train_compression_dictionary(
+      const void* samples,
+      const std::vector<uint64_t>& sample_sizes,
+      uint64_t dictionary_size) {
+    auto& ctx = ctx_.get();
+    ctx.handle_error(tiledb_filter_train_compression_dictionary(
+        ctx,
+        filter_.get(),
+        samples,
+        sample_sizes.data(),
+        sample_sizes.size(),
+        dictionary_size));
+    return *this;
+  }
+
   /** Gets the filter type of this filter. */
   tiledb_filter_type_t filter_type() const {
     auto& ctx = ctx_.get();
@@ -268,6 +342,14 @@ class Filter {
         return "BYTESHUFFLE";
       case TILEDB_FILTER_POSITIVE_DELTA:
         return "POSITIVE_DELTA";
+      case TILEDB_FILTER_PFOR:
+        return "PFOR";
+      case TILEDB_FILTER_FLOAT_PLANE:
+        return "FLOAT_PLANE";
+      case TILEDB_FILTER_DICTIONARY:
+        return "DICTIONARY";
+      case TILEDB_FILTER_ADAPTIVE:
+        return "ADAPTIVE";
     }
     return "";
   }
@@ -303,6 +385,7 @@ class Filter {
         break;
       case TILEDB_BIT_WIDTH_MAX_WINDOW:
       case TILEDB_POSITIVE_DELTA_MAX_WINDOW:
+      case TILEDB_ADAPTIVE_DECODE_WEIGHT:
         if (!std::is_same<uint32_t, T>::value)
           throw std::invalid_argument("Option value must be uint32_t.");
         break;
@@ -41,6 +41,7 @@
 #include "core_interface.h"
 #include "deleter.h"
 #include "exception.h"
+#include "query_condition.h"
 #include "subarray.h"
 #include "tiledb.h"
 #include "type.h"
@@ -222,6 +223,110 @@ class Query {
     return query_layout;
   }
 
+  /**
+   * Sets a condition on the attribute values of the cells to be read. Only
+   * the cells that satisfy the condition are returned, and the tiles of the
+   * other attributes that hold no such cell are never fetched.
+   *
+   * **Example:**
+   *
+   * @code{.cpp}
+   * tiledb::Query query(ctx, array, TILEDB_READ);
+   * auto cond = tiledb::QueryCondition::create(ctx, "a1", 5, TILEDB_LT);
+   * query.set_condition(cond);
+   * @endcode
+   *
+   * @param condition The condition to be set. It is copied into the query.
+   * @return Reference to this Query
+   *
+   * @note Applicable only to read queries on sparse arrays, with conditions
+   *     on fixed-sized attributes storing a single value per cell.
+   */
+  Query& set_condition(const QueryCondition& condition) {
+    auto& ctx = ctx_.get();
+    ctx.handle_error(tiledb_query_set_condition(
+        ctx, query_.get(), condition.ptr().get()));
+    return *this;
+  }
+
+  /**
+   * Adds an aggregate over the values of an attribute to a read query. A
+   * read with aggregates sets no buffers and completes in a single
+   * submission.
+   *
+   * **Example:**
+   *
+   * @code{.cpp}
+   * tiledb::Query query(ctx, array, TILEDB_READ);
+   * query.add_aggregate("a1", TILEDB_COUNT).add_aggregate("a1", TILEDB_MAX);
+   * query.submit();
+   * auto count = query.get_aggregate<uint64_t>("a1", TILEDB_COUNT);
+   * auto max = query.get_aggregate<int32_t>("a1", TILEDB_MAX);
+   * @endcode
+   *
+   * @param attr The aggregated attribute.
+   * @param op The aggregate operator.
+   * @return Reference to this Query
+   *
+   * @note Except for `TILEDB_COUNT`, the attribute must store a single
+   *     numeric value per cell.
+   */
+  Query& add_aggregate(const std::string& attr, tiledb_aggregate_op_t op) {
+    auto& ctx = ctx_.get();
+    ctx.handle_error(
+        tiledb_query_add_aggregate(ctx, query_.get(), attr.c_str(), op));
+    return *this;
+  }
+
+  /**
+   * Returns the result of an aggregate of a completed read query.
+   *
+   * @tparam T The result type: `uint64_t` for `TILEDB_COUNT`, `int64_t`,
+   *     `uint64_t` or `double` for `TILEDB_SUM` (see
+   *     `tiledb_query_get_aggregate`), the attribute type for `TILEDB_MIN`
+   *     and `TILEDB_MAX`, and `double` for `TILEDB_MEAN`.
+   * @param attr The aggregated attribute.
+   * @param op The aggregate operator.
+   * @return The result of the aggregate.
+   */
+  template <typename T>
+  T get_aggregate(const std::string& attr, tiledb_aggregate_op_t op) const {
+    if (op == TILEDB_MIN || op == TILEDB_MAX)
+      impl::type_check<T>(schema_.attribute(attr).type());
+    else if (sizeof(T) != sizeof(uint64_t))
+      throw TypeError(
+          "Static type size (" + std::to_string(sizeof(T)) +
+          ") does not match the size of the aggregate result (8)");
+
+    auto& ctx = ctx_.get();
+    T result;
+    ctx.handle_error(tiledb_query_get_aggregate(
+        ctx, query_.get(), attr.c_str(), op, &result));
+    return result;
+  }
+
+  /**
+   * Sets whether the tiles fetched by this read query are inserted into the
+   * tile cache. Disable it for bulk scans, so that they do not evict tiles
+   * that other queries read repeatedly.
+   *
+   * **Example:**
+   *
+   * @code{.cpp}
+   * tiledb::Query query(ctx, array, TILEDB_READ);
+   * query.set_tile_cache_populate(false);
+   * @endcode
+   *
+   * @param populate If `false`, the fetched tiles are not cached.
+   * @return Reference to this Query
+   */
+  Query& set_tile_cache_populate(bool populate) {
+    auto& ctx = ctx_.get();
+    ctx.handle_error(tiledb_query_set_tile_cache_populate(
+        ctx, query_.get(), populate ? 1 : 0));
+    return *this;
+  }
+
   /** Returns the query status. */
   Status query_status() const {
     tiledb_query_status_t status;
@@ -0,0 +1,231 @@
+/**
+ * @file   query_condition.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares the C++ API for the TileDB QueryCondition object.
+ */
+
+#ifndef TILEDB_CPP_API_QUERY_CONDITION_H
+#define TILEDB_CPP_API_QUERY_CONDITION_H
+
+#include "context.h"
+#include "deleter.h"
+#include "tiledb.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace tiledb {
+
+/**
+ * A condition on the attribute values of the cells read by a query. Only
+ * the cells that satisfy it are returned.
+ *
+ * **Example:**
+ *
+ * @code{.cpp}
+ * tiledb::Context ctx;
+ * auto cond1 = tiledb::QueryCondition::create(ctx, "a1", 5, TILEDB_LT);
+ * auto cond2 = tiledb::QueryCondition::create(ctx, "a2", 0.5f, TILEDB_GE);
+ * auto cond = cond1.combine(cond2, TILEDB_AND);
+ * query.set_condition(cond);
+ * @endcode
+ */
+class QueryCondition {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Creates an empty TileDB query condition object.
+   *
+   * @param ctx TileDB context.
+   */
+  explicit QueryCondition(const Context& ctx)
+      : ctx_(ctx) {
+    tiledb_query_condition_t* cond;
+    ctx.handle_error(tiledb_query_condition_alloc(ctx, &cond));
+    query_condition_ =
+        std::shared_ptr<tiledb_query_condition_t>(cond, deleter_);
+  }
+
+  /**
+   * Creates a TileDB query condition object with the input C object.
+   *
+   * @param ctx TileDB context.
+   * @param cond C API query condition object.
+   */
+  QueryCondition(const Context& ctx, tiledb_query_condition_t* cond)
+      : ctx_(ctx) {
+    query_condition_ =
+        std::shared_ptr<tiledb_query_condition_t>(cond, deleter_);
+  }
+
+  QueryCondition(const QueryCondition&) = default;
+  QueryCondition(QueryCondition&&) = default;
+  QueryCondition& operator=(const QueryCondition&) = default;
+  QueryCondition& operator=(QueryCondition&&) = default;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Creates a query condition comparing the values of an attribute against
+   * a value.
+   *
+   * **Example:**
+   *
+   * @code{.cpp}
+   * auto cond = tiledb::QueryCondition::create(ctx, "a1", 5, TILEDB_LT);
+   * @endcode
+   *
+   * @tparam T The type of the value. It must match the attribute type.
+   * @param ctx TileDB context.
+   * @param attribute_name The name of the attribute to compare.
+   * @param value The value to compare against.
+   * @param op The comparison operator.
+   * @return The new query condition.
+   */
+  template <
+      typename T,
+      typename std::enable_if<std::is_arithmetic<T>::value>::type* = nullptr>
+  static QueryCondition create(
+      const Context& ctx,
+      const std::string& attribute_name,
+      T value,
+      tiledb_query_condition_op_t op) {
+    QueryCondition cond(ctx);
+    cond.init(attribute_name, &value, sizeof(T), op);
+    return cond;
+  }
+
+  /**
+   * Creates a query condition comparing the values of a var-sized string
+   * attribute against a string. Only `TILEDB_EQ` and `TILEDB_NE` are
+   * supported on var-sized attributes.
+   *
+   * **Example:**
+   *
+   * @code{.cpp}
+   * auto cond = tiledb::QueryCondition::create(ctx, "a1", "red", TILEDB_EQ);
+   * @endcode
+   *
+   * @param ctx TileDB context.
+   * @param attribute_name The name of the attribute to compare.
+   * @param value The string to compare against.
+   * @param op The comparison operator.
+   * @return The new query condition.
+   */
+  static QueryCondition create(
+      const Context& ctx,
+      const std::string& attribute_name,
+      const std::string& value,
+      tiledb_query_condition_op_t op) {
+    QueryCondition cond(ctx);
+    cond.init(attribute_name, value.data(), value.size(), op);
+    return cond;
+  }
+
+  /**
+   * Initializes the query condition as a comparison of the values of an
+   * attribute against a value.
+   *
+   * @param attribute_name The name of the attribute to compare.
+   * @param value The value to compare against.
+   * @param value_size The size of `value` in bytes.
+   * @param op The comparison operator.
+   */
+  void init(
+      const std::string& attribute_name,
+      const void* value,
+      uint64_t value_size,
+      tiledb_query_condition_op_t op) {
+    auto& ctx = ctx_.get();
+    ctx.handle_error(tiledb_query_condition_init(
+        ctx,
+        query_condition_.get(),
+        attribute_name.c_str(),
+        value,
+        value_size,
+        op));
+  }
+
+  /**
+   * Combines this query condition with another one.
+   *
+   * **Example:**
+   *
+   * @code{.cpp}
+   * auto cond = cond1.combine(cond2, TILEDB_OR);
+   * @endcode
+   *
+   * @param rhs The other query condition.
+   * @param combination_op The logical operator combining the conditions.
+   * @return The combined query condition.
+   */
+  QueryCondition combine(
+      const QueryCondition& rhs,
+      tiledb_query_condition_combination_op_t combination_op) const {
+    auto& ctx = ctx_.get();
+    tiledb_query_condition_t* combined;
+    ctx.handle_error(tiledb_query_condition_combine(
+        ctx,
+        query_condition_.get(),
+        rhs.query_condition_.get(),
+        combination_op,
+        &combined));
+    return QueryCondition(ctx, combined);
+  }
+
+  /** Returns a shared pointer to the C TileDB query condition object. */
+  std::shared_ptr<tiledb_query_condition_t> ptr() const {
+    return query_condition_;
+  }
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The TileDB context. */
+  std::reference_wrapper<const Context> ctx_;
+
+  /** Deleter wrapper. */
+  impl::Deleter deleter_;
+
+  /** Pointer to the TileDB C query condition object. */
+  std::shared_ptr<tiledb_query_condition_t> query_condition_;
+};
+
+}  // namespace tiledb
+
+#endif  // TILEDB_CPP_API_QUERY_CONDITION_H
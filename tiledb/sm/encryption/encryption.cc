@@ -40,9 +40,42 @@
 #include "tiledb/sm/encryption/encryption_openssl.h"
 #endif
 
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <cpuid.h>
+#define TILEDB_ENCRYPTION_X86
+#endif
+
 namespace tiledb {
 namespace sm {
 
+/*
+ * The CPU features are queried with `cpuid` directly rather than with
+ * `__builtin_cpu_supports`, as the latter clashes with the `__cpu_model`
+ * work-around in misc/work_arounds.cc.
+ */
+Encryption::AesIsa Encryption::aes_isa() {
+#ifdef TILEDB_ENCRYPTION_X86
+  unsigned eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_AES) ||
+      !(ecx & bit_PCLMUL))
+    return AesIsa::NONE;
+
+  // VAES operates on YMM registers, which the OS must save on context
+  // switches.
+  if ((ecx & bit_OSXSAVE) && (ecx & bit_AVX)) {
+    unsigned xcr0_lo, xcr0_hi;
+    __asm__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    if ((xcr0_lo & 0x6) == 0x6 &&
+        __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) &&
+        (ecx & bit_VAES) && (ecx & bit_VPCLMULQDQ))
+      return AesIsa::VAES;
+  }
+  return AesIsa::AES_NI;
+#else
+  return AesIsa::NONE;
+#endif
+}
+
 Status Encryption::encrypt_aes256gcm(
     ConstBuffer* key,
     ConstBuffer* iv,
@@ -65,6 +98,8 @@ Status Encryption::encrypt_aes256gcm(
     return LOG_STATUS(Status::EncryptionError(
         "AES-256-GCM error; invalid output tag buffer."));
 
+  STATS_COUNTER_ADD(encryption_num_bytes_encrypted, input->size());
+
 #ifdef _WIN32
   return Win32CNG::encrypt_aes256gcm(
       key, iv, input, output, output_iv, output_tag);
@@ -94,6 +129,8 @@ Status Encryption::decrypt_aes256gcm(
     return LOG_STATUS(
         Status::EncryptionError("AES-256-GCM error; invalid tag."));
 
+  STATS_COUNTER_ADD(encryption_num_bytes_decrypted, input->size());
+
 #ifdef _WIN32
   return Win32CNG::decrypt_aes256gcm(key, iv, tag, input, output);
 #else
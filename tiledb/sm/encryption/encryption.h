@@ -54,6 +54,24 @@ class Encryption {
   /** Size of an AES-256-GCM tag in bytes. */
   static const unsigned AES256GCM_TAG_BYTES = 16;
 
+  /** The hardware AES instructions supported by the CPU. */
+  enum class AesIsa : uint8_t {
+    /** No hardware support; AES runs in software. */
+    NONE,
+    /** AES-NI and carry-less multiplication on 128-bit registers. */
+    AES_NI,
+    /** Vector AES and carry-less multiplication on 256-bit registers. */
+    VAES
+  };
+
+  /**
+   * Returns the widest hardware AES instructions the CPU supports. The
+   * AES-256-GCM implementation (OpenSSL or Windows CNG) detects and
+   * dispatches to these on its own; this is for reporting whether encryption
+   * is hardware-accelerated.
+   */
+  static AesIsa aes_isa();
+
   /**
    * Encrypt the given data using AES-256-GCM.
    *
@@ -34,7 +34,9 @@
 
 #include "tiledb/sm/encryption/encryption_openssl.h"
 #include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/stats.h"
 
+#include <openssl/crypto.h>
 #include <openssl/err.h>
 #include <openssl/evp.h>
 #include <openssl/rand.h>
@@ -42,6 +44,100 @@
 namespace tiledb {
 namespace sm {
 
+namespace {
+
+/**
+ * An AES-256-GCM cipher context whose allocation is reused across calls on
+ * the same thread. It is initialized with the key on every call and cleansed
+ * when the call returns, so no key material outlives the call.
+ */
+class ThreadCipherContext {
+ public:
+  explicit ThreadCipherContext(bool encrypt)
+      : ctx_(nullptr)
+      , encrypt_(encrypt) {
+  }
+
+  ~ThreadCipherContext() {
+    if (ctx_ != nullptr)
+      EVP_CIPHER_CTX_free(ctx_);
+  }
+
+  ThreadCipherContext(const ThreadCipherContext&) = delete;
+  ThreadCipherContext& operator=(const ThreadCipherContext&) = delete;
+
+  /**
+   * Initializes the context for a new operation with the given key and IV.
+   * Returns `nullptr` on error.
+   */
+  EVP_CIPHER_CTX* init(const unsigned char* key, const unsigned char* iv) {
+    if (ctx_ == nullptr) {
+      ctx_ = EVP_CIPHER_CTX_new();
+      if (ctx_ == nullptr)
+        return nullptr;
+      STATS_COUNTER_ADD(encryption_num_contexts_created, 1);
+    }
+
+    // We use the default parameter lengths for the IV and tag, so no further
+    // configuration is needed for the cipher.
+    int rc =
+        EVP_CipherInit_ex(ctx_, EVP_aes_256_gcm(), nullptr, key, iv, encrypt_);
+    return rc == 0 ? nullptr : ctx_;
+  }
+
+  /**
+   * Cleanses the cipher state (including the expanded key), keeping only the
+   * context allocation.
+   */
+  void reset() {
+    if (ctx_ == nullptr)
+      return;
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+    EVP_CIPHER_CTX_reset(ctx_);
+#else
+    EVP_CIPHER_CTX_cleanup(ctx_);
+    EVP_CIPHER_CTX_init(ctx_);
+#endif
+  }
+
+ private:
+  /** The OpenSSL cipher context. */
+  EVP_CIPHER_CTX* ctx_;
+
+  /** Whether the context encrypts or decrypts. */
+  const bool encrypt_;
+};
+
+/** Resets a thread cipher context when going out of scope. */
+class CipherContextReset {
+ public:
+  explicit CipherContextReset(ThreadCipherContext* cipher)
+      : cipher_(cipher) {
+  }
+
+  ~CipherContextReset() {
+    cipher_->reset();
+  }
+
+ private:
+  /** The context to reset. */
+  ThreadCipherContext* cipher_;
+};
+
+/** Returns the encryption context of the calling thread. */
+ThreadCipherContext& thread_encrypt_context() {
+  static thread_local ThreadCipherContext ctx(true);
+  return ctx;
+}
+
+/** Returns the decryption context of the calling thread. */
+ThreadCipherContext& thread_decrypt_context() {
+  static thread_local ThreadCipherContext ctx(false);
+  return ctx;
+}
+
+}  // namespace
+
 Status OpenSSL::get_random_bytes(unsigned num_bytes, Buffer* output) {
   if (output->free_space() < num_bytes)
     RETURN_NOT_OK(output->realloc(output->alloced_size() + num_bytes));
@@ -92,24 +188,13 @@ Status OpenSSL::encrypt_aes256gcm(
   // Copy IV to output arg.
   std::memcpy(output_iv->cur_data(), iv_buf, iv_len);
 
-  EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+  // Initialize the cipher.
+  auto& cipher = thread_encrypt_context();
+  CipherContextReset cipher_reset(&cipher);
+  EVP_CIPHER_CTX* ctx = cipher.init((const unsigned char*)key->data(), iv_buf);
   if (ctx == nullptr)
-    return LOG_STATUS(Status::EncryptionError(
-        "OpenSSL error; cannot encrypt: context allocation failed."));
-
-  // Initialize the cipher. We use the default parameter lengths for the IV and
-  // tag, so no further configuration is needed for the cipher.
-  EVP_CIPHER_CTX_init(ctx);
-  if (EVP_EncryptInit_ex(
-          ctx,
-          EVP_aes_256_gcm(),
-          nullptr,
-          (unsigned char*)key->data(),
-          iv_buf) == 0) {
-    EVP_CIPHER_CTX_free(ctx);
     return LOG_STATUS(
         Status::EncryptionError("OpenSSL error; error initializing cipher."));
-  }
 
   // Encrypt the input.
   int output_len;
@@ -119,7 +204,6 @@ Status OpenSSL::encrypt_aes256gcm(
           &output_len,
           (const unsigned char*)input->data(),
           (int)input->size()) == 0) {
-    EVP_CIPHER_CTX_free(ctx);
     return LOG_STATUS(
         Status::EncryptionError("OpenSSL error; error encrypting data."));
   }
@@ -129,7 +213,6 @@ Status OpenSSL::encrypt_aes256gcm(
   // Finalize encryption.
   if (EVP_EncryptFinal_ex(
           ctx, (unsigned char*)output->cur_data(), &output_len) == 0) {
-    EVP_CIPHER_CTX_free(ctx);
     return LOG_STATUS(
         Status::EncryptionError("OpenSSL error; error finalizing encryption."));
   }
@@ -142,14 +225,10 @@ Status OpenSSL::encrypt_aes256gcm(
           EVP_CTRL_GCM_GET_TAG,
           Encryption::AES256GCM_TAG_BYTES,
           (char*)output_tag->data()) == 0) {
-    EVP_CIPHER_CTX_free(ctx);
     return LOG_STATUS(
         Status::EncryptionError("OpenSSL error; error getting tag."));
   }
 
-  // Clean up.
-  EVP_CIPHER_CTX_free(ctx);
-
   return Status::Ok();
 }
 
@@ -174,24 +253,14 @@ Status OpenSSL::decrypt_aes256gcm(
         "OpenSSL error; cannot decrypt: output buffer too small."));
   }
 
-  EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+  // Initialize the cipher.
+  auto& cipher = thread_decrypt_context();
+  CipherContextReset cipher_reset(&cipher);
+  EVP_CIPHER_CTX* ctx = cipher.init(
+      (const unsigned char*)key->data(), (const unsigned char*)iv->data());
   if (ctx == nullptr)
-    return LOG_STATUS(Status::EncryptionError(
-        "OpenSSL error; cannot decrypt: context allocation failed."));
-
-  // Initialize the cipher. We use the default parameter lengths for the IV and
-  // tag, so no further configuration is needed for the cipher.
-  EVP_CIPHER_CTX_init(ctx);
-  if (EVP_DecryptInit_ex(
-          ctx,
-          EVP_aes_256_gcm(),
-          nullptr,
-          (unsigned char*)key->data(),
-          (unsigned char*)iv->data()) == 0) {
-    EVP_CIPHER_CTX_free(ctx);
     return LOG_STATUS(
         Status::EncryptionError("OpenSSL error; error initializing cipher."));
-  }
 
   // Decrypt the input.
   int output_len;
@@ -201,7 +270,6 @@ Status OpenSSL::decrypt_aes256gcm(
           &output_len,
           (const unsigned char*)input->data(),
           (int)input->size()) == 0) {
-    EVP_CIPHER_CTX_free(ctx);
     return LOG_STATUS(
         Status::EncryptionError("OpenSSL error; error decrypting data."));
   }
@@ -215,7 +283,6 @@ Status OpenSSL::decrypt_aes256gcm(
           EVP_CTRL_GCM_SET_TAG,
           Encryption::AES256GCM_TAG_BYTES,
           (char*)tag->data()) == 0) {
-    EVP_CIPHER_CTX_free(ctx);
     return LOG_STATUS(
         Status::EncryptionError("OpenSSL error; error setting tag."));
   }
@@ -223,7 +290,6 @@ Status OpenSSL::decrypt_aes256gcm(
   // Finalize decryption.
   if (EVP_DecryptFinal_ex(
           ctx, (unsigned char*)output->cur_data(), &output_len) == 0) {
-    EVP_CIPHER_CTX_free(ctx);
     return LOG_STATUS(
         Status::EncryptionError("OpenSSL error; error finalizing decryption."));
   }
@@ -231,9 +297,6 @@ Status OpenSSL::decrypt_aes256gcm(
     output->advance_size((uint64_t)output_len);
   output->advance_offset((uint64_t)output_len);
 
-  // Clean up.
-  EVP_CIPHER_CTX_free(ctx);
-
   return Status::Ok();
 }
 
@@ -0,0 +1,422 @@
+/**
+ * @file   io_uring.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class IOUring.
+ */
+
+#ifndef _WIN32
+
+#include "tiledb/sm/filesystem/io_uring.h"
+#include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/stats.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+
+#ifdef HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#endif
+
+namespace tiledb {
+namespace sm {
+
+#ifdef HAVE_IO_URING
+
+/** The maximum number of bytes submitted in a single read operation. */
+static const uint64_t io_uring_max_read_bytes = 1ULL << 30;
+
+static int io_uring_setup(unsigned entries, struct io_uring_params* params) {
+  return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int io_uring_enter(
+    int ring_fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+  return (int)syscall(
+      __NR_io_uring_enter,
+      ring_fd,
+      to_submit,
+      min_complete,
+      flags,
+      nullptr,
+      0);
+}
+
+#endif
+
+/* ********************************* */
+/*     CONSTRUCTORS & DESTRUCTORS    */
+/* ********************************* */
+
+IOUring::IOUring()
+    : ring_fd_(-1)
+    , sq_entries_(0)
+    , sq_ring_(nullptr)
+    , sq_ring_size_(0)
+    , cq_ring_(nullptr)
+    , cq_ring_size_(0)
+    , sqes_(nullptr)
+    , sqes_size_(0)
+    , sq_head_(nullptr)
+    , sq_tail_(nullptr)
+    , sq_mask_(nullptr)
+    , sq_array_(nullptr)
+    , cq_head_(nullptr)
+    , cq_tail_(nullptr)
+    , cq_mask_(nullptr)
+    , cqes_(nullptr) {
+}
+
+IOUring::~IOUring() {
+  destroy();
+}
+
+/* ********************************* */
+/*                API                */
+/* ********************************* */
+
+#ifdef HAVE_IO_URING
+
+Status IOUring::init(unsigned queue_depth) {
+  destroy();
+
+  struct io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+  ring_fd_ = io_uring_setup(queue_depth, &params);
+  if (ring_fd_ < 0) {
+    ring_fd_ = -1;
+    return LOG_STATUS(Status::IOError(
+        std::string("Cannot set up io_uring; ") + strerror(errno)));
+  }
+  sq_entries_ = params.sq_entries;
+
+  // Map the submission and completion queue rings
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size_ =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  bool single_mmap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+  single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+#endif
+  if (single_mmap)
+    sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+
+  void* ptr = mmap(
+      nullptr,
+      sq_ring_size_,
+      PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE,
+      ring_fd_,
+      IORING_OFF_SQ_RING);
+  if (ptr == MAP_FAILED) {
+    destroy();
+    return LOG_STATUS(Status::IOError(
+        std::string("Cannot map io_uring submission queue; ") +
+        strerror(errno)));
+  }
+  sq_ring_ = ptr;
+
+  if (single_mmap) {
+    cq_ring_ = sq_ring_;
+  } else {
+    ptr = mmap(
+        nullptr,
+        cq_ring_size_,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE,
+        ring_fd_,
+        IORING_OFF_CQ_RING);
+    if (ptr == MAP_FAILED) {
+      destroy();
+      return LOG_STATUS(Status::IOError(
+          std::string("Cannot map io_uring completion queue; ") +
+          strerror(errno)));
+    }
+    cq_ring_ = ptr;
+  }
+
+  // Map the submission queue entries
+  sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+  ptr = mmap(
+      nullptr,
+      sqes_size_,
+      PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE,
+      ring_fd_,
+      IORING_OFF_SQES);
+  if (ptr == MAP_FAILED) {
+    destroy();
+    return LOG_STATUS(Status::IOError(
+        std::string("Cannot map io_uring submission entries; ") +
+        strerror(errno)));
+  }
+  sqes_ = ptr;
+
+  auto sq = static_cast<char*>(sq_ring_);
+  sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  sq_mask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+  auto cq = static_cast<char*>(cq_ring_);
+  cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  cq_mask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  cqes_ = cq + params.cq_off.cqes;
+
+  return Status::Ok();
+}
+
+Status IOUring::read(
+    int fd, const std::vector<std::tuple<uint64_t, void*, uint64_t>>& regions) {
+  if (ring_fd_ == -1)
+    return LOG_STATUS(
+        Status::IOError("Cannot read with io_uring; Ring is not set up"));
+
+  // The remaining part of each region, along with its (stable) iovec
+  struct PendingRead {
+    uint64_t offset_;
+    char* buffer_;
+    uint64_t nbytes_;
+    struct iovec iov_;
+  };
+  std::vector<PendingRead> reads(regions.size());
+  std::vector<uint64_t> queue;
+  queue.reserve(regions.size());
+  for (uint64_t i = 0; i < regions.size(); ++i) {
+    reads[i].offset_ = std::get<0>(regions[i]);
+    reads[i].buffer_ = static_cast<char*>(std::get<1>(regions[i]));
+    reads[i].nbytes_ = std::get<2>(regions[i]);
+    if (reads[i].nbytes_ > 0)
+      queue.push_back(i);
+  }
+  std::reverse(queue.begin(), queue.end());
+
+  auto sqes = static_cast<struct io_uring_sqe*>(sqes_);
+  auto cqes = static_cast<struct io_uring_cqe*>(cqes_);
+  unsigned unsubmitted = 0;
+  uint64_t inflight = 0;
+  Status st;
+
+  while (!queue.empty() || inflight > 0) {
+    // Fill as many submission entries as there are free slots
+    unsigned tail = *sq_tail_;
+    while (!queue.empty() && inflight + unsubmitted < sq_entries_) {
+      uint64_t idx = queue.back();
+      queue.pop_back();
+      auto& r = reads[idx];
+      r.iov_.iov_base = r.buffer_;
+      r.iov_.iov_len = (size_t)std::min(r.nbytes_, io_uring_max_read_bytes);
+
+      unsigned slot = tail & *sq_mask_;
+      struct io_uring_sqe* sqe = &sqes[slot];
+      std::memset(sqe, 0, sizeof(*sqe));
+      sqe->opcode = IORING_OP_READV;
+      sqe->fd = fd;
+      sqe->off = r.offset_;
+      sqe->addr = (uint64_t)(uintptr_t)&r.iov_;
+      sqe->len = 1;
+      sqe->user_data = idx;
+      sq_array_[slot] = slot;
+      ++tail;
+      ++unsubmitted;
+    }
+    __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+
+    // Submit and wait for at least one completion
+    int ret;
+    do {
+      ret = io_uring_enter(ring_fd_, unsubmitted, 1, IORING_ENTER_GETEVENTS);
+    } while (ret < 0 && errno == EINTR);
+    if (ret < 0) {
+      int err = errno;
+      bool waiting = (unsubmitted == 0);
+      if (st.ok())
+        st = LOG_STATUS(Status::IOError(
+            std::string("Cannot submit io_uring reads; ") + strerror(err)));
+
+      // Retract the entries the kernel has not consumed, and only wait for
+      // the in-flight reads
+      __atomic_store_n(sq_tail_, tail - unsubmitted, __ATOMIC_RELEASE);
+      unsubmitted = 0;
+      queue.clear();
+      if (inflight == 0)
+        return st;
+
+      // The in-flight reads still write through `reads` into the caller's
+      // buffers, so they must complete before returning. If even waiting
+      // fails for a reason other than a transient one, tear down the ring
+      // so that its stale completions are never reaped by another read.
+      if (waiting && err != EAGAIN && err != EBUSY) {
+        destroy();
+        return st;
+      }
+    } else {
+      unsubmitted -= (unsigned)ret;
+      inflight += (uint64_t)ret;
+      STATS_COUNTER_ADD(vfs_posix_io_uring_num_submissions, 1);
+    }
+
+    // Reap all available completions
+    unsigned head = *cq_head_;
+    unsigned cq_tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    for (; head != cq_tail; ++head) {
+      struct io_uring_cqe* cqe = &cqes[head & *cq_mask_];
+      uint64_t idx = cqe->user_data;
+      int res = cqe->res;
+      auto& r = reads[idx];
+      --inflight;
+
+      if (res == -EINTR || res == -EAGAIN) {
+        queue.push_back(idx);
+      } else if (res == -EINVAL || res == -EOPNOTSUPP) {
+        // The kernel cannot service this read; fall back to pread
+        while (r.nbytes_ > 0) {
+          ssize_t n = ::pread(fd, r.buffer_, r.nbytes_, r.offset_);
+          if (n <= 0) {
+            st = LOG_STATUS(Status::IOError(
+                std::string("POSIX pread error: ") + strerror(errno)));
+            break;
+          }
+          r.offset_ += n;
+          r.buffer_ += n;
+          r.nbytes_ -= n;
+        }
+      } else if (res < 0) {
+        st = LOG_STATUS(Status::IOError(
+            std::string("io_uring read error: ") + strerror(-res)));
+      } else if (res == 0) {
+        st = LOG_STATUS(Status::IOError(
+            "io_uring read error: Unexpected end of file"));
+      } else {
+        r.offset_ += res;
+        r.buffer_ += res;
+        r.nbytes_ -= res;
+        if (r.nbytes_ > 0)
+          queue.push_back(idx);
+      }
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+
+    // On error, only drain the in-flight reads
+    if (!st.ok())
+      queue.clear();
+  }
+
+  return st;
+}
+
+bool IOUring::is_set_up() const {
+  return ring_fd_ != -1;
+}
+
+bool IOUring::is_supported() {
+  static std::once_flag probed;
+  static bool supported = false;
+  std::call_once(probed, []() {
+    struct io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    int ring_fd = io_uring_setup(1, &params);
+    if (ring_fd >= 0) {
+      supported = true;
+      ::close(ring_fd);
+    }
+  });
+  return supported;
+}
+
+#else
+
+Status IOUring::init(unsigned queue_depth) {
+  (void)queue_depth;
+  return LOG_STATUS(
+      Status::IOError("Cannot set up io_uring; TileDB was built without "
+                      "io_uring support"));
+}
+
+Status IOUring::read(
+    int fd, const std::vector<std::tuple<uint64_t, void*, uint64_t>>& regions) {
+  (void)fd;
+  (void)regions;
+  return LOG_STATUS(Status::IOError(
+      "Cannot read with io_uring; TileDB was built without io_uring support"));
+}
+
+bool IOUring::is_set_up() const {
+  return false;
+}
+
+bool IOUring::is_supported() {
+  return false;
+}
+
+#endif
+
+/* ********************************* */
+/*          PRIVATE METHODS          */
+/* ********************************* */
+
+void IOUring::destroy() {
+#ifdef HAVE_IO_URING
+  if (sqes_ != nullptr)
+    munmap(sqes_, sqes_size_);
+  if (cq_ring_ != nullptr && cq_ring_ != sq_ring_)
+    munmap(cq_ring_, cq_ring_size_);
+  if (sq_ring_ != nullptr)
+    munmap(sq_ring_, sq_ring_size_);
+#endif
+  if (ring_fd_ != -1)
+    ::close(ring_fd_);
+
+  ring_fd_ = -1;
+  sq_entries_ = 0;
+  sq_ring_ = nullptr;
+  cq_ring_ = nullptr;
+  sqes_ = nullptr;
+  sq_head_ = sq_tail_ = sq_mask_ = sq_array_ = nullptr;
+  cq_head_ = cq_tail_ = cq_mask_ = nullptr;
+  cqes_ = nullptr;
+}
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // !_WIN32
@@ -0,0 +1,164 @@
+/**
+ * @file   io_uring.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares class IOUring.
+ */
+
+#ifndef TILEDB_IO_URING_H
+#define TILEDB_IO_URING_H
+
+#ifndef _WIN32
+
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+#include "tiledb/sm/misc/status.h"
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A minimal Linux io_uring instance, used by the POSIX backend to submit a
+ * set of positional reads with a single system call and wait for all of
+ * them to complete. If TileDB was built without io_uring support (i.e.,
+ * `HAVE_IO_URING` is not defined), `init` always fails and the caller is
+ * expected to fall back to `pread`.
+ *
+ * An instance is not thread-safe; each thread must use its own ring.
+ */
+class IOUring {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  IOUring();
+
+  /** Destructor. Tears down the ring. */
+  ~IOUring();
+
+  IOUring(const IOUring&) = delete;
+  IOUring& operator=(const IOUring&) = delete;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Sets up the ring.
+   *
+   * @param queue_depth The number of submission queue entries.
+   * @return Status
+   */
+  Status init(unsigned queue_depth);
+
+  /**
+   * Reads the input regions from an open file, submitting as many reads as
+   * the queue depth allows at a time, and blocks until all of them have
+   * completed. Short reads are resubmitted for the remaining bytes. If the
+   * kernel does not support the read operation, the affected regions are
+   * read with `pread`. On error, it still waits for all submitted reads to
+   * complete; if that is impossible, the ring is torn down and
+   * `is_set_up()` returns `false`.
+   *
+   * @param fd The open file descriptor to read from.
+   * @param regions The regions to read, as tuples of the form
+   *     (file offset, destination buffer, number of bytes).
+   * @return Status
+   */
+  Status read(
+      int fd,
+      const std::vector<std::tuple<uint64_t, void*, uint64_t>>& regions);
+
+  /** Returns `true` if the ring is set up and can be used for reads. */
+  bool is_set_up() const;
+
+  /**
+   * Returns `true` if io_uring rings can be set up on this system. The
+   * result is computed once per process.
+   */
+  static bool is_supported();
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The ring file descriptor (-1 if the ring is not set up). */
+  int ring_fd_;
+
+  /** The number of submission queue entries. */
+  unsigned sq_entries_;
+
+  /** The mapped submission queue ring. */
+  void* sq_ring_;
+
+  /** The size of the mapped submission queue ring. */
+  size_t sq_ring_size_;
+
+  /** The mapped completion queue ring (may alias `sq_ring_`). */
+  void* cq_ring_;
+
+  /** The size of the mapped completion queue ring. */
+  size_t cq_ring_size_;
+
+  /** The mapped submission queue entries. */
+  void* sqes_;
+
+  /** The size of the mapped submission queue entries. */
+  size_t sqes_size_;
+
+  /** Submission queue head, tail, mask and index array. */
+  unsigned* sq_head_;
+  unsigned* sq_tail_;
+  unsigned* sq_mask_;
+  unsigned* sq_array_;
+
+  /** Completion queue head, tail, mask and entries. */
+  unsigned* cq_head_;
+  unsigned* cq_tail_;
+  unsigned* cq_mask_;
+  void* cqes_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Unmaps the rings and closes the ring file descriptor. */
+  void destroy();
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // !_WIN32
+
+#endif  // TILEDB_IO_URING_H
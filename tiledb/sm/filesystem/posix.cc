@@ -44,12 +44,40 @@
 
 #include <ftw.h>
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+
+#include <cstring>
 #include <fstream>
 #include <iostream>
 
 namespace tiledb {
 namespace sm {
 
+/* ********************************* */
+/*     CONSTRUCTORS & DESTRUCTORS    */
+/* ********************************* */
+
+Posix::Posix()
+    : vfs_thread_pool_(nullptr)
+    , io_uring_failed_(false) {
+}
+
+Posix::~Posix() {
+  clear_open_files();
+}
+
+Posix::OpenFile::~OpenFile() {
+  if (map_ != nullptr)
+    munmap(map_, size_);
+  ::close(fd_);
+}
+
+/* ********************************* */
+/*                API                */
+/* ********************************* */
+
 bool Posix::both_slashes(char a, char b) {
   return a == '/' && b == '/';
 }
@@ -73,6 +101,35 @@ uint64_t Posix::read_all(
   return nread;
 }
 
+Status Posix::preadv_all(
+    int fd, std::vector<struct iovec>* iovs, uint64_t offset) {
+  size_t first = 0;
+  while (first < iovs->size()) {
+    ssize_t n = ::preadv(
+        fd, &(*iovs)[first], (int)(iovs->size() - first), (off_t)offset);
+    if (n == -1 && errno == EINTR)
+      continue;
+    if (n <= 0) {
+      return LOG_STATUS(Status::IOError(
+          std::string("POSIX preadv error: ") +
+          ((n == 0) ? "Unexpected end of file" : strerror(errno))));
+    }
+
+    // Advance past the fully read buffers, and trim a partially read one
+    offset += n;
+    auto remaining = (size_t)n;
+    while (first < iovs->size() && remaining >= (*iovs)[first].iov_len)
+      remaining -= (*iovs)[first++].iov_len;
+    if (remaining > 0) {
+      auto& iov = (*iovs)[first];
+      iov.iov_base = static_cast<char*>(iov.iov_base) + remaining;
+      iov.iov_len -= remaining;
+    }
+  }
+
+  return Status::Ok();
+}
+
 uint64_t Posix::pwrite_all(
     int fd, uint64_t file_offset, const void* buffer, uint64_t nbytes) {
   auto bytes = reinterpret_cast<const char*>(buffer);
@@ -190,6 +247,7 @@ int Posix::unlink_cb(
 }
 
 Status Posix::remove_dir(const std::string& path) const {
+  invalidate_open_files(path);
   int rc = nftw(path.c_str(), unlink_cb, 64, FTW_DEPTH | FTW_PHYS);
   if (rc)
     return LOG_STATUS(Status::IOError(
@@ -199,6 +257,7 @@ Status Posix::remove_dir(const std::string& path) const {
 }
 
 Status Posix::remove_file(const std::string& path) const {
+  invalidate_open_files(path);
   if (remove(path.c_str()) != 0) {
     return LOG_STATUS(Status::IOError(
         std::string("Cannot delete file '") + path + "'; " + strerror(errno)));
@@ -249,6 +308,45 @@ Status Posix::filelock_lock(
   return Status::Ok();
 }
 
+Status Posix::filelock_try_lock(
+    const std::string& filename,
+    filelock_t* fd,
+    bool shared,
+    bool* locked) const {
+  *locked = false;
+
+  // Prepare the flock struct
+  struct flock fl;
+  memset(&fl, 0, sizeof(struct flock));
+  if (shared)
+    fl.l_type = F_RDLCK;
+  else
+    fl.l_type = F_WRLCK;
+  fl.l_whence = SEEK_SET;
+  fl.l_start = 0;
+  fl.l_len = 0;
+  fl.l_pid = getpid();
+
+  // Open the file
+  *fd = ::open(filename.c_str(), O_RDWR);
+  if (*fd == -1) {
+    return LOG_STATUS(Status::IOError(
+        "Cannot open filelock '" + filename + "'; " + strerror(errno)));
+  }
+  // Acquire the lock, without waiting for other processes
+  if (fcntl(*fd, F_SETLK, &fl) == -1) {
+    int err = errno;
+    ::close(*fd);
+    *fd = INVALID_FILELOCK;
+    if (err == EACCES || err == EAGAIN)
+      return Status::Ok();
+    return LOG_STATUS(Status::IOError(
+        "Cannot lock filelock '" + filename + "'; " + strerror(err)));
+  }
+  *locked = true;
+  return Status::Ok();
+}
+
 Status Posix::filelock_unlock(filelock_t fd) const {
   if (::close(fd) == -1)
     return LOG_STATUS(Status::IOError(
@@ -265,6 +363,7 @@ Status Posix::init(
 
   vfs_params_ = vfs_params;
   vfs_thread_pool_ = vfs_thread_pool;
+  clear_open_files();
 
   return Status::Ok();
 }
@@ -304,6 +403,8 @@ Status Posix::ls(
 
 Status Posix::move_path(
     const std::string& old_path, const std::string& new_path) {
+  invalidate_open_files(old_path);
+  invalidate_open_files(new_path);
   if (rename(old_path.c_str(), new_path.c_str()) != 0) {
     return LOG_STATUS(
         Status::IOError(std::string("Cannot move path: ") + strerror(errno)));
@@ -370,19 +471,14 @@ Status Posix::read(
     uint64_t offset,
     void* buffer,
     uint64_t nbytes) const {
+  // Open file (or retrieve it from the open file cache)
+  std::shared_ptr<OpenFile> file;
+  RETURN_NOT_OK(open_read(path, &file));
+
   // Checks
-  uint64_t file_size;
-  RETURN_NOT_OK(this->file_size(path, &file_size));
-  if (offset + nbytes > file_size)
+  if (offset + nbytes > file->size_)
     return LOG_STATUS(
         Status::IOError("Cannot read from file; Read exceeds file size"));
-
-  // Open file
-  int fd = open(path.c_str(), O_RDONLY);
-  if (fd == -1) {
-    return LOG_STATUS(Status::IOError(
-        std::string("Cannot read from file; ") + strerror(errno)));
-  }
   if (offset > std::numeric_limits<off_t>::max()) {
     return LOG_STATUS(Status::IOError(
         std::string("Cannot read from file ' ") + path.c_str() +
@@ -393,20 +489,191 @@ Status Posix::read(
         std::string("Cannot read from file ' ") + path.c_str() +
         "'; nbytes > SSIZE_MAX"));
   }
-  uint64_t bytes_read = read_all(fd, buffer, nbytes, offset);
+  if (file->map_ != nullptr) {
+    STATS_COUNTER_ADD(vfs_posix_mmap_num_reads, 1);
+    std::memcpy(buffer, static_cast<char*>(file->map_) + offset, nbytes);
+    return Status::Ok();
+  }
+  uint64_t bytes_read = read_all(file->fd_, buffer, nbytes, offset);
   if (bytes_read != nbytes) {
     return LOG_STATUS(Status::IOError(
         std::string("Cannot read from file '") + path.c_str() +
         "'; File reading error"));
   }
-  // Close file
-  if (close(fd)) {
+  return Status::Ok();
+}
+
+Status Posix::read_scatter(
+    const std::string& path,
+    uint64_t offset,
+    const std::vector<std::pair<void*, uint64_t>>& buffers) const {
+  // Open file (or retrieve it from the open file cache)
+  std::shared_ptr<OpenFile> file;
+  RETURN_NOT_OK(open_read(path, &file));
+
+  // Checks
+  uint64_t nbytes = 0;
+  for (const auto& buffer : buffers)
+    nbytes += buffer.second;
+  if (offset + nbytes > file->size_)
+    return LOG_STATUS(
+        Status::IOError("Cannot read from file; Read exceeds file size"));
+  if (offset + nbytes > (uint64_t)std::numeric_limits<off_t>::max()) {
     return LOG_STATUS(Status::IOError(
-        std::string("Cannot read from file; ") + strerror(errno)));
+        std::string("Cannot read from file ' ") + path.c_str() +
+        "'; offset > typemax(off_t)"));
+  }
+
+  // Copy from the mapped file
+  if (file->map_ != nullptr) {
+    STATS_COUNTER_ADD(vfs_posix_mmap_num_reads, 1);
+    auto src = static_cast<const char*>(file->map_) + offset;
+    for (const auto& buffer : buffers) {
+      if (buffer.first != nullptr)
+        std::memcpy(buffer.first, src, buffer.second);
+      src += buffer.second;
+    }
+    return Status::Ok();
+  }
+
+  // Small gaps are read into a scratch page, shared by all gaps
+  std::vector<char> scratch;
+
+  std::vector<struct iovec> iovs;
+  iovs.reserve(std::min<size_t>(buffers.size(), IOV_MAX));
+  uint64_t iovs_offset = offset, iovs_nbytes = 0;
+  for (size_t i = 0; i <= buffers.size(); ++i) {
+    bool last = (i == buffers.size());
+    void* dest = last ? nullptr : buffers[i].first;
+    uint64_t len = last ? 0 : buffers[i].second;
+    bool skip = dest == nullptr &&
+                (last || len > constants::vfs_file_scatter_scratch_size);
+
+    // Issue the pending vectored read before skipping a large gap, or when
+    // there is no room left for more buffers
+    if ((skip || iovs.size() == IOV_MAX ||
+         iovs_nbytes + len > (uint64_t)SSIZE_MAX) &&
+        !iovs.empty()) {
+      RETURN_NOT_OK(preadv_all(file->fd_, &iovs, iovs_offset));
+      iovs_offset += iovs_nbytes;
+      iovs_nbytes = 0;
+      iovs.clear();
+    }
+
+    if (skip) {
+      iovs_offset += len;
+    } else if (len > 0) {
+      struct iovec iov;
+      if (dest == nullptr && scratch.empty())
+        scratch.resize(constants::vfs_file_scatter_scratch_size);
+      iov.iov_base = (dest == nullptr) ? scratch.data() : dest;
+      iov.iov_len = (size_t)len;
+      iovs.push_back(iov);
+      iovs_nbytes += len;
+    }
+  }
+
+  STATS_COUNTER_ADD(vfs_posix_read_scatter_num_buffers, buffers.size());
+  return Status::Ok();
+}
+
+Status Posix::read_io_uring(
+    const std::string& path,
+    const std::vector<std::tuple<uint64_t, void*, uint64_t>>& regions) const {
+  // Open file (or retrieve it from the open file cache)
+  std::shared_ptr<OpenFile> file;
+  RETURN_NOT_OK(open_read(path, &file));
+
+  // Checks
+  for (const auto& region : regions) {
+    if (std::get<0>(region) + std::get<2>(region) > file->size_)
+      return LOG_STATUS(
+          Status::IOError("Cannot read from file; Read exceeds file size"));
+  }
+
+  // Take an idle ring, or set up a new one
+  std::unique_ptr<IOUring> ring;
+  {
+    std::unique_lock<std::mutex> lck(io_urings_mtx_);
+    if (!io_urings_.empty()) {
+      ring = std::move(io_urings_.back());
+      io_urings_.pop_back();
+    }
+  }
+  if (ring == nullptr && !io_uring_failed_) {
+    ring.reset(new IOUring());
+    if (!ring->init(constants::vfs_file_io_uring_queue_depth).ok()) {
+      // The ring could not be set up (e.g., due to RLIMIT_MEMLOCK). This is
+      // remembered, so that later reads do not try (and log) again.
+      io_uring_failed_ = true;
+      ring.reset(nullptr);
+    }
+  }
+
+  // Read the regions with pread if there is no ring
+  if (ring == nullptr) {
+    for (const auto& region : regions) {
+      uint64_t offset = std::get<0>(region);
+      uint64_t nbytes = std::get<2>(region);
+      if (read_all(file->fd_, std::get<1>(region), nbytes, offset) != nbytes) {
+        return LOG_STATUS(Status::IOError(
+            std::string("Cannot read from file '") + path.c_str() +
+            "'; File reading error"));
+      }
+    }
+    return Status::Ok();
+  }
+
+  STATS_COUNTER_ADD(vfs_posix_io_uring_num_regions, regions.size());
+  Status st = ring->read(file->fd_, regions);
+
+  // Return the ring, unless it had to be torn down
+  if (ring->is_set_up()) {
+    std::unique_lock<std::mutex> lck(io_urings_mtx_);
+    io_urings_.push_back(std::move(ring));
+  }
+
+  if (!st.ok()) {
+    return LOG_STATUS(Status::IOError(
+        std::string("Cannot read from file '") + path.c_str() + "'; " +
+        st.message()));
   }
   return Status::Ok();
 }
 
+Status Posix::read_mapped(
+    const std::string& path,
+    uint64_t offset,
+    uint64_t nbytes,
+    const void** data,
+    std::shared_ptr<void>* owner) const {
+  *data = nullptr;
+  if (!vfs_params_.file_params_.enable_mmap_)
+    return Status::Ok();
+
+  // Open file (or retrieve it from the open file cache)
+  std::shared_ptr<OpenFile> file;
+  RETURN_NOT_OK(open_read(path, &file));
+  if (file->map_ == nullptr)
+    return Status::Ok();
+
+  // Checks
+  if (offset + nbytes > file->size_)
+    return LOG_STATUS(
+        Status::IOError("Cannot read from file; Read exceeds file size"));
+
+  *data = static_cast<const char*>(file->map_) + offset;
+  *owner = file;
+
+  return Status::Ok();
+}
+
+bool Posix::use_io_uring() const {
+  return vfs_params_.file_params_.enable_io_uring_ &&
+         !vfs_params_.file_params_.enable_mmap_ && !io_uring_failed_ &&
+         IOUring::is_supported();
+}
+
 Status Posix::sync(const std::string& path) {
   // Open file
   int fd = -1;
@@ -443,16 +710,28 @@ Status Posix::sync(const std::string& path) {
 
 Status Posix::write(
     const std::string& path, const void* buffer, uint64_t buffer_size) {
-  Status st;
   uint64_t file_offset = 0;
   if (is_file(path)) {
-    st = file_size(path, &file_offset);
+    auto st = file_size(path, &file_offset);
     if (!st.ok()) {
       std::stringstream errmsg;
       errmsg << "Cannot write to file '" << path << "'; " << st.message();
       return LOG_STATUS(Status::IOError(errmsg.str()));
     }
   }
+
+  return write(path, file_offset, buffer, buffer_size);
+}
+
+Status Posix::write(
+    const std::string& path,
+    uint64_t file_offset,
+    const void* buffer,
+    uint64_t buffer_size) {
+  // Writing changes the file contents, so any cached open file is stale
+  invalidate_open_files(path);
+
+  Status st;
   // Open or create file.
   int fd = open(path.c_str(), O_WRONLY | O_CREAT, S_IRWXU);
   if (fd == -1) {
@@ -504,6 +783,100 @@ Status Posix::write(
   return st;
 }
 
+/* ********************************* */
+/*          PRIVATE METHODS          */
+/* ********************************* */
+
+void Posix::clear_open_files() const {
+  std::unique_lock<std::mutex> lck(open_files_mtx_);
+  open_files_map_.clear();
+  open_files_ll_.clear();
+}
+
+void Posix::invalidate_open_files(const std::string& path) const {
+  std::unique_lock<std::mutex> lck(open_files_mtx_);
+  if (open_files_map_.empty())
+    return;
+
+  std::string dir_prefix = path + "/";
+  for (auto it = open_files_map_.begin(); it != open_files_map_.end();) {
+    if (it->first == path || utils::parse::starts_with(it->first, dir_prefix)) {
+      open_files_ll_.erase(it->second.second);
+      it = open_files_map_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+Status Posix::open_read(
+    const std::string& path, std::shared_ptr<OpenFile>* file) const {
+  uint64_t max_open_handles = vfs_params_.file_params_.max_open_handles_;
+
+  // Check the cache
+  if (max_open_handles > 0) {
+    std::unique_lock<std::mutex> lck(open_files_mtx_);
+    auto it = open_files_map_.find(path);
+    if (it != open_files_map_.end()) {
+      STATS_COUNTER_ADD(vfs_posix_open_file_cache_hits, 1);
+      open_files_ll_.splice(
+          open_files_ll_.end(), open_files_ll_, it->second.second);
+      *file = it->second.first;
+      return Status::Ok();
+    }
+  }
+
+  STATS_COUNTER_ADD(vfs_posix_open_file_cache_misses, 1);
+
+  // Open the file and get its size outside the lock
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd == -1) {
+    return LOG_STATUS(Status::IOError(
+        std::string("Cannot read from file; ") + strerror(errno)));
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    ::close(fd);
+    return LOG_STATUS(Status::IOError(
+        "Cannot get file size of '" + path + "'; " + strerror(errno)));
+  }
+  auto size = (uint64_t)st.st_size;
+
+  // Map the whole file if enabled. If mapping fails, the file is read with
+  // regular reads.
+  void* map = nullptr;
+  if (vfs_params_.file_params_.enable_mmap_ && size > 0) {
+    map = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+      LOG_STATUS(Status::IOError(
+          "Cannot map file '" + path + "'; " + strerror(errno)));
+      map = nullptr;
+    } else {
+      STATS_COUNTER_ADD(vfs_posix_mmap_num_files, 1);
+    }
+  }
+  file->reset(new OpenFile(fd, size, map));
+
+  if (max_open_handles == 0)
+    return Status::Ok();
+
+  // Insert in the cache, unless another thread opened the file meanwhile
+  std::unique_lock<std::mutex> lck(open_files_mtx_);
+  auto it = open_files_map_.find(path);
+  if (it != open_files_map_.end()) {
+    *file = it->second.first;
+    return Status::Ok();
+  }
+  while (open_files_map_.size() >= max_open_handles) {
+    open_files_map_.erase(open_files_ll_.front());
+    open_files_ll_.pop_front();
+  }
+  auto node = open_files_ll_.insert(open_files_ll_.end(), path);
+  open_files_map_[path] = std::make_pair(*file, node);
+
+  return Status::Ok();
+}
+
 Status Posix::write_at(
     int fd, uint64_t file_offset, const void* buffer, uint64_t buffer_size) {
   // Append data to the file in batches of constants::max_write_bytes
@@ -37,12 +37,19 @@
 
 #include <ftw.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/filesystem/filelock.h"
+#include "tiledb/sm/filesystem/io_uring.h"
 #include "tiledb/sm/misc/status.h"
 #include "tiledb/sm/misc/thread_pool.h"
 #include "tiledb/sm/misc/uri.h"
@@ -56,6 +63,20 @@ namespace sm {
  */
 class Posix {
  public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. */
+  Posix();
+
+  /** Destructor. */
+  ~Posix();
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
   /**
    * Returns the absolute posix (string) path of the input in the
    * form "file://<absolute path>"
@@ -126,6 +147,23 @@ class Posix {
   Status filelock_lock(
       const std::string& filename, filelock_t* fd, bool shared) const;
 
+  /**
+   * Lock a given filename like `filelock_lock`, but without waiting if
+   * another process holds the lock in a conflicting mode.
+   *
+   * @param filename The filelock to lock
+   * @param fd A pointer to a file descriptor
+   * @param shared *True* if this is a shared lock, *false* if it is an
+   * exclusive lock.
+   * @param locked Set to *true* if the filelock got locked.
+   * @return Status
+   */
+  Status filelock_try_lock(
+      const std::string& filename,
+      filelock_t* fd,
+      bool shared,
+      bool* locked) const;
+
   /**
    * Unlock an opened file descriptor
    *
@@ -193,6 +231,67 @@ class Posix {
       void* buffer,
       uint64_t nbytes) const;
 
+  /**
+   * Reads a contiguous range of a file directly into a list of buffers,
+   * using vectored reads. A buffer that is `nullptr` denotes bytes that are
+   * not needed; small such gaps are read into a scratch page, whereas
+   * larger ones are skipped by starting a new read.
+   *
+   * @param path The name of the file.
+   * @param offset The offset in the file from which the read will start.
+   * @param buffers The (buffer, nbytes) list into which the consecutive
+   *     bytes of the file are read.
+   * @return Status.
+   */
+  Status read_scatter(
+      const std::string& path,
+      uint64_t offset,
+      const std::vector<std::pair<void*, uint64_t>>& buffers) const;
+
+  /**
+   * Reads a set of regions from a file with a single io_uring submission
+   * (as far as the ring queue depth allows), blocking until all regions are
+   * read. This must be called only if `use_io_uring()` is `true`. If a ring
+   * cannot be set up, the regions are read with `pread` instead, and so are
+   * all later reads.
+   *
+   * @param path The name of the file.
+   * @param regions The regions to read, as tuples of the form
+   *     (file offset, destination buffer, number of bytes).
+   * @return Status
+   */
+  Status read_io_uring(
+      const std::string& path,
+      const std::vector<std::tuple<uint64_t, void*, uint64_t>>& regions) const;
+
+  /**
+   * Retrieves a pointer to a region of a memory-mapped file, so that it can
+   * be used without any copy. If `vfs.file.enable_mmap` is not set or the
+   * file could not be mapped, `*data` is set to `nullptr`.
+   *
+   * @param path The name of the file.
+   * @param offset The offset of the region in the file.
+   * @param nbytes The size of the region.
+   * @param data Set to the start of the region in the mapped file.
+   * @param owner Set to a handle that keeps the mapping valid for as long as
+   *     it is held.
+   * @return Status
+   */
+  Status read_mapped(
+      const std::string& path,
+      uint64_t offset,
+      uint64_t nbytes,
+      const void** data,
+      std::shared_ptr<void>* owner) const;
+
+  /**
+   * Returns `true` if `vfs.file.enable_io_uring` is set, io_uring is
+   * supported by this build and the running kernel, and reads are not served
+   * from mapped files instead (i.e., `vfs.file.enable_mmap` is not set).
+   * It becomes `false` once a ring fails to be set up.
+   */
+  bool use_io_uring() const;
+
   /**
    * Syncs a file or directory.
    *
@@ -215,17 +314,125 @@ class Posix {
   Status write(
       const std::string& path, const void* buffer, uint64_t buffer_size);
 
+  /**
+   * Writes the input buffer to a file at the input offset, creating the file
+   * if it does not exist. Multiple threads can safely write disjoint regions
+   * of the same file concurrently.
+   *
+   * @param path The name of the file.
+   * @param offset The offset in the file at which to start writing.
+   * @param buffer The input buffer.
+   * @param buffer_size The size of the input buffer.
+   * @return Status
+   */
+  Status write(
+      const std::string& path,
+      uint64_t offset,
+      const void* buffer,
+      uint64_t buffer_size);
+
  private:
+  /* ********************************* */
+  /*          TYPE DEFINITIONS         */
+  /* ********************************* */
+
+  /**
+   * A read-only file descriptor along with the size of the file at the time
+   * it was opened, and optionally a read-only mapping of the whole file. The
+   * descriptor is closed (and the file unmapped) upon destruction, i.e., when
+   * the last reader holding it releases it.
+   */
+  struct OpenFile {
+    /** The open read-only file descriptor. */
+    int fd_;
+    /** The file size. */
+    uint64_t size_;
+    /** The mapped file contents, or `nullptr` if the file is not mapped. */
+    void* map_;
+
+    /** Constructor. */
+    OpenFile(int fd, uint64_t size, void* map)
+        : fd_(fd)
+        , size_(size)
+        , map_(map) {
+    }
+
+    /** Destructor. Unmaps the file and closes the file descriptor. */
+    ~OpenFile();
+  };
+
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
   /** Config parameters from parent VFS instance. */
   Config::VFSParams vfs_params_;
 
   /** Thread pool from parent VFS instance. */
   ThreadPool* vfs_thread_pool_;
 
+  /**
+   * LRU list of the paths with a cached open file. The head of the list is
+   * the next path to be evicted.
+   */
+  mutable std::list<std::string> open_files_ll_;
+
+  /** Maps a path to its cached open file and its node in `open_files_ll_`. */
+  mutable std::unordered_map<
+      std::string,
+      std::pair<
+          std::shared_ptr<OpenFile>,
+          std::list<std::string>::iterator>>
+      open_files_map_;
+
+  /** Protects `open_files_ll_` and `open_files_map_`. */
+  mutable std::mutex open_files_mtx_;
+
+  /**
+   * Idle io_uring instances. A reading thread takes one (or sets up a new
+   * one) and returns it when done, so that rings are reused across reads.
+   */
+  mutable std::vector<std::unique_ptr<IOUring>> io_urings_;
+
+  /** Protects `io_urings_`. */
+  mutable std::mutex io_urings_mtx_;
+
+  /** Set when a ring fails to be set up, so that no other one is tried. */
+  mutable std::atomic<bool> io_uring_failed_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
   static void adjacent_slashes_dedup(std::string* path);
 
   static bool both_slashes(char a, char b);
 
+  /** Closes all cached open files. */
+  void clear_open_files() const;
+
+  /**
+   * Evicts the cached open files of `path`. If `path` is a directory, the
+   * open files of all the paths under it are evicted as well. Readers that
+   * still hold an evicted file keep using it until they release it.
+   *
+   * @param path The path whose cached open files will be evicted.
+   */
+  void invalidate_open_files(const std::string& path) const;
+
+  /**
+   * Retrieves a read-only open file for `path`, either from the open file
+   * cache, or by opening the file and inserting it in the cache. If the cache
+   * is disabled (`vfs.file.max_open_handles` is 0), the returned file is
+   * closed as soon as it is released.
+   *
+   * @param path The file to open.
+   * @param file Set to the open file.
+   * @return Status
+   */
+  Status open_read(
+      const std::string& path, std::shared_ptr<OpenFile>* file) const;
+
   /**
    * It takes as input an **absolute** path, and returns it in its canonicalized
    * form, after appropriately replacing "./" and "../" in the path.
@@ -251,6 +458,18 @@ class Posix {
   static uint64_t read_all(
       int fd, void* buffer, uint64_t nbytes, uint64_t offset);
 
+  /**
+   * Reads into all the given buffers from the given file descriptor with
+   * vectored reads, retrying as necessary.
+   *
+   * @param fd Open file descriptor to read from
+   * @param iovs The buffers to read into. They are modified while reading.
+   * @param offset Offset in file to start reading from.
+   * @return Status
+   */
+  static Status preadv_all(
+      int fd, std::vector<struct iovec>* iovs, uint64_t offset);
+
   static int unlink_cb(
       const char* fpath,
       const struct stat* sb,
@@ -392,6 +392,51 @@ Status VFS::filelock_lock(const URI& uri, filelock_t* fd, bool shared) const {
   STATS_FUNC_OUT(vfs_filelock_lock);
 }
 
+Status VFS::filelock_try_lock(
+    const URI& uri, filelock_t* fd, bool shared, bool* locked) const {
+  STATS_FUNC_IN(vfs_filelock_lock);
+
+  // Hold the lock while updating counts and performing the lock.
+  std::unique_lock<std::mutex> lck(filelock_mtx_);
+
+  // Only need to actually lock the file if this is the first one on the URI.
+  *locked = true;
+  if (incr_lock_count(uri)) {
+    return Status::Ok();
+  }
+
+  Status st;
+  if (uri.is_file()) {
+#ifdef _WIN32
+    st = win_.filelock_try_lock(uri.to_path(), fd, shared, locked);
+#else
+    st = posix_.filelock_try_lock(uri.to_path(), fd, shared, locked);
+#endif
+  } else if (uri.is_hdfs()) {
+#ifndef HAVE_HDFS
+    st = LOG_STATUS(Status::VFSError("TileDB was built without HDFS support"));
+#endif
+  } else if (uri.is_s3()) {
+#ifndef HAVE_S3
+    st = LOG_STATUS(Status::VFSError("TileDB was built without S3 support"));
+#endif
+  } else {
+    st = LOG_STATUS(
+        Status::VFSError("Unsupported URI scheme: " + uri.to_string()));
+  }
+
+  // Drop the count of a filelock that did not get locked
+  if (!st.ok() || !*locked) {
+    *locked = false;
+    bool is_zero = false;
+    RETURN_NOT_OK(decr_lock_count(uri, &is_zero));
+  }
+
+  return st;
+
+  STATS_FUNC_OUT(vfs_filelock_lock);
+}
+
 Status VFS::filelock_unlock(const URI& uri, filelock_t fd) const {
   STATS_FUNC_IN(vfs_filelock_unlock);
 
@@ -868,20 +913,69 @@ Status VFS::read_all(
   if (regions.empty())
     return Status::Ok();
 
+#ifndef _WIN32
+  // Submit the regions of a local file together through io_uring, straight
+  // into their destinations, with a single task instead of one blocking read
+  // per task.
+  if (uri.is_file() && posix_.use_io_uring()) {
+    URI uri_copy = uri;
+    uint64_t nbytes = 0;
+    for (const auto& region : regions)
+      nbytes += std::get<2>(region);
+    STATS_COUNTER_ADD(vfs_read_total_bytes, nbytes);
+    auto task = thread_pool->enqueue([uri_copy, regions, this]() {
+      return posix_.read_io_uring(uri_copy.to_path(), regions);
+    });
+
+    tasks->push_back(std::move(task));
+    return Status::Ok();
+  }
+#endif
+
   // Convert the individual regions into batched regions.
   std::vector<BatchedRead> batches;
   RETURN_NOT_OK(compute_read_batches(regions, &batches));
 
-  // Read all the batches and copy to the original destinations.
+  // Read all the batches directly into the original destinations.
   for (const auto& batch : batches) {
     URI uri_copy = uri;
     BatchedRead batch_copy = batch;
     auto task = thread_pool->enqueue([uri_copy, batch_copy, this]() {
+      // A single region needs no scattering
+      if (batch_copy.regions.size() == 1) {
+        const auto& region = batch_copy.regions.front();
+        return read(
+            uri_copy,
+            std::get<0>(region),
+            std::get<1>(region),
+            std::get<2>(region));
+      }
+
+      // Scatter the batch into the destinations, leaving the gaps unassigned.
+      // This is not possible if any regions overlap.
+      std::vector<std::pair<void*, uint64_t>> buffers;
+      buffers.reserve(2 * batch_copy.regions.size());
+      uint64_t end = batch_copy.offset;
+      bool overlap = false;
+      for (const auto& region : batch_copy.regions) {
+        uint64_t offset = std::get<0>(region);
+        if (offset < end) {
+          overlap = true;
+          break;
+        }
+        if (offset > end)
+          buffers.emplace_back(nullptr, offset - end);
+        buffers.emplace_back(std::get<1>(region), std::get<2>(region));
+        end = offset + std::get<2>(region);
+      }
+      if (!overlap)
+        return read_scatter(uri_copy, batch_copy.offset, buffers);
+
+      // Read the whole batch and copy to the individual destinations.
       Buffer buffer;
       RETURN_NOT_OK(buffer.realloc(batch_copy.nbytes));
       RETURN_NOT_OK(
           read(uri_copy, batch_copy.offset, buffer.data(), batch_copy.nbytes));
-      // Parallel copy back into the individual destinations.
       for (uint64_t i = 0; i < batch_copy.regions.size(); i++) {
         const auto& region = batch_copy.regions[i];
         uint64_t offset = std::get<0>(region);
@@ -901,6 +995,119 @@ Status VFS::read_all(
   STATS_FUNC_OUT(vfs_read_all);
 }
 
+Status VFS::read_mapped(
+    const URI& uri,
+    uint64_t offset,
+    uint64_t nbytes,
+    const void** data,
+    std::shared_ptr<void>* owner) const {
+  *data = nullptr;
+#ifndef _WIN32
+  if (uri.is_file())
+    return posix_.read_mapped(uri.to_path(), offset, nbytes, data, owner);
+#else
+  (void)uri;
+  (void)offset;
+  (void)nbytes;
+  (void)owner;
+#endif
+  return Status::Ok();
+}
+
+Status VFS::read_scatter(
+    const URI& uri,
+    uint64_t offset,
+    const std::vector<std::pair<void*, uint64_t>>& buffers) {
+  STATS_FUNC_IN(vfs_read_scatter);
+
+  uint64_t nbytes = 0;
+  for (const auto& buffer : buffers)
+    nbytes += buffer.second;
+  STATS_COUNTER_ADD(vfs_read_total_bytes, nbytes);
+
+  // Ensure that each thread is responsible for at least min_parallel_size
+  // bytes, and cap the number of parallel operations at the configured maximum
+  // number.
+  uint64_t num_ops = std::min(
+      std::max(nbytes / vfs_params_.min_parallel_size_, uint64_t(1)),
+      max_parallel_ops(uri));
+  if (num_ops == 1)
+    return read_scatter_impl(uri, offset, buffers);
+
+  // Split the buffers into ranges of (about) equal size, splitting the
+  // buffers that straddle the range boundaries
+  STATS_COUNTER_ADD(vfs_read_num_parallelized, 1);
+  std::vector<std::future<Status>> results;
+  uint64_t thread_read_nbytes = utils::math::ceil(nbytes, num_ops);
+  std::vector<std::pair<void*, uint64_t>> thread_buffers;
+  uint64_t thread_offset = offset, thread_nbytes = 0;
+  auto submit = [&]() {
+    auto task = cancelable_tasks_.enqueue(
+        &thread_pool_, [this, uri, thread_offset, thread_buffers]() {
+          return read_scatter_impl(uri, thread_offset, thread_buffers);
+        });
+    results.push_back(std::move(task));
+    thread_offset += thread_nbytes;
+    thread_buffers.clear();
+    thread_nbytes = 0;
+  };
+  for (const auto& buffer : buffers) {
+    auto data = static_cast<char*>(buffer.first);
+    uint64_t remaining = buffer.second;
+    while (remaining > 0) {
+      uint64_t n = std::min(remaining, thread_read_nbytes - thread_nbytes);
+      thread_buffers.emplace_back(data, n);
+      thread_nbytes += n;
+      remaining -= n;
+      if (data != nullptr)
+        data += n;
+      if (thread_nbytes == thread_read_nbytes)
+        submit();
+    }
+  }
+  if (!thread_buffers.empty())
+    submit();
+
+  Status st = thread_pool_.wait_all(results);
+  if (!st.ok()) {
+    std::stringstream errmsg;
+    errmsg << "VFS parallel read error '" << uri.to_string() << "'; "
+           << st.message();
+    return LOG_STATUS(Status::VFSError(errmsg.str()));
+  }
+  return st;
+
+  STATS_FUNC_OUT(vfs_read_scatter);
+}
+
+Status VFS::read_scatter_impl(
+    const URI& uri,
+    uint64_t offset,
+    const std::vector<std::pair<void*, uint64_t>>& buffers) {
+#ifndef _WIN32
+  if (uri.is_file())
+    return posix_.read_scatter(uri.to_path(), offset, buffers);
+#endif
+
+  uint64_t nbytes = 0;
+  for (const auto& buffer : buffers)
+    nbytes += buffer.second;
+
+  // The other backends (S3, HDFS) have no scattered reads, so the range is
+  // read into a temporary buffer and copied
+  Buffer buffer;
+  RETURN_NOT_OK(buffer.realloc(nbytes));
+  RETURN_NOT_OK(read_impl(uri, offset, buffer.data(), nbytes));
+  uint64_t buffer_offset = 0;
+  for (const auto& b : buffers) {
+    if (b.first != nullptr)
+      std::memcpy(b.first, buffer.data(buffer_offset), b.second);
+    buffer_offset += b.second;
+  }
+
+  return Status::Ok();
+}
+
 Status VFS::compute_read_batches(
     const std::vector<std::tuple<uint64_t, void*, uint64_t>>& regions,
     std::vector<BatchedRead>* batches) const {
@@ -1063,6 +1270,15 @@ Status VFS::close_file(const URI& uri) {
   STATS_FUNC_OUT(vfs_close_file);
 }
 
+bool VFS::supports_write_at(const URI& uri) const {
+#ifdef _WIN32
+  (void)uri;
+  return false;
+#else
+  return uri.is_file();
+#endif
+}
+
 Status VFS::write(const URI& uri, const void* buffer, uint64_t buffer_size) {
   STATS_FUNC_IN(vfs_write);
   STATS_COUNTER_ADD(vfs_write_total_bytes, buffer_size);
@@ -1095,5 +1311,23 @@ Status VFS::write(const URI& uri, const void* buffer, uint64_t buffer_size) {
   STATS_FUNC_OUT(vfs_write);
 }
 
+Status VFS::write_at(
+    const URI& uri,
+    uint64_t offset,
+    const void* buffer,
+    uint64_t buffer_size) {
+  STATS_FUNC_IN(vfs_write);
+  STATS_COUNTER_ADD(vfs_write_total_bytes, buffer_size);
+
+#ifndef _WIN32
+  if (uri.is_file())
+    return posix_.write(uri.to_path(), offset, buffer, buffer_size);
+#endif
+  return LOG_STATUS(Status::VFSError(
+      "Cannot write at offset; Unsupported URI scheme: " + uri.to_string()));
+
+  STATS_FUNC_OUT(vfs_write);
+}
+
 }  // namespace sm
 }  // namespace tiledb
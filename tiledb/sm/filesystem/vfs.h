@@ -53,6 +53,7 @@
 #include "tiledb/sm/filesystem/hdfs_filesystem.h"
 #endif
 
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -185,6 +186,21 @@ class VFS {
    */
   Status filelock_lock(const URI& uri, filelock_t* lock, bool shared) const;
 
+  /**
+   * Locks a filelock, like `filelock_lock`, but returns immediately if the
+   * filelock is held by another process in a conflicting mode.
+   *
+   * @param uri The URI of the filelock.
+   * @param lock A handle for the filelock (used in unlocking the
+   *     filelock).
+   * @param shared *True* if it is a shared lock, *false* if it is an
+   *     exclusive lock.
+   * @param locked Set to *true* if the filelock got locked.
+   * @return Status
+   */
+  Status filelock_try_lock(
+      const URI& uri, filelock_t* lock, bool shared, bool* locked) const;
+
   /**
    * Unlocks a filelock.
    *
@@ -313,12 +329,61 @@ class VFS {
       ThreadPool* thread_pool,
       std::vector<std::future<Status>>* tasks);
 
+  /**
+   * Retrieves a pointer to a region of a file that is memory-mapped (see
+   * `vfs.file.enable_mmap`), so that it can be used without any copy. If the
+   * file is not mapped (e.g., it is not local), `*data` is set to `nullptr`
+   * and the region must be read instead.
+   *
+   * @param uri The URI of the file.
+   * @param offset The offset of the region in the file.
+   * @param nbytes The size of the region.
+   * @param data Set to the start of the region in the mapped file.
+   * @param owner Set to a handle that keeps the mapping valid for as long as
+   *     it is held.
+   * @return Status
+   */
+  Status read_mapped(
+      const URI& uri,
+      uint64_t offset,
+      uint64_t nbytes,
+      const void** data,
+      std::shared_ptr<void>* owner) const;
+
+  /**
+   * Reads a contiguous range of a file directly into a list of buffers. A
+   * `nullptr` buffer denotes bytes that are not needed and are discarded.
+   * Like `read`, large ranges are split into parallel reads of at least
+   * `vfs.min_parallel_size` bytes.
+   *
+   * Only local files are read without any copy. The other backends (S3,
+   * HDFS) read each part of the range into a temporary buffer, which is
+   * then copied into the buffers.
+   *
+   * @param uri The URI of the file.
+   * @param offset The offset where the read begins.
+   * @param buffers The (buffer, nbytes) list into which the consecutive
+   *     bytes of the range are read.
+   * @return Status
+   */
+  Status read_scatter(
+      const URI& uri,
+      uint64_t offset,
+      const std::vector<std::pair<void*, uint64_t>>& buffers);
+
   /** Checks if a given filesystem is supported. */
   bool supports_fs(Filesystem fs) const;
 
   /** Checks if the backend required to access the given URI is supported. */
   bool supports_uri_scheme(const URI& uri) const;
 
+  /**
+   * Checks if the backend of the given URI supports writing at arbitrary
+   * offsets (see `write_at`), which allows the regions of a file to be
+   * written concurrently. Currently only local POSIX files do.
+   */
+  bool supports_write_at(const URI& uri) const;
+
   /**
    * Syncs (flushes) a file. Note that for S3 this is a noop.
    *
@@ -366,6 +431,24 @@ class VFS {
    */
   Status write(const URI& uri, const void* buffer, uint64_t buffer_size);
 
+  /**
+   * Writes the contents of a buffer into a file at the given offset,
+   * creating the file if it does not exist. Disjoint regions of the same
+   * file can be written concurrently. Applicable only to the backends for
+   * which `supports_write_at` returns `true`.
+   *
+   * @param uri The URI of the file.
+   * @param offset The offset in the file at which to start writing.
+   * @param buffer The buffer to write from.
+   * @param buffer_size The buffer size.
+   * @return Status
+   */
+  Status write_at(
+      const URI& uri,
+      uint64_t offset,
+      const void* buffer,
+      uint64_t buffer_size);
+
  private:
   /* ********************************* */
   /*        PRIVATE DATATYPES          */
@@ -438,6 +521,23 @@ class VFS {
       const std::vector<std::tuple<uint64_t, void*, uint64_t>>& regions,
       std::vector<BatchedRead>* batches) const;
 
+  /**
+   * Reads a contiguous range of a file into a list of buffers (see
+   * `read_scatter`) by calling the specific backend function. Only the
+   * POSIX backend supports scattered reads; for the others, the range is
+   * read into a temporary buffer and copied.
+   *
+   * @param uri The URI of the file.
+   * @param offset The offset where the read begins.
+   * @param buffers The (buffer, nbytes) list into which the consecutive
+   *     bytes of the range are read.
+   * @return Status
+   */
+  Status read_scatter_impl(
+      const URI& uri,
+      uint64_t offset,
+      const std::vector<std::pair<void*, uint64_t>>& buffers);
+
   /**
    * Reads from a file by calling the specific backend read function.
    *
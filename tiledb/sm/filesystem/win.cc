@@ -262,6 +262,43 @@ Status Win::filelock_lock(
   return Status::Ok();
 }
 
+Status Win::filelock_try_lock(
+    const std::string& filename,
+    filelock_t* fd,
+    bool shared,
+    bool* locked) const {
+  *locked = false;
+  *fd = INVALID_FILELOCK;
+  HANDLE file_h = CreateFile(
+      filename.c_str(),
+      GENERIC_READ | GENERIC_WRITE,
+      FILE_SHARE_READ | FILE_SHARE_WRITE,
+      NULL,
+      OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL,
+      NULL);
+  if (file_h == INVALID_HANDLE_VALUE) {
+    return LOG_STATUS(Status::IOError(
+        std::string("Failed to lock '" + filename + "'; CreateFile error")));
+  }
+  OVERLAPPED overlapped = {0};
+  DWORD flags = LOCKFILE_FAIL_IMMEDIATELY;
+  if (!shared)
+    flags |= LOCKFILE_EXCLUSIVE_LOCK;
+  if (LockFileEx(file_h, flags, 0, MAXDWORD, MAXDWORD, &overlapped) == 0) {
+    DWORD err = GetLastError();
+    CloseHandle(file_h);
+    if (err == ERROR_LOCK_VIOLATION)
+      return Status::Ok();
+    return LOG_STATUS(Status::IOError(
+        std::string("Failed to lock '" + filename + "'; LockFile error")));
+  }
+
+  *fd = file_h;
+  *locked = true;
+  return Status::Ok();
+}
+
 Status Win::filelock_unlock(filelock_t fd) const {
   OVERLAPPED overlapped = {0};
   if (UnlockFileEx(fd, 0, MAXDWORD, MAXDWORD, &overlapped) == 0) {
@@ -125,6 +125,23 @@ class Win {
   Status filelock_lock(
       const std::string& filename, filelock_t* fd, bool shared) const;
 
+  /**
+   * Lock a given filename like `filelock_lock`, but without waiting if
+   * another process holds the lock in a conflicting mode.
+   *
+   * @param filename The filelock to lock
+   * @param fd A pointer to a file descriptor
+   * @param shared *True* if this is a shared lock, *false* if it is an
+   * exclusive lock.
+   * @param locked Set to *true* if the filelock got locked.
+   * @return Status
+   */
+  Status filelock_try_lock(
+      const std::string& filename,
+      filelock_t* fd,
+      bool shared,
+      bool* locked) const;
+
   /**
    * Unlock an opened file descriptor
    *
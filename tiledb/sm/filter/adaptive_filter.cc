@@ -0,0 +1,393 @@
+/**
+ * @file   adaptive_filter.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class AdaptiveFilter.
+ */
+
+#include "tiledb/sm/filter/adaptive_filter.h"
+#include "blosc/shuffle.h"
+#include "tiledb/sm/buffer/preallocated_buffer.h"
+#include "tiledb/sm/compressors/dd_compressor.h"
+#include "tiledb/sm/compressors/lz4_compressor.h"
+#include "tiledb/sm/compressors/zstd_compressor.h"
+#include "tiledb/sm/filter/filter_pipeline.h"
+#include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/tile/tile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+
+/** The default weight of the decode cost in the codec selection. */
+static const uint32_t DEFAULT_DECODE_WEIGHT = 10;
+
+/** The zstd compression level of the candidates using zstd. */
+static const int ZSTD_LEVEL = 1;
+
+/**
+ * The nominal decode cost of each codec, relative to the slowest one. These
+ * are rough single-threaded decode times per byte on typical data.
+ */
+static const double DECODE_COST[AdaptiveFilter::CODEC_NUM] = {
+    0.0,   // NONE
+    0.2,   // LZ4
+    0.5,   // ZSTD
+    0.75,  // BYTESHUFFLE_ZSTD
+    1.0    // DOUBLE_DELTA
+};
+
+AdaptiveFilter::AdaptiveFilter()
+    : AdaptiveFilter(DEFAULT_DECODE_WEIGHT) {
+}
+
+AdaptiveFilter::AdaptiveFilter(uint32_t decode_weight)
+    : Filter(FilterType::FILTER_ADAPTIVE) {
+  decode_weight_ = std::min(decode_weight, 100u);
+}
+
+uint32_t AdaptiveFilter::decode_weight() const {
+  return decode_weight_;
+}
+
+Status AdaptiveFilter::set_decode_weight(uint32_t decode_weight) {
+  if (decode_weight > 100)
+    return LOG_STATUS(Status::FilterError(
+        "Adaptive filter error; decode weight must be at most 100"));
+  decode_weight_ = decode_weight;
+  return Status::Ok();
+}
+
+AdaptiveFilter* AdaptiveFilter::clone_impl() const {
+  return new AdaptiveFilter(decode_weight_);
+}
+
+Status AdaptiveFilter::run_forward(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  auto type = pipeline_->current_tile()->type();
+
+  // An encoded part is never larger than the original one.
+  std::vector<ConstBuffer> parts = input->buffers();
+  auto num_parts = (uint32_t)parts.size();
+  uint64_t output_size_ub = 0;
+  for (const auto& part : parts)
+    output_size_ub += part.size();
+
+  RETURN_NOT_OK(output->prepend_buffer(output_size_ub));
+  Buffer* output_buf = output->buffer_ptr(0);
+  assert(output_buf != nullptr);
+
+  // Forward the existing metadata
+  RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+  // Allocate a buffer for this filter's metadata and write the header.
+  uint32_t metadata_size =
+      sizeof(uint32_t) +
+      num_parts * (sizeof(uint8_t) + 2 * sizeof(uint32_t));
+  RETURN_NOT_OK(output_metadata->prepend_buffer(metadata_size));
+  RETURN_NOT_OK(output_metadata->write(&num_parts, sizeof(uint32_t)));
+
+  // Encode all parts.
+  Buffer encoded;
+  for (const auto& part : parts) {
+    Codec codec;
+    encoded.reset_size();
+    encoded.reset_offset();
+    RETURN_NOT_OK(select_codec(part, type, &codec, &encoded));
+    // The selected codec may still fail on the parts of the input it did
+    // not sample, in which case the part is stored raw.
+    if (codec != Codec::NONE && encoded.size() == 0 &&
+        !encode(codec, type, part, &encoded).ok())
+      codec = Codec::NONE;
+
+    // Store the part raw if the codec did not make it smaller.
+    if (codec == Codec::NONE || encoded.size() >= part.size()) {
+      codec = Codec::NONE;
+      RETURN_NOT_OK(output_buf->write(part.data(), part.size()));
+    } else {
+      RETURN_NOT_OK(output_buf->write(encoded.data(), encoded.size()));
+    }
+
+    auto codec_char = static_cast<uint8_t>(codec);
+    auto part_size = (uint32_t)part.size();
+    auto encoded_size =
+        codec == Codec::NONE ? part_size : (uint32_t)encoded.size();
+    RETURN_NOT_OK(output_metadata->write(&codec_char, sizeof(uint8_t)));
+    RETURN_NOT_OK(output_metadata->write(&part_size, sizeof(uint32_t)));
+    RETURN_NOT_OK(output_metadata->write(&encoded_size, sizeof(uint32_t)));
+  }
+
+  return Status::Ok();
+}
+
+Status AdaptiveFilter::select_codec(
+    const ConstBuffer& part,
+    Datatype type,
+    Codec* codec,
+    Buffer* encoded) const {
+  *codec = Codec::NONE;
+  if (part.size() == 0 || decode_weight_ == 100)
+    return Status::Ok();
+
+  // Sample windows aligned to the values. Each window is encoded on its
+  // own, so that the joins between them do not skew the trials.
+  auto type_size = datatype_size(type);
+  auto window_size = SAMPLE_WINDOW_SIZE / type_size * type_size;
+  bool whole_part = part.size() <= SAMPLE_WINDOWS * window_size;
+  std::vector<ConstBuffer> windows;
+  if (whole_part) {
+    windows.emplace_back(part.data(), part.size());
+  } else {
+    auto data = static_cast<const uint8_t*>(part.data());
+    auto value_num = part.size() / type_size;
+    auto stride = (value_num - window_size / type_size) / (SAMPLE_WINDOWS - 1);
+    for (uint64_t i = 0; i < SAMPLE_WINDOWS; i++)
+      windows.emplace_back(data + i * stride * type_size, window_size);
+  }
+  uint64_t sample_size = 0;
+  for (const auto& window : windows)
+    sample_size += window.size();
+
+  // Try the candidates on the sample. Storing it raw scores
+  // `100 - decode_weight_`.
+  bool is_aligned = part.size() % type_size == 0;
+  double best_score = 100.0 - decode_weight_;
+  Buffer trial_buffers[2];
+  Buffer *trial = &trial_buffers[0], *best = &trial_buffers[1];
+  for (unsigned c = 1; c < CODEC_NUM; c++) {
+    auto candidate = static_cast<Codec>(c);
+    if ((candidate == Codec::DOUBLE_DELTA &&
+         (!datatype_is_integer(type) || !is_aligned)) ||
+        (candidate == Codec::BYTESHUFFLE_ZSTD && type_size == 1))
+      continue;
+
+    // A codec may not handle the sample (e.g., double-delta fails on
+    // deltas out of bounds), in which case it is not a candidate.
+    trial->reset_size();
+    trial->reset_offset();
+    bool ok = true;
+    for (const auto& window : windows)
+      ok = ok && encode(candidate, type, window, trial).ok();
+    if (!ok)
+      continue;
+
+    double score = (100.0 - decode_weight_) * trial->size() / sample_size +
+                   decode_weight_ * DECODE_COST[c];
+    if (score < best_score) {
+      best_score = score;
+      *codec = candidate;
+      std::swap(trial, best);
+    }
+  }
+
+  if (whole_part && encoded != nullptr && *codec != Codec::NONE)
+    RETURN_NOT_OK(encoded->write(best->data(), best->size()));
+
+  return Status::Ok();
+}
+
+Status AdaptiveFilter::encode(
+    Codec codec, Datatype type, const ConstBuffer& input, Buffer* output) {
+  ConstBuffer input_buffer(input.data(), input.size());
+  auto type_size = datatype_size(type);
+  switch (codec) {
+    case Codec::NONE:
+      return output->write(input.data(), input.size());
+    case Codec::LZ4:
+      RETURN_NOT_OK(output->realloc(
+          output->size() + input.size() + LZ4::overhead(input.size())));
+      return LZ4::compress(LZ4::default_level(), &input_buffer, output);
+    case Codec::ZSTD:
+      RETURN_NOT_OK(output->realloc(
+          output->size() + input.size() + ZStd::overhead(input.size())));
+      return ZStd::compress(ZSTD_LEVEL, &input_buffer, output);
+    case Codec::BYTESHUFFLE_ZSTD: {
+      std::unique_ptr<uint8_t[]> shuffled(new uint8_t[input.size()]);
+      blosc::shuffle(
+          type_size,
+          input.size(),
+          static_cast<const uint8_t*>(input.data()),
+          shuffled.get());
+      ConstBuffer shuffled_buffer(shuffled.get(), input.size());
+      RETURN_NOT_OK(output->realloc(
+          output->size() + input.size() + ZStd::overhead(input.size())));
+      return ZStd::compress(ZSTD_LEVEL, &shuffled_buffer, output);
+    }
+    case Codec::DOUBLE_DELTA:
+      RETURN_NOT_OK(output->realloc(
+          output->size() + input.size() + DoubleDelta::OVERHEAD));
+      return DoubleDelta::compress(type, &input_buffer, output);
+  }
+
+  return LOG_STATUS(Status::FilterError("Adaptive filter error; bad codec"));
+}
+
+Status AdaptiveFilter::run_reverse(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  auto type = pipeline_->current_tile()->type();
+
+  // Read the codecs and sizes of all parts.
+  uint32_t num_parts;
+  RETURN_NOT_OK(input_metadata->read(&num_parts, sizeof(uint32_t)));
+  std::vector<Codec> codecs(num_parts);
+  std::vector<uint32_t> orig_sizes(num_parts), encoded_sizes(num_parts);
+  uint64_t total_size = 0;
+  for (uint32_t i = 0; i < num_parts; i++) {
+    uint8_t codec_char;
+    RETURN_NOT_OK(input_metadata->read(&codec_char, sizeof(uint8_t)));
+    if (codec_char >= CODEC_NUM)
+      return LOG_STATUS(
+          Status::FilterError("Adaptive filter error; unknown codec"));
+    codecs[i] = static_cast<Codec>(codec_char);
+    RETURN_NOT_OK(input_metadata->read(&orig_sizes[i], sizeof(uint32_t)));
+    RETURN_NOT_OK(input_metadata->read(&encoded_sizes[i], sizeof(uint32_t)));
+    total_size += orig_sizes[i];
+  }
+
+  RETURN_NOT_OK(output->prepend_buffer(total_size));
+  Buffer* output_buf = output->buffer_ptr(0);
+  assert(output_buf != nullptr);
+
+  // Decode all parts.
+  for (uint32_t i = 0; i < num_parts; i++) {
+    ConstBuffer part(nullptr, 0);
+    RETURN_NOT_OK(input->get_const_buffer(encoded_sizes[i], &part));
+    RETURN_NOT_OK(decode(
+        codecs[i], type, &part, orig_sizes[i], output_buf->cur_data()));
+    input->advance_offset(encoded_sizes[i]);
+    output_buf->advance_size(orig_sizes[i]);
+    output_buf->advance_offset(orig_sizes[i]);
+  }
+
+  // Output metadata is a view on the input metadata, skipping what was used
+  // by this filter.
+  auto md_offset = input_metadata->offset();
+  RETURN_NOT_OK(output_metadata->append_view(
+      input_metadata, md_offset, input_metadata->size() - md_offset));
+
+  return Status::Ok();
+}
+
+Status AdaptiveFilter::decode(
+    Codec codec,
+    Datatype type,
+    ConstBuffer* input,
+    uint32_t orig_size,
+    void* output) {
+  PreallocatedBuffer output_buffer(output, orig_size);
+  Status st;
+  switch (codec) {
+    case Codec::NONE:
+      if (input->size() != orig_size)
+        return LOG_STATUS(Status::FilterError(
+            "Adaptive filter error; raw part size mismatch"));
+      std::memcpy(output, input->data(), orig_size);
+      return Status::Ok();
+    case Codec::LZ4:
+      st = LZ4::decompress(input, &output_buffer);
+      break;
+    case Codec::ZSTD:
+      st = ZStd::decompress(input, &output_buffer);
+      break;
+    case Codec::BYTESHUFFLE_ZSTD: {
+      std::unique_ptr<uint8_t[]> shuffled(new uint8_t[orig_size]);
+      PreallocatedBuffer shuffled_buffer(shuffled.get(), orig_size);
+      RETURN_NOT_OK(ZStd::decompress(input, &shuffled_buffer));
+      if (shuffled_buffer.offset() != orig_size)
+        return LOG_STATUS(Status::FilterError(
+            "Adaptive filter error; decoded part size mismatch"));
+      blosc::unshuffle(
+          datatype_size(type),
+          orig_size,
+          shuffled.get(),
+          static_cast<uint8_t*>(output));
+      return Status::Ok();
+    }
+    case Codec::DOUBLE_DELTA:
+      st = DoubleDelta::decompress(type, input, &output_buffer);
+      break;
+  }
+
+  // A short decode would leave part of the output uninitialized
+  RETURN_NOT_OK(st);
+  if (output_buffer.offset() != orig_size)
+    return LOG_STATUS(Status::FilterError(
+        "Adaptive filter error; decoded part size mismatch"));
+
+  return Status::Ok();
+}
+
+Status AdaptiveFilter::set_option_impl(
+    FilterOption option, const void* value) {
+  if (value == nullptr)
+    return LOG_STATUS(
+        Status::FilterError("Adaptive filter error; invalid option value"));
+
+  switch (option) {
+    case FilterOption::ADAPTIVE_DECODE_WEIGHT:
+      return set_decode_weight(*(uint32_t*)value);
+    default:
+      return LOG_STATUS(
+          Status::FilterError("Adaptive filter error; unknown option"));
+  }
+}
+
+Status AdaptiveFilter::get_option_impl(
+    FilterOption option, void* value) const {
+  switch (option) {
+    case FilterOption::ADAPTIVE_DECODE_WEIGHT:
+      *(uint32_t*)value = decode_weight_;
+      return Status::Ok();
+    default:
+      return LOG_STATUS(
+          Status::FilterError("Adaptive filter error; unknown option"));
+  }
+}
+
+Status AdaptiveFilter::deserialize_impl(ConstBuffer* buff) {
+  RETURN_NOT_OK(buff->read(&decode_weight_, sizeof(uint32_t)));
+  return Status::Ok();
+}
+
+Status AdaptiveFilter::serialize_impl(Buffer* buff) const {
+  RETURN_NOT_OK(buff->write(&decode_weight_, sizeof(uint32_t)));
+  return Status::Ok();
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,209 @@
+/**
+ * @file   adaptive_filter.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares class AdaptiveFilter.
+ */
+
+#ifndef TILEDB_ADAPTIVE_FILTER_H
+#define TILEDB_ADAPTIVE_FILTER_H
+
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/buffer/const_buffer.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/filter/filter.h"
+#include "tiledb/sm/misc/status.h"
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A compressor that picks the codec of each part of its input among a small
+ * set of candidates (see `Codec`), so that random and highly repetitive
+ * tiles of the same attribute are each stored the way that suits them.
+ *
+ * The candidates are tried on a sample of the part, made of up to
+ * `SAMPLE_WINDOWS` evenly spaced windows of `SAMPLE_WINDOW_SIZE` bytes (the
+ * whole part if it is not larger than the sample, in which case the winning
+ * trial output is kept as is). Each candidate gets the score
+ *
+ *   (100 - W) * compressed size / sample size + W * decode cost
+ *
+ * where the decode cost is a nominal per-codec cost in `[0, 1]` (`0` for
+ * storing the part raw), and `W` in `[0, 100]` is the decode weight: `0`
+ * optimizes for size only, and `100` for decode speed only. The candidate
+ * with the lowest score wins. DOUBLE_DELTA is only tried on integer types,
+ * and BYTESHUFFLE_ZSTD on types wider than a byte. A part is stored raw if
+ * the winner does not make it smaller.
+ *
+ * Input metadata is not modified.
+ *
+ * The forward output metadata has the format:
+ *   uint32_t - Number of parts
+ *   uint8_t - Codec of part0 (see `Codec`)
+ *   uint32_t - Number of bytes of the original part0
+ *   uint32_t - Number of bytes of the encoded part0
+ *   ...
+ *   uint8_t - Codec of partN
+ *   uint32_t - Number of bytes of the original partN
+ *   uint32_t - Number of bytes of the encoded partN
+ *
+ * The forward output data is the concatenated encoded parts.
+ *
+ * The reverse output format is simply:
+ *   uint8_t[] - The original bytes
+ */
+class AdaptiveFilter : public Filter {
+ public:
+  /** The candidate codecs. */
+  enum class Codec : uint8_t {
+    /** The part is stored raw. */
+    NONE = 0,
+    /** LZ4 at the default level. */
+    LZ4 = 1,
+    /** Zstandard at level 1. */
+    ZSTD = 2,
+    /** Byte shuffling of the values, followed by Zstandard at level 1. */
+    BYTESHUFFLE_ZSTD = 3,
+    /** Double-delta encoding of the values (integer types only). */
+    DOUBLE_DELTA = 4
+  };
+
+  /** The number of candidate codecs. */
+  static const unsigned CODEC_NUM = 5;
+
+  /** The number of windows making up the sample of a part. */
+  static const uint64_t SAMPLE_WINDOWS = 4;
+
+  /** The size in bytes of a window of the sample of a part. */
+  static const uint64_t SAMPLE_WINDOW_SIZE = 4096;
+
+  /** Constructor. */
+  AdaptiveFilter();
+
+  /**
+   * Constructor.
+   *
+   * @param decode_weight The weight of the decode cost in the codec
+   *     selection, in `[0, 100]`.
+   */
+  explicit AdaptiveFilter(uint32_t decode_weight);
+
+  /** Return the decode weight used by this filter instance. */
+  uint32_t decode_weight() const;
+
+  /**
+   * Encode the given input into the given output.
+   */
+  Status run_forward(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+  /**
+   * Decode the given input into the given output.
+   */
+  Status run_reverse(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+  /**
+   * Selects the codec of a part of the filter input.
+   *
+   * @param part The part.
+   * @param type The datatype of the values of the part.
+   * @param codec Set to the selected codec.
+   * @param encoded If not `nullptr` and the sample is the whole part, set
+   *     to the part encoded with the selected codec. Otherwise left empty.
+   * @return Status
+   */
+  Status select_codec(
+      const ConstBuffer& part,
+      Datatype type,
+      Codec* codec,
+      Buffer* encoded = nullptr) const;
+
+  /** Set the decode weight used by this filter instance. */
+  Status set_decode_weight(uint32_t decode_weight);
+
+ private:
+  /** The weight of the decode cost in the codec selection. */
+  uint32_t decode_weight_;
+
+  /** Returns a new clone of this filter. */
+  AdaptiveFilter* clone_impl() const override;
+
+  /**
+   * Decodes a part encoded with the given codec.
+   *
+   * @param codec The codec of the part.
+   * @param type The datatype of the values of the part.
+   * @param input The encoded part.
+   * @param orig_size The number of bytes of the original part.
+   * @param output Pointer to write the decoded part to.
+   * @return Status
+   */
+  static Status decode(
+      Codec codec,
+      Datatype type,
+      ConstBuffer* input,
+      uint32_t orig_size,
+      void* output);
+
+  /** Deserializes this filter's metadata from the given buffer. */
+  Status deserialize_impl(ConstBuffer* buff) override;
+
+  /**
+   * Encodes the input with the given codec, appending to the output.
+   *
+   * @param codec The codec.
+   * @param type The datatype of the values of the input.
+   * @param input The input.
+   * @param output Buffer to append the encoded input to.
+   * @return Status
+   */
+  static Status encode(
+      Codec codec, Datatype type, const ConstBuffer& input, Buffer* output);
+
+  /** Gets an option from this filter. */
+  Status get_option_impl(FilterOption option, void* value) const override;
+
+  /** Sets an option on this filter. */
+  Status set_option_impl(FilterOption option, const void* value) override;
+
+  /** Serializes this filter's metadata to the given buffer. */
+  Status serialize_impl(Buffer* buff) const override;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_ADAPTIVE_FILTER_H
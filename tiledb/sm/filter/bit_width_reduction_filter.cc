@@ -32,6 +32,7 @@
 
 #include "tiledb/sm/filter/bit_width_reduction_filter.h"
 #include "bit_width_reduction_filter.h"
+#include "tiledb/sm/filter/filter_kernels.h"
 #include "tiledb/sm/filter/filter_pipeline.h"
 #include "tiledb/sm/misc/logger.h"
 #include "tiledb/sm/misc/utils.h"
@@ -77,6 +78,77 @@ static inline uint8_t bits_required(T value) {
   return bits_required(value, std::is_signed<T>());
 }
 
+/** The integer type of the given bit width with the signedness of T. */
+template <typename T, unsigned Bits>
+struct ReducedType {
+  typedef typename std::conditional<
+      Bits == 8,
+      int8_t,
+      typename std::conditional<
+          Bits == 16,
+          int16_t,
+          typename std::conditional<Bits == 32, int32_t, int64_t>::type>::
+          type>::type signed_type;
+  typedef typename std::conditional<
+      std::is_signed<T>::value,
+      signed_type,
+      typename std::make_unsigned<signed_type>::type>::type type;
+};
+
+/**
+ * Compresses `num` values relative to `offset` into values of `Bits` bits.
+ * Bit widths not narrower than T never occur, as such windows are stored
+ * uncompressed.
+ */
+template <typename T, unsigned Bits>
+static inline void narrow_values(
+    const T* values, uint32_t num, T offset, void* out, std::true_type) {
+  typedef typename ReducedType<T, Bits>::type U;
+  filter_kernels::narrow(values, num, offset, static_cast<U*>(out));
+}
+
+template <typename T, unsigned Bits>
+static inline void narrow_values(
+    const T*, uint32_t, T, void*, std::false_type) {
+  assert(false);
+}
+
+template <typename T, unsigned Bits>
+static inline void narrow_values(
+    const T* values, uint32_t num, T offset, void* out) {
+  narrow_values<T, Bits>(
+      values,
+      num,
+      offset,
+      out,
+      std::integral_constant<bool, (Bits < 8 * sizeof(T))>());
+}
+
+/** The inverse of `narrow_values`. */
+template <typename T, unsigned Bits>
+static inline void widen_values(
+    const void* in, uint32_t num, T offset, T* values, std::true_type) {
+  typedef typename ReducedType<T, Bits>::type U;
+  filter_kernels::widen(static_cast<const U*>(in), num, offset, values);
+}
+
+template <typename T, unsigned Bits>
+static inline void widen_values(
+    const void*, uint32_t, T, T*, std::false_type) {
+  assert(false);
+}
+
+template <typename T, unsigned Bits>
+static inline void widen_values(
+    const void* in, uint32_t num, T offset, T* values) {
+  widen_values<T, Bits>(
+      in,
+      num,
+      offset,
+      values,
+      std::integral_constant<bool, (Bits < 8 * sizeof(T))>());
+}
+
 BitWidthReductionFilter::BitWidthReductionFilter()
     : Filter(FilterType::FILTER_BIT_WIDTH_REDUCTION) {
   max_window_size_ = 256;
@@ -191,6 +263,9 @@ Status BitWidthReductionFilter::compress_part(
   uint32_t num_windows =
       input_bytes / window_size + uint32_t(bool(input_bytes % window_size));
 
+  // Scratch space for the compressed values of a window.
+  std::vector<uint8_t> scratch;
+
   // Write each window.
   for (uint32_t i = 0; i < num_windows; i++) {
     // Compute the actual size in bytes of the window (may be smaller at the end
@@ -200,7 +275,7 @@ Status BitWidthReductionFilter::compress_part(
     uint32_t window_nelts = window_nbytes / sizeof(T);
 
     // Write window metadata.
-    T window_value_offset;
+    T window_value_offset = 0;
     uint8_t orig_bits = sizeof(T) * 8;
     uint8_t compressed_bits =
         compute_bits_required(input, window_nelts, &window_value_offset);
@@ -215,14 +290,14 @@ Status BitWidthReductionFilter::compress_part(
       input->advance_offset(window_nbytes);
     } else {
       // Compress and write the relative values to output.
-      for (uint32_t j = 0; j < window_nelts; j++) {
-        T relative_value = input->value<T>() - window_value_offset;
-
-        RETURN_NOT_OK(
-            write_compressed_value(output, relative_value, compressed_bits));
-
-        input->advance_offset(sizeof(T));
-      }
+      RETURN_NOT_OK(write_compressed_window(
+          output,
+          static_cast<const T*>(input->cur_data()),
+          window_nelts,
+          window_value_offset,
+          compressed_bits,
+          &scratch));
+      input->advance_offset(window_nbytes);
     }
   }
 
@@ -290,6 +365,10 @@ Status BitWidthReductionFilter::run_reverse(
   RETURN_NOT_OK(output->prepend_buffer(orig_length));
   output->reset_offset();
 
+  // Scratch space for the compressed and decompressed values of a window.
+  std::vector<uint8_t> scratch;
+  std::vector<T> window_values;
+
   // Read each window
   for (uint32_t i = 0; i < num_windows; i++) {
     uint32_t window_nbytes;
@@ -305,15 +384,17 @@ Status BitWidthReductionFilter::run_reverse(
       RETURN_NOT_OK(output->write(input, window_nbytes));
       input->advance_offset(window_nbytes);
     } else {
-      // Read and uncompress each window value.
+      // Read and uncompress the window values.
       uint32_t window_nelts = window_nbytes / sizeof(T);
-      for (uint32_t j = 0; j < window_nelts; j++) {
-        T input_value = 0;
-        RETURN_NOT_OK(
-            read_compressed_value(input, compressed_bits, &input_value));
-        input_value += window_value_offset;
-        RETURN_NOT_OK(output->write(&input_value, tile_type_size));
-      }
+      window_values.resize(window_nelts);
+      RETURN_NOT_OK(read_compressed_window(
+          input,
+          compressed_bits,
+          window_value_offset,
+          window_nelts,
+          &scratch,
+          window_values.data()));
+      RETURN_NOT_OK(output->write(window_values.data(), window_nbytes));
     }
   }
 
@@ -330,16 +411,12 @@ template <typename T>
 uint8_t BitWidthReductionFilter::compute_bits_required(
     ConstBuffer* buffer, uint32_t num_elements, T* min_value) const {
   // Compute the min and max element values within the window.
-  T window_min = std::numeric_limits<T>::max(),
-    window_max = std::numeric_limits<T>::lowest();
-  auto orig_offset = buffer->offset();
-  for (uint32_t j = 0; j < num_elements; j++) {
-    T input_value = buffer->value<T>();
-    window_min = std::min(window_min, input_value);
-    window_max = std::max(window_max, input_value);
-    buffer->advance_offset(sizeof(T));
-  }
-  buffer->set_offset(orig_offset);
+  T window_min, window_max;
+  filter_kernels::min_max(
+      static_cast<const T*>(buffer->cur_data()),
+      num_elements,
+      &window_min,
+      &window_max);
 
   // Check for overflow
   T range = window_max - window_min;
@@ -364,79 +441,51 @@ uint8_t BitWidthReductionFilter::compute_bits_required(
 }
 
 template <typename T>
-Status BitWidthReductionFilter::write_compressed_value(
-    FilterBuffer* buffer, T value, uint8_t num_bits) const {
+Status BitWidthReductionFilter::write_compressed_window(
+    FilterBuffer* buffer,
+    const T* values,
+    uint32_t num,
+    T window_value_offset,
+    uint8_t num_bits,
+    std::vector<uint8_t>* scratch) const {
+  scratch->resize(num * (num_bits / 8));
   switch (num_bits) {
-    case 8: {
-      auto val = static_cast<
-          typename std::conditional<std::is_signed<T>::value, int8_t, uint8_t>::
-              type>(value);
-      RETURN_NOT_OK(buffer->write(&val, sizeof(val)));
-      break;
-    }
-    case 16: {
-      auto val = static_cast<
-          typename std::
-              conditional<std::is_signed<T>::value, int16_t, uint16_t>::type>(
-          value);
-      RETURN_NOT_OK(buffer->write(&val, sizeof(val)));
+    case 8:
+      narrow_values<T, 8>(values, num, window_value_offset, scratch->data());
       break;
-    }
-    case 32: {
-      auto val = static_cast<
-          typename std::
-              conditional<std::is_signed<T>::value, int32_t, uint32_t>::type>(
-          value);
-      RETURN_NOT_OK(buffer->write(&val, sizeof(val)));
+    case 16:
+      narrow_values<T, 16>(values, num, window_value_offset, scratch->data());
       break;
-    }
-    case 64: {
-      auto val = static_cast<
-          typename std::
-              conditional<std::is_signed<T>::value, int64_t, uint64_t>::type>(
-          value);
-      RETURN_NOT_OK(buffer->write(&val, sizeof(val)));
+    case 32:
+      narrow_values<T, 32>(values, num, window_value_offset, scratch->data());
       break;
-    }
     default:
       assert(false);
   }
 
-  return Status::Ok();
+  return buffer->write(scratch->data(), scratch->size());
 }
 
 template <typename T>
-Status BitWidthReductionFilter::read_compressed_value(
-    FilterBuffer* buffer, uint8_t compressed_bits, T* value) const {
+Status BitWidthReductionFilter::read_compressed_window(
+    FilterBuffer* buffer,
+    uint8_t compressed_bits,
+    T window_value_offset,
+    uint32_t num,
+    std::vector<uint8_t>* scratch,
+    T* values) const {
+  scratch->resize(num * (compressed_bits / 8));
+  RETURN_NOT_OK(buffer->read(scratch->data(), scratch->size()));
   switch (compressed_bits) {
-    case 8: {
-      typename std::conditional<std::is_signed<T>::value, int8_t, uint8_t>::type
-          val;
-      RETURN_NOT_OK(buffer->read(&val, sizeof(val)));
-      *value = val;
-      break;
-    }
-    case 16: {
-      typename std::conditional<std::is_signed<T>::value, int16_t, uint16_t>::
-          type val;
-      RETURN_NOT_OK(buffer->read(&val, sizeof(val)));
-      *value = val;
+    case 8:
+      widen_values<T, 8>(scratch->data(), num, window_value_offset, values);
       break;
-    }
-    case 32: {
-      typename std::conditional<std::is_signed<T>::value, int32_t, uint32_t>::
-          type val;
-      RETURN_NOT_OK(buffer->read(&val, sizeof(val)));
-      *value = val;
+    case 16:
+      widen_values<T, 16>(scratch->data(), num, window_value_offset, values);
       break;
-    }
-    case 64: {
-      typename std::conditional<std::is_signed<T>::value, int64_t, uint64_t>::
-          type val;
-      RETURN_NOT_OK(buffer->read(&val, sizeof(val)));
-      *value = val;
+    case 32:
+      widen_values<T, 32>(scratch->data(), num, window_value_offset, values);
       break;
-    }
     default:
       assert(false);
   }
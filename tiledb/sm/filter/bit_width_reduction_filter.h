@@ -36,6 +36,8 @@
 #include "tiledb/sm/filter/filter.h"
 #include "tiledb/sm/misc/status.h"
 
+#include <vector>
+
 namespace tiledb {
 namespace sm {
 
@@ -151,18 +153,26 @@ class BitWidthReductionFilter : public Filter {
   Status get_option_impl(FilterOption option, void* value) const override;
 
   /**
-   * Reads a compressed value of type T from the given buffer after
-   * decompressing from a value of the given bit width.
+   * Reads a window of compressed values from the given buffer and restores
+   * them to type T.
    *
    * @tparam T Tile cell datatype
    * @param buffer Buffer to read from
-   * @param compressed_bits Bit width of compressed value to read
-   * @param value Will be set to the decompressed value
+   * @param compressed_bits Bit width of the compressed values
+   * @param window_value_offset Offset the values were compressed relative to
+   * @param num Number of values in the window
+   * @param scratch Scratch space for the compressed values
+   * @param values Will be set to the `num` decompressed values
    * @return Status
    */
   template <typename T>
-  Status read_compressed_value(
-      FilterBuffer* buffer, uint8_t compressed_bits, T* value) const;
+  Status read_compressed_window(
+      FilterBuffer* buffer,
+      uint8_t compressed_bits,
+      T window_value_offset,
+      uint32_t num,
+      std::vector<uint8_t>* scratch,
+      T* values) const;
 
   /** Run_forward method templated on the tile cell datatype. */
   template <typename T>
@@ -187,17 +197,26 @@ class BitWidthReductionFilter : public Filter {
   Status serialize_impl(Buffer* buff) const override;
 
   /**
-   * Writes the given value of type T to the given buffer after compressing
-   * (casting) to a value of the given bit width.
+   * Writes a window of values of type T to the given buffer after compressing
+   * them (relative to the window value offset) to the given bit width.
    *
+   * @tparam T Tile cell datatype
    * @param buffer Buffer to write to
-   * @param value Uncompressed value to write
-   * @param num_bits Bit width of compressed value to write
+   * @param values Uncompressed values to write
+   * @param num Number of values in the window
+   * @param window_value_offset Offset to compress the values relative to
+   * @param num_bits Bit width of the compressed values to write
+   * @param scratch Scratch space for the compressed values
    * @return Status
    */
   template <typename T>
-  Status write_compressed_value(
-      FilterBuffer* buffer, T value, uint8_t num_bits) const;
+  Status write_compressed_window(
+      FilterBuffer* buffer,
+      const T* values,
+      uint32_t num,
+      T window_value_offset,
+      uint8_t num_bits,
+      std::vector<uint8_t>* scratch) const;
 };
 
 }  // namespace sm
@@ -66,8 +66,14 @@ int CompressionFilter::compression_level() const {
   return level_;
 }
 
+const ZStd::Dictionary* CompressionFilter::dictionary() const {
+  return dictionary_.get();
+}
+
 CompressionFilter* CompressionFilter::clone_impl() const {
-  return new CompressionFilter(compressor_, level_);
+  auto clone = new CompressionFilter(compressor_, level_);
+  clone->dictionary_ = dictionary_;
+  return clone;
 }
 
 void CompressionFilter::set_compressor(Compressor compressor) {
@@ -75,8 +81,46 @@ void CompressionFilter::set_compressor(Compressor compressor) {
   type_ = compressor_to_filter(compressor);
 }
 
-void CompressionFilter::set_compression_level(int compressor_level) {
+Status CompressionFilter::set_compression_level(int compressor_level) {
+  if (dictionary_ != nullptr) {
+    // The dictionary is digested for a given level. If it cannot be digested
+    // for the new level, the level and the dictionary are left unchanged.
+    const auto& data = dictionary_->data();
+    std::shared_ptr<ZStd::Dictionary> dictionary;
+    RETURN_NOT_OK(ZStd::Dictionary::create(
+        data.data(), data.size(), compressor_level, &dictionary));
+    dictionary_ = dictionary;
+  }
   level_ = compressor_level;
+
+  return Status::Ok();
+}
+
+Status CompressionFilter::set_dictionary(const void* data, uint64_t size) {
+  if (size == 0) {
+    dictionary_.reset();
+    return Status::Ok();
+  }
+
+  if (compressor_ != Compressor::ZSTD)
+    return LOG_STATUS(Status::FilterError(
+        "Compression filter error; only ZSTD supports dictionaries"));
+
+  return ZStd::Dictionary::create(data, size, level_, &dictionary_);
+}
+
+Status CompressionFilter::train_dictionary(
+    const void* samples,
+    const std::vector<uint64_t>& sample_sizes,
+    uint64_t max_size) {
+  if (compressor_ != Compressor::ZSTD)
+    return LOG_STATUS(Status::FilterError(
+        "Compression filter error; only ZSTD supports dictionaries"));
+
+  std::vector<uint8_t> dictionary;
+  RETURN_NOT_OK(
+      ZStd::train_dictionary(samples, sample_sizes, max_size, &dictionary));
+  return set_dictionary(dictionary.data(), dictionary.size());
 }
 
 FilterType CompressionFilter::compressor_to_filter(Compressor compressor) {
@@ -131,8 +175,7 @@ Status CompressionFilter::set_option_impl(
 
   switch (option) {
     case FilterOption::COMPRESSION_LEVEL:
-      level_ = *(int*)value;
-      return Status::Ok();
+      return set_compression_level(*(int*)value);
     default:
       return LOG_STATUS(
           Status::FilterError("Compression filter error; unknown option"));
@@ -250,7 +293,11 @@ Status CompressionFilter::compress_part(
       RETURN_NOT_OK(GZip::compress(level_, &input_buffer, output));
       break;
     case Compressor::ZSTD:
-      RETURN_NOT_OK(ZStd::compress(level_, &input_buffer, output));
+      if (dictionary_ != nullptr) {
+        RETURN_NOT_OK(ZStd::compress(*dictionary_, &input_buffer, output));
+      } else {
+        RETURN_NOT_OK(ZStd::compress(level_, &input_buffer, output));
+      }
       break;
     case Compressor::LZ4:
       RETURN_NOT_OK(LZ4::compress(level_, &input_buffer, output));
@@ -315,7 +362,9 @@ Status CompressionFilter::decompress_part(
       st = GZip::decompress(&input_buffer, &output_buffer);
       break;
     case Compressor::ZSTD:
-      st = ZStd::decompress(&input_buffer, &output_buffer);
+      st = dictionary_ != nullptr ?
+               ZStd::decompress(*dictionary_, &input_buffer, &output_buffer) :
+               ZStd::decompress(&input_buffer, &output_buffer);
       break;
     case Compressor::LZ4:
       st = LZ4::decompress(&input_buffer, &output_buffer);
@@ -367,6 +416,15 @@ Status CompressionFilter::serialize_impl(Buffer* buff) const {
   RETURN_NOT_OK(buff->write(&compressor_char, sizeof(uint8_t)));
   RETURN_NOT_OK(buff->write(&level_, sizeof(int32_t)));
 
+  // The dictionary is optional, so that filters without one keep the
+  // original format
+  if (dictionary_ != nullptr) {
+    const auto& data = dictionary_->data();
+    uint64_t size = data.size();
+    RETURN_NOT_OK(buff->write(&size, sizeof(uint64_t)));
+    RETURN_NOT_OK(buff->write(data.data(), size));
+  }
+
   return Status::Ok();
 }
 
@@ -376,6 +434,18 @@ Status CompressionFilter::deserialize_impl(ConstBuffer* buff) {
   compressor_ = static_cast<Compressor>(compressor_char);
   RETURN_NOT_OK(buff->read(&level_, sizeof(int32_t)));
 
+  dictionary_.reset();
+  if (buff->nbytes_left_to_read() > 0) {
+    uint64_t size;
+    RETURN_NOT_OK(buff->read(&size, sizeof(uint64_t)));
+    if (size > buff->nbytes_left_to_read())
+      return LOG_STATUS(Status::FilterError(
+          "Compression filter error; invalid dictionary size"));
+    RETURN_NOT_OK(ZStd::Dictionary::create(
+        buff->cur_data(), size, level_, &dictionary_));
+    buff->advance_offset(size);
+  }
+
   return Status::Ok();
 }
 
@@ -34,6 +34,7 @@
 #define TILEDB_COMPRESSION_FILTER_H
 
 #include "tiledb/sm/buffer/preallocated_buffer.h"
+#include "tiledb/sm/compressors/zstd_compressor.h"
 #include "tiledb/sm/enums/compressor.h"
 #include "tiledb/sm/filter/filter.h"
 #include "tiledb/sm/misc/status.h"
@@ -95,6 +96,12 @@ class CompressionFilter : public Filter {
   /** Return the compression level used by this filter instance. */
   int compression_level() const;
 
+  /**
+   * Return the dictionary used by this filter instance, or `nullptr` if it
+   * does not use one.
+   */
+  const ZStd::Dictionary* dictionary() const;
+
   /**
    * Compress the given input into the given output.
    */
@@ -116,8 +123,38 @@ class CompressionFilter : public Filter {
   /** Set the compressor used by this filter instance. */
   void set_compressor(Compressor compressor);
 
-  /** Set the compression level used by this filter instance. */
-  void set_compression_level(int compressor_level);
+  /**
+   * Set the compression level used by this filter instance. If the filter
+   * has a dictionary that cannot be digested for the new level, an error
+   * is returned and the level and the dictionary are left unchanged.
+   */
+  Status set_compression_level(int compressor_level);
+
+  /**
+   * Sets the dictionary to compress the chunks against. This benefits small
+   * chunks, which do not hold enough data to build a good dictionary on
+   * their own. Only ZSTD supports dictionaries.
+   *
+   * @param data The dictionary content.
+   * @param size The size of `data` in bytes. If `0`, the filter stops using
+   *     a dictionary.
+   * @return Status
+   */
+  Status set_dictionary(const void* data, uint64_t size);
+
+  /**
+   * Trains a dictionary on samples of the data to be compressed, and sets it
+   * as the dictionary of this filter instance.
+   *
+   * @param samples The concatenated samples.
+   * @param sample_sizes The size in bytes of each sample.
+   * @param max_size The maximum size of the dictionary in bytes.
+   * @return Status
+   */
+  Status train_dictionary(
+      const void* samples,
+      const std::vector<uint64_t>& sample_sizes,
+      uint64_t max_size);
 
  private:
   /** The compressor. */
@@ -126,6 +163,9 @@ class CompressionFilter : public Filter {
   /** The compression level. */
   int level_;
 
+  /** The dictionary (ZSTD only), shared with the clones of this filter. */
+  std::shared_ptr<ZStd::Dictionary> dictionary_;
+
   /** Returns a new clone of this filter. */
   CompressionFilter* clone_impl() const override;
 
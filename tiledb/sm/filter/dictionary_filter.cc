@@ -0,0 +1,309 @@
+/**
+ * @file   dictionary_filter.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class DictionaryFilter.
+ */
+
+
+#include "tiledb/sm/filter/dictionary_filter.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/filter/filter_buffer.h"
+#include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/tile/tile.h"
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+
+/** Returns the 64-bit FNV-1a hash of a byte string. */
+static inline uint64_t hash_bytes(const uint8_t* data, uint64_t size) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (uint64_t i = 0; i < size; ++i) {
+    hash ^= data[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+/**
+ * Builds the dictionary of the values of a var tile.
+ *
+ * @param offsets The cell offsets.
+ * @param cell_num The number of cells.
+ * @param data The values.
+ * @param data_size The size of the values in bytes.
+ * @param codes Set to the code of each cell.
+ * @param entries Set to the offset and size of the first occurrence of each
+ *     dictionary value in `data`.
+ * @param entry_bytes Set to the total size of the dictionary values.
+ * @return `false` if the dictionary encoding would not be smaller than the
+ *     values, in which case building the dictionary stops early.
+ */
+static bool build_dictionary(
+    const uint64_t* offsets,
+    uint64_t cell_num,
+    const uint8_t* data,
+    uint64_t data_size,
+    std::vector<uint32_t>* codes,
+    std::vector<std::pair<uint64_t, uint64_t>>* entries,
+    uint64_t* entry_bytes) {
+  // Open addressing hash table of the dictionary values, storing `code + 1`
+  // per occupied slot. It is kept at most half full.
+  uint64_t capacity = 64;
+  std::vector<uint32_t> slots(capacity, 0);
+  std::vector<uint64_t> hashes;
+
+  // The encoding is only worth it if it is smaller than the values (the
+  // codes take at least one byte each)
+  uint64_t min_encoded_size = 3 * sizeof(uint64_t) + cell_num;
+
+  codes->resize(cell_num);
+  *entry_bytes = 0;
+  for (uint64_t i = 0; i < cell_num; ++i) {
+    uint64_t start = offsets[i] - offsets[0];
+    uint64_t end =
+        (i + 1 < cell_num) ? offsets[i + 1] - offsets[0] : data_size;
+    if (start > end || end > data_size)
+      return false;
+    auto cell = data + start;
+    auto size = end - start;
+
+    auto hash = hash_bytes(cell, size);
+    auto slot = hash & (capacity - 1);
+    for (;; slot = (slot + 1) & (capacity - 1)) {
+      auto code = slots[slot];
+      if (code == 0)
+        break;
+      const auto& entry = (*entries)[code - 1];
+      if (hashes[code - 1] == hash && entry.second == size &&
+          !std::memcmp(data + entry.first, cell, size))
+        break;
+    }
+    if (slots[slot] != 0) {
+      (*codes)[i] = slots[slot] - 1;
+      continue;
+    }
+
+    // New dictionary value
+    auto code = static_cast<uint32_t>(entries->size());
+    entries->emplace_back(start, size);
+    hashes.push_back(hash);
+    slots[slot] = code + 1;
+    (*codes)[i] = code;
+    *entry_bytes += size;
+    min_encoded_size += sizeof(uint64_t) + size;
+    if (min_encoded_size >= data_size)
+      return false;
+
+    // Grow the hash table
+    if (2 * entries->size() > capacity) {
+      capacity *= 2;
+      slots.assign(capacity, 0);
+      for (uint32_t c = 0; c < entries->size(); ++c) {
+        auto s = hashes[c] & (capacity - 1);
+        while (slots[s] != 0)
+          s = (s + 1) & (capacity - 1);
+        slots[s] = c + 1;
+      }
+    }
+  }
+
+  return true;
+}
+
+/** Writes the codes of the cells as `C`-typed integers. */
+template <typename C>
+static Status write_codes(const std::vector<uint32_t>& codes, Buffer* output) {
+  std::vector<C> narrowed(codes.begin(), codes.end());
+  return output->write(narrowed.data(), narrowed.size() * sizeof(C));
+}
+
+DictionaryFilter::VarTileView::VarTileView()
+    : offsets_(nullptr)
+    , cell_num_(0)
+    , code_size_(0)
+    , codes_(nullptr)
+    , entry_offsets_(nullptr)
+    , entry_num_(0)
+    , data_(nullptr)
+    , data_size_(0) {
+}
+
+Status DictionaryFilter::VarTileView::init(
+    const Tile* offsets_tile, const Tile* var_tile, bool encoded) {
+  offsets_ = static_cast<const uint64_t*>(offsets_tile->data());
+  cell_num_ = offsets_tile->cell_num();
+  code_size_ = 0;
+  data_ = static_cast<const uint8_t*>(var_tile->data());
+  data_size_ = var_tile->size();
+  entry_num_ = cell_num_;
+  if (!encoded)
+    return Status::Ok();
+
+  // Read the header
+  if (data_size_ < HEADER_SIZE)
+    return LOG_STATUS(Status::FilterError(
+        "Dictionary filter error; var tile is smaller than its header"));
+  auto encoding = static_cast<Encoding>(data_[0]);
+  auto code_size = data_[1];
+  data_ += HEADER_SIZE;
+  data_size_ -= HEADER_SIZE;
+  if (encoding == Encoding::RAW)
+    return Status::Ok();
+  if (encoding != Encoding::DICTIONARY ||
+      (code_size != 1 && code_size != 2 && code_size != 4))
+    return LOG_STATUS(Status::FilterError(
+        "Dictionary filter error; invalid var tile encoding"));
+
+  // Read the dictionary
+  auto header = reinterpret_cast<const uint64_t*>(data_);
+  if (data_size_ < 2 * sizeof(uint64_t) || header[0] != cell_num_)
+    return LOG_STATUS(Status::FilterError(
+        "Dictionary filter error; number of cells does not match the "
+        "offsets tile"));
+  entry_num_ = header[1];
+  uint64_t prefix_size = (3 + entry_num_) * sizeof(uint64_t) +
+                         cell_num_ * code_size;
+  if (entry_num_ > data_size_ || prefix_size > data_size_ ||
+      header[2 + entry_num_] != data_size_ - prefix_size)
+    return LOG_STATUS(Status::FilterError(
+        "Dictionary filter error; invalid dictionary size"));
+  code_size_ = code_size;
+  entry_offsets_ = header + 2;
+  codes_ = data_ + (3 + entry_num_) * sizeof(uint64_t);
+  data_ += prefix_size;
+  data_size_ -= prefix_size;
+
+  return Status::Ok();
+}
+
+DictionaryFilter::DictionaryFilter()
+    : Filter(FilterType::FILTER_DICTIONARY) {
+}
+
+DictionaryFilter* DictionaryFilter::clone_impl() const {
+  return new DictionaryFilter;
+}
+
+Status DictionaryFilter::run_forward(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  RETURN_NOT_OK(output->append_view(input));
+  RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+  return Status::Ok();
+}
+
+Status DictionaryFilter::run_forward_var_tile(
+    const Tile& offsets_tile, Tile* tile) const {
+  auto offsets = static_cast<const uint64_t*>(offsets_tile.data());
+  auto cell_num = offsets_tile.cell_num();
+  auto data = static_cast<const uint8_t*>(tile->data());
+  auto data_size = tile->size();
+
+  std::vector<uint32_t> codes;
+  std::vector<std::pair<uint64_t, uint64_t>> entries;
+  uint64_t entry_bytes = 0;
+  bool dictionary = cell_num > 0 && build_dictionary(
+                                        offsets,
+                                        cell_num,
+                                        data,
+                                        data_size,
+                                        &codes,
+                                        &entries,
+                                        &entry_bytes);
+
+  // Use the fewest bytes per code, and fall back to the raw values if the
+  // dictionary encoding is not smaller
+  uint64_t entry_num = entries.size();
+  uint8_t code_size = 0;
+  if (dictionary) {
+    code_size = entry_num <= (1 << 8) ? 1 : entry_num <= (1 << 16) ? 2 : 4;
+    dictionary = (3 + entry_num) * sizeof(uint64_t) + cell_num * code_size +
+                     entry_bytes <
+                 data_size;
+    if (!dictionary)
+      code_size = 0;
+  }
+
+  // Write the header
+  Buffer encoded;
+  RETURN_NOT_OK(encoded.realloc(HEADER_SIZE + data_size));
+  uint8_t header[HEADER_SIZE] = {};
+  header[0] = static_cast<uint8_t>(
+      dictionary ? Encoding::DICTIONARY : Encoding::RAW);
+  header[1] = code_size;
+  RETURN_NOT_OK(encoded.write(header, HEADER_SIZE));
+
+  // Write the data
+  if (!dictionary) {
+    RETURN_NOT_OK(encoded.write(data, data_size));
+  } else {
+    RETURN_NOT_OK(encoded.write(&cell_num, sizeof(uint64_t)));
+    RETURN_NOT_OK(encoded.write(&entry_num, sizeof(uint64_t)));
+    uint64_t entry_offset = 0;
+    for (const auto& entry : entries) {
+      RETURN_NOT_OK(encoded.write(&entry_offset, sizeof(uint64_t)));
+      entry_offset += entry.second;
+    }
+    RETURN_NOT_OK(encoded.write(&entry_offset, sizeof(uint64_t)));
+    switch (code_size) {
+      case 1:
+        RETURN_NOT_OK(write_codes<uint8_t>(codes, &encoded));
+        break;
+      case 2:
+        RETURN_NOT_OK(write_codes<uint16_t>(codes, &encoded));
+        break;
+      default:
+        RETURN_NOT_OK(write_codes<uint32_t>(codes, &encoded));
+        break;
+    }
+    for (const auto& entry : entries)
+      RETURN_NOT_OK(encoded.write(data + entry.first, entry.second));
+  }
+
+  return tile->buffer()->swap(encoded);
+}
+
+Status DictionaryFilter::run_reverse(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  RETURN_NOT_OK(output->append_view(input));
+  RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+  return Status::Ok();
+}
+
+}  // namespace sm
+}  // namespace tiledb
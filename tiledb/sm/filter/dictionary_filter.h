@@ -0,0 +1,209 @@
+/**
+ * @file   dictionary_filter.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares class DictionaryFilter.
+ */
+
+#ifndef TILEDB_DICTIONARY_FILTER_H
+#define TILEDB_DICTIONARY_FILTER_H
+
+#include "tiledb/sm/filter/filter.h"
+#include "tiledb/sm/misc/status.h"
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A filter that dictionary-encodes the values of var-sized attributes, which
+ * suits low-cardinality values such as categorical labels.
+ *
+ * Unlike the other filters, it encodes whole var tiles before the pipeline
+ * splits them into chunks (see `run_forward_var_tile`), as it needs the cell
+ * boundaries given by the offsets tile. The distinct values of the tile form
+ * its dictionary, and each cell is stored as the integer code of its value,
+ * i.e., the position of the value in the dictionary. Codes take the fewest
+ * bytes (1, 2 or 4) that fit all of them. If the encoded tile would not be
+ * smaller than the original one, the values are stored unmodified. The
+ * offsets tile is not modified, and the chunks are passed through the filter
+ * unmodified in both directions.
+ *
+ * The encoded var tile has the format:
+ *   uint8_t - Encoding (`RAW` or `DICTIONARY`)
+ *   uint8_t - Number of bytes C of a code (0 for `RAW`)
+ *   uint8_t[6] - Reserved (zeros)
+ *
+ * followed by, for the `RAW` encoding:
+ *   uint8_t[] - The original values
+ *
+ * and for the `DICTIONARY` encoding:
+ *   uint64_t - Number of cells N
+ *   uint64_t - Number of dictionary values D
+ *   uint64_t[D + 1] - Offsets of the dictionary values in the value data
+ *   uint8_t[N * C] - Codes of the cells
+ *   uint8_t[] - Value data (the concatenated dictionary values)
+ *
+ * Running the pipeline in reverse yields the encoded var tile, since undoing
+ * the encoding would defeat its purpose: the readers access the cells through
+ * a `VarTileView`, and may evaluate a predicate once per dictionary value
+ * rather than once per cell.
+ */
+class DictionaryFilter : public Filter {
+ public:
+  /** The encoding of a var tile. */
+  enum class Encoding : uint8_t { RAW = 0, DICTIONARY = 1 };
+
+  /** Size in bytes of the header of an encoded var tile. */
+  static const uint64_t HEADER_SIZE = 8;
+
+  /**
+   * A read-only view of the cells of an unfiltered var tile, which may be
+   * dictionary-encoded. A tile that is not dictionary-encoded is viewed as
+   * having a dictionary value per cell.
+   */
+  class VarTileView {
+   public:
+    /** Constructor. */
+    VarTileView();
+
+    /**
+     * Initializes the view.
+     *
+     * @param offsets_tile The unfiltered offsets tile.
+     * @param var_tile The unfiltered var tile.
+     * @param encoded `true` if `var_tile` was written by a pipeline with a
+     *     dictionary filter, i.e., it is in the encoded format.
+     * @return Status
+     */
+    Status init(const Tile* offsets_tile, const Tile* var_tile, bool encoded);
+
+    /** Returns the value of a cell, storing its size in `size`. */
+    inline const uint8_t* cell(uint64_t cell_idx, uint64_t* size) const {
+      return entry(code(cell_idx), size);
+    }
+
+    /** Returns the number of cells. */
+    inline uint64_t cell_num() const {
+      return cell_num_;
+    }
+
+    /** Returns the code of a cell. */
+    inline uint64_t code(uint64_t cell_idx) const {
+      switch (code_size_) {
+        case 1:
+          return codes_[cell_idx];
+        case 2:
+          return reinterpret_cast<const uint16_t*>(codes_)[cell_idx];
+        case 4:
+          return reinterpret_cast<const uint32_t*>(codes_)[cell_idx];
+        default:
+          return cell_idx;
+      }
+    }
+
+    /** Returns `true` if the tile is dictionary-encoded. */
+    inline bool dictionary() const {
+      return code_size_ != 0;
+    }
+
+    /** Returns the dictionary value with the given code. */
+    inline const uint8_t* entry(uint64_t code, uint64_t* size) const {
+      uint64_t start, end;
+      if (dictionary()) {
+        start = entry_offsets_[code];
+        end = entry_offsets_[code + 1];
+      } else {
+        start = offsets_[code] - offsets_[0];
+        end = (code + 1 < cell_num_) ? offsets_[code + 1] - offsets_[0] :
+                                       data_size_;
+      }
+      *size = end - start;
+      return data_ + start;
+    }
+
+    /** Returns the number of dictionary values. */
+    inline uint64_t entry_num() const {
+      return entry_num_;
+    }
+
+   private:
+    /** The cell offsets (for the `RAW` encoding). */
+    const uint64_t* offsets_;
+
+    /** The number of cells. */
+    uint64_t cell_num_;
+
+    /** The number of bytes of a code (0 if not dictionary-encoded). */
+    uint8_t code_size_;
+
+    /** The codes of the cells. */
+    const uint8_t* codes_;
+
+    /** The offsets of the dictionary values in `data_`. */
+    const uint64_t* entry_offsets_;
+
+    /** The number of dictionary values. */
+    uint64_t entry_num_;
+
+    /** The value data. */
+    const uint8_t* data_;
+
+    /** The size of the value data in bytes. */
+    uint64_t data_size_;
+  };
+
+  /** Constructor. */
+  DictionaryFilter();
+
+  /** Passes the input through unmodified. */
+  Status run_forward(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+  /** Dictionary-encodes the given var tile. */
+  Status run_forward_var_tile(
+      const Tile& offsets_tile, Tile* tile) const override;
+
+  /** Passes the input through unmodified. */
+  Status run_reverse(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+ private:
+  /** Returns a new clone of this filter. */
+  DictionaryFilter* clone_impl() const override;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_DICTIONARY_FILTER_H
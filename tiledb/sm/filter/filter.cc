@@ -31,12 +31,16 @@
  */
 
 #include "tiledb/sm/filter/filter.h"
+#include "tiledb/sm/filter/adaptive_filter.h"
 #include "tiledb/sm/filter/bit_width_reduction_filter.h"
 #include "tiledb/sm/filter/bitshuffle_filter.h"
 #include "tiledb/sm/filter/byteshuffle_filter.h"
 #include "tiledb/sm/filter/compression_filter.h"
+#include "tiledb/sm/filter/dictionary_filter.h"
 #include "tiledb/sm/filter/encryption_aes256gcm_filter.h"
+#include "tiledb/sm/filter/float_plane_filter.h"
 #include "tiledb/sm/filter/noop_filter.h"
+#include "tiledb/sm/filter/pfor_filter.h"
 #include "tiledb/sm/filter/positive_delta_filter.h"
 #include "tiledb/sm/misc/logger.h"
 
@@ -75,6 +79,14 @@ Filter* Filter::create(FilterType type) {
       return new (std::nothrow) ByteshuffleFilter();
     case FilterType::FILTER_POSITIVE_DELTA:
       return new (std::nothrow) PositiveDeltaFilter();
+    case FilterType::FILTER_PFOR:
+      return new (std::nothrow) PFORFilter();
+    case FilterType::FILTER_FLOAT_PLANE:
+      return new (std::nothrow) FloatPlaneFilter();
+    case FilterType::FILTER_DICTIONARY:
+      return new (std::nothrow) DictionaryFilter();
+    case FilterType::FILTER_ADAPTIVE:
+      return new (std::nothrow) AdaptiveFilter();
     case FilterType::INTERNAL_FILTER_AES_256_GCM:
       return new (std::nothrow) EncryptionAES256GCMFilter();
     default:
@@ -95,6 +107,13 @@ Status Filter::set_option(FilterOption option, const void* value) {
   return set_option_impl(option, value);
 }
 
+Status Filter::run_forward_var_tile(
+    const Tile& offsets_tile, Tile* tile) const {
+  (void)offsets_tile;
+  (void)tile;
+  return Status::Ok();
+}
+
 Status Filter::deserialize(ConstBuffer* buff, Filter** filter) {
   uint8_t type;
   RETURN_NOT_OK(buff->read(&type, sizeof(uint8_t)));
@@ -105,14 +124,23 @@ Status Filter::deserialize(ConstBuffer* buff, Filter** filter) {
   if (f == nullptr)
     return LOG_STATUS(Status::FilterError("Deserialization error."));
 
-  auto offset = buff->offset();
-  RETURN_NOT_OK_ELSE(f->deserialize_impl(buff), delete f);
+  if (filter_metadata_len > buff->nbytes_left_to_read()) {
+    delete f;
+    return LOG_STATUS(Status::FilterError(
+        "Deserialization error; unexpected metadata length"));
+  }
+
+  // The filter sees its own metadata only, so that it can tell where
+  // optional trailing fields end
+  ConstBuffer metadata(buff->cur_data(), filter_metadata_len);
+  RETURN_NOT_OK_ELSE(f->deserialize_impl(&metadata), delete f);
 
-  if (buff->offset() - offset != filter_metadata_len) {
+  if (metadata.offset() != filter_metadata_len) {
     delete f;
     return LOG_STATUS(Status::FilterError(
         "Deserialization error; unexpected metadata length"));
   }
+  buff->advance_offset(filter_metadata_len);
 
   *filter = f;
 
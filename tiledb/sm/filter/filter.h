@@ -42,6 +42,7 @@ namespace tiledb {
 namespace sm {
 
 class FilterPipeline;
+class Tile;
 
 /**
  * A Filter processes or modifies a byte region, modifying it in place, or
@@ -132,6 +133,22 @@ class Filter {
       FilterBuffer* output_metadata,
       FilterBuffer* output) const = 0;
 
+  /**
+   * Encodes a whole var-sized attribute tile in place, before the pipeline
+   * splits it into chunks (see `FilterPipeline::run_forward`). This is for
+   * filters that need the cell boundaries, which the chunks do not preserve.
+   * The encoding is not undone by `run_reverse`; the readers of the
+   * unfiltered tile are responsible for interpreting it.
+   *
+   * The default implementation leaves the tile unmodified.
+   *
+   * @param offsets_tile The unfiltered offsets tile of `tile`.
+   * @param tile The var-sized tile to encode.
+   * @return Status
+   */
+  virtual Status run_forward_var_tile(
+      const Tile& offsets_tile, Tile* tile) const;
+
   /**
    * Sets an option on this filter.
    *
@@ -176,7 +193,8 @@ class Filter {
    * If a filter subclass has no specific metadata, it's not necessary to
    * implement this method.
    *
-   * @param buff The buffer to deserialize from
+   * @param buff The buffer to deserialize from, holding exactly the metadata
+   *     of this filter
    * @return Status
    */
   virtual Status deserialize_impl(ConstBuffer* buff);
@@ -0,0 +1,417 @@
+/**
+ * @file   filter_kernels.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines the element-wise kernels used by the bit width reduction
+ * and positive delta filters.
+ *
+ * Each kernel is written once as a plain loop, which is then compiled for
+ * several instruction sets through the `target` function attribute and
+ * selected at runtime. The loops are simple enough for the compiler to
+ * vectorize, except for the prefix sum of `delta_decode`, which is
+ * implemented with SSE intrinsics.
+ */
+
+#include "tiledb/sm/filter/filter_kernels.h"
+
+#include <limits>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define TILEDB_FILTER_KERNELS_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#define TILEDB_KERNEL_INLINE inline __attribute__((always_inline))
+#define TILEDB_KERNEL_TARGET(isa) __attribute__((target(isa)))
+#else
+#define TILEDB_KERNEL_INLINE inline
+#endif
+
+namespace tiledb {
+namespace sm {
+namespace filter_kernels {
+
+namespace {
+
+/* ********************************* */
+/*          PORTABLE LOOPS           */
+/* ********************************* */
+
+/*
+ * The arithmetic is carried out on the unsigned counterpart of the element
+ * type, so that it wraps around instead of overflowing.
+ */
+
+template <typename T>
+TILEDB_KERNEL_INLINE void min_max_loop(
+    const T* values, uint64_t num, T* min, T* max) {
+  T lo = std::numeric_limits<T>::max(), hi = std::numeric_limits<T>::lowest();
+  for (uint64_t i = 0; i < num; i++) {
+    lo = values[i] < lo ? values[i] : lo;
+    hi = values[i] > hi ? values[i] : hi;
+  }
+  *min = lo;
+  *max = hi;
+}
+
+template <typename T, typename U>
+TILEDB_KERNEL_INLINE void narrow_loop(
+    const T* values, uint64_t num, T offset, U* out) {
+  typedef typename std::make_unsigned<T>::type UT;
+  for (uint64_t i = 0; i < num; i++)
+    out[i] = static_cast<U>(
+        static_cast<UT>(values[i]) - static_cast<UT>(offset));
+}
+
+template <typename T, typename U>
+TILEDB_KERNEL_INLINE void widen_loop(
+    const U* values, uint64_t num, T offset, T* out) {
+  typedef typename std::make_unsigned<T>::type UT;
+  for (uint64_t i = 0; i < num; i++)
+    out[i] = static_cast<T>(
+        static_cast<UT>(static_cast<T>(values[i])) + static_cast<UT>(offset));
+}
+
+template <typename T>
+TILEDB_KERNEL_INLINE bool delta_encode_loop(
+    const T* values, uint64_t num, T prev, T* out) {
+  typedef typename std::make_unsigned<T>::type UT;
+  if (num == 0)
+    return true;
+  uint8_t decreasing = values[0] < prev;
+  out[0] = static_cast<T>(static_cast<UT>(values[0]) - static_cast<UT>(prev));
+  for (uint64_t i = 1; i < num; i++) {
+    decreasing |= values[i] < values[i - 1];
+    out[i] = static_cast<T>(
+        static_cast<UT>(values[i]) - static_cast<UT>(values[i - 1]));
+  }
+  return decreasing == 0;
+}
+
+template <typename T>
+TILEDB_KERNEL_INLINE void delta_decode_loop(
+    const T* deltas, uint64_t num, T prev, T* out) {
+  typedef typename std::make_unsigned<T>::type UT;
+  auto sum = static_cast<UT>(prev);
+  for (uint64_t i = 0; i < num; i++) {
+    sum += static_cast<UT>(deltas[i]);
+    out[i] = static_cast<T>(sum);
+  }
+}
+
+#ifdef TILEDB_FILTER_KERNELS_X86
+
+/* ********************************* */
+/*         SSE4.1 AND AVX2           */
+/* ********************************* */
+
+template <typename T>
+TILEDB_KERNEL_TARGET("sse4.1")
+void min_max_sse41(const T* values, uint64_t num, T* min, T* max) {
+  min_max_loop(values, num, min, max);
+}
+
+template <typename T>
+TILEDB_KERNEL_TARGET("avx2")
+void min_max_avx2(const T* values, uint64_t num, T* min, T* max) {
+  min_max_loop(values, num, min, max);
+}
+
+template <typename T, typename U>
+TILEDB_KERNEL_TARGET("sse4.1")
+void narrow_sse41(const T* values, uint64_t num, T offset, U* out) {
+  narrow_loop(values, num, offset, out);
+}
+
+template <typename T, typename U>
+TILEDB_KERNEL_TARGET("avx2")
+void narrow_avx2(const T* values, uint64_t num, T offset, U* out) {
+  narrow_loop(values, num, offset, out);
+}
+
+template <typename T, typename U>
+TILEDB_KERNEL_TARGET("sse4.1")
+void widen_sse41(const U* values, uint64_t num, T offset, T* out) {
+  widen_loop(values, num, offset, out);
+}
+
+template <typename T, typename U>
+TILEDB_KERNEL_TARGET("avx2")
+void widen_avx2(const U* values, uint64_t num, T offset, T* out) {
+  widen_loop(values, num, offset, out);
+}
+
+template <typename T>
+TILEDB_KERNEL_TARGET("sse4.1")
+bool delta_encode_sse41(const T* values, uint64_t num, T prev, T* out) {
+  return delta_encode_loop(values, num, prev, out);
+}
+
+template <typename T>
+TILEDB_KERNEL_TARGET("avx2")
+bool delta_encode_avx2(const T* values, uint64_t num, T prev, T* out) {
+  return delta_encode_loop(values, num, prev, out);
+}
+
+/** Lane-wise operations on 128-bit vectors of `W`-byte integers. */
+template <unsigned W>
+struct Lanes;
+
+template <>
+struct Lanes<1> {
+  static TILEDB_KERNEL_TARGET("sse4.1") __m128i add(__m128i a, __m128i b) {
+    return _mm_add_epi8(a, b);
+  }
+  static TILEDB_KERNEL_TARGET("sse4.1") __m128i set1(uint64_t v) {
+    return _mm_set1_epi8(static_cast<char>(v));
+  }
+  static TILEDB_KERNEL_TARGET("sse4.1") __m128i broadcast_last(__m128i a) {
+    return _mm_shuffle_epi8(a, _mm_set1_epi8(15));
+  }
+};
+
+template <>
+struct Lanes<2> {
+  static TILEDB_KERNEL_TARGET("sse4.1") __m128i add(__m128i a, __m128i b) {
+    return _mm_add_epi16(a, b);
+  }
+  static TILEDB_KERNEL_TARGET("sse4.1") __m128i set1(uint64_t v) {
+    return _mm_set1_epi16(static_cast<short>(v));
+  }
+  static TILEDB_KERNEL_TARGET("sse4.1") __m128i broadcast_last(__m128i a) {
+    return _mm_shuffle_epi8(a, _mm_set1_epi16(0x0F0E));
+  }
+};
+
+template <>
+struct Lanes<4> {
+  static TILEDB_KERNEL_TARGET("sse4.1") __m128i add(__m128i a, __m128i b) {
+    return _mm_add_epi32(a, b);
+  }
+  static TILEDB_KERNEL_TARGET("sse4.1") __m128i set1(uint64_t v) {
+    return _mm_set1_epi32(static_cast<int>(v));
+  }
+  static TILEDB_KERNEL_TARGET("sse4.1") __m128i broadcast_last(__m128i a) {
+    return _mm_shuffle_epi32(a, 0xFF);
+  }
+};
+
+template <>
+struct Lanes<8> {
+  static TILEDB_KERNEL_TARGET("sse4.1") __m128i add(__m128i a, __m128i b) {
+    return _mm_add_epi64(a, b);
+  }
+  static TILEDB_KERNEL_TARGET("sse4.1") __m128i set1(uint64_t v) {
+    return _mm_set1_epi64x(static_cast<long long>(v));
+  }
+  static TILEDB_KERNEL_TARGET("sse4.1") __m128i broadcast_last(__m128i a) {
+    return _mm_shuffle_epi32(a, 0xEE);
+  }
+};
+
+/**
+ * Computes the prefix sums 16 bytes at a time: the sums within a vector are
+ * computed with log2(lanes) shift-and-add steps, and the last sum of each
+ * vector is carried over to the next one. Wider vectors would need a
+ * cross-lane fix-up step that costs as much as it saves, so this is used for
+ * AVX2 as well.
+ */
+template <typename T>
+TILEDB_KERNEL_TARGET("sse4.1")
+void delta_decode_sse41(const T* deltas, uint64_t num, T prev, T* out) {
+  typedef Lanes<sizeof(T)> L;
+  const uint64_t lanes = 16 / sizeof(T);
+  __m128i carry = L::set1(static_cast<uint64_t>(prev));
+  uint64_t i = 0;
+  for (; i + lanes <= num; i += lanes) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(deltas + i));
+    v = L::add(v, _mm_slli_si128(v, sizeof(T)));
+    if (sizeof(T) <= 4)
+      v = L::add(v, _mm_slli_si128(v, 2 * sizeof(T)));
+    if (sizeof(T) <= 2)
+      v = L::add(v, _mm_slli_si128(v, 4 * sizeof(T)));
+    if (sizeof(T) == 1)
+      v = L::add(v, _mm_slli_si128(v, 8));
+    v = L::add(v, carry);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), v);
+    carry = L::broadcast_last(v);
+  }
+  delta_decode_loop(deltas + i, num - i, i == 0 ? prev : out[i - 1], out + i);
+}
+
+#endif  // TILEDB_FILTER_KERNELS_X86
+
+/*
+ * The CPU features are queried with `cpuid` directly rather than with
+ * `__builtin_cpu_supports`, as the latter clashes with the `__cpu_model`
+ * work-around in misc/work_arounds.cc.
+ */
+KernelIsa detect_isa() {
+#ifdef TILEDB_FILTER_KERNELS_X86
+  unsigned eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_SSE4_1))
+    return KernelIsa::SCALAR;
+
+  // AVX2 also requires the OS to save the YMM registers on context switches.
+  if ((ecx & bit_OSXSAVE) && (ecx & bit_AVX)) {
+    unsigned xcr0_lo, xcr0_hi;
+    __asm__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    if ((xcr0_lo & 0x6) == 0x6 &&
+        __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & bit_AVX2))
+      return KernelIsa::AVX2;
+  }
+  return KernelIsa::SSE4_1;
+#else
+  return KernelIsa::SCALAR;
+#endif
+}
+
+}  // namespace
+
+/* ********************************* */
+/*                API                */
+/* ********************************* */
+
+KernelIsa best_isa() {
+  static const KernelIsa isa = detect_isa();
+  return isa;
+}
+
+bool isa_supported(KernelIsa isa) {
+  return static_cast<uint8_t>(isa) <= static_cast<uint8_t>(best_isa());
+}
+
+template <typename T>
+void min_max(const T* values, uint64_t num, T* min, T* max, KernelIsa isa) {
+  switch (isa) {
+#ifdef TILEDB_FILTER_KERNELS_X86
+    case KernelIsa::AVX2:
+      return min_max_avx2(values, num, min, max);
+    case KernelIsa::SSE4_1:
+      return min_max_sse41(values, num, min, max);
+#endif
+    default:
+      return min_max_loop(values, num, min, max);
+  }
+}
+
+template <typename T, typename U>
+void narrow(const T* values, uint64_t num, T offset, U* out, KernelIsa isa) {
+  switch (isa) {
+#ifdef TILEDB_FILTER_KERNELS_X86
+    case KernelIsa::AVX2:
+      return narrow_avx2(values, num, offset, out);
+    case KernelIsa::SSE4_1:
+      return narrow_sse41(values, num, offset, out);
+#endif
+    default:
+      return narrow_loop(values, num, offset, out);
+  }
+}
+
+template <typename T, typename U>
+void widen(const U* values, uint64_t num, T offset, T* out, KernelIsa isa) {
+  switch (isa) {
+#ifdef TILEDB_FILTER_KERNELS_X86
+    case KernelIsa::AVX2:
+      return widen_avx2(values, num, offset, out);
+    case KernelIsa::SSE4_1:
+      return widen_sse41(values, num, offset, out);
+#endif
+    default:
+      return widen_loop(values, num, offset, out);
+  }
+}
+
+template <typename T>
+bool delta_encode(
+    const T* values, uint64_t num, T prev, T* out, KernelIsa isa) {
+  switch (isa) {
+#ifdef TILEDB_FILTER_KERNELS_X86
+    case KernelIsa::AVX2:
+      return delta_encode_avx2(values, num, prev, out);
+    case KernelIsa::SSE4_1:
+      return delta_encode_sse41(values, num, prev, out);
+#endif
+    default:
+      return delta_encode_loop(values, num, prev, out);
+  }
+}
+
+template <typename T>
+void delta_decode(
+    const T* deltas, uint64_t num, T prev, T* out, KernelIsa isa) {
+  switch (isa) {
+#ifdef TILEDB_FILTER_KERNELS_X86
+    case KernelIsa::AVX2:
+    case KernelIsa::SSE4_1:
+      return delta_decode_sse41(deltas, num, prev, out);
+#endif
+    default:
+      return delta_decode_loop(deltas, num, prev, out);
+  }
+}
+
+/* ********************************* */
+/*     EXPLICIT INSTANTIATIONS       */
+/* ********************************* */
+
+#define TILEDB_KERNELS_INSTANTIATE(T)                                      \
+  template void min_max<T>(const T*, uint64_t, T*, T*, KernelIsa);         \
+  template bool delta_encode<T>(const T*, uint64_t, T, T*, KernelIsa);     \
+  template void delta_decode<T>(const T*, uint64_t, T, T*, KernelIsa);
+
+#define TILEDB_KERNELS_INSTANTIATE_NARROW(T, U)                            \
+  template void narrow<T, U>(const T*, uint64_t, T, U*, KernelIsa);        \
+  template void widen<T, U>(const U*, uint64_t, T, T*, KernelIsa);
+
+TILEDB_KERNELS_INSTANTIATE(int8_t)
+TILEDB_KERNELS_INSTANTIATE(uint8_t)
+TILEDB_KERNELS_INSTANTIATE(int16_t)
+TILEDB_KERNELS_INSTANTIATE(uint16_t)
+TILEDB_KERNELS_INSTANTIATE(int32_t)
+TILEDB_KERNELS_INSTANTIATE(uint32_t)
+TILEDB_KERNELS_INSTANTIATE(int64_t)
+TILEDB_KERNELS_INSTANTIATE(uint64_t)
+
+TILEDB_KERNELS_INSTANTIATE_NARROW(int16_t, int8_t)
+TILEDB_KERNELS_INSTANTIATE_NARROW(int32_t, int8_t)
+TILEDB_KERNELS_INSTANTIATE_NARROW(int32_t, int16_t)
+TILEDB_KERNELS_INSTANTIATE_NARROW(int64_t, int8_t)
+TILEDB_KERNELS_INSTANTIATE_NARROW(int64_t, int16_t)
+TILEDB_KERNELS_INSTANTIATE_NARROW(int64_t, int32_t)
+TILEDB_KERNELS_INSTANTIATE_NARROW(uint16_t, uint8_t)
+TILEDB_KERNELS_INSTANTIATE_NARROW(uint32_t, uint8_t)
+TILEDB_KERNELS_INSTANTIATE_NARROW(uint32_t, uint16_t)
+TILEDB_KERNELS_INSTANTIATE_NARROW(uint64_t, uint8_t)
+TILEDB_KERNELS_INSTANTIATE_NARROW(uint64_t, uint16_t)
+TILEDB_KERNELS_INSTANTIATE_NARROW(uint64_t, uint32_t)
+
+}  // namespace filter_kernels
+}  // namespace sm
+}  // namespace tiledb
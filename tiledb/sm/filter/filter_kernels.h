@@ -0,0 +1,135 @@
+/**
+ * @file   filter_kernels.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares the element-wise kernels used by the bit width reduction
+ * and positive delta filters.
+ */
+
+#ifndef TILEDB_FILTER_KERNELS_H
+#define TILEDB_FILTER_KERNELS_H
+
+#include <cstdint>
+
+namespace tiledb {
+namespace sm {
+namespace filter_kernels {
+
+/**
+ * The instruction sets the kernels are compiled for. Every kernel has a
+ * portable scalar implementation, plus SSE4.1 and AVX2 ones on x86 builds
+ * with GCC or Clang. All implementations produce identical output.
+ */
+enum class KernelIsa : uint8_t { SCALAR, SSE4_1, AVX2 };
+
+/**
+ * Returns the best instruction set supported by both the build and the CPU
+ * the process runs on. It is detected once, on the first call.
+ */
+KernelIsa best_isa();
+
+/**
+ * Returns `true` if both the build and the CPU support the given instruction
+ * set.
+ */
+bool isa_supported(KernelIsa isa);
+
+/**
+ * Computes the minimum and maximum of `num` values. If `num` is zero, `min`
+ * and `max` are set to the largest and lowest values of T respectively.
+ *
+ * @tparam T An integral type.
+ */
+template <typename T>
+void min_max(
+    const T* values, uint64_t num, T* min, T* max, KernelIsa isa = best_isa());
+
+/**
+ * Writes `out[i] = U(values[i] - offset)` for the `num` input values, i.e.,
+ * the values relative to `offset` truncated to the narrower type `U`.
+ *
+ * @tparam T An integral type.
+ * @tparam U An integral type of the same signedness, at most as wide as `T`.
+ */
+template <typename T, typename U>
+void narrow(
+    const T* values,
+    uint64_t num,
+    T offset,
+    U* out,
+    KernelIsa isa = best_isa());
+
+/**
+ * The inverse of `narrow`: writes `out[i] = T(values[i]) + offset`.
+ *
+ * @tparam T An integral type.
+ * @tparam U An integral type of the same signedness, at most as wide as `T`.
+ */
+template <typename T, typename U>
+void widen(
+    const U* values,
+    uint64_t num,
+    T offset,
+    T* out,
+    KernelIsa isa = best_isa());
+
+/**
+ * Delta-encodes `num` values, writing `out[i] = values[i] - values[i - 1]`,
+ * where `values[-1]` is taken to be `prev`.
+ *
+ * @tparam T An integral type.
+ * @return `false` if some value is smaller than its predecessor (the output
+ *     is still written), `true` otherwise.
+ */
+template <typename T>
+bool delta_encode(
+    const T* values,
+    uint64_t num,
+    T prev,
+    T* out,
+    KernelIsa isa = best_isa());
+
+/**
+ * The inverse of `delta_encode`: writes the prefix sums of the `num` input
+ * deltas, starting from `prev`.
+ *
+ * @tparam T An integral type.
+ */
+template <typename T>
+void delta_decode(
+    const T* deltas,
+    uint64_t num,
+    T prev,
+    T* out,
+    KernelIsa isa = best_isa());
+
+}  // namespace filter_kernels
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_FILTER_KERNELS_H
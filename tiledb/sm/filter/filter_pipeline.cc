@@ -348,11 +348,18 @@ uint32_t FilterPipeline::max_chunk_size() const {
   return max_chunk_size_;
 }
 
-Status FilterPipeline::run_forward(Tile* tile) const {
+Status FilterPipeline::run_forward(
+    Tile* tile, const Tile* offsets_tile) const {
   STATS_FUNC_IN(filter_pipeline_run_forward);
 
   current_tile_ = tile;
 
+  // Encode whole var tiles, which requires their cell boundaries
+  if (offsets_tile != nullptr) {
+    for (const auto& filter : filters_)
+      RETURN_NOT_OK(filter->run_forward_var_tile(*offsets_tile, tile));
+  }
+
   // Split the coords if the tile stores coordinates.
   if (tile->stores_coords())
     tile->split_coordinates();
@@ -163,10 +163,16 @@ class FilterPipeline {
    * The given Tile's underlying buffer is modified to contain the filtered
    * data.
    *
+   * If the tile is a var-sized attribute tile, its offsets tile may be given
+   * so that the filters encoding whole var tiles (see
+   * `Filter::run_forward_var_tile`) can run before the tile is chunked.
+   *
    * @param tile Tile to filter.
+   * @param offsets_tile The unfiltered offsets tile of `tile`, if `tile` is a
+   *     var-sized attribute tile, or `nullptr`.
    * @return Status
    */
-  Status run_forward(Tile* tile) const;
+  Status run_forward(Tile* tile, const Tile* offsets_tile = nullptr) const;
 
   /**
    * Runs the pipeline in reverse on the given filtered tile. This is used
@@ -0,0 +1,406 @@
+/**
+ * @file   float_plane_filter.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class FloatPlaneFilter.
+ */
+
+#include "tiledb/sm/filter/float_plane_filter.h"
+#include "blosc/shuffle.h"
+#include "tiledb/sm/compressors/zstd_compressor.h"
+#include "tiledb/sm/filter/filter_kernels.h"
+#include "tiledb/sm/filter/filter_pipeline.h"
+#include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/tile/tile.h"
+
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * Planes whose order-0 entropy exceeds this many bits per byte are stored
+ * raw: compressing them would save less than 1.25% of their size.
+ */
+static const double RAW_PLANE_ENTROPY_BITS = 7.9;
+
+FloatPlaneFilter::FloatPlaneFilter()
+    : FloatPlaneFilter(1) {
+}
+
+FloatPlaneFilter::FloatPlaneFilter(int level)
+    : Filter(FilterType::FILTER_FLOAT_PLANE) {
+  level_ = level;
+}
+
+int FloatPlaneFilter::compression_level() const {
+  return level_;
+}
+
+void FloatPlaneFilter::set_compression_level(int compression_level) {
+  level_ = compression_level;
+}
+
+FloatPlaneFilter* FloatPlaneFilter::clone_impl() const {
+  return new FloatPlaneFilter(level_);
+}
+
+Status FloatPlaneFilter::run_forward(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  switch (pipeline_->current_tile()->type()) {
+    case Datatype::FLOAT32:
+      return run_forward<uint32_t>(
+          input_metadata, input, output_metadata, output);
+    case Datatype::FLOAT64:
+      return run_forward<uint64_t>(
+          input_metadata, input, output_metadata, output);
+    default:
+      // If encoding can't work, just return the input unmodified.
+      RETURN_NOT_OK(output->append_view(input));
+      RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+      return Status::Ok();
+  }
+}
+
+template <typename T>
+Status FloatPlaneFilter::run_forward(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  // Compute the upper bound on the size of the output: a compressed plane
+  // is only kept if it is smaller than the raw one.
+  std::vector<ConstBuffer> parts = input->buffers();
+  auto num_parts = (uint32_t)parts.size();
+  uint64_t output_size_ub = 0;
+  for (const auto& part : parts)
+    output_size_ub +=
+        sizeof(T) + sizeof(T) * (1 + sizeof(uint32_t)) + part.size();
+
+  RETURN_NOT_OK(output->prepend_buffer(output_size_ub));
+  Buffer* output_buf = output->buffer_ptr(0);
+  assert(output_buf != nullptr);
+
+  // Forward the existing metadata
+  RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+  // Allocate a buffer for this filter's metadata and write the header.
+  uint32_t metadata_size = sizeof(uint32_t) + num_parts * 2 * sizeof(uint32_t);
+  RETURN_NOT_OK(output_metadata->prepend_buffer(metadata_size));
+  RETURN_NOT_OK(output_metadata->write(&num_parts, sizeof(uint32_t)));
+
+  // Encode all parts.
+  for (const auto& part : parts) {
+    auto offset = output_buf->offset();
+    RETURN_NOT_OK(encode_part<T>(&part, output_buf));
+    auto part_size = (uint32_t)part.size();
+    auto encoded_size = (uint32_t)(output_buf->offset() - offset);
+    RETURN_NOT_OK(output_metadata->write(&part_size, sizeof(uint32_t)));
+    RETURN_NOT_OK(output_metadata->write(&encoded_size, sizeof(uint32_t)));
+  }
+
+  return Status::Ok();
+}
+
+template <typename T>
+Status FloatPlaneFilter::encode_part(
+    const ConstBuffer* input, Buffer* output) const {
+  uint64_t cell_num = input->size() / sizeof(T);
+  auto out = static_cast<uint8_t*>(output->cur_data());
+  auto out_begin = out;
+
+  if (cell_num > 0) {
+    // Delta-encode the bit patterns starting from the first one, which is
+    // written as is.
+    auto values = static_cast<const T*>(input->data());
+    std::memcpy(out, values, sizeof(T));
+    out += sizeof(T);
+    std::unique_ptr<T[]> deltas(new T[cell_num]);
+    filter_kernels::delta_encode(values, cell_num, values[0], deltas.get());
+
+    // Zigzag-encode the (wrapped around) deltas, and split them into byte
+    // planes.
+    const unsigned sign_shift = 8 * sizeof(T) - 1;
+    for (uint64_t i = 0; i < cell_num; i++)
+      deltas[i] = (deltas[i] << 1) ^ (T(0) - (deltas[i] >> sign_shift));
+    std::unique_ptr<uint8_t[]> planes(new uint8_t[cell_num * sizeof(T)]);
+    blosc::shuffle(
+        sizeof(T),
+        cell_num * sizeof(T),
+        reinterpret_cast<const uint8_t*>(deltas.get()),
+        planes.get());
+
+    Buffer scratch;
+    RETURN_NOT_OK(scratch.realloc(cell_num + ZStd::overhead(cell_num)));
+    for (unsigned k = 0; k < sizeof(T); k++)
+      RETURN_NOT_OK(
+          encode_plane(&planes[k * cell_num], cell_num, &scratch, &out));
+  }
+
+  // Copy the trailing bytes that do not form a whole value.
+  uint64_t trailing_size = input->size() % sizeof(T);
+  std::memcpy(
+      out,
+      static_cast<const uint8_t*>(input->data()) + cell_num * sizeof(T),
+      trailing_size);
+  out += trailing_size;
+
+  auto nbytes = static_cast<uint64_t>(out - out_begin);
+  if (output->owns_data())
+    output->advance_size(nbytes);
+  output->advance_offset(nbytes);
+
+  return Status::Ok();
+}
+
+Status FloatPlaneFilter::encode_plane(
+    const uint8_t* plane,
+    uint64_t nbytes,
+    Buffer* scratch,
+    uint8_t** output) const {
+  uint8_t* out = *output;
+
+  // Estimate the order-0 entropy of the plane.
+  uint64_t histogram[256] = {0};
+  for (uint64_t i = 0; i < nbytes; i++)
+    histogram[plane[i]]++;
+  double entropy_bits = 0;
+  for (unsigned v = 0; v < 256; v++) {
+    if (histogram[v] == nbytes) {
+      *out++ = static_cast<uint8_t>(PlaneEncoding::CONSTANT);
+      *out++ = static_cast<uint8_t>(v);
+      *output = out;
+      return Status::Ok();
+    }
+    if (histogram[v] > 0)
+      entropy_bits -=
+          histogram[v] * std::log2(static_cast<double>(histogram[v]) / nbytes);
+  }
+
+  // Compress the plane if it is not close to random.
+  if (entropy_bits < RAW_PLANE_ENTROPY_BITS * nbytes) {
+    ConstBuffer input_buffer(plane, nbytes);
+    scratch->reset_size();
+    scratch->reset_offset();
+    RETURN_NOT_OK(ZStd::compress(level_, &input_buffer, scratch));
+    if (scratch->size() < nbytes) {
+      auto compressed_size = static_cast<uint32_t>(scratch->size());
+      *out++ = static_cast<uint8_t>(PlaneEncoding::ZSTD);
+      std::memcpy(out, &compressed_size, sizeof(uint32_t));
+      out += sizeof(uint32_t);
+      std::memcpy(out, scratch->data(), compressed_size);
+      *output = out + compressed_size;
+      return Status::Ok();
+    }
+  }
+
+  *out++ = static_cast<uint8_t>(PlaneEncoding::RAW);
+  std::memcpy(out, plane, nbytes);
+  *output = out + nbytes;
+  return Status::Ok();
+}
+
+Status FloatPlaneFilter::run_reverse(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  switch (pipeline_->current_tile()->type()) {
+    case Datatype::FLOAT32:
+      return run_reverse<uint32_t>(
+          input_metadata, input, output_metadata, output);
+    case Datatype::FLOAT64:
+      return run_reverse<uint64_t>(
+          input_metadata, input, output_metadata, output);
+    default:
+      // If encoding wasn't applied, just return the input unmodified.
+      RETURN_NOT_OK(output->append_view(input));
+      RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+      return Status::Ok();
+  }
+}
+
+template <typename T>
+Status FloatPlaneFilter::run_reverse(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  // Read the original and encoded sizes of all parts.
+  uint32_t num_parts;
+  RETURN_NOT_OK(input_metadata->read(&num_parts, sizeof(uint32_t)));
+  std::vector<std::pair<uint32_t, uint32_t>> part_sizes(num_parts);
+  uint64_t output_size = 0;
+  for (auto& part_size : part_sizes) {
+    RETURN_NOT_OK(input_metadata->read(&part_size.first, sizeof(uint32_t)));
+    RETURN_NOT_OK(input_metadata->read(&part_size.second, sizeof(uint32_t)));
+    output_size += part_size.first;
+  }
+
+  RETURN_NOT_OK(output->prepend_buffer(output_size));
+  Buffer* output_buf = output->buffer_ptr(0);
+  assert(output_buf != nullptr);
+
+  for (const auto& part_size : part_sizes) {
+    if (part_size.second == 0)
+      continue;
+    ConstBuffer part(nullptr, 0);
+    RETURN_NOT_OK(input->get_const_buffer(part_size.second, &part));
+    RETURN_NOT_OK(decode_part<T>(&part, part_size.first, output_buf));
+    input->advance_offset(part_size.second);
+  }
+
+  // Output metadata is a view on the input metadata, skipping what was used
+  // by this filter.
+  auto md_offset = input_metadata->offset();
+  RETURN_NOT_OK(output_metadata->append_view(
+      input_metadata, md_offset, input_metadata->size() - md_offset));
+
+  return Status::Ok();
+}
+
+template <typename T>
+Status FloatPlaneFilter::decode_part(
+    ConstBuffer* input, uint32_t orig_size, Buffer* output) const {
+  uint64_t cell_num = orig_size / sizeof(T);
+
+  if (cell_num > 0) {
+    T first;
+    RETURN_NOT_OK(input->read(&first, sizeof(T)));
+
+    // Decode the byte planes.
+    std::unique_ptr<uint8_t[]> planes(new uint8_t[cell_num * sizeof(T)]);
+    for (unsigned k = 0; k < sizeof(T); k++) {
+      uint8_t* plane = &planes[k * cell_num];
+      uint8_t encoding;
+      RETURN_NOT_OK(input->read(&encoding, sizeof(uint8_t)));
+      switch (static_cast<PlaneEncoding>(encoding)) {
+        case PlaneEncoding::RAW:
+          RETURN_NOT_OK(input->read(plane, cell_num));
+          break;
+        case PlaneEncoding::CONSTANT: {
+          uint8_t value;
+          RETURN_NOT_OK(input->read(&value, sizeof(uint8_t)));
+          std::memset(plane, value, cell_num);
+          break;
+        }
+        case PlaneEncoding::ZSTD: {
+          uint32_t compressed_size;
+          RETURN_NOT_OK(input->read(&compressed_size, sizeof(uint32_t)));
+          if (compressed_size > input->nbytes_left_to_read())
+            return LOG_STATUS(Status::FilterError(
+                "Float plane filter error; invalid compressed plane size."));
+          ConstBuffer compressed(input->cur_data(), compressed_size);
+          PreallocatedBuffer decompressed(plane, cell_num);
+          RETURN_NOT_OK(ZStd::decompress(&compressed, &decompressed));
+          if (decompressed.offset() != cell_num)
+            return LOG_STATUS(Status::FilterError(
+                "Float plane filter error; invalid compressed plane."));
+          input->advance_offset(compressed_size);
+          break;
+        }
+        default:
+          return LOG_STATUS(Status::FilterError(
+              "Float plane filter error; invalid plane encoding."));
+      }
+    }
+
+    // Join the planes, and undo the zigzag and delta encodings.
+    auto values = static_cast<T*>(output->cur_data());
+    blosc::unshuffle(
+        sizeof(T),
+        cell_num * sizeof(T),
+        planes.get(),
+        reinterpret_cast<uint8_t*>(values));
+    for (uint64_t i = 0; i < cell_num; i++)
+      values[i] = (values[i] >> 1) ^ (T(0) - (values[i] & 1));
+    filter_kernels::delta_decode(values, cell_num, first, values);
+
+    if (output->owns_data())
+      output->advance_size(cell_num * sizeof(T));
+    output->advance_offset(cell_num * sizeof(T));
+  }
+
+  // Copy the trailing bytes that do not form a whole value.
+  uint64_t trailing_size = orig_size % sizeof(T);
+  if (trailing_size > 0) {
+    RETURN_NOT_OK(input->read(output->cur_data(), trailing_size));
+    if (output->owns_data())
+      output->advance_size(trailing_size);
+    output->advance_offset(trailing_size);
+  }
+
+  return Status::Ok();
+}
+
+Status FloatPlaneFilter::set_option_impl(
+    FilterOption option, const void* value) {
+  if (value == nullptr)
+    return LOG_STATUS(
+        Status::FilterError("Float plane filter error; invalid option value"));
+
+  switch (option) {
+    case FilterOption::COMPRESSION_LEVEL:
+      level_ = *(int*)value;
+      return Status::Ok();
+    default:
+      return LOG_STATUS(
+          Status::FilterError("Float plane filter error; unknown option"));
+  }
+}
+
+Status FloatPlaneFilter::get_option_impl(
+    FilterOption option, void* value) const {
+  switch (option) {
+    case FilterOption::COMPRESSION_LEVEL:
+      *(int*)value = level_;
+      return Status::Ok();
+    default:
+      return LOG_STATUS(
+          Status::FilterError("Float plane filter error; unknown option"));
+  }
+}
+
+Status FloatPlaneFilter::serialize_impl(Buffer* buff) const {
+  RETURN_NOT_OK(buff->write(&level_, sizeof(int32_t)));
+  return Status::Ok();
+}
+
+Status FloatPlaneFilter::deserialize_impl(ConstBuffer* buff) {
+  RETURN_NOT_OK(buff->read(&level_, sizeof(int32_t)));
+  return Status::Ok();
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,212 @@
+/**
+ * @file   float_plane_filter.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares class FloatPlaneFilter.
+ */
+
+#ifndef TILEDB_FLOAT_PLANE_FILTER_H
+#define TILEDB_FLOAT_PLANE_FILTER_H
+
+#include "tiledb/sm/buffer/const_buffer.h"
+#include "tiledb/sm/filter/filter.h"
+#include "tiledb/sm/misc/status.h"
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A lossless compressor for floating-point values.
+ *
+ * The bit patterns of the values are delta-encoded as integers (starting
+ * from the first value, which is stored as is), which for neighboring values
+ * of the same sign and exponent yields the difference of their mantissas.
+ * The (wrapped around) deltas are zigzag-encoded, so that small negative
+ * deltas have zero high bits as the small positive ones do. The results are
+ * then split into byte planes (plane `k` holding byte `k` of every value, as
+ * with the byteshuffle filter), and each plane is encoded separately:
+ *
+ * - A plane holding a single byte value (e.g., the high bytes of the deltas
+ *   of a slowly varying signal) is stored as that value.
+ * - A plane whose bytes are close to uniformly distributed (e.g., the low
+ *   mantissa bytes of noisy data) is stored raw, without attempting to
+ *   compress it.
+ * - Any other plane is compressed with zstd, or stored raw if that does not
+ *   make it smaller.
+ *
+ * If the input comes in multiple FilterBuffer parts, each part is encoded
+ * separately. Bytes at the end of a part that do not form a whole element
+ * are copied unmodified. Input that is not FLOAT32 or FLOAT64 is passed
+ * through unmodified.
+ *
+ * Input metadata is not modified.
+ *
+ * The forward output metadata has the format:
+ *   uint32_t - Number of parts
+ *   uint32_t - Number of bytes of the original part0
+ *   uint32_t - Number of bytes of the encoded part0
+ *   ...
+ *   uint32_t - Number of bytes of the original partN
+ *   uint32_t - Number of bytes of the encoded partN
+ *
+ * The forward output data is the concatenated encoded parts, each being the
+ * first value of the part (if any) and its `sizeof(T)` encoded byte planes
+ * (the least significant byte first), followed by the trailing bytes of the
+ * part. An encoded plane has the
+ * format:
+ *   uint8_t - Plane encoding (see `PlaneEncoding`)
+ *   For RAW:      uint8_t[N] - The plane bytes
+ *   For CONSTANT: uint8_t - The value of all plane bytes
+ *   For ZSTD:     uint32_t - Number of compressed bytes S
+ *                 uint8_t[S] - The compressed plane bytes
+ * where N is the number of elements of the part.
+ *
+ * The reverse output format is simply:
+ *   T[] - Array of original elements
+ */
+class FloatPlaneFilter : public Filter {
+ public:
+  /** Encoding of a byte plane. */
+  enum class PlaneEncoding : uint8_t { RAW = 0, CONSTANT = 1, ZSTD = 2 };
+
+  /** Constructor. */
+  FloatPlaneFilter();
+
+  /**
+   * Constructor.
+   *
+   * @param level The zstd compression level of the compressed planes.
+   */
+  explicit FloatPlaneFilter(int level);
+
+  /** Return the zstd compression level used by this filter instance. */
+  int compression_level() const;
+
+  /**
+   * Encode the given input into the given output.
+   */
+  Status run_forward(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+  /**
+   * Decode the given input into the given output.
+   */
+  Status run_reverse(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+  /** Set the zstd compression level used by this filter instance. */
+  void set_compression_level(int compression_level);
+
+ private:
+  /**
+   * The zstd compression level. A negative level selects the zstd default
+   * level.
+   */
+  int level_;
+
+  /** Returns a new clone of this filter. */
+  FloatPlaneFilter* clone_impl() const override;
+
+  /**
+   * Decode a part of the filter input.
+   *
+   * @tparam T Unsigned integer type of the size of the tile cells
+   * @param input Buffer with the encoded part to decode
+   * @param orig_size Number of bytes of the original part
+   * @param output Buffer to write the decoded part to
+   * @return Status
+   */
+  template <typename T>
+  Status decode_part(ConstBuffer* input, uint32_t orig_size, Buffer* output)
+      const;
+
+  /** Deserializes this filter's metadata from the given buffer. */
+  Status deserialize_impl(ConstBuffer* buff) override;
+
+  /**
+   * Encode a part of the filter input.
+   *
+   * @tparam T Unsigned integer type of the size of the tile cells
+   * @param input Buffer with the part to encode
+   * @param output Buffer to write the encoded part to
+   * @return Status
+   */
+  template <typename T>
+  Status encode_part(const ConstBuffer* input, Buffer* output) const;
+
+  /**
+   * Encode a byte plane, appending it to the given output.
+   *
+   * @param plane The plane bytes
+   * @param nbytes The number of plane bytes
+   * @param scratch Buffer for the compressed plane
+   * @param output Pointer to write the encoded plane to, advanced past it
+   * @return Status
+   */
+  Status encode_plane(
+      const uint8_t* plane,
+      uint64_t nbytes,
+      Buffer* scratch,
+      uint8_t** output) const;
+
+  /** Gets an option from this filter. */
+  Status get_option_impl(FilterOption option, void* value) const override;
+
+  /** Run_forward method templated on the tile cell datatype. */
+  template <typename T>
+  Status run_forward(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const;
+
+  /** Run_reverse method templated on the tile cell datatype. */
+  template <typename T>
+  Status run_reverse(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const;
+
+  /** Sets an option on this filter. */
+  Status set_option_impl(FilterOption option, const void* value) override;
+
+  /** Serializes this filter's metadata to the given buffer. */
+  Status serialize_impl(Buffer* buff) const override;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_FLOAT_PLANE_FILTER_H
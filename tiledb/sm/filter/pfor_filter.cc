@@ -0,0 +1,449 @@
+/**
+ * @file   pfor_filter.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class PFORFilter.
+ */
+
+#include "tiledb/sm/filter/pfor_filter.h"
+#include "tiledb/sm/filter/filter_kernels.h"
+#include "tiledb/sm/filter/filter_pipeline.h"
+#include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/utils.h"
+#include "tiledb/sm/tile/tile.h"
+
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace tiledb {
+namespace sm {
+
+/** The word type the values of type T are packed into. */
+template <typename T>
+struct PackedWord {
+  typedef typename std::conditional<sizeof(T) <= 4, uint32_t, uint64_t>::type
+      type;
+};
+
+/** Returns the number of bits required to represent the input value. */
+static inline unsigned bit_length(uint64_t value) {
+  unsigned bits = 0;
+  for (unsigned shift = 32; shift > 0; shift /= 2) {
+    if (value >> shift) {
+      bits += shift;
+      value >>= shift;
+    }
+  }
+  return bits + static_cast<unsigned>(value);
+}
+
+/**
+ * Packs a block of values of `bits` bits each into `16 * bits` bytes, as
+ * words interleaved over the lanes of a 128-bit vector.
+ */
+template <typename W>
+static void pack(const W* values, unsigned bits, W* packed) {
+  const unsigned lanes = 16 / sizeof(W), word_bits = 8 * sizeof(W);
+  const unsigned lane_cell_num = PFORFilter::BLOCK_CELL_NUM / lanes;
+  std::memset(packed, 0, 16 * bits);
+  if (bits == 0)
+    return;
+
+  for (unsigned j = 0; j < lane_cell_num; j++) {
+    unsigned bit = j * bits, shift = bit % word_bits;
+    W* words = packed + (bit / word_bits) * lanes;
+    for (unsigned l = 0; l < lanes; l++) {
+      W value = values[j * lanes + l];
+      words[l] |= value << shift;
+      if (shift + bits > word_bits)
+        words[lanes + l] |= value >> (word_bits - shift);
+    }
+  }
+}
+
+/**
+ * The inverse of `pack`. All lanes are unpacked with the same shifts, so the
+ * inner loops compile to SIMD instructions.
+ */
+template <typename W>
+static void unpack(const W* packed, unsigned bits, W* values) {
+  const unsigned lanes = 16 / sizeof(W), word_bits = 8 * sizeof(W);
+  const unsigned lane_cell_num = PFORFilter::BLOCK_CELL_NUM / lanes;
+  if (bits == 0) {
+    std::memset(values, 0, PFORFilter::BLOCK_CELL_NUM * sizeof(W));
+    return;
+  }
+
+  const W mask = bits == word_bits ? ~W(0) : (W(1) << bits) - 1;
+  for (unsigned j = 0; j < lane_cell_num; j++) {
+    unsigned bit = j * bits, shift = bit % word_bits;
+    const W* words = packed + (bit / word_bits) * lanes;
+    W* out = values + j * lanes;
+    if (shift + bits > word_bits) {
+      for (unsigned l = 0; l < lanes; l++)
+        out[l] = ((words[l] >> shift) |
+                  (words[lanes + l] << (word_bits - shift))) &
+                 mask;
+    } else {
+      for (unsigned l = 0; l < lanes; l++)
+        out[l] = (words[l] >> shift) & mask;
+    }
+  }
+}
+
+PFORFilter::PFORFilter()
+    : Filter(FilterType::FILTER_PFOR) {
+}
+
+PFORFilter* PFORFilter::clone_impl() const {
+  return new PFORFilter;
+}
+
+Status PFORFilter::run_forward(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  auto tile_type = pipeline_->current_tile()->type();
+
+  // If encoding can't work, just return the input unmodified.
+  if (!datatype_is_integer(tile_type)) {
+    RETURN_NOT_OK(output->append_view(input));
+    RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+    return Status::Ok();
+  }
+
+  switch (tile_type) {
+    case Datatype::INT8:
+      return run_forward<int8_t>(
+          input_metadata, input, output_metadata, output);
+    case Datatype::UINT8:
+      return run_forward<uint8_t>(
+          input_metadata, input, output_metadata, output);
+    case Datatype::INT16:
+      return run_forward<int16_t>(
+          input_metadata, input, output_metadata, output);
+    case Datatype::UINT16:
+      return run_forward<uint16_t>(
+          input_metadata, input, output_metadata, output);
+    case Datatype::INT32:
+      return run_forward<int>(input_metadata, input, output_metadata, output);
+    case Datatype::UINT32:
+      return run_forward<unsigned>(
+          input_metadata, input, output_metadata, output);
+    case Datatype::INT64:
+      return run_forward<int64_t>(
+          input_metadata, input, output_metadata, output);
+    case Datatype::UINT64:
+      return run_forward<uint64_t>(
+          input_metadata, input, output_metadata, output);
+    default:
+      return LOG_STATUS(
+          Status::FilterError("Cannot filter; Unsupported input type"));
+  }
+}
+
+template <typename T>
+Status PFORFilter::run_forward(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  // Compute the upper bound on the size of the output: the last block of a
+  // part is padded, and a block is never larger than its unpacked values.
+  std::vector<ConstBuffer> parts = input->buffers();
+  auto num_parts = (uint32_t)parts.size();
+  uint64_t output_size_ub = 0;
+  for (const auto& part : parts) {
+    uint64_t num_blocks =
+        utils::math::ceil(part.size() / sizeof(T), BLOCK_CELL_NUM);
+    output_size_ub += num_blocks * (sizeof(T) + 2 + BLOCK_CELL_NUM * sizeof(T));
+    output_size_ub += part.size() % sizeof(T);
+  }
+
+  RETURN_NOT_OK(output->prepend_buffer(output_size_ub));
+  Buffer* output_buf = output->buffer_ptr(0);
+  assert(output_buf != nullptr);
+
+  // Forward the existing metadata
+  RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+  // Allocate a buffer for this filter's metadata and write the header.
+  uint32_t metadata_size = sizeof(uint32_t) + num_parts * 2 * sizeof(uint32_t);
+  RETURN_NOT_OK(output_metadata->prepend_buffer(metadata_size));
+  RETURN_NOT_OK(output_metadata->write(&num_parts, sizeof(uint32_t)));
+
+  // Encode all parts.
+  for (const auto& part : parts) {
+    auto offset = output_buf->offset();
+    RETURN_NOT_OK(encode_part<T>(&part, output_buf));
+    auto part_size = (uint32_t)part.size();
+    auto encoded_size = (uint32_t)(output_buf->offset() - offset);
+    RETURN_NOT_OK(output_metadata->write(&part_size, sizeof(uint32_t)));
+    RETURN_NOT_OK(output_metadata->write(&encoded_size, sizeof(uint32_t)));
+  }
+
+  return Status::Ok();
+}
+
+template <typename T>
+Status PFORFilter::encode_part(const ConstBuffer* input, Buffer* output) const {
+  typedef typename std::make_unsigned<T>::type UT;
+  typedef typename PackedWord<T>::type W;
+  uint64_t cell_num = input->size() / sizeof(T);
+  auto values = static_cast<const T*>(input->data());
+  auto out = static_cast<uint8_t*>(output->cur_data());
+  auto out_begin = out;
+
+  W deltas[BLOCK_CELL_NUM], packed[BLOCK_CELL_NUM];
+  for (uint64_t start = 0; start < cell_num; start += BLOCK_CELL_NUM) {
+    auto block_cell_num =
+        (unsigned)std::min<uint64_t>(BLOCK_CELL_NUM, cell_num - start);
+    const T* block = values + start;
+
+    // Compute the values relative to the block minimum, and a histogram of
+    // the number of bits they require.
+    T min, max;
+    filter_kernels::min_max(block, block_cell_num, &min, &max);
+    unsigned bit_histogram[65] = {0};
+    for (unsigned i = 0; i < block_cell_num; i++) {
+      deltas[i] = static_cast<W>(
+          static_cast<UT>(static_cast<UT>(block[i]) - static_cast<UT>(min)));
+      bit_histogram[bit_length(deltas[i])]++;
+    }
+    for (unsigned i = block_cell_num; i < BLOCK_CELL_NUM; i++)
+      deltas[i] = 0;
+
+    // Pick the bit width minimizing the block size. Lowering the width from
+    // B to B - 1 turns the values requiring B bits into exceptions.
+    unsigned max_bits = bit_length(
+        static_cast<UT>(static_cast<UT>(max) - static_cast<UT>(min)));
+    unsigned bits = max_bits, num_exceptions = 0, exceptions = 0;
+    uint64_t best_size = 16 * max_bits;
+    for (unsigned b = max_bits; b > 0; b--) {
+      exceptions += bit_histogram[b];
+      uint64_t size = 16 * (b - 1) + exceptions * (1 + sizeof(T));
+      if (size < best_size) {
+        best_size = size;
+        bits = b - 1;
+        num_exceptions = exceptions;
+      }
+    }
+
+    // Write the block header.
+    std::memcpy(out, &min, sizeof(T));
+    out += sizeof(T);
+    *out++ = static_cast<uint8_t>(bits);
+    *out++ = static_cast<uint8_t>(num_exceptions);
+
+    // Write the exceptions, keeping only their low bits in the packed values.
+    if (num_exceptions > 0) {
+      uint8_t* positions = out + 16 * bits;
+      uint8_t* high_bits = positions + num_exceptions;
+      const W mask = (W(1) << bits) - 1;
+      for (unsigned i = 0; i < block_cell_num; i++) {
+        if (deltas[i] > mask) {
+          auto high = static_cast<UT>(deltas[i] >> bits);
+          *positions++ = static_cast<uint8_t>(i);
+          std::memcpy(high_bits, &high, sizeof(T));
+          high_bits += sizeof(T);
+          deltas[i] &= mask;
+        }
+      }
+    }
+
+    // Write the packed values.
+    pack(deltas, bits, packed);
+    std::memcpy(out, packed, 16 * bits);
+    out += 16 * bits + num_exceptions * (1 + sizeof(T));
+  }
+
+  // Copy the trailing bytes that do not form a whole value.
+  uint64_t trailing_size = input->size() % sizeof(T);
+  std::memcpy(
+      out, static_cast<const uint8_t*>(input->data()) + cell_num * sizeof(T),
+      trailing_size);
+  out += trailing_size;
+
+  auto nbytes = static_cast<uint64_t>(out - out_begin);
+  if (output->owns_data())
+    output->advance_size(nbytes);
+  output->advance_offset(nbytes);
+
+  return Status::Ok();
+}
+
+Status PFORFilter::run_reverse(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  auto tile_type = pipeline_->current_tile()->type();
+
+  // If encoding wasn't applied, just return the input unmodified.
+  if (!datatype_is_integer(tile_type)) {
+    RETURN_NOT_OK(output->append_view(input));
+    RETURN_NOT_OK(output_metadata->append_view(input_metadata));
+    return Status::Ok();
+  }
+
+  switch (tile_type) {
+    case Datatype::INT8:
+      return run_reverse<int8_t>(
+          input_metadata, input, output_metadata, output);
+    case Datatype::UINT8:
+      return run_reverse<uint8_t>(
+          input_metadata, input, output_metadata, output);
+    case Datatype::INT16:
+      return run_reverse<int16_t>(
+          input_metadata, input, output_metadata, output);
+    case Datatype::UINT16:
+      return run_reverse<uint16_t>(
+          input_metadata, input, output_metadata, output);
+    case Datatype::INT32:
+      return run_reverse<int>(input_metadata, input, output_metadata, output);
+    case Datatype::UINT32:
+      return run_reverse<unsigned>(
+          input_metadata, input, output_metadata, output);
+    case Datatype::INT64:
+      return run_reverse<int64_t>(
+          input_metadata, input, output_metadata, output);
+    case Datatype::UINT64:
+      return run_reverse<uint64_t>(
+          input_metadata, input, output_metadata, output);
+    default:
+      return LOG_STATUS(
+          Status::FilterError("Cannot filter; Unsupported input type"));
+  }
+}
+
+template <typename T>
+Status PFORFilter::run_reverse(
+    FilterBuffer* input_metadata,
+    FilterBuffer* input,
+    FilterBuffer* output_metadata,
+    FilterBuffer* output) const {
+  // Read the original and encoded sizes of all parts.
+  uint32_t num_parts;
+  RETURN_NOT_OK(input_metadata->read(&num_parts, sizeof(uint32_t)));
+  std::vector<std::pair<uint32_t, uint32_t>> part_sizes(num_parts);
+  uint64_t output_size = 0;
+  for (auto& part_size : part_sizes) {
+    RETURN_NOT_OK(input_metadata->read(&part_size.first, sizeof(uint32_t)));
+    RETURN_NOT_OK(input_metadata->read(&part_size.second, sizeof(uint32_t)));
+    output_size += part_size.first;
+  }
+
+  RETURN_NOT_OK(output->prepend_buffer(output_size));
+  Buffer* output_buf = output->buffer_ptr(0);
+  assert(output_buf != nullptr);
+
+  for (const auto& part_size : part_sizes) {
+    if (part_size.second == 0)
+      continue;
+    ConstBuffer part(nullptr, 0);
+    RETURN_NOT_OK(input->get_const_buffer(part_size.second, &part));
+    RETURN_NOT_OK(decode_part<T>(&part, part_size.first, output_buf));
+    input->advance_offset(part_size.second);
+  }
+
+  // Output metadata is a view on the input metadata, skipping what was used
+  // by this filter.
+  auto md_offset = input_metadata->offset();
+  RETURN_NOT_OK(output_metadata->append_view(
+      input_metadata, md_offset, input_metadata->size() - md_offset));
+
+  return Status::Ok();
+}
+
+template <typename T>
+Status PFORFilter::decode_part(
+    ConstBuffer* input, uint32_t orig_size, Buffer* output) const {
+  typedef typename std::make_unsigned<T>::type UT;
+  typedef typename PackedWord<T>::type W;
+  uint64_t cell_num = orig_size / sizeof(T);
+
+  W packed[BLOCK_CELL_NUM], deltas[BLOCK_CELL_NUM];
+  T values[BLOCK_CELL_NUM];
+  uint8_t positions[BLOCK_CELL_NUM];
+  for (uint64_t start = 0; start < cell_num; start += BLOCK_CELL_NUM) {
+    auto block_cell_num =
+        (unsigned)std::min<uint64_t>(BLOCK_CELL_NUM, cell_num - start);
+
+    // Read the block header.
+    T min;
+    uint8_t bits, num_exceptions;
+    RETURN_NOT_OK(input->read(&min, sizeof(T)));
+    RETURN_NOT_OK(input->read(&bits, sizeof(uint8_t)));
+    RETURN_NOT_OK(input->read(&num_exceptions, sizeof(uint8_t)));
+    if (bits > 8 * sizeof(T) || num_exceptions > block_cell_num ||
+        (num_exceptions > 0 && bits == 8 * sizeof(T)))
+      return LOG_STATUS(
+          Status::FilterError("PFOR filter error; invalid block header."));
+
+    // Unpack the values.
+    RETURN_NOT_OK(input->read(packed, 16 * bits));
+    unpack(packed, bits, deltas);
+    for (unsigned i = 0; i < block_cell_num; i++)
+      values[i] = static_cast<T>(
+          static_cast<UT>(min) + static_cast<UT>(deltas[i]));
+
+    // Patch the exceptions.
+    if (num_exceptions > 0) {
+      RETURN_NOT_OK(input->read(positions, num_exceptions));
+      for (unsigned e = 0; e < num_exceptions; e++) {
+        UT high;
+        RETURN_NOT_OK(input->read(&high, sizeof(T)));
+        unsigned pos = positions[e];
+        if (pos >= block_cell_num)
+          return LOG_STATUS(Status::FilterError(
+              "PFOR filter error; invalid exception position."));
+        auto delta = static_cast<UT>(
+            static_cast<UT>(deltas[pos]) | static_cast<UT>(high << bits));
+        values[pos] = static_cast<T>(static_cast<UT>(min) + delta);
+      }
+    }
+
+    std::memcpy(output->cur_data(), values, block_cell_num * sizeof(T));
+    if (output->owns_data())
+      output->advance_size(block_cell_num * sizeof(T));
+    output->advance_offset(block_cell_num * sizeof(T));
+  }
+
+  // Copy the trailing bytes that do not form a whole value.
+  uint64_t trailing_size = orig_size % sizeof(T);
+  RETURN_NOT_OK(input->read(output->cur_data(), trailing_size));
+  if (output->owns_data())
+    output->advance_size(trailing_size);
+  output->advance_offset(trailing_size);
+
+  return Status::Ok();
+}
+
+}  // namespace sm
+}  // namespace tiledb
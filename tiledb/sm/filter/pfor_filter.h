@@ -0,0 +1,161 @@
+/**
+ * @file   pfor_filter.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares class PFORFilter.
+ */
+
+#ifndef TILEDB_PFOR_FILTER_H
+#define TILEDB_PFOR_FILTER_H
+
+#include "tiledb/sm/buffer/const_buffer.h"
+#include "tiledb/sm/filter/filter.h"
+#include "tiledb/sm/misc/status.h"
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A filter that compresses integers with patched frame-of-reference (PFOR)
+ * bitpacking.
+ *
+ * The input elements are split into blocks of `BLOCK_CELL_NUM` (128) values.
+ * Each block stores its values relative to its minimum value (the frame of
+ * reference), packed with the number of bits B that minimizes the size of the
+ * block. The few relative values that need more than B bits are "exceptions":
+ * their low B bits are packed along with the rest, and their high bits are
+ * stored separately and patched in after unpacking.
+ *
+ * The packed values are interleaved over 128-bit lanes (4 lanes of 32-bit
+ * words for elements up to 4 bytes wide, 2 lanes of 64-bit words otherwise),
+ * i.e., value `i` is packed into lane `i % lanes`. This lets a block be
+ * unpacked with the same shifts applied to all lanes of a SIMD register.
+ * The last block of a part is padded with zeros.
+ *
+ * If the input comes in multiple FilterBuffer parts, each part is encoded
+ * separately. Bytes at the end of a part that do not form a whole element
+ * are copied unmodified. Non-integer input is passed through unmodified.
+ *
+ * Input metadata is not modified.
+ *
+ * The forward output metadata has the format:
+ *   uint32_t - Number of parts
+ *   uint32_t - Number of bytes of the original part0
+ *   uint32_t - Number of bytes of the encoded part0
+ *   ...
+ *   uint32_t - Number of bytes of the original partN
+ *   uint32_t - Number of bytes of the encoded partN
+ *
+ * The forward output data is the concatenated encoded parts, each being the
+ * concatenated blocks followed by the trailing bytes of the part. A block has
+ * the format:
+ *   T - Frame of reference (minimum value of the block)
+ *   uint8_t - Bit width B of the packed values
+ *   uint8_t - Number of exceptions E
+ *   uint8_t[16 * B] - Packed values
+ *   uint8_t[E] - Positions of the exceptions in the block
+ *   T[E] - High bits of the exceptions (shifted right by B)
+ *
+ * The reverse output format is simply:
+ *   T[] - Array of original elements
+ */
+class PFORFilter : public Filter {
+ public:
+  /** Number of values in a block. */
+  static const unsigned BLOCK_CELL_NUM = 128;
+
+  /** Constructor. */
+  PFORFilter();
+
+  /**
+   * Encode the given input into the given output.
+   */
+  Status run_forward(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+  /**
+   * Decode the given input into the given output.
+   */
+  Status run_reverse(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const override;
+
+ private:
+  /** Returns a new clone of this filter. */
+  PFORFilter* clone_impl() const override;
+
+  /**
+   * Decode a part of the filter input.
+   *
+   * @tparam T Tile cell datatype
+   * @param input Buffer holding the encoded part
+   * @param orig_size Number of bytes of the original part
+   * @param output Buffer to write the decoded part to
+   * @return Status
+   */
+  template <typename T>
+  Status decode_part(
+      ConstBuffer* input, uint32_t orig_size, Buffer* output) const;
+
+  /**
+   * Encode a part of the filter input.
+   *
+   * @tparam T Tile cell datatype
+   * @param input Part to encode
+   * @param output Buffer to write the encoded part to
+   * @return Status
+   */
+  template <typename T>
+  Status encode_part(const ConstBuffer* input, Buffer* output) const;
+
+  /** Run_forward method templated on the tile cell datatype. */
+  template <typename T>
+  Status run_forward(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const;
+
+  /** Run_reverse method templated on the tile cell datatype. */
+  template <typename T>
+  Status run_reverse(
+      FilterBuffer* input_metadata,
+      FilterBuffer* input,
+      FilterBuffer* output_metadata,
+      FilterBuffer* output) const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_PFOR_FILTER_H
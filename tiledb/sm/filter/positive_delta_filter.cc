@@ -31,6 +31,7 @@
  */
 
 #include "tiledb/sm/filter/positive_delta_filter.h"
+#include "tiledb/sm/filter/filter_kernels.h"
 #include "tiledb/sm/filter/filter_pipeline.h"
 #include "tiledb/sm/misc/logger.h"
 #include "tiledb/sm/misc/utils.h"
@@ -148,6 +149,9 @@ Status PositiveDeltaFilter::encode_part(
   uint32_t num_windows =
       input_bytes / window_size + uint32_t(bool(input_bytes % window_size));
 
+  // Scratch space for the deltas of a window.
+  std::vector<T> deltas;
+
   // Write each window.
   for (uint32_t i = 0; i < num_windows; i++) {
     // Compute the actual size in bytes of the window (may be smaller at the end
@@ -168,19 +172,17 @@ Status PositiveDeltaFilter::encode_part(
       input->advance_offset(window_nbytes);
     } else {
       // Encode and write the relative values to output.
-      T prev_value = input->value<T>();
-      for (uint32_t j = 0; j < window_nelts; j++) {
-        T curr_value = input->value<T>();
-        if (curr_value < prev_value)
-          return LOG_STATUS(Status::FilterError(
-              "Positive delta filter error: delta is not positive."));
-
-        T delta = curr_value - prev_value;
-        RETURN_NOT_OK(output->write(&delta, sizeof(T)));
-        input->advance_offset(sizeof(T));
-
-        prev_value = curr_value;
-      }
+      deltas.resize(window_nelts);
+      if (!filter_kernels::delta_encode(
+              static_cast<const T*>(input->cur_data()),
+              window_nelts,
+              window_value_offset,
+              deltas.data()))
+        return LOG_STATUS(Status::FilterError(
+            "Positive delta filter error: delta is not positive."));
+
+      RETURN_NOT_OK(output->write(deltas.data(), window_nbytes));
+      input->advance_offset(window_nbytes);
     }
   }
 
@@ -246,6 +248,9 @@ Status PositiveDeltaFilter::run_reverse(
   RETURN_NOT_OK(output->prepend_buffer(input->size()));
   output->reset_offset();
 
+  // Scratch space for the deltas and decoded values of a window.
+  std::vector<T> deltas, values;
+
   // Read each window
   for (uint32_t i = 0; i < num_windows; i++) {
     uint32_t window_nbytes;
@@ -259,17 +264,14 @@ Status PositiveDeltaFilter::run_reverse(
       RETURN_NOT_OK(output->write(input, window_nbytes));
       input->advance_offset(window_nbytes);
     } else {
-      // Read and decode each window value.
+      // Read and decode the window values.
       uint32_t window_nelts = window_nbytes / sizeof(T);
-      T prev_value = window_value_offset;
-      for (uint32_t j = 0; j < window_nelts; j++) {
-        T delta;
-        RETURN_NOT_OK(input->read(&delta, sizeof(T)));
-        T decoded_value = prev_value + delta;
-        RETURN_NOT_OK(output->write(&decoded_value, tile_type_size));
-
-        prev_value = decoded_value;
-      }
+      deltas.resize(window_nelts);
+      values.resize(window_nelts);
+      RETURN_NOT_OK(input->read(deltas.data(), window_nbytes));
+      filter_kernels::delta_decode(
+          deltas.data(), window_nelts, window_value_offset, values.data());
+      RETURN_NOT_OK(output->write(values.data(), window_nbytes));
     }
   }
 
@@ -71,6 +71,7 @@ FragmentMetadata::FragmentMetadata(
   non_empty_domain_ = nullptr;
   version_ = constants::format_version;
   tile_index_base_ = 0;
+  tile_cache_id_ = constants::tile_cache_no_fragment_id;
   sparse_tile_num_ = 0;
   auto attributes = array_schema_->attributes();
   for (unsigned i = 0; i < attributes.size(); ++i) {
@@ -155,6 +156,35 @@ void FragmentMetadata::set_tile_index_base(uint64_t tile_base) {
   tile_index_base_ = tile_base;
 }
 
+void FragmentMetadata::set_tile_cache_id(uint64_t id) {
+  tile_cache_id_ = id;
+}
+
+void FragmentMetadata::set_tile_cell_num(uint64_t tile, uint64_t cell_num) {
+  tile += tile_index_base_;
+  if (cell_num == array_schema_->capacity())
+    tile_cell_nums_.erase(tile);
+  else
+    tile_cell_nums_[tile] = cell_num;
+}
+
+void FragmentMetadata::set_tile_metadata(
+    const std::string& attribute,
+    uint64_t tile,
+    const void* min,
+    const void* max,
+    const void* sum) {
+  auto attribute_id = attribute_idx_map_[attribute];
+  auto value_size = tile_metadata_value_size(attribute_id);
+  tile += tile_index_base_;
+  assert(has_tile_metadata(attribute));
+  assert((tile + 1) * sizeof(uint64_t) <= tile_sum_[attribute_id].size());
+  std::memcpy(&tile_min_[attribute_id][tile * value_size], min, value_size);
+  std::memcpy(&tile_max_[attribute_id][tile * value_size], max, value_size);
+  std::memcpy(
+      &tile_sum_[attribute_id][tile * sizeof(uint64_t)], sum, sizeof(uint64_t));
+}
+
 void FragmentMetadata::set_tile_offset(
     const std::string& attribute, uint64_t tile, uint64_t tile_size) {
   auto attribute_id = attribute_idx_map_[attribute];
@@ -186,8 +216,14 @@ uint64_t FragmentMetadata::cell_num(uint64_t tile_pos) const {
     return array_schema_->domain()->cell_num_per_tile();
 
   uint64_t tile_num = this->tile_num();
-  if (tile_pos != tile_num - 1)
+  if (tile_pos != tile_num - 1) {
+    if (!tile_cell_nums_.empty()) {
+      auto it = tile_cell_nums_.find(tile_pos);
+      if (it != tile_cell_nums_.end())
+        return it->second;
+    }
     return array_schema_->capacity();
+  }
 
   return last_tile_cell_num();
 }
@@ -350,6 +386,21 @@ uint32_t FragmentMetadata::format_version() const {
   return version_;
 }
 
+bool FragmentMetadata::has_tile_metadata(const std::string& attribute) const {
+  // The tile metadata were introduced in format version 4
+  if (version_ < 4)
+    return false;
+
+  auto attr = array_schema_->attribute(attribute);
+  if (attr == nullptr || attribute == constants::coords ||
+      attr->cell_val_num() != 1)
+    return false;
+
+  auto type = attr->type();
+  return datatype_is_integer(type) || type == Datatype::FLOAT32 ||
+         type == Datatype::FLOAT64;
+}
+
 Status FragmentMetadata::fragment_size(uint64_t* size) const {
   // Add file sizes
   *size = 0;
@@ -434,6 +485,11 @@ Status FragmentMetadata::init(const void* non_empty_domain) {
   // Initialize variable tile sizes
   tile_var_sizes_.resize(attribute_num);
 
+  // Initialize tile min/max/sum values
+  tile_min_.resize(attribute_num);
+  tile_max_.resize(attribute_num);
+  tile_sum_.resize(attribute_num);
+
   return Status::Ok();
 }
 
@@ -462,6 +518,50 @@ Status FragmentMetadata::load(const EncryptionKey& encryption_key) {
   return load_v3(encryption_key);
 }
 
+Status FragmentMetadata::load_consolidated(ConstBuffer* buff) {
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  // Load basic metadata
+  uint64_t basic_size;
+  RETURN_NOT_OK(buff->read(&basic_size, sizeof(uint64_t)));
+  if (basic_size > buff->nbytes_left_to_read())
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load consolidated fragment metadata; Invalid basic size"));
+  ConstBuffer basic(buff->cur_data(), basic_size);
+  RETURN_NOT_OK(load_basic(&basic));
+  buff->advance_offset(basic_size);
+
+  // Load generic tile offsets, in the order they are stored
+  auto attribute_num = array_schema_->attribute_num();
+  uint64_t offset_num;
+  RETURN_NOT_OK(buff->read(&offset_num, sizeof(uint64_t)));
+  uint64_t expected_num = 3 + 3 * (uint64_t)attribute_num;
+  if (version_ >= 4)
+    expected_num += attribute_num;
+  if (offset_num != expected_num)
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load consolidated fragment metadata; Invalid number of "
+        "generic tile offsets"));
+  std::vector<uint64_t> offsets(offset_num);
+  RETURN_NOT_OK(buff->read(offsets.data(), offset_num * sizeof(uint64_t)));
+
+  auto it = offsets.begin();
+  gt_offsets_.basic_ = 0;
+  gt_offsets_.rtree_ = *it++;
+  gt_offsets_.mbrs_ = *it++;
+  gt_offsets_.tile_offsets_.assign(it, it + attribute_num + 1);
+  it += attribute_num + 1;
+  gt_offsets_.tile_var_offsets_.assign(it, it + attribute_num);
+  it += attribute_num;
+  gt_offsets_.tile_var_sizes_.assign(it, it + attribute_num);
+  it += attribute_num;
+  if (version_ >= 4)
+    gt_offsets_.tile_metadata_.assign(it, it + attribute_num);
+  loaded_metadata_.generic_tile_offsets_ = true;
+
+  return Status::Ok();
+}
+
 Status FragmentMetadata::store(const EncryptionKey& encryption_key) {
   auto array_uri = this->array_uri();
   auto fragment_metadata_uri =
@@ -540,6 +640,17 @@ Status FragmentMetadata::store(const EncryptionKey& encryption_key) {
     }
   }
 
+  // Store tile min/max/sum values
+  for (unsigned int i = 0; i < attribute_num; ++i) {
+    st = store_tile_metadata(i, encryption_key);
+    if (!st.ok()) {
+      storage_manager_->close_file(fragment_metadata_uri);
+      storage_manager_->vfs()->remove_file(fragment_metadata_uri);
+      storage_manager_->array_xunlock(array_uri);
+      return st;
+    }
+  }
+
   // Close file
   st = storage_manager_->close_file(fragment_metadata_uri);
 
@@ -550,6 +661,50 @@ Status FragmentMetadata::store(const EncryptionKey& encryption_key) {
   return st;
 }
 
+Status FragmentMetadata::write_consolidated(
+    const EncryptionKey& encryption_key, Buffer* buff) {
+  if (version_ < 3)
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot write consolidated fragment metadata; Format version " +
+        std::to_string(version_) + " not supported"));
+
+  RETURN_NOT_OK(load_generic_tile_offsets());
+
+  // Write basic metadata, as stored in the fragment metadata file
+  Buffer basic;
+  RETURN_NOT_OK(
+      read_generic_tile_from_file(encryption_key, gt_offsets_.basic_, &basic));
+  uint64_t basic_size = basic.size();
+  RETURN_NOT_OK(buff->write(&basic_size, sizeof(uint64_t)));
+  RETURN_NOT_OK(buff->write(basic.data(), basic_size));
+
+  // Write generic tile offsets
+  std::vector<uint64_t> offsets;
+  offsets.push_back(gt_offsets_.rtree_);
+  offsets.push_back(gt_offsets_.mbrs_);
+  offsets.insert(
+      offsets.end(),
+      gt_offsets_.tile_offsets_.begin(),
+      gt_offsets_.tile_offsets_.end());
+  offsets.insert(
+      offsets.end(),
+      gt_offsets_.tile_var_offsets_.begin(),
+      gt_offsets_.tile_var_offsets_.end());
+  offsets.insert(
+      offsets.end(),
+      gt_offsets_.tile_var_sizes_.begin(),
+      gt_offsets_.tile_var_sizes_.end());
+  offsets.insert(
+      offsets.end(),
+      gt_offsets_.tile_metadata_.begin(),
+      gt_offsets_.tile_metadata_.end());
+  uint64_t offset_num = offsets.size();
+  RETURN_NOT_OK(buff->write(&offset_num, sizeof(uint64_t)));
+  RETURN_NOT_OK(buff->write(offsets.data(), offset_num * sizeof(uint64_t)));
+
+  return Status::Ok();
+}
+
 // TODO (sp): remove when the new dense algorithm is in
 Status FragmentMetadata::mbrs(
     const EncryptionKey& encryption_key, const std::vector<void*>** mbrs) {
@@ -558,6 +713,16 @@ Status FragmentMetadata::mbrs(
   return Status::Ok();
 }
 
+uint64_t FragmentMetadata::next_tile_offset(
+    const std::string& attribute) const {
+  return next_tile_offsets_[attribute_idx_map_.at(attribute)];
+}
+
+uint64_t FragmentMetadata::next_tile_var_offset(
+    const std::string& attribute) const {
+  return next_tile_var_offsets_[attribute_idx_map_.at(attribute)];
+}
+
 const void* FragmentMetadata::non_empty_domain() const {
   return non_empty_domain_;
 }
@@ -571,6 +736,12 @@ Status FragmentMetadata::set_num_tiles(uint64_t num_tiles) {
     if (i < num_attributes) {
       tile_var_offsets_[i].resize(num_tiles, 0);
       tile_var_sizes_[i].resize(num_tiles, 0);
+      if (has_tile_metadata(array_schema_->attribute(i)->name())) {
+        auto value_size = tile_metadata_value_size(i);
+        tile_min_[i].resize(num_tiles * value_size, 0);
+        tile_max_[i].resize(num_tiles * value_size, 0);
+        tile_sum_[i].resize(num_tiles * sizeof(uint64_t), 0);
+      }
     }
   }
 
@@ -587,6 +758,12 @@ void FragmentMetadata::set_last_tile_cell_num(uint64_t cell_num) {
   last_tile_cell_num_ = cell_num;
 }
 
+TileCacheKey FragmentMetadata::tile_cache_key(
+    const std::string& attribute, bool var, uint64_t offset) const {
+  auto attribute_id = attribute_idx_map_.at(attribute);
+  return {tile_cache_id_, offset, (attribute_id << 1) | (var ? 1u : 0u)};
+}
+
 uint64_t FragmentMetadata::tile_index_base() const {
   return tile_index_base_;
 }
@@ -684,6 +861,33 @@ uint64_t FragmentMetadata::tile_size(
                       cell_num * array_schema_->cell_size(attribute);
 }
 
+Status FragmentMetadata::tile_metadata(
+    const EncryptionKey& encryption_key,
+    const std::string& attribute,
+    uint64_t tile_idx,
+    const void** min,
+    const void** max,
+    const void** sum) {
+  if (!has_tile_metadata(attribute))
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot get tile metadata; The fragment does not store the tile "
+        "metadata of attribute '" +
+        attribute + "'"));
+
+  auto attribute_id = attribute_idx_map_.at(attribute);
+  RETURN_NOT_OK(load_tile_metadata(encryption_key, attribute_id));
+  if (tile_idx >= tile_sum_[attribute_id].size() / sizeof(uint64_t))
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot get tile metadata; Invalid tile index"));
+
+  auto value_size = tile_metadata_value_size(attribute_id);
+  *min = &tile_min_[attribute_id][tile_idx * value_size];
+  *max = &tile_max_[attribute_id][tile_idx * value_size];
+  *sum = &tile_sum_[attribute_id][tile_idx * sizeof(uint64_t)];
+
+  return Status::Ok();
+}
+
 Status FragmentMetadata::tile_var_size(
     const EncryptionKey& encryption_key,
     const std::string& attribute,
@@ -856,12 +1060,18 @@ Status FragmentMetadata::load_basic(const EncryptionKey& encryption_key) {
       read_generic_tile_from_file(encryption_key, gt_offsets_.basic_, &buff));
 
   ConstBuffer cbuff(&buff);
-  RETURN_NOT_OK(load_version(&cbuff));
-  RETURN_NOT_OK(load_non_empty_domain(&cbuff));
-  RETURN_NOT_OK(load_sparse_tile_num(&cbuff));
-  RETURN_NOT_OK(load_last_tile_cell_num(&cbuff));
-  RETURN_NOT_OK(load_file_sizes(&cbuff));
-  RETURN_NOT_OK(load_file_var_sizes(&cbuff));
+  return load_basic(&cbuff);
+}
+
+Status FragmentMetadata::load_basic(ConstBuffer* buff) {
+  RETURN_NOT_OK(load_version(buff));
+  RETURN_NOT_OK(load_non_empty_domain(buff));
+  RETURN_NOT_OK(load_sparse_tile_num(buff));
+  RETURN_NOT_OK(load_last_tile_cell_num(buff));
+  RETURN_NOT_OK(load_file_sizes(buff));
+  RETURN_NOT_OK(load_file_var_sizes(buff));
+  if (version_ >= 5)
+    RETURN_NOT_OK(load_tile_cell_nums(buff));
 
   tile_offsets_.resize(array_schema_->attribute_num() + 1);
   tile_var_offsets_.resize(array_schema_->attribute_num());
@@ -874,6 +1084,11 @@ Status FragmentMetadata::load_basic(const EncryptionKey& encryption_key) {
   loaded_metadata_.tile_var_sizes_.resize(
       array_schema_->attribute_num(), false);
 
+  tile_min_.resize(array_schema_->attribute_num());
+  tile_max_.resize(array_schema_->attribute_num());
+  tile_sum_.resize(array_schema_->attribute_num());
+  loaded_metadata_.tile_metadata_.resize(array_schema_->attribute_num(), false);
+
   loaded_metadata_.basic_ = true;
 
   return Status::Ok();
@@ -982,6 +1197,27 @@ Status FragmentMetadata::load_tile_var_sizes(
   return Status::Ok();
 }
 
+Status FragmentMetadata::load_tile_metadata(
+    const EncryptionKey& encryption_key, unsigned attr_id) {
+  RETURN_NOT_OK(load_generic_tile_offsets());
+
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  if (loaded_metadata_.tile_metadata_[attr_id])
+    return Status::Ok();
+
+  Buffer buff;
+  RETURN_NOT_OK(read_generic_tile_from_file(
+      encryption_key, gt_offsets_.tile_metadata_[attr_id], &buff));
+
+  ConstBuffer cbuff(&buff);
+  RETURN_NOT_OK(load_tile_metadata(attr_id, &cbuff));
+
+  loaded_metadata_.tile_metadata_[attr_id] = true;
+
+  return Status::Ok();
+}
+
 // ===== FORMAT =====
 //  bounding_coords_num (uint64_t)
 //  bounding_coords_#1 (void*) bounding_coords_#2 (void*) ...
@@ -1340,6 +1576,38 @@ Status FragmentMetadata::load_tile_var_sizes(
   return Status::Ok();
 }
 
+Status FragmentMetadata::load_tile_metadata(
+    unsigned attr_id, ConstBuffer* buff) {
+  Status st;
+  uint64_t tile_metadata_num = 0;
+
+  // Get number of tiles
+  st = buff->read(&tile_metadata_num, sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading number of tile metadata "
+        "failed"));
+  }
+
+  // Get minimum, maximum and sum values
+  if (tile_metadata_num != 0) {
+    auto value_size = tile_metadata_value_size(attr_id);
+    tile_min_[attr_id].resize(tile_metadata_num * value_size);
+    tile_max_[attr_id].resize(tile_metadata_num * value_size);
+    tile_sum_[attr_id].resize(tile_metadata_num * sizeof(uint64_t));
+    for (auto values :
+         {&tile_min_[attr_id], &tile_max_[attr_id], &tile_sum_[attr_id]}) {
+      st = buff->read(values->data(), values->size());
+      if (!st.ok()) {
+        return LOG_STATUS(Status::FragmentMetadataError(
+            "Cannot load fragment metadata; Reading tile metadata failed"));
+      }
+    }
+  }
+
+  return Status::Ok();
+}
+
 Status FragmentMetadata::load_version(ConstBuffer* buff) {
   RETURN_NOT_OK(buff->read(&version_, sizeof(uint32_t)));
   return Status::Ok();
@@ -1350,6 +1618,29 @@ Status FragmentMetadata::load_sparse_tile_num(ConstBuffer* buff) {
   return Status::Ok();
 }
 
+// ===== FORMAT =====
+// tile_cell_num_num (uint64_t)
+// tile#1 (uint64_t) cell_num#1 (uint64_t)
+// ...
+// tile#tile_cell_num_num (uint64_t) cell_num#tile_cell_num_num (uint64_t)
+Status FragmentMetadata::load_tile_cell_nums(ConstBuffer* buff) {
+  uint64_t tile_cell_num_num;
+  Status st = buff->read(&tile_cell_num_num, sizeof(uint64_t));
+  for (uint64_t i = 0; st.ok() && i < tile_cell_num_num; ++i) {
+    uint64_t tile_and_cell_num[2];
+    st = buff->read(tile_and_cell_num, sizeof(tile_and_cell_num));
+    if (st.ok())
+      tile_cell_nums_[tile_and_cell_num[0]] = tile_and_cell_num[1];
+  }
+
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot load fragment metadata; Reading tile cell numbers failed"));
+  }
+
+  return Status::Ok();
+}
+
 // TODO: when the new dense read algorithm is in, don't double
 // TODO: buffer the leaf level of the tree
 Status FragmentMetadata::create_rtree() {
@@ -1422,6 +1713,16 @@ Status FragmentMetadata::load_generic_tile_offsets() {
     gt_offsets_.tile_var_sizes_[i] = offset;
   }
 
+  // Offsets for tile min/max/sum values (format version 4 or later)
+  if (version_ >= 4) {
+    gt_offsets_.tile_metadata_.resize(attribute_num);
+    for (unsigned i = 0; i < attribute_num; ++i) {
+      RETURN_NOT_OK(get_generic_tile_size(offset, &size));
+      offset += size;
+      gt_offsets_.tile_metadata_[i] = offset;
+    }
+  }
+
   loaded_metadata_.generic_tile_offsets_ = true;
 
   return Status::Ok();
@@ -1732,6 +2033,52 @@ Status FragmentMetadata::write_tile_var_sizes(unsigned attr_id, Buffer* buff) {
   return Status::Ok();
 }
 
+Status FragmentMetadata::store_tile_metadata(
+    unsigned attr_id, const EncryptionKey& encryption_key) {
+  Buffer buff;
+  RETURN_NOT_OK(write_tile_metadata(attr_id, &buff));
+  RETURN_NOT_OK(write_generic_tile_to_file(encryption_key, &buff));
+
+  return Status::Ok();
+}
+
+// ===== FORMAT =====
+// tile_metadata_num (uint64_t)
+// tile_min_#1 (void*) tile_min_#2 (void*) ...
+// tile_max_#1 (void*) tile_max_#2 (void*) ...
+// tile_sum_#1 (8 bytes) tile_sum_#2 (8 bytes) ...
+Status FragmentMetadata::write_tile_metadata(unsigned attr_id, Buffer* buff) {
+  Status st;
+
+  // Write number of tiles (zero for attributes without tile metadata)
+  uint64_t tile_metadata_num = tile_sum_[attr_id].size() / sizeof(uint64_t);
+  st = buff->write(&tile_metadata_num, sizeof(uint64_t));
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot serialize fragment metadata; Writing number of tile "
+        "metadata failed"));
+  }
+
+  // Write minimum, maximum and sum values
+  if (tile_metadata_num != 0) {
+    for (const auto& values :
+         {&tile_min_[attr_id], &tile_max_[attr_id], &tile_sum_[attr_id]}) {
+      st = buff->write(values->data(), values->size());
+      if (!st.ok()) {
+        return LOG_STATUS(Status::FragmentMetadataError(
+            "Cannot serialize fragment metadata; Writing tile metadata "
+            "failed"));
+      }
+    }
+  }
+
+  return Status::Ok();
+}
+
+uint64_t FragmentMetadata::tile_metadata_value_size(unsigned attr_id) const {
+  return datatype_size(array_schema_->type(attr_id));
+}
+
 Status FragmentMetadata::write_version(Buffer* buff) {
   RETURN_NOT_OK(buff->write(&version_, sizeof(uint32_t)));
   return Status::Ok();
@@ -1742,6 +2089,30 @@ Status FragmentMetadata::write_sparse_tile_num(Buffer* buff) {
   return Status::Ok();
 }
 
+// ===== FORMAT =====
+// tile_cell_num_num (uint64_t)
+// tile#1 (uint64_t) cell_num#1 (uint64_t)
+// ...
+// tile#tile_cell_num_num (uint64_t) cell_num#tile_cell_num_num (uint64_t)
+Status FragmentMetadata::write_tile_cell_nums(Buffer* buff) {
+  uint64_t tile_cell_num_num = tile_cell_nums_.size();
+  Status st = buff->write(&tile_cell_num_num, sizeof(uint64_t));
+  for (auto it = tile_cell_nums_.begin();
+       st.ok() && it != tile_cell_nums_.end();
+       ++it) {
+    uint64_t tile_and_cell_num[2] = {it->first, it->second};
+    st = buff->write(tile_and_cell_num, sizeof(tile_and_cell_num));
+  }
+
+  if (!st.ok()) {
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot serialize fragment metadata; Writing tile cell numbers "
+        "failed"));
+  }
+
+  return Status::Ok();
+}
+
 Status FragmentMetadata::store_basic(const EncryptionKey& encryption_key) {
   Buffer buff;
   RETURN_NOT_OK(write_version(&buff));
@@ -1750,6 +2121,7 @@ Status FragmentMetadata::store_basic(const EncryptionKey& encryption_key) {
   RETURN_NOT_OK(write_last_tile_cell_num(&buff));
   RETURN_NOT_OK(write_file_sizes(&buff));
   RETURN_NOT_OK(write_file_var_sizes(&buff));
+  RETURN_NOT_OK(write_tile_cell_nums(&buff));
   RETURN_NOT_OK(write_generic_tile_to_file(encryption_key, &buff));
 
   return Status::Ok();
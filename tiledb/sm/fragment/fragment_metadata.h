@@ -36,10 +36,12 @@
 
 #include "tiledb/sm/array_schema/array_schema.h"
 #include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/cache/tile_cache.h"
 #include "tiledb/sm/enums/query_type.h"
 #include "tiledb/sm/misc/status.h"
 #include "tiledb/sm/rtree/rtree.h"
 
+#include <map>
 #include <mutex>
 #include <vector>
 
@@ -249,6 +251,14 @@ class FragmentMetadata {
   template <class T>
   uint64_t get_tile_pos(const T* tile_coords) const;
 
+  /**
+   * Returns `true` if the fragment stores the minimum, maximum and sum of the
+   * values of each tile of the input attribute (see `tile_metadata`). This
+   * holds for the attributes with a single numeric value per cell, in
+   * fragments of format version 4 or later.
+   */
+  bool has_tile_metadata(const std::string& attribute) const;
+
   /**
    * Initializes the fragment metadata structures.
    *
@@ -264,14 +274,50 @@ class FragmentMetadata {
   /** Loads the basic metadata from storage. */
   Status load(const EncryptionKey& encryption_key);
 
+  /**
+   * Loads the basic metadata and the generic tile offsets from the
+   * consolidated fragment metadata of the array, without accessing
+   * the fragment.
+   *
+   * @param buff The consolidated fragment metadata, positioned at the
+   *     entry written by `write_consolidated`. The offset is advanced
+   *     past the entry.
+   * @return Status
+   */
+  Status load_consolidated(ConstBuffer* buff);
+
   /** Stores all the metadata to storage. */
   Status store(const EncryptionKey& encryption_key);
 
+  /**
+   * Writes the entry of the fragment in the consolidated fragment metadata
+   * of the array, i.e., the basic metadata as stored in the fragment
+   * metadata file, followed by the offsets of its generic tiles. Applicable
+   * to format version 3 or later.
+   *
+   * @param encryption_key The encryption key of the array.
+   * @param buff The buffer to write the entry to.
+   * @return Status
+   */
+  Status write_consolidated(const EncryptionKey& encryption_key, Buffer* buff);
+
   /** Retrieves the MBRs. */
   // TODO: Remove after the new dense read algorithm is in
   Status mbrs(
       const EncryptionKey& encryption_key, const std::vector<void*>** mbrs);
 
+  /**
+   * Returns the offset in the file of the input attribute at which the
+   * next tile will be written.
+   */
+  uint64_t next_tile_offset(const std::string& attribute) const;
+
+  /**
+   * Returns the offset in the var-sized file of the input attribute at which
+   * the next var-sized tile will be written.
+   */
+  uint64_t next_tile_var_offset(const std::string& attribute) const;
+
   /** Returns the non-empty domain in which the fragment is constrained. */
   const void* non_empty_domain() const;
 
@@ -326,6 +372,43 @@ class FragmentMetadata {
    */
   void set_tile_index_base(uint64_t tile_base);
 
+  /**
+   * Sets the id of the fragment in the tile cache, which is used to form
+   * the cache keys of its tiles. Until it is set, the tiles of the fragment
+   * are not cached.
+   */
+  void set_tile_cache_id(uint64_t id);
+
+  /**
+   * Sets the number of cells of a sparse tile. Only needed for the tiles
+   * other than the last one holding fewer cells than the array capacity,
+   * which occur in fragments consolidated by copying the tiles of other
+   * fragments.
+   *
+   * @param tile The tile index.
+   * @param cell_num The number of cells in the tile.
+   */
+  void set_tile_cell_num(uint64_t tile, uint64_t cell_num);
+
+  /**
+   * Sets the minimum, maximum and sum of the values of a tile of the input
+   * attribute, which must satisfy `has_tile_metadata`.
+   *
+   * @param attribute The attribute the tile belongs to.
+   * @param tile The index of the tile.
+   * @param min The minimum value, of the attribute type.
+   * @param max The maximum value, of the attribute type.
+   * @param sum The sum of the values, stored as `int64_t`, `uint64_t` or
+   *     `double` for signed integer, unsigned integer and real attributes,
+   *     respectively.
+   */
+  void set_tile_metadata(
+      const std::string& attribute,
+      uint64_t tile,
+      const void* min,
+      const void* max,
+      const void* sum);
+
   /**
    * Sets a tile offset for the input attribute.
    *
@@ -361,6 +444,19 @@ class FragmentMetadata {
   void set_tile_var_size(
       const std::string& attribute, uint64_t tile, uint64_t size);
 
+  /**
+   * Returns the tile cache key of the tile of the input attribute located at
+   * the input file offset.
+   *
+   * @param attribute The attribute the tile belongs to.
+   * @param var If `true`, the tile is in the var-sized values file of the
+   *     attribute; otherwise it is in the fixed-sized (or offsets) file.
+   * @param offset The offset of the tile in the attribute file.
+   * @return The tile cache key.
+   */
+  TileCacheKey tile_cache_key(
+      const std::string& attribute, bool var, uint64_t offset) const;
+
   /** Returns the tile index base value. */
   uint64_t tile_index_base() const;
 
@@ -454,6 +550,27 @@ class FragmentMetadata {
    */
   uint64_t tile_size(const std::string& attribute, uint64_t tile_idx) const;
 
+  /**
+   * Retrieves the minimum, maximum and sum of the values of a tile of the
+   * input attribute, which must satisfy `has_tile_metadata`. See
+   * `set_tile_metadata` for the types of the values.
+   *
+   * @param encryption_key The key the array got opened with.
+   * @param attribute The input attribute.
+   * @param tile_idx The index of the tile in the metadata.
+   * @param min Set to point to the minimum value.
+   * @param max Set to point to the maximum value.
+   * @param sum Set to point to the sum of the values.
+   * @return Status
+   */
+  Status tile_metadata(
+      const EncryptionKey& encryption_key,
+      const std::string& attribute,
+      uint64_t tile_idx,
+      const void** min,
+      const void** max,
+      const void** sum);
+
   /**
    * Retrieves the (uncompressed) tile size for a given var-sized attribute
    * and tile index.
@@ -496,6 +613,7 @@ class FragmentMetadata {
     std::vector<uint64_t> tile_offsets_;
     std::vector<uint64_t> tile_var_offsets_;
     std::vector<uint64_t> tile_var_sizes_;
+    std::vector<uint64_t> tile_metadata_;
   };
 
   /** Keeps track of which metadata is loaded. */
@@ -507,6 +625,7 @@ class FragmentMetadata {
     std::vector<bool> tile_offsets_;
     std::vector<bool> tile_var_offsets_;
     std::vector<bool> tile_var_sizes_;
+    std::vector<bool> tile_metadata_;
   };
 
   /* ********************************* */
@@ -582,6 +701,9 @@ class FragmentMetadata {
   /** An RTree for the MBRs. */
   RTree rtree_;
 
+  /** The id of the fragment in the tile cache. */
+  uint64_t tile_cache_id_;
+
   /**
    * The tile index base which is added to tile indices in setter functions.
    * Only used in global order writes.
@@ -606,6 +728,24 @@ class FragmentMetadata {
    */
   std::vector<std::vector<uint64_t>> tile_var_sizes_;
 
+  /**
+   * The minimum value of each tile, per attribute. Meaningful only for the
+   * attributes satisfying `has_tile_metadata`.
+   */
+  std::vector<std::vector<uint8_t>> tile_min_;
+
+  /** The maximum value of each tile, per attribute. */
+  std::vector<std::vector<uint8_t>> tile_max_;
+
+  /** The sum of the values of each tile (8 bytes per tile), per attribute. */
+  std::vector<std::vector<uint8_t>> tile_sum_;
+
+  /**
+   * The number of cells of the sparse tiles that are not full, excluding the
+   * last tile (see `last_tile_cell_num_`), keyed by tile index.
+   */
+  std::map<uint64_t, uint64_t> tile_cell_nums_;
+
   /** The format version of this metadata. */
   uint32_t version_;
 
@@ -651,6 +791,9 @@ class FragmentMetadata {
   /** Loads the basic metadata from storage. */
   Status load_basic(const EncryptionKey& encryption_key);
 
+  /** Loads the basic metadata from the input buffer. */
+  Status load_basic(ConstBuffer* buff);
+
   /** Loads the R-tree from storage. */
   Status load_rtree(const EncryptionKey& encryption_key);
 
@@ -669,6 +812,10 @@ class FragmentMetadata {
   Status load_tile_var_sizes(
       const EncryptionKey& encryption_key, unsigned attr_id);
 
+  /** Loads the tile min/max/sum values for the input attribute from storage. */
+  Status load_tile_metadata(
+      const EncryptionKey& encryption_key, unsigned attr_id);
+
   /**
    * Loads the bounding coordinates from the fragment metadata buffer.
    *
@@ -743,12 +890,20 @@ class FragmentMetadata {
    */
   Status load_tile_var_sizes(unsigned attr_id, ConstBuffer* buff);
 
+  /**
+   * Loads the tile min/max/sum values for the input attribute from the buffer.
+   */
+  Status load_tile_metadata(unsigned attr_id, ConstBuffer* buff);
+
   /** Loads the format version from the buffer. */
   Status load_version(ConstBuffer* buff);
 
   /** Loads the number of sparse tiles from the buffer. */
   Status load_sparse_tile_num(ConstBuffer* buff);
 
+  /** Loads the cell numbers of the sparse tiles that are not full. */
+  Status load_tile_cell_nums(ConstBuffer* buff);
+
   /**
    * Retrieves the size of the generic tile starting at the input offset.
    */
@@ -764,7 +919,7 @@ class FragmentMetadata {
   /** Loads the basic metadata from storage (version 2 or before). */
   Status load_v2(const EncryptionKey& encryption_key);
 
-  /** Loads the basic metadata from storage (version 3). */
+  /** Loads the basic metadata from storage (version 3 or later). */
   Status load_v3(const EncryptionKey& encryption_key);
 
   /** Writes the sizes of each attribute file to the buffer. */
@@ -814,12 +969,25 @@ class FragmentMetadata {
   /** Writes the variable tile sizes to storage. */
   Status write_tile_var_sizes(unsigned attr_id, Buffer* buff);
 
+  /** Writes the tile min/max/sum values of the input attribute to storage. */
+  Status store_tile_metadata(
+      unsigned attr_id, const EncryptionKey& encryption_key);
+
+  /** Writes the tile min/max/sum values of the input attribute to a buffer. */
+  Status write_tile_metadata(unsigned attr_id, Buffer* buff);
+
+  /** Returns the size of the tile min/max values of the input attribute. */
+  uint64_t tile_metadata_value_size(unsigned attr_id) const;
+
   /** Writes the format version to the buffer. */
   Status write_version(Buffer* buff);
 
   /** Writes the number of sparse tiles to the buffer. */
   Status write_sparse_tile_num(Buffer* buff);
 
+  /** Writes the cell numbers of the sparse tiles that are not full. */
+  Status write_tile_cell_nums(Buffer* buff);
+
   /** Writes the basic metadata to storage. */
   Status store_basic(const EncryptionKey& encryption_key);
 
@@ -69,6 +69,12 @@ const uint64_t memory_budget_fixed = 5368709120;  // 5GB
  */
 const uint64_t memory_budget_var = 10737418240;  // 10GB;
 
+/**
+ * The minimum number of cells reduced by each parallel task of a read
+ * with aggregates.
+ */
+const uint64_t aggregate_chunk_cell_num = 65536;
+
 /**
  * Reduction factor (must be in [0.0, 1.0]) for the multi_range subarray
  * split by the partitioner. If the number is equal to 0.3, then this
@@ -106,6 +112,10 @@ const std::string kv_schema_filename = "__kv_schema.tdb";
 /** The fragment metadata file name. */
 const std::string fragment_metadata_filename = "__fragment_metadata.tdb";
 
+/** The name of the file packing the basic metadata of all fragments. */
+const std::string consolidated_fragment_metadata_filename =
+    "__fragment_meta.tdb";
+
 /** The default tile capacity. */
 const uint64_t capacity = 10000;
 
@@ -241,6 +251,40 @@ const uint32_t consolidation_step_max_frags = UINT32_MAX;
  */
 const float consolidation_step_size_ratio = 0.0f;
 
+/**
+ * What gets consolidated: "fragments" merges the fragments of the array,
+ * and "fragment_meta" packs the basic metadata of its fragments into a
+ * single file.
+ */
+const std::string consolidation_mode = "fragments";
+
+/** Whether the arrays written are consolidated in the background. */
+const bool consolidation_auto = false;
+
+/**
+ * Number of fragments of an array that triggers its consolidation in the
+ * background.
+ */
+const uint32_t consolidation_auto_frag_num = 32;
+
+/**
+ * Interval in milliseconds at which the fragments of the arrays written are
+ * counted for background consolidation.
+ */
+const uint64_t consolidation_auto_interval_ms = 1000;
+
+/**
+ * Maximum rate in bytes per second at which background consolidation reads
+ * and writes fragments. 0 means no limit.
+ */
+const uint64_t consolidation_auto_io_budget = 0;
+
+/**
+ * Interval in milliseconds between the attempts of non-blocking
+ * consolidation to lock an array exclusively.
+ */
+const uint64_t consolidation_xlock_retry_ms = 10;
+
 /** The maximum number of bytes written in a single I/O. */
 const uint64_t max_write_bytes = std::numeric_limits<int>::max();
 
@@ -261,6 +305,27 @@ const uint64_t vfs_min_batch_size = 20 * 1024 * 1024;
 /** The default maximum number of parallel file:/// operations. */
 const uint64_t vfs_file_max_parallel_ops = vfs_num_threads;
 
+/**
+ * The default maximum number of read-only file:/// handles kept open by the
+ * POSIX backend.
+ */
+const uint64_t vfs_file_max_open_handles = 128;
+
+/** Whether io_uring is used by default for batched file:/// reads. */
+const bool vfs_file_enable_io_uring = false;
+
+/** Whether file:/// reads are served from memory-mapped files by default. */
+const bool vfs_file_enable_mmap = false;
+
+/** The number of submission queue entries of a file:/// io_uring instance. */
+const unsigned vfs_file_io_uring_queue_depth = 128;
+
+/**
+ * The size of the scratch page that receives the unneeded gap bytes of a
+ * file:/// scatter read. Larger gaps are skipped with a separate read.
+ */
+const uint64_t vfs_file_scatter_scratch_size = 4096;
+
 /** The maximum name length. */
 const uint32_t uri_max_len = 256;
 
@@ -297,6 +362,55 @@ const int num_tbb_threads = -1;
 /** The tile cache size. */
 const uint64_t tile_cache_size = 10000000;
 
+/**
+ * The number of shards of the tile cache. Each shard is protected by its own
+ * mutex. It must be a power of two.
+ */
+const unsigned tile_cache_shard_num = 16;
+
+/** The default tile cache eviction policy. */
+const std::string tile_cache_policy = "lru";
+
+/**
+ * The default fraction of the tile cache that holds decoded (unfiltered)
+ * tiles. The rest holds tiles as they are stored (filtered).
+ */
+const float tile_cache_decoded_ratio = 1.0f;
+
+/**
+ * The fraction of the nominal size of a tile cache shard that the 2Q A1in
+ * queue may occupy before the main list is evicted from.
+ */
+const double tile_cache_2q_in_ratio = 0.25;
+
+/**
+ * The fraction of the nominal size of a tile cache shard for the W-TinyLFU
+ * window.
+ */
+const double tile_cache_window_ratio = 0.01;
+
+/**
+ * The fraction of the nominal size of a tile cache shard for the W-TinyLFU
+ * protected list.
+ */
+const double tile_cache_protected_ratio = 0.8;
+
+/**
+ * The number of counters per row of the W-TinyLFU frequency sketch of a
+ * tile cache shard. It must be a power of two.
+ */
+const uint64_t tile_cache_sketch_width = 4096;
+
+/** The number of rows of the W-TinyLFU frequency sketch. */
+const uint64_t tile_cache_sketch_depth = 4;
+
+/**
+ * The tile cache id of a fragment that was not assigned one. The tiles of
+ * such a fragment are never cached.
+ */
+const uint64_t tile_cache_no_fragment_id =
+    std::numeric_limits<uint64_t>::max();
+
 /** Empty String **/
 const std::string empty_str = "";
 
@@ -427,7 +541,7 @@ const int32_t library_version[3] = {
     TILEDB_VERSION_MAJOR, TILEDB_VERSION_MINOR, TILEDB_VERSION_PATCH};
 
 /** The TileDB serialization format version number. */
-const uint32_t format_version = 3;
+const uint32_t format_version = 5;
 
 /** The maximum size of a tile chunk (unit of compression) in bytes. */
 const uint64_t max_tile_chunk_size = 64 * 1024;
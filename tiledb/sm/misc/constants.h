@@ -56,6 +56,12 @@ extern const uint64_t memory_budget_fixed;
  */
 extern const uint64_t memory_budget_var;
 
+/**
+ * The minimum number of cells reduced by each parallel task of a read
+ * with aggregates.
+ */
+extern const uint64_t aggregate_chunk_cell_num;
+
 /**
  * Reduction factor (must be in [0.0, 1.0]) for the multi_range subarray
  * split by the partitioner. If the number is equal to 0.3, then this
@@ -183,6 +189,9 @@ extern const std::string file_suffix;
 /** The fragment metadata file name. */
 extern const std::string fragment_metadata_filename;
 
+/** The name of the file packing the basic metadata of all fragments. */
+extern const std::string consolidated_fragment_metadata_filename;
+
 /** Default datatype for a generic tile. */
 extern const Datatype generic_tile_datatype;
 
@@ -228,6 +237,40 @@ extern const uint32_t consolidation_step_max_frags;
  */
 extern const float consolidation_step_size_ratio;
 
+/**
+ * What gets consolidated: "fragments" merges the fragments of the array,
+ * and "fragment_meta" packs the basic metadata of its fragments into a
+ * single file.
+ */
+extern const std::string consolidation_mode;
+
+/** Whether the arrays written are consolidated in the background. */
+extern const bool consolidation_auto;
+
+/**
+ * Number of fragments of an array that triggers its consolidation in the
+ * background.
+ */
+extern const uint32_t consolidation_auto_frag_num;
+
+/**
+ * Interval in milliseconds at which the fragments of the arrays written are
+ * counted for background consolidation.
+ */
+extern const uint64_t consolidation_auto_interval_ms;
+
+/**
+ * Maximum rate in bytes per second at which background consolidation reads
+ * and writes fragments. 0 means no limit.
+ */
+extern const uint64_t consolidation_auto_io_budget;
+
+/**
+ * Interval in milliseconds between the attempts of non-blocking
+ * consolidation to lock an array exclusively.
+ */
+extern const uint64_t consolidation_xlock_retry_ms;
+
 /** The maximum number of bytes written in a single I/O. */
 extern const uint64_t max_write_bytes;
 
@@ -249,6 +292,27 @@ extern const uint64_t vfs_min_batch_size;
 /** The default maximum number of parallel file:/// operations. */
 extern const uint64_t vfs_file_max_parallel_ops;
 
+/**
+ * The default maximum number of read-only file:/// handles kept open by the
+ * POSIX backend.
+ */
+extern const uint64_t vfs_file_max_open_handles;
+
+/** Whether io_uring is used by default for batched file:/// reads. */
+extern const bool vfs_file_enable_io_uring;
+
+/** Whether file:/// reads are served from memory-mapped files by default. */
+extern const bool vfs_file_enable_mmap;
+
+/** The number of submission queue entries of a file:/// io_uring instance. */
+extern const unsigned vfs_file_io_uring_queue_depth;
+
+/**
+ * The size of the scratch page that receives the unneeded gap bytes of a
+ * file:/// scatter read. Larger gaps are skipped with a separate read.
+ */
+extern const uint64_t vfs_file_scatter_scratch_size;
+
 /** The maximum name length. */
 extern const uint32_t uri_max_len;
 
@@ -279,6 +343,54 @@ extern const int num_tbb_threads;
 /** The tile cache size. */
 extern const uint64_t tile_cache_size;
 
+/**
+ * The number of shards of the tile cache. Each shard is protected by its own
+ * mutex. It must be a power of two.
+ */
+extern const unsigned tile_cache_shard_num;
+
+/** The default tile cache eviction policy. */
+extern const std::string tile_cache_policy;
+
+/**
+ * The default fraction of the tile cache that holds decoded (unfiltered)
+ * tiles. The rest holds tiles as they are stored (filtered).
+ */
+extern const float tile_cache_decoded_ratio;
+
+/**
+ * The fraction of the nominal size of a tile cache shard that the 2Q A1in
+ * queue may occupy before the main list is evicted from.
+ */
+extern const double tile_cache_2q_in_ratio;
+
+/**
+ * The fraction of the nominal size of a tile cache shard for the W-TinyLFU
+ * window.
+ */
+extern const double tile_cache_window_ratio;
+
+/**
+ * The fraction of the nominal size of a tile cache shard for the W-TinyLFU
+ * protected list.
+ */
+extern const double tile_cache_protected_ratio;
+
+/**
+ * The number of counters per row of the W-TinyLFU frequency sketch of a
+ * tile cache shard. It must be a power of two.
+ */
+extern const uint64_t tile_cache_sketch_width;
+
+/** The number of rows of the W-TinyLFU frequency sketch. */
+extern const uint64_t tile_cache_sketch_depth;
+
+/**
+ * The tile cache id of a fragment that was not assigned one. The tiles of
+ * such a fragment are never cached.
+ */
+extern const uint64_t tile_cache_no_fragment_id;
+
 /** Empty String reference **/
 extern const std::string empty_str;
 
@@ -1,11 +1,27 @@
 #include <thread>
 
+#include "tiledb/sm/encryption/encryption.h"
 #include "tiledb/sm/misc/stats.h"
 
 namespace tiledb {
 namespace sm {
 namespace stats {
 
+namespace {
+
+const char* aes_isa_str(Encryption::AesIsa isa) {
+  switch (isa) {
+    case Encryption::AesIsa::AES_NI:
+      return "AES-NI";
+    case Encryption::AesIsa::VAES:
+      return "VAES";
+    default:
+      return "none";
+  }
+}
+
+}  // namespace
+
 Statistics all_stats;
 
 Statistics::Statistics() {
@@ -43,6 +59,7 @@ void Statistics::dump(FILE* out) const {
   fprintf(out, "--------\n");
   fprintf(
       out, "Hardware concurrency: %d\n", std::thread::hardware_concurrency());
+  fprintf(out, "Hardware AES: %s\n", aes_isa_str(Encryption::aes_isa()));
 
   fprintf(out, "Reads:\n");
   dump_read_summary(out);
@@ -97,6 +114,14 @@ void Statistics::dump_read_summary(FILE* out) const {
       counter_reader_num_bytes_after_filtering +
           counter_tileio_read_num_resulting_bytes,
       counter_reader_num_tile_bytes_read + counter_tileio_read_num_bytes_read);
+
+  // Decryption throughput is over the time spent in the decryption calls,
+  // summed across all threads.
+  report_throughput(
+      out,
+      "  Decryption throughput",
+      counter_encryption_num_bytes_decrypted,
+      encryption_decrypt_aes256gcm_total_ns);
 }
 
 void Statistics::dump_write_summary(FILE* out) const {
@@ -120,6 +145,23 @@ void Statistics::dump_write_summary(FILE* out) const {
           counter_tileio_write_num_input_bytes,
       counter_writer_num_bytes_written +
           counter_tileio_write_num_bytes_written);
+
+  // Encryption throughput is over the time spent in the encryption calls,
+  // summed across all threads.
+  report_throughput(
+      out,
+      "  Encryption throughput",
+      counter_encryption_num_bytes_encrypted,
+      encryption_encrypt_aes256gcm_total_ns);
+
+  // The time consolidation reads and writes overlap, over the time spent
+  // copying the cells of the consolidated fragments.
+  report_ratio_pct(
+      out,
+      "  Consolidation read/write overlap",
+      "ns",
+      counter_consolidator_copy_overlap_ns,
+      consolidator_copy_array_total_ns);
 }
 
 void Statistics::dump(std::string* out) const {
@@ -183,6 +225,15 @@ void Statistics::report_ratio_pct(
   fprintf(out, "\n");
 }
 
+void Statistics::report_throughput(
+    FILE* out, const char* msg, uint64_t bytes, uint64_t ns) const {
+  fprintf(out, "%s: %" PRIu64 " bytes / %" PRIu64 " ns", msg, bytes, ns);
+  if (ns > 0) {
+    fprintf(out, " (%.2f bytes/ns)", double(bytes) / double(ns));
+  }
+  fprintf(out, "\n");
+}
+
 bool Statistics::enabled() const {
   return enabled_;
 }
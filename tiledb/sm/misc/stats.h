@@ -182,6 +182,17 @@ class Statistics {
       const char* unit,
       uint64_t numerator,
       uint64_t denominator) const;
+
+  /**
+   * Helper function to pretty-print a throughput in bytes per nanosecond.
+   *
+   * @param out Output file
+   * @param msg Message to print at the beginning
+   * @param bytes Number of bytes processed
+   * @param ns Time spent processing them, in nanoseconds
+   */
+  void report_throughput(
+      FILE* out, const char* msg, uint64_t bytes, uint64_t ns) const;
 };
 
 /**
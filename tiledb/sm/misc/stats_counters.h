@@ -44,6 +44,8 @@ STATS_DEFINE_FUNC_STAT(compressor_rle_compress)
 STATS_DEFINE_FUNC_STAT(compressor_rle_decompress)
 STATS_DEFINE_FUNC_STAT(compressor_zstd_compress)
 STATS_DEFINE_FUNC_STAT(compressor_zstd_decompress)
+// Consolidator
+STATS_DEFINE_FUNC_STAT(consolidator_copy_array)
 // Encryption
 STATS_DEFINE_FUNC_STAT(encryption_encrypt_aes256gcm)
 STATS_DEFINE_FUNC_STAT(encryption_decrypt_aes256gcm)
@@ -57,6 +59,8 @@ STATS_DEFINE_FUNC_STAT(cache_lru_invalidate)
 STATS_DEFINE_FUNC_STAT(cache_lru_read)
 STATS_DEFINE_FUNC_STAT(cache_lru_read_partial)
 // Reader
+STATS_DEFINE_FUNC_STAT(reader_aggregate_cells)
+STATS_DEFINE_FUNC_STAT(reader_apply_condition)
 STATS_DEFINE_FUNC_STAT(reader_compute_cell_ranges)
 STATS_DEFINE_FUNC_STAT(reader_compute_dense_cell_ranges)
 STATS_DEFINE_FUNC_STAT(reader_compute_dense_overlapping_tiles_and_cell_ranges)
@@ -82,6 +86,7 @@ STATS_DEFINE_FUNC_STAT(writer_check_global_order)
 STATS_DEFINE_FUNC_STAT(writer_compute_coord_dups)
 STATS_DEFINE_FUNC_STAT(writer_compute_coord_dups_global)
 STATS_DEFINE_FUNC_STAT(writer_compute_coords_metadata)
+STATS_DEFINE_FUNC_STAT(writer_compute_tile_metadata)
 STATS_DEFINE_FUNC_STAT(writer_compute_write_cell_ranges)
 STATS_DEFINE_FUNC_STAT(writer_create_fragment)
 STATS_DEFINE_FUNC_STAT(writer_filter_tiles)
@@ -134,6 +139,7 @@ STATS_DEFINE_FUNC_STAT(vfs_move_file)
 STATS_DEFINE_FUNC_STAT(vfs_open_file)
 STATS_DEFINE_FUNC_STAT(vfs_read)
 STATS_DEFINE_FUNC_STAT(vfs_read_all)
+STATS_DEFINE_FUNC_STAT(vfs_read_scatter)
 STATS_DEFINE_FUNC_STAT(vfs_remove_bucket)
 STATS_DEFINE_FUNC_STAT(vfs_remove_dir)
 STATS_DEFINE_FUNC_STAT(vfs_remove_file)
@@ -159,6 +165,8 @@ STATS_INIT_FUNC_STAT(compressor_rle_compress)
 STATS_INIT_FUNC_STAT(compressor_rle_decompress)
 STATS_INIT_FUNC_STAT(compressor_zstd_compress)
 STATS_INIT_FUNC_STAT(compressor_zstd_decompress)
+// Consolidator
+STATS_INIT_FUNC_STAT(consolidator_copy_array)
 // Encryption
 STATS_INIT_FUNC_STAT(encryption_encrypt_aes256gcm)
 STATS_INIT_FUNC_STAT(encryption_decrypt_aes256gcm)
@@ -172,6 +180,8 @@ STATS_INIT_FUNC_STAT(cache_lru_invalidate)
 STATS_INIT_FUNC_STAT(cache_lru_read)
 STATS_INIT_FUNC_STAT(cache_lru_read_partial)
 // Reader
+STATS_INIT_FUNC_STAT(reader_aggregate_cells)
+STATS_INIT_FUNC_STAT(reader_apply_condition)
 STATS_INIT_FUNC_STAT(reader_compute_cell_ranges)
 STATS_INIT_FUNC_STAT(reader_compute_dense_cell_ranges)
 STATS_INIT_FUNC_STAT(reader_compute_dense_overlapping_tiles_and_cell_ranges)
@@ -197,6 +207,7 @@ STATS_INIT_FUNC_STAT(writer_check_global_order)
 STATS_INIT_FUNC_STAT(writer_compute_coord_dups)
 STATS_INIT_FUNC_STAT(writer_compute_coord_dups_global)
 STATS_INIT_FUNC_STAT(writer_compute_coords_metadata)
+STATS_INIT_FUNC_STAT(writer_compute_tile_metadata)
 STATS_INIT_FUNC_STAT(writer_compute_write_cell_ranges)
 STATS_INIT_FUNC_STAT(writer_create_fragment)
 STATS_INIT_FUNC_STAT(writer_filter_tiles)
@@ -249,6 +260,7 @@ STATS_INIT_FUNC_STAT(vfs_move_dir)
 STATS_INIT_FUNC_STAT(vfs_open_file)
 STATS_INIT_FUNC_STAT(vfs_read)
 STATS_INIT_FUNC_STAT(vfs_read_all)
+STATS_INIT_FUNC_STAT(vfs_read_scatter)
 STATS_INIT_FUNC_STAT(vfs_remove_bucket)
 STATS_INIT_FUNC_STAT(vfs_remove_file)
 STATS_INIT_FUNC_STAT(vfs_remove_dir)
@@ -274,6 +286,8 @@ STATS_REPORT_FUNC_STAT(compressor_rle_compress)
 STATS_REPORT_FUNC_STAT(compressor_rle_decompress)
 STATS_REPORT_FUNC_STAT(compressor_zstd_compress)
 STATS_REPORT_FUNC_STAT(compressor_zstd_decompress)
+// Consolidator
+STATS_REPORT_FUNC_STAT(consolidator_copy_array)
 // Encryption
 STATS_REPORT_FUNC_STAT(encryption_encrypt_aes256gcm)
 STATS_REPORT_FUNC_STAT(encryption_decrypt_aes256gcm)
@@ -287,6 +301,8 @@ STATS_REPORT_FUNC_STAT(cache_lru_invalidate)
 STATS_REPORT_FUNC_STAT(cache_lru_read)
 STATS_REPORT_FUNC_STAT(cache_lru_read_partial)
 // Reader
+STATS_REPORT_FUNC_STAT(reader_aggregate_cells)
+STATS_REPORT_FUNC_STAT(reader_apply_condition)
 STATS_REPORT_FUNC_STAT(reader_compute_cell_ranges)
 STATS_REPORT_FUNC_STAT(reader_compute_dense_cell_ranges)
 STATS_REPORT_FUNC_STAT(reader_compute_dense_overlapping_tiles_and_cell_ranges)
@@ -312,6 +328,7 @@ STATS_REPORT_FUNC_STAT(writer_check_global_order)
 STATS_REPORT_FUNC_STAT(writer_compute_coord_dups)
 STATS_REPORT_FUNC_STAT(writer_compute_coord_dups_global)
 STATS_REPORT_FUNC_STAT(writer_compute_coords_metadata)
+STATS_REPORT_FUNC_STAT(writer_compute_tile_metadata)
 STATS_REPORT_FUNC_STAT(writer_compute_write_cell_ranges)
 STATS_REPORT_FUNC_STAT(writer_create_fragment)
 STATS_REPORT_FUNC_STAT(writer_filter_tiles)
@@ -364,6 +381,7 @@ STATS_REPORT_FUNC_STAT(vfs_move_dir)
 STATS_REPORT_FUNC_STAT(vfs_open_file)
 STATS_REPORT_FUNC_STAT(vfs_read)
 STATS_REPORT_FUNC_STAT(vfs_read_all)
+STATS_REPORT_FUNC_STAT(vfs_read_scatter)
 STATS_REPORT_FUNC_STAT(vfs_remove_bucket)
 STATS_REPORT_FUNC_STAT(vfs_remove_file)
 STATS_REPORT_FUNC_STAT(vfs_remove_dir)
@@ -380,8 +398,36 @@ STATS_REPORT_FUNC_STAT(vfs_s3_write_multipart)
 STATS_DEFINE_COUNTER_STAT(cache_lru_inserts)
 STATS_DEFINE_COUNTER_STAT(cache_lru_read_hits)
 STATS_DEFINE_COUNTER_STAT(cache_lru_read_misses)
+STATS_DEFINE_COUNTER_STAT(cache_tile_admission_rejections)
+STATS_DEFINE_COUNTER_STAT(cache_tile_decode_ns_saved)
+STATS_DEFINE_COUNTER_STAT(cache_tile_evictions)
+STATS_DEFINE_COUNTER_STAT(cache_tile_inserts)
+STATS_DEFINE_COUNTER_STAT(cache_tile_read_hits)
+STATS_DEFINE_COUNTER_STAT(cache_tile_read_misses)
+// Compressors
+STATS_DEFINE_COUNTER_STAT(compressor_num_contexts_created)
+// Consolidator
+STATS_DEFINE_COUNTER_STAT(consolidator_num_tile_copy_steps)
+STATS_DEFINE_COUNTER_STAT(consolidator_num_tiles_copied)
+STATS_DEFINE_COUNTER_STAT(consolidator_num_bytes_copied)
+STATS_DEFINE_COUNTER_STAT(consolidator_num_merge_steps)
+STATS_DEFINE_COUNTER_STAT(consolidator_num_cells_merged)
+STATS_DEFINE_COUNTER_STAT(consolidator_num_cells_deduped)
+STATS_DEFINE_COUNTER_STAT(consolidator_num_copy_chunks)
+STATS_DEFINE_COUNTER_STAT(consolidator_copy_read_ns)
+STATS_DEFINE_COUNTER_STAT(consolidator_copy_write_ns)
+STATS_DEFINE_COUNTER_STAT(consolidator_copy_overlap_ns)
+STATS_DEFINE_COUNTER_STAT(consolidator_num_auto_consolidations)
+STATS_DEFINE_COUNTER_STAT(consolidator_num_auto_io_bytes)
+STATS_DEFINE_COUNTER_STAT(consolidator_auto_throttle_ns)
+STATS_DEFINE_COUNTER_STAT(consolidator_num_fragment_meta_packed)
+// Encryption
+STATS_DEFINE_COUNTER_STAT(encryption_num_bytes_decrypted)
+STATS_DEFINE_COUNTER_STAT(encryption_num_bytes_encrypted)
+STATS_DEFINE_COUNTER_STAT(encryption_num_contexts_created)
 // Fragment Metadata
 STATS_DEFINE_COUNTER_STAT(fragment_metadata_num_fragments)
+STATS_DEFINE_COUNTER_STAT(fragment_metadata_num_consolidated)
 STATS_DEFINE_COUNTER_STAT(fragment_metadata_bytes)
 STATS_DEFINE_COUNTER_STAT(fragment_metadata_bytes_read)
 STATS_DEFINE_COUNTER_STAT(fragment_metadata_cached_bytes_copied)
@@ -390,7 +436,14 @@ STATS_DEFINE_COUNTER_STAT(fragment_metadata_cache_read_hits)
 STATS_DEFINE_COUNTER_STAT(fragment_metadata_cache_read_misses)
 // Reader
 STATS_DEFINE_COUNTER_STAT(reader_attr_tile_cache_hits)
+STATS_DEFINE_COUNTER_STAT(reader_attr_tile_filtered_cache_hits)
+STATS_DEFINE_COUNTER_STAT(reader_num_tiles_mapped)
 STATS_DEFINE_COUNTER_STAT(reader_num_attr_tiles_touched)
+STATS_DEFINE_COUNTER_STAT(reader_num_attr_prefetches)
+STATS_DEFINE_COUNTER_STAT(reader_num_cells_filtered_by_condition)
+STATS_DEFINE_COUNTER_STAT(reader_num_tiles_pruned_by_condition)
+STATS_DEFINE_COUNTER_STAT(reader_num_tiles_pruned_by_tile_metadata)
+STATS_DEFINE_COUNTER_STAT(reader_num_tiles_aggregated_from_metadata)
 STATS_DEFINE_COUNTER_STAT(reader_num_bytes_after_filtering)
 STATS_DEFINE_COUNTER_STAT(reader_num_fixed_cell_bytes_copied)
 STATS_DEFINE_COUNTER_STAT(reader_num_fixed_cell_bytes_read)
@@ -420,6 +473,13 @@ STATS_DEFINE_COUNTER_STAT(vfs_write_total_bytes)
 STATS_DEFINE_COUNTER_STAT(vfs_read_num_parallelized)
 STATS_DEFINE_COUNTER_STAT(vfs_read_all_total_regions)
 STATS_DEFINE_COUNTER_STAT(vfs_posix_write_num_parallelized)
+STATS_DEFINE_COUNTER_STAT(vfs_posix_open_file_cache_hits)
+STATS_DEFINE_COUNTER_STAT(vfs_posix_open_file_cache_misses)
+STATS_DEFINE_COUNTER_STAT(vfs_posix_io_uring_num_submissions)
+STATS_DEFINE_COUNTER_STAT(vfs_posix_io_uring_num_regions)
+STATS_DEFINE_COUNTER_STAT(vfs_posix_read_scatter_num_buffers)
+STATS_DEFINE_COUNTER_STAT(vfs_posix_mmap_num_files)
+STATS_DEFINE_COUNTER_STAT(vfs_posix_mmap_num_reads)
 STATS_DEFINE_COUNTER_STAT(vfs_win32_write_num_parallelized)
 STATS_DEFINE_COUNTER_STAT(vfs_s3_num_parts_written)
 STATS_DEFINE_COUNTER_STAT(vfs_s3_write_num_parallelized)
@@ -430,8 +490,36 @@ STATS_DEFINE_COUNTER_STAT(vfs_s3_write_num_parallelized)
 STATS_INIT_COUNTER_STAT(cache_lru_inserts)
 STATS_INIT_COUNTER_STAT(cache_lru_read_hits)
 STATS_INIT_COUNTER_STAT(cache_lru_read_misses)
+STATS_INIT_COUNTER_STAT(cache_tile_admission_rejections)
+STATS_INIT_COUNTER_STAT(cache_tile_decode_ns_saved)
+STATS_INIT_COUNTER_STAT(cache_tile_evictions)
+STATS_INIT_COUNTER_STAT(cache_tile_inserts)
+STATS_INIT_COUNTER_STAT(cache_tile_read_hits)
+STATS_INIT_COUNTER_STAT(cache_tile_read_misses)
+// Compressors
+STATS_INIT_COUNTER_STAT(compressor_num_contexts_created)
+// Consolidator
+STATS_INIT_COUNTER_STAT(consolidator_num_tile_copy_steps)
+STATS_INIT_COUNTER_STAT(consolidator_num_tiles_copied)
+STATS_INIT_COUNTER_STAT(consolidator_num_bytes_copied)
+STATS_INIT_COUNTER_STAT(consolidator_num_merge_steps)
+STATS_INIT_COUNTER_STAT(consolidator_num_cells_merged)
+STATS_INIT_COUNTER_STAT(consolidator_num_cells_deduped)
+STATS_INIT_COUNTER_STAT(consolidator_num_copy_chunks)
+STATS_INIT_COUNTER_STAT(consolidator_copy_read_ns)
+STATS_INIT_COUNTER_STAT(consolidator_copy_write_ns)
+STATS_INIT_COUNTER_STAT(consolidator_copy_overlap_ns)
+STATS_INIT_COUNTER_STAT(consolidator_num_auto_consolidations)
+STATS_INIT_COUNTER_STAT(consolidator_num_auto_io_bytes)
+STATS_INIT_COUNTER_STAT(consolidator_auto_throttle_ns)
+STATS_INIT_COUNTER_STAT(consolidator_num_fragment_meta_packed)
+// Encryption
+STATS_INIT_COUNTER_STAT(encryption_num_bytes_decrypted)
+STATS_INIT_COUNTER_STAT(encryption_num_bytes_encrypted)
+STATS_INIT_COUNTER_STAT(encryption_num_contexts_created)
 // Fragment Metadata
 STATS_INIT_COUNTER_STAT(fragment_metadata_num_fragments)
+STATS_INIT_COUNTER_STAT(fragment_metadata_num_consolidated)
 STATS_INIT_COUNTER_STAT(fragment_metadata_bytes)
 STATS_INIT_COUNTER_STAT(fragment_metadata_bytes_read)
 STATS_INIT_COUNTER_STAT(fragment_metadata_cached_bytes_copied)
@@ -440,7 +528,14 @@ STATS_INIT_COUNTER_STAT(fragment_metadata_cache_read_hits)
 STATS_INIT_COUNTER_STAT(fragment_metadata_cache_read_misses)
 // Reader
 STATS_INIT_COUNTER_STAT(reader_attr_tile_cache_hits)
+STATS_INIT_COUNTER_STAT(reader_attr_tile_filtered_cache_hits)
+STATS_INIT_COUNTER_STAT(reader_num_tiles_mapped)
 STATS_INIT_COUNTER_STAT(reader_num_attr_tiles_touched)
+STATS_INIT_COUNTER_STAT(reader_num_attr_prefetches)
+STATS_INIT_COUNTER_STAT(reader_num_cells_filtered_by_condition)
+STATS_INIT_COUNTER_STAT(reader_num_tiles_pruned_by_condition)
+STATS_INIT_COUNTER_STAT(reader_num_tiles_pruned_by_tile_metadata)
+STATS_INIT_COUNTER_STAT(reader_num_tiles_aggregated_from_metadata)
 STATS_INIT_COUNTER_STAT(reader_num_bytes_after_filtering)
 STATS_INIT_COUNTER_STAT(reader_num_fixed_cell_bytes_copied)
 STATS_INIT_COUNTER_STAT(reader_num_fixed_cell_bytes_read)
@@ -470,6 +565,13 @@ STATS_INIT_COUNTER_STAT(vfs_write_total_bytes)
 STATS_INIT_COUNTER_STAT(vfs_read_num_parallelized)
 STATS_INIT_COUNTER_STAT(vfs_read_all_total_regions)
 STATS_INIT_COUNTER_STAT(vfs_posix_write_num_parallelized)
+STATS_INIT_COUNTER_STAT(vfs_posix_open_file_cache_hits)
+STATS_INIT_COUNTER_STAT(vfs_posix_open_file_cache_misses)
+STATS_INIT_COUNTER_STAT(vfs_posix_io_uring_num_submissions)
+STATS_INIT_COUNTER_STAT(vfs_posix_io_uring_num_regions)
+STATS_INIT_COUNTER_STAT(vfs_posix_read_scatter_num_buffers)
+STATS_INIT_COUNTER_STAT(vfs_posix_mmap_num_files)
+STATS_INIT_COUNTER_STAT(vfs_posix_mmap_num_reads)
 STATS_INIT_COUNTER_STAT(vfs_win32_write_num_parallelized)
 STATS_INIT_COUNTER_STAT(vfs_s3_num_parts_written)
 STATS_INIT_COUNTER_STAT(vfs_s3_write_num_parallelized)
@@ -480,8 +582,36 @@ STATS_INIT_COUNTER_STAT(vfs_s3_write_num_parallelized)
 STATS_REPORT_COUNTER_STAT(cache_lru_inserts)
 STATS_REPORT_COUNTER_STAT(cache_lru_read_hits)
 STATS_REPORT_COUNTER_STAT(cache_lru_read_misses)
+STATS_REPORT_COUNTER_STAT(cache_tile_admission_rejections)
+STATS_REPORT_COUNTER_STAT(cache_tile_decode_ns_saved)
+STATS_REPORT_COUNTER_STAT(cache_tile_evictions)
+STATS_REPORT_COUNTER_STAT(cache_tile_inserts)
+STATS_REPORT_COUNTER_STAT(cache_tile_read_hits)
+STATS_REPORT_COUNTER_STAT(cache_tile_read_misses)
+// Compressors
+STATS_REPORT_COUNTER_STAT(compressor_num_contexts_created)
+// Consolidator
+STATS_REPORT_COUNTER_STAT(consolidator_num_tile_copy_steps)
+STATS_REPORT_COUNTER_STAT(consolidator_num_tiles_copied)
+STATS_REPORT_COUNTER_STAT(consolidator_num_bytes_copied)
+STATS_REPORT_COUNTER_STAT(consolidator_num_merge_steps)
+STATS_REPORT_COUNTER_STAT(consolidator_num_cells_merged)
+STATS_REPORT_COUNTER_STAT(consolidator_num_cells_deduped)
+STATS_REPORT_COUNTER_STAT(consolidator_num_copy_chunks)
+STATS_REPORT_COUNTER_STAT(consolidator_copy_read_ns)
+STATS_REPORT_COUNTER_STAT(consolidator_copy_write_ns)
+STATS_REPORT_COUNTER_STAT(consolidator_copy_overlap_ns)
+STATS_REPORT_COUNTER_STAT(consolidator_num_auto_consolidations)
+STATS_REPORT_COUNTER_STAT(consolidator_num_auto_io_bytes)
+STATS_REPORT_COUNTER_STAT(consolidator_auto_throttle_ns)
+STATS_REPORT_COUNTER_STAT(consolidator_num_fragment_meta_packed)
+// Encryption
+STATS_REPORT_COUNTER_STAT(encryption_num_bytes_decrypted)
+STATS_REPORT_COUNTER_STAT(encryption_num_bytes_encrypted)
+STATS_REPORT_COUNTER_STAT(encryption_num_contexts_created)
 // Fragment Metadata
 STATS_REPORT_COUNTER_STAT(fragment_metadata_num_fragments)
+STATS_REPORT_COUNTER_STAT(fragment_metadata_num_consolidated)
 STATS_REPORT_COUNTER_STAT(fragment_metadata_bytes)
 STATS_REPORT_COUNTER_STAT(fragment_metadata_bytes_read)
 STATS_REPORT_COUNTER_STAT(fragment_metadata_cached_bytes_copied)
@@ -490,7 +620,14 @@ STATS_REPORT_COUNTER_STAT(fragment_metadata_cache_read_hits)
 STATS_REPORT_COUNTER_STAT(fragment_metadata_cache_read_misses)
 // Reader
 STATS_REPORT_COUNTER_STAT(reader_attr_tile_cache_hits)
+STATS_REPORT_COUNTER_STAT(reader_attr_tile_filtered_cache_hits)
+STATS_REPORT_COUNTER_STAT(reader_num_tiles_mapped)
 STATS_REPORT_COUNTER_STAT(reader_num_attr_tiles_touched)
+STATS_REPORT_COUNTER_STAT(reader_num_attr_prefetches)
+STATS_REPORT_COUNTER_STAT(reader_num_cells_filtered_by_condition)
+STATS_REPORT_COUNTER_STAT(reader_num_tiles_pruned_by_condition)
+STATS_REPORT_COUNTER_STAT(reader_num_tiles_pruned_by_tile_metadata)
+STATS_REPORT_COUNTER_STAT(reader_num_tiles_aggregated_from_metadata)
 STATS_REPORT_COUNTER_STAT(reader_num_bytes_after_filtering)
 STATS_REPORT_COUNTER_STAT(reader_num_fixed_cell_bytes_copied)
 STATS_REPORT_COUNTER_STAT(reader_num_fixed_cell_bytes_read)
@@ -520,6 +657,13 @@ STATS_REPORT_COUNTER_STAT(vfs_write_total_bytes)
 STATS_REPORT_COUNTER_STAT(vfs_read_num_parallelized)
 STATS_REPORT_COUNTER_STAT(vfs_read_all_total_regions)
 STATS_REPORT_COUNTER_STAT(vfs_posix_write_num_parallelized)
+STATS_REPORT_COUNTER_STAT(vfs_posix_open_file_cache_hits)
+STATS_REPORT_COUNTER_STAT(vfs_posix_open_file_cache_misses)
+STATS_REPORT_COUNTER_STAT(vfs_posix_io_uring_num_submissions)
+STATS_REPORT_COUNTER_STAT(vfs_posix_io_uring_num_regions)
+STATS_REPORT_COUNTER_STAT(vfs_posix_read_scatter_num_buffers)
+STATS_REPORT_COUNTER_STAT(vfs_posix_mmap_num_files)
+STATS_REPORT_COUNTER_STAT(vfs_posix_mmap_num_reads)
 STATS_REPORT_COUNTER_STAT(vfs_win32_write_num_parallelized)
 STATS_REPORT_COUNTER_STAT(vfs_s3_num_parts_written)
 STATS_REPORT_COUNTER_STAT(vfs_s3_write_num_parallelized)
@@ -213,6 +213,15 @@ std::string Status::code_to_string() const {
     case StatusCode::CellSlabIterError:
       type = "[TileDB::CellSlabIter] Error";
       break;
+    case StatusCode::TileCacheError:
+      type = "[TileDB::TileCache] Error";
+      break;
+    case StatusCode::QueryConditionError:
+      type = "[TileDB::QueryCondition] Error";
+      break;
+    case StatusCode::AggregateError:
+      type = "[TileDB::Aggregate] Error";
+      break;
     default:
       type = "[TileDB::?] Error:";
   }
@@ -117,6 +117,9 @@ enum class StatusCode : char {
   SubarrayPartitionerError,
   RTreeError,
   CellSlabIterError,
+  TileCacheError,
+  QueryConditionError,
+  AggregateError,
 };
 
 class Status {
@@ -354,6 +357,21 @@ class Status {
     return Status(StatusCode::CellSlabIterError, msg, -1);
   }
 
+  /** Return a TileCacheError error class Status with a given message **/
+  static Status TileCacheError(const std::string& msg) {
+    return Status(StatusCode::TileCacheError, msg, -1);
+  }
+
+  /** Return a QueryConditionError error class Status with a given message **/
+  static Status QueryConditionError(const std::string& msg) {
+    return Status(StatusCode::QueryConditionError, msg, -1);
+  }
+
+  /** Return an AggregateError error class Status with a given message **/
+  static Status AggregateError(const std::string& msg) {
+    return Status(StatusCode::AggregateError, msg, -1);
+  }
+
   /** Returns true iff the status indicates success **/
   bool ok() const {
     return (state_ == nullptr);
@@ -0,0 +1,333 @@
+/**
+ * @file   aggregate.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class Aggregate.
+ */
+
+#include "tiledb/sm/query/aggregate.h"
+#include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/misc/constants.h"
+#include "tiledb/sm/misc/logger.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+Aggregate::Aggregate(
+    const std::string& attribute, AggregateOp op, Datatype type)
+    : attribute_(attribute)
+    , op_(op)
+    , type_(type) {
+  reset();
+}
+
+Aggregate::~Aggregate() = default;
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+const std::string& Aggregate::attribute() const {
+  return attribute_;
+}
+
+Status Aggregate::check(
+    const ArraySchema* array_schema,
+    const std::string& attribute,
+    AggregateOp op) {
+  auto attr = array_schema->attribute(attribute);
+  if (attr == nullptr || attribute == constants::coords)
+    return LOG_STATUS(Status::AggregateError(
+        "Aggregate check failed; Unknown attribute '" + attribute + "'"));
+  if (op == AggregateOp::COUNT)
+    return Status::Ok();
+
+  if (attr->var_size() || attr->cell_val_num() != 1)
+    return LOG_STATUS(Status::AggregateError(
+        "Aggregate check failed; Attribute '" + attribute +
+        "' must store a single fixed-sized value per cell"));
+
+  auto type = attr->type();
+  switch (type) {
+    case Datatype::INT8:
+    case Datatype::UINT8:
+    case Datatype::INT16:
+    case Datatype::UINT16:
+    case Datatype::INT32:
+    case Datatype::UINT32:
+    case Datatype::INT64:
+    case Datatype::UINT64:
+    case Datatype::FLOAT32:
+    case Datatype::FLOAT64:
+      break;
+    default:
+      return LOG_STATUS(Status::AggregateError(
+          "Aggregate check failed; Unsupported type '" + datatype_str(type) +
+          "' of attribute '" + attribute + "'"));
+  }
+
+  return Status::Ok();
+}
+
+bool Aggregate::can_update_from_tile_metadata(
+    const void* min, const void* max) const {
+  if (op_ != AggregateOp::MIN && op_ != AggregateOp::MAX)
+    return true;
+
+  // The writer sets both bounds of a tile with a NaN value to NaN
+  (void)max;
+  if (type_ == Datatype::FLOAT32)
+    return !std::isnan(*(const float*)min);
+  if (type_ == Datatype::FLOAT64)
+    return !std::isnan(*(const double*)min);
+  return true;
+}
+
+void Aggregate::merge(const Aggregate& other) {
+  count_ += other.count_;
+  sum_int_ += other.sum_int_;
+  sum_real_ += other.sum_real_;
+  if (other.has_min_max_)
+    merge_bounds(other.min_, other.max_);
+}
+
+AggregateOp Aggregate::op() const {
+  return op_;
+}
+
+void Aggregate::reset() {
+  count_ = 0;
+  sum_int_ = 0;
+  sum_real_ = 0;
+  std::memset(min_, 0, sizeof(min_));
+  std::memset(max_, 0, sizeof(max_));
+  has_min_max_ = false;
+}
+
+Status Aggregate::result(void* result) const {
+  bool real = (type_ == Datatype::FLOAT32 || type_ == Datatype::FLOAT64);
+  switch (op_) {
+    case AggregateOp::COUNT:
+      std::memcpy(result, &count_, sizeof(count_));
+      break;
+    case AggregateOp::SUM:
+      // The wrapped around signed sums have the bit pattern of `int64_t`
+      if (real)
+        std::memcpy(result, &sum_real_, sizeof(sum_real_));
+      else
+        std::memcpy(result, &sum_int_, sizeof(sum_int_));
+      break;
+    case AggregateOp::MIN:
+    case AggregateOp::MAX:
+      if (!has_min_max_)
+        return LOG_STATUS(Status::AggregateError(
+            "Cannot get aggregate result; No values of attribute '" +
+            attribute_ + "' were aggregated"));
+      std::memcpy(
+          result,
+          op_ == AggregateOp::MIN ? min_ : max_,
+          datatype_size(type_));
+      break;
+    case AggregateOp::MEAN: {
+      double mean = std::numeric_limits<double>::quiet_NaN();
+      if (count_ != 0) {
+        if (real)
+          mean = sum_real_ / count_;
+        else if (
+            type_ == Datatype::INT8 || type_ == Datatype::INT16 ||
+            type_ == Datatype::INT32 || type_ == Datatype::INT64)
+          mean = (double)(int64_t)sum_int_ / count_;
+        else
+          mean = (double)sum_int_ / count_;
+      }
+      std::memcpy(result, &mean, sizeof(mean));
+      break;
+    }
+  }
+
+  return Status::Ok();
+}
+
+uint64_t Aggregate::result_size() const {
+  if (op_ == AggregateOp::MIN || op_ == AggregateOp::MAX)
+    return datatype_size(type_);
+  return sizeof(uint64_t);
+}
+
+void Aggregate::update(const void* values, uint64_t cell_num) {
+  count_ += cell_num;
+  if (!uses_values())
+    return;
+
+  switch (type_) {
+    case Datatype::INT8:
+      return update_typed((const int8_t*)values, cell_num);
+    case Datatype::UINT8:
+      return update_typed((const uint8_t*)values, cell_num);
+    case Datatype::INT16:
+      return update_typed((const int16_t*)values, cell_num);
+    case Datatype::UINT16:
+      return update_typed((const uint16_t*)values, cell_num);
+    case Datatype::INT32:
+      return update_typed((const int32_t*)values, cell_num);
+    case Datatype::UINT32:
+      return update_typed((const uint32_t*)values, cell_num);
+    case Datatype::INT64:
+      return update_typed((const int64_t*)values, cell_num);
+    case Datatype::UINT64:
+      return update_typed((const uint64_t*)values, cell_num);
+    case Datatype::FLOAT32:
+      return update_typed((const float*)values, cell_num);
+    case Datatype::FLOAT64:
+      return update_typed((const double*)values, cell_num);
+    default:
+      assert(false);
+  }
+}
+
+void Aggregate::update_from_tile_metadata(
+    const void* min, const void* max, const void* sum, uint64_t cell_num) {
+  count_ += cell_num;
+  switch (op_) {
+    case AggregateOp::COUNT:
+      break;
+    case AggregateOp::SUM:
+    case AggregateOp::MEAN:
+      // The tile sums are stored as `int64_t`, `uint64_t` or `double`,
+      // matching `sum_int_` and `sum_real_`
+      if (type_ == Datatype::FLOAT32 || type_ == Datatype::FLOAT64) {
+        double s;
+        std::memcpy(&s, sum, sizeof(s));
+        sum_real_ += s;
+      } else {
+        uint64_t s;
+        std::memcpy(&s, sum, sizeof(s));
+        sum_int_ += s;
+      }
+      break;
+    case AggregateOp::MIN:
+    case AggregateOp::MAX:
+      merge_bounds(min, max);
+      break;
+  }
+}
+
+bool Aggregate::uses_values() const {
+  return op_ != AggregateOp::COUNT;
+}
+
+/* ****************************** */
+/*          PRIVATE METHODS       */
+/* ****************************** */
+
+void Aggregate::merge_bounds(const void* min, const void* max) {
+  switch (type_) {
+    case Datatype::INT8:
+      return merge_typed_bounds(*(const int8_t*)min, *(const int8_t*)max);
+    case Datatype::UINT8:
+      return merge_typed_bounds(*(const uint8_t*)min, *(const uint8_t*)max);
+    case Datatype::INT16:
+      return merge_typed_bounds(*(const int16_t*)min, *(const int16_t*)max);
+    case Datatype::UINT16:
+      return merge_typed_bounds(*(const uint16_t*)min, *(const uint16_t*)max);
+    case Datatype::INT32:
+      return merge_typed_bounds(*(const int32_t*)min, *(const int32_t*)max);
+    case Datatype::UINT32:
+      return merge_typed_bounds(*(const uint32_t*)min, *(const uint32_t*)max);
+    case Datatype::INT64:
+      return merge_typed_bounds(*(const int64_t*)min, *(const int64_t*)max);
+    case Datatype::UINT64:
+      return merge_typed_bounds(*(const uint64_t*)min, *(const uint64_t*)max);
+    case Datatype::FLOAT32:
+      return merge_typed_bounds(*(const float*)min, *(const float*)max);
+    case Datatype::FLOAT64:
+      return merge_typed_bounds(*(const double*)min, *(const double*)max);
+    default:
+      assert(false);
+  }
+}
+
+template <class T>
+void Aggregate::merge_typed_bounds(T min, T max) {
+  // Also false if either value is NaN
+  if (!(min <= max))
+    return;
+
+  if (has_min_max_) {
+    T cur_min, cur_max;
+    std::memcpy(&cur_min, min_, sizeof(T));
+    std::memcpy(&cur_max, max_, sizeof(T));
+    min = cur_min < min ? cur_min : min;
+    max = cur_max > max ? cur_max : max;
+  }
+  std::memcpy(min_, &min, sizeof(T));
+  std::memcpy(max_, &max, sizeof(T));
+  has_min_max_ = true;
+}
+
+template <class T>
+void Aggregate::update_typed(const T* values, uint64_t cell_num) {
+  // The loops keep their accumulators in locals and have no early exits,
+  // so that the compiler vectorizes them
+  if (op_ == AggregateOp::MIN || op_ == AggregateOp::MAX) {
+    // NaN values fail both comparisons and are skipped. If all values are
+    // NaN, `min > max` and the bounds are ignored by `merge_typed_bounds`.
+    T min = std::numeric_limits<T>::max();
+    T max = std::numeric_limits<T>::lowest();
+    for (uint64_t i = 0; i < cell_num; ++i) {
+      auto v = values[i];
+      min = v < min ? v : min;
+      max = v > max ? v : max;
+    }
+    merge_typed_bounds(min, max);
+  } else if (std::is_floating_point<T>::value) {
+    double sum = 0;
+    for (uint64_t i = 0; i < cell_num; ++i)
+      sum += values[i];
+    sum_real_ += sum;
+  } else {
+    // Unsigned arithmetic wraps around on overflow
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < cell_num; ++i)
+      sum += (uint64_t)values[i];
+    sum_int_ += sum;
+  }
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,212 @@
+/**
+ * @file   aggregate.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class Aggregate.
+ */
+
+#ifndef TILEDB_AGGREGATE_H
+#define TILEDB_AGGREGATE_H
+
+#include "tiledb/sm/enums/aggregate_op.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/misc/status.h"
+
+#include <string>
+
+namespace tiledb {
+namespace sm {
+
+class ArraySchema;
+
+/**
+ * An aggregate (COUNT, SUM, MIN, MAX or MEAN) over the values of an
+ * attribute, computed by the reader while it scans the attribute tiles
+ * instead of copying the cells into user buffers.
+ *
+ * The result type depends on the operator: COUNT returns a `uint64_t`,
+ * SUM an `int64_t`, `uint64_t` or `double` for signed integer, unsigned
+ * integer and real attributes respectively, MIN and MAX a value of the
+ * attribute type, and MEAN a `double`. The integer sums wrap around on
+ * overflow. NaN values are ignored by MIN and MAX, but propagate to SUM
+ * and MEAN.
+ */
+class Aggregate {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param attribute The aggregated attribute.
+   * @param op The aggregate operator.
+   * @param type The type of the attribute.
+   */
+  Aggregate(const std::string& attribute, AggregateOp op, Datatype type);
+
+  /** Destructor. */
+  ~Aggregate();
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Returns the aggregated attribute. */
+  const std::string& attribute() const;
+
+  /**
+   * Checks that an aggregate can be computed on the given array, i.e.,
+   * that the attribute exists and, unless the operator is COUNT, that it
+   * stores a single numeric value per cell.
+   *
+   * @param array_schema The array schema to check against.
+   * @param attribute The aggregated attribute.
+   * @param op The aggregate operator.
+   * @return Status
+   */
+  static Status check(
+      const ArraySchema* array_schema,
+      const std::string& attribute,
+      AggregateOp op);
+
+  /**
+   * Checks whether the aggregate can be updated with the minimum, maximum
+   * and sum of a tile (see `update_from_tile_metadata`) in place of its
+   * values. This is not the case for MIN and MAX over a tile of real values
+   * with a NaN value, whose bounds are unknown.
+   */
+  bool can_update_from_tile_metadata(const void* min, const void* max) const;
+
+  /**
+   * Merges the partial aggregate of a disjoint set of cells into this one.
+   *
+   * @param other The aggregate to merge, on the same attribute and
+   *     operator.
+   */
+  void merge(const Aggregate& other);
+
+  /** Returns the aggregate operator. */
+  AggregateOp op() const;
+
+  /** Clears the aggregated values. */
+  void reset();
+
+  /**
+   * Retrieves the result of the aggregate.
+   *
+   * @param result The result, of the type documented in the class
+   *     description.
+   * @return Status
+   */
+  Status result(void* result) const;
+
+  /** Returns the size in bytes of the result of the aggregate. */
+  uint64_t result_size() const;
+
+  /**
+   * Updates the aggregate with a batch of cells.
+   *
+   * @param values The values of the cells, stored contiguously. Ignored
+   *     for COUNT.
+   * @param cell_num The number of cells.
+   */
+  void update(const void* values, uint64_t cell_num);
+
+  /**
+   * Updates the aggregate with the cells of a whole tile, given the
+   * minimum, maximum and sum of its values as stored in the fragment
+   * metadata.
+   *
+   * @param min The minimum value of the tile.
+   * @param max The maximum value of the tile.
+   * @param sum The sum of the values of the tile.
+   * @param cell_num The number of cells of the tile.
+   */
+  void update_from_tile_metadata(
+      const void* min, const void* max, const void* sum, uint64_t cell_num);
+
+  /** Returns `true` if the aggregate needs the values of the cells. */
+  bool uses_values() const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The aggregated attribute. */
+  std::string attribute_;
+
+  /** The aggregate operator. */
+  AggregateOp op_;
+
+  /** The type of the attribute. */
+  Datatype type_;
+
+  /** The number of aggregated cells. */
+  uint64_t count_;
+
+  /** The sum of the aggregated integer values, wrapped around on overflow. */
+  uint64_t sum_int_;
+
+  /** The sum of the aggregated real values. */
+  double sum_real_;
+
+  /** The minimum aggregated value, stored in the attribute type. */
+  uint8_t min_[8];
+
+  /** The maximum aggregated value, stored in the attribute type. */
+  uint8_t max_[8];
+
+  /** `true` if `min_` and `max_` hold a value (i.e., not all were NaN). */
+  bool has_min_max_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /**
+   * Merges a minimum and a maximum value into the bounds of the aggregate.
+   * The values are ignored if `min > max` or either is NaN.
+   */
+  void merge_bounds(const void* min, const void* max);
+
+  /** Merges a minimum and a maximum value of type `T` into the bounds. */
+  template <class T>
+  void merge_typed_bounds(T min, T max);
+
+  /** Updates the aggregate with values of type `T`. */
+  template <class T>
+  void update_typed(const T* values, uint64_t cell_num);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_AGGREGATE_H
@@ -81,6 +81,16 @@ Query::~Query() = default;
 /*               API              */
 /* ****************************** */
 
+Status Query::add_aggregate(const char* attribute, AggregateOp op) {
+  if (type_ != QueryType::READ)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot add aggregate; Only applicable to read queries"));
+
+  std::string normalized;
+  RETURN_NOT_OK(ArraySchema::attribute_name_normalized(attribute, &normalized));
+  return reader_.add_aggregate(normalized, op);
+}
+
 const ArraySchema* Query::array_schema() const {
   if (type_ == QueryType::WRITE)
     return writer_.array_schema();
@@ -102,6 +112,20 @@ Status Query::finalize() {
   return Status::Ok();
 }
 
+Status Query::get_aggregate(
+    const char* attribute, AggregateOp op, void* result) const {
+  if (type_ != QueryType::READ)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot get aggregate; Only applicable to read queries"));
+  if (status_ != QueryStatus::COMPLETED)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot get aggregate; The query has not completed"));
+
+  std::string normalized;
+  RETURN_NOT_OK(ArraySchema::attribute_name_normalized(attribute, &normalized));
+  return reader_.get_aggregate(normalized, op, result);
+}
+
 Status Query::get_buffer(
     const char* attribute, void** buffer, uint64_t** buffer_size) const {
   // Normalize attribute
@@ -300,6 +324,14 @@ Status Query::set_buffer(
       attribute, buffer_off, buffer_off_size, buffer_val, buffer_val_size);
 }
 
+Status Query::set_condition(const QueryCondition& condition) {
+  if (type_ != QueryType::READ)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot set query condition; Only applicable to read queries"));
+
+  return reader_.set_condition(condition);
+}
+
 Status Query::set_layout(Layout layout) {
   layout_ = layout;
   if (type_ == QueryType::WRITE)
@@ -315,6 +347,15 @@ Status Query::set_sparse_mode(bool sparse_mode) {
   return reader_.set_sparse_mode(sparse_mode);
 }
 
+Status Query::set_tile_cache_populate(bool populate) {
+  if (type_ != QueryType::READ)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot set tile cache populate; Only applicable to read queries"));
+
+  reader_.set_tile_cache_populate(populate);
+  return Status::Ok();
+}
+
 Status Query::set_subarray(const void* subarray) {
   RETURN_NOT_OK(check_subarray(subarray));
   if (type_ == QueryType::WRITE) {
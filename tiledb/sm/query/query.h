@@ -33,6 +33,7 @@
 #ifndef TILEDB_QUERY_H
 #define TILEDB_QUERY_H
 
+#include "tiledb/sm/enums/aggregate_op.h"
 #include "tiledb/sm/enums/query_status.h"
 #include "tiledb/sm/enums/query_type.h"
 #include "tiledb/sm/fragment/fragment_metadata.h"
@@ -40,6 +41,7 @@
 #include "tiledb/sm/misc/status.h"
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/query/dense_cell_range_iter.h"
+#include "tiledb/sm/query/query_condition.h"
 #include "tiledb/sm/query/reader.h"
 #include "tiledb/sm/query/writer.h"
 #include "tiledb/sm/storage_manager/storage_manager.h"
@@ -81,6 +83,19 @@ class Query {
   /*                 API               */
   /* ********************************* */
 
+  /**
+   * Adds an aggregate over the values of an attribute to a read query. A
+   * read with aggregates sets no buffers; it completes in a single
+   * submission, after which the results are retrieved with
+   * `get_aggregate`.
+   *
+   * @param attribute The aggregated attribute. An empty string means
+   *     the special default attribute.
+   * @param op The aggregate operator.
+   * @return Status
+   */
+  Status add_aggregate(const char* attribute, AggregateOp op);
+
   /** Returns the array schema. */
   const ArraySchema* array_schema() const;
 
@@ -188,6 +203,18 @@ class Query {
    */
   Status finalize();
 
+  /**
+   * Retrieves the result of an aggregate of a completed read query.
+   *
+   * @param attribute The aggregated attribute. An empty string means
+   *     the special default attribute.
+   * @param op The aggregate operator.
+   * @param result The result (see `Aggregate` for its type).
+   * @return Status
+   */
+  Status get_aggregate(const char* attribute, AggregateOp op, void* result)
+      const;
+
   /**
    * Retrieves the buffer of a fixed-sized attribute.
    *
@@ -280,6 +307,15 @@ class Query {
       void* buffer_val,
       uint64_t* buffer_val_size);
 
+  /**
+   * Sets a condition on the attribute values of the cells to be read.
+   * Applicable only to read queries.
+   *
+   * @param condition The condition to be set. It is copied into the query.
+   * @return Status
+   */
+  Status set_condition(const QueryCondition& condition);
+
   /**
    * Sets the cell layout of the query. The function will return an error
    * if the queried array is a key-value store (because it has its default
@@ -300,6 +336,15 @@ class Query {
    */
   Status set_sparse_mode(bool sparse_mode);
 
+  /**
+   * Sets whether the tiles fetched by the query are inserted into the tile
+   * cache. Applicable only to read queries.
+   *
+   * @param populate If `false`, fetched tiles are not cached.
+   * @return Status
+   */
+  Status set_tile_cache_populate(bool populate);
+
   /**
    * Sets the query subarray. If it is null, then the subarray will be set to
    * the entire domain.
@@ -0,0 +1,414 @@
+/**
+ * @file   query_condition.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class QueryCondition.
+ */
+
+#include "tiledb/sm/query/query_condition.h"
+#include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/misc/constants.h"
+#include "tiledb/sm/misc/logger.h"
+
+#include <cstring>
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+QueryCondition::QueryCondition()
+    : op_(QueryConditionOp::EQ)
+    , combination_op_(QueryConditionCombinationOp::AND) {
+}
+
+QueryCondition::~QueryCondition() = default;
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status QueryCondition::apply(
+    const ArraySchema* array_schema,
+    const std::unordered_map<std::string, const void*>& values,
+    const std::unordered_map<std::string, VarValues>& var_values,
+    uint64_t cell_num,
+    std::vector<uint8_t>* result) const {
+  if (empty())
+    return LOG_STATUS(Status::QueryConditionError(
+        "Cannot apply query condition; Condition is empty"));
+
+  result->resize(cell_num);
+  return apply(array_schema, values, var_values, cell_num, result->data());
+}
+
+Status QueryCondition::check(const ArraySchema* array_schema) const {
+  if (empty())
+    return LOG_STATUS(Status::QueryConditionError(
+        "Query condition check failed; Condition is empty"));
+
+  for (const auto& child : children_)
+    RETURN_NOT_OK(child.check(array_schema));
+  if (!children_.empty())
+    return Status::Ok();
+
+  auto attr = array_schema->attribute(attribute_name_);
+  if (attr == nullptr || attribute_name_ == constants::coords)
+    return LOG_STATUS(Status::QueryConditionError(
+        "Query condition check failed; Unknown attribute '" +
+        attribute_name_ + "'"));
+  auto type = attr->type();
+  if (attr->var_size()) {
+    if (op_ != QueryConditionOp::EQ && op_ != QueryConditionOp::NE)
+      return LOG_STATUS(Status::QueryConditionError(
+          "Query condition check failed; Var-sized attribute '" +
+          attribute_name_ + "' can only be compared for equality"));
+    if (value_.size() % datatype_size(type) != 0)
+      return LOG_STATUS(Status::QueryConditionError(
+          "Query condition check failed; The size of the value compared "
+          "against attribute '" +
+          attribute_name_ + "' is not a multiple of the attribute type size"));
+    return Status::Ok();
+  }
+  if (attr->cell_val_num() != 1)
+    return LOG_STATUS(Status::QueryConditionError(
+        "Query condition check failed; Attribute '" + attribute_name_ +
+        "' must store a single fixed-sized value per cell"));
+
+  switch (type) {
+    case Datatype::INT8:
+    case Datatype::UINT8:
+    case Datatype::INT16:
+    case Datatype::UINT16:
+    case Datatype::INT32:
+    case Datatype::UINT32:
+    case Datatype::INT64:
+    case Datatype::UINT64:
+    case Datatype::FLOAT32:
+    case Datatype::FLOAT64:
+    case Datatype::CHAR:
+    case Datatype::STRING_ASCII:
+    case Datatype::STRING_UTF8:
+      break;
+    default:
+      return LOG_STATUS(Status::QueryConditionError(
+          "Query condition check failed; Unsupported type '" +
+          datatype_str(type) + "' of attribute '" + attribute_name_ + "'"));
+  }
+
+  if (value_.size() != datatype_size(type))
+    return LOG_STATUS(Status::QueryConditionError(
+        "Query condition check failed; The size of the value compared "
+        "against attribute '" +
+        attribute_name_ + "' does not match the attribute type"));
+
+  return Status::Ok();
+}
+
+Status QueryCondition::combine(
+    const QueryCondition& rhs,
+    QueryConditionCombinationOp combination_op,
+    QueryCondition* combined) const {
+  if (empty() || rhs.empty())
+    return LOG_STATUS(Status::QueryConditionError(
+        "Cannot combine query conditions; Condition is empty"));
+
+  // Conditions combined with the same operator are flattened, so that
+  // chains such as `a AND b AND c` are evaluated in a single pass
+  QueryCondition result;
+  result.combination_op_ = combination_op;
+  for (const auto cond : {this, &rhs}) {
+    if (!cond->children_.empty() && cond->combination_op_ == combination_op) {
+      result.children_.insert(
+          result.children_.end(),
+          cond->children_.begin(),
+          cond->children_.end());
+    } else {
+      result.children_.push_back(*cond);
+    }
+    result.field_names_.insert(
+        cond->field_names_.begin(), cond->field_names_.end());
+  }
+  *combined = std::move(result);
+
+  return Status::Ok();
+}
+
+bool QueryCondition::empty() const {
+  return field_names_.empty();
+}
+
+bool QueryCondition::may_satisfy(
+    const ArraySchema* array_schema,
+    const std::unordered_map<std::string, std::pair<const void*, const void*>>&
+        bounds) const {
+  // Combination of conditions
+  if (!children_.empty()) {
+    bool is_and = (combination_op_ == QueryConditionCombinationOp::AND);
+    for (const auto& child : children_) {
+      if (child.may_satisfy(array_schema, bounds) != is_and)
+        return !is_and;
+    }
+    return is_and;
+  }
+
+  // Single comparison
+  auto it = bounds.find(attribute_name_);
+  if (it == bounds.end())
+    return true;
+  auto min = it->second.first;
+  auto max = it->second.second;
+  switch (array_schema->type(attribute_name_)) {
+    case Datatype::INT8:
+      return may_satisfy_comparison<int8_t>(min, max);
+    case Datatype::UINT8:
+      return may_satisfy_comparison<uint8_t>(min, max);
+    case Datatype::INT16:
+      return may_satisfy_comparison<int16_t>(min, max);
+    case Datatype::UINT16:
+      return may_satisfy_comparison<uint16_t>(min, max);
+    case Datatype::INT32:
+      return may_satisfy_comparison<int32_t>(min, max);
+    case Datatype::UINT32:
+      return may_satisfy_comparison<uint32_t>(min, max);
+    case Datatype::INT64:
+      return may_satisfy_comparison<int64_t>(min, max);
+    case Datatype::UINT64:
+      return may_satisfy_comparison<uint64_t>(min, max);
+    case Datatype::FLOAT32:
+      return may_satisfy_comparison<float>(min, max);
+    case Datatype::FLOAT64:
+      return may_satisfy_comparison<double>(min, max);
+    default:
+      return true;
+  }
+}
+
+const std::set<std::string>& QueryCondition::field_names() const {
+  return field_names_;
+}
+
+Status QueryCondition::init(
+    const std::string& attribute_name,
+    const void* value,
+    uint64_t value_size,
+    QueryConditionOp op) {
+  if (!empty())
+    return LOG_STATUS(Status::QueryConditionError(
+        "Cannot initialize query condition; Condition is already initialized"));
+  if (attribute_name.empty())
+    return LOG_STATUS(Status::QueryConditionError(
+        "Cannot initialize query condition; Attribute name cannot be empty"));
+  if (value == nullptr || value_size == 0)
+    return LOG_STATUS(Status::QueryConditionError(
+        "Cannot initialize query condition; Value cannot be empty"));
+
+  attribute_name_ = attribute_name;
+  value_.resize(value_size);
+  std::memcpy(value_.data(), value, value_size);
+  op_ = op;
+  field_names_.insert(attribute_name);
+
+  return Status::Ok();
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+Status QueryCondition::apply(
+    const ArraySchema* array_schema,
+    const std::unordered_map<std::string, const void*>& values,
+    const std::unordered_map<std::string, VarValues>& var_values,
+    uint64_t cell_num,
+    uint8_t* result) const {
+  // Combination of conditions
+  if (!children_.empty()) {
+    RETURN_NOT_OK(
+        children_[0].apply(array_schema, values, var_values, cell_num, result));
+    std::vector<uint8_t> child_result(cell_num);
+    for (size_t c = 1; c < children_.size(); ++c) {
+      RETURN_NOT_OK(children_[c].apply(
+          array_schema, values, var_values, cell_num, child_result.data()));
+      if (combination_op_ == QueryConditionCombinationOp::AND) {
+        for (uint64_t i = 0; i < cell_num; ++i)
+          result[i] &= child_result[i];
+      } else {
+        for (uint64_t i = 0; i < cell_num; ++i)
+          result[i] |= child_result[i];
+      }
+    }
+    return Status::Ok();
+  }
+
+  // Single comparison on a var-sized attribute
+  if (array_schema->var_size(attribute_name_)) {
+    auto it = var_values.find(attribute_name_);
+    if (it == var_values.end() || it->second.codes.size() < cell_num)
+      return LOG_STATUS(Status::QueryConditionError(
+          "Cannot apply query condition; Missing values of attribute '" +
+          attribute_name_ + "'"));
+    apply_var_comparison(it->second, cell_num, result);
+    return Status::Ok();
+  }
+
+  // Single comparison on a fixed-sized attribute
+  auto it = values.find(attribute_name_);
+  if (it == values.end())
+    return LOG_STATUS(Status::QueryConditionError(
+        "Cannot apply query condition; Missing values of attribute '" +
+        attribute_name_ + "'"));
+  auto buff = it->second;
+  switch (array_schema->type(attribute_name_)) {
+    case Datatype::INT8:
+      apply_comparison((const int8_t*)buff, cell_num, result);
+      break;
+    case Datatype::UINT8:
+    case Datatype::STRING_ASCII:
+    case Datatype::STRING_UTF8:
+      apply_comparison((const uint8_t*)buff, cell_num, result);
+      break;
+    case Datatype::INT16:
+      apply_comparison((const int16_t*)buff, cell_num, result);
+      break;
+    case Datatype::UINT16:
+      apply_comparison((const uint16_t*)buff, cell_num, result);
+      break;
+    case Datatype::INT32:
+      apply_comparison((const int32_t*)buff, cell_num, result);
+      break;
+    case Datatype::UINT32:
+      apply_comparison((const uint32_t*)buff, cell_num, result);
+      break;
+    case Datatype::INT64:
+      apply_comparison((const int64_t*)buff, cell_num, result);
+      break;
+    case Datatype::UINT64:
+      apply_comparison((const uint64_t*)buff, cell_num, result);
+      break;
+    case Datatype::FLOAT32:
+      apply_comparison((const float*)buff, cell_num, result);
+      break;
+    case Datatype::FLOAT64:
+      apply_comparison((const double*)buff, cell_num, result);
+      break;
+    case Datatype::CHAR:
+      apply_comparison((const char*)buff, cell_num, result);
+      break;
+    default:
+      return LOG_STATUS(Status::QueryConditionError(
+          "Cannot apply query condition; Unsupported attribute type"));
+  }
+
+  return Status::Ok();
+}
+
+template <class T>
+void QueryCondition::apply_comparison(
+    const T* values, uint64_t cell_num, uint8_t* result) const {
+  T value;
+  std::memcpy(&value, value_.data(), sizeof(T));
+
+  switch (op_) {
+    case QueryConditionOp::LT:
+      for (uint64_t i = 0; i < cell_num; ++i)
+        result[i] = values[i] < value;
+      break;
+    case QueryConditionOp::LE:
+      for (uint64_t i = 0; i < cell_num; ++i)
+        result[i] = values[i] <= value;
+      break;
+    case QueryConditionOp::GT:
+      for (uint64_t i = 0; i < cell_num; ++i)
+        result[i] = values[i] > value;
+      break;
+    case QueryConditionOp::GE:
+      for (uint64_t i = 0; i < cell_num; ++i)
+        result[i] = values[i] >= value;
+      break;
+    case QueryConditionOp::EQ:
+      for (uint64_t i = 0; i < cell_num; ++i)
+        result[i] = values[i] == value;
+      break;
+    case QueryConditionOp::NE:
+      for (uint64_t i = 0; i < cell_num; ++i)
+        result[i] = values[i] != value;
+      break;
+  }
+}
+
+void QueryCondition::apply_var_comparison(
+    const VarValues& values, uint64_t cell_num, uint8_t* result) const {
+  // Compare each dictionary value once, then look up the result of each cell
+  auto eq = (op_ == QueryConditionOp::EQ);
+  std::vector<uint8_t> entry_result(values.entries.size());
+  for (size_t e = 0; e < values.entries.size(); ++e) {
+    const auto& entry = values.entries[e];
+    bool equal = entry.second == value_.size() &&
+                 !std::memcmp(entry.first, value_.data(), value_.size());
+    entry_result[e] = equal == eq;
+  }
+  for (uint64_t i = 0; i < cell_num; ++i)
+    result[i] = entry_result[values.codes[i]];
+}
+
+template <class T>
+bool QueryCondition::may_satisfy_comparison(
+    const void* min, const void* max) const {
+  T value, lo, hi;
+  std::memcpy(&value, value_.data(), sizeof(T));
+  std::memcpy(&lo, min, sizeof(T));
+  std::memcpy(&hi, max, sizeof(T));
+
+  // Unordered (NaN) bounds rule out nothing
+  if (lo != lo || hi != hi)
+    return true;
+
+  switch (op_) {
+    case QueryConditionOp::LT:
+      return lo < value;
+    case QueryConditionOp::LE:
+      return lo <= value;
+    case QueryConditionOp::GT:
+      return hi > value;
+    case QueryConditionOp::GE:
+      return hi >= value;
+    case QueryConditionOp::EQ:
+      return lo <= value && value <= hi;
+    case QueryConditionOp::NE:
+      return !(lo == value && hi == value);
+  }
+
+  return true;
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,234 @@
+/**
+ * @file   query_condition.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class QueryCondition.
+ */
+
+#ifndef TILEDB_QUERY_CONDITION_H
+#define TILEDB_QUERY_CONDITION_H
+
+#include "tiledb/sm/enums/query_condition_combination_op.h"
+#include "tiledb/sm/enums/query_condition_op.h"
+#include "tiledb/sm/misc/status.h"
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tiledb {
+namespace sm {
+
+class ArraySchema;
+
+/**
+ * A condition on the attribute values of the cells of a read query. It is
+ * either a single comparison of an attribute against a value (e.g.,
+ * `a1 < 5`), or a combination of conditions with a logical operator
+ * (e.g., `a1 < 5 AND a2 == 0.5`).
+ */
+class QueryCondition {
+ public:
+  /* ********************************* */
+  /*           TYPE DEFINITIONS        */
+  /* ********************************* */
+
+  /**
+   * The values of a var-sized attribute for a batch of cells, given as a
+   * dictionary of values and the code (i.e., dictionary position) of the
+   * value of each cell. Comparisons are evaluated once per dictionary value.
+   */
+  struct VarValues {
+    /** The dictionary values, as pointers to the data and sizes in bytes. */
+    std::vector<std::pair<const void*, uint64_t>> entries;
+
+    /** The code of each cell. */
+    std::vector<uint64_t> codes;
+  };
+
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Constructor. Creates an empty condition. */
+  QueryCondition();
+
+  /** Destructor. */
+  ~QueryCondition();
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Evaluates the condition on a batch of cells.
+   *
+   * @param array_schema The schema of the array the cells belong to.
+   * @param values Maps each fixed-sized attribute the condition refers to
+   *     (see `field_names`) to a buffer holding the values of the cells
+   *     contiguously.
+   * @param var_values Maps each var-sized attribute the condition refers to
+   *     to the values of the cells.
+   * @param cell_num The number of cells.
+   * @param result Set to `cell_num` values, each equal to `1` if the
+   *     respective cell satisfies the condition and `0` otherwise.
+   * @return Status
+   */
+  Status apply(
+      const ArraySchema* array_schema,
+      const std::unordered_map<std::string, const void*>& values,
+      const std::unordered_map<std::string, VarValues>& var_values,
+      uint64_t cell_num,
+      std::vector<uint8_t>* result) const;
+
+  /**
+   * Checks that the condition can be evaluated on the given array, i.e.,
+   * that every attribute it refers to exists and either stores a single
+   * fixed-sized value per cell of a supported type, with each compared value
+   * having the size of the attribute type, or is var-sized and only compared
+   * for equality.
+   *
+   * @param array_schema The array schema to check against.
+   * @return Status
+   */
+  Status check(const ArraySchema* array_schema) const;
+
+  /**
+   * Combines this condition with another one into `combined`.
+   *
+   * @param rhs The other condition.
+   * @param combination_op The logical operator combining the two conditions.
+   * @param combined The resulting condition.
+   * @return Status
+   */
+  Status combine(
+      const QueryCondition& rhs,
+      QueryConditionCombinationOp combination_op,
+      QueryCondition* combined) const;
+
+  /** Returns `true` if the condition has not been initialized. */
+  bool empty() const;
+
+  /**
+   * Checks whether some cell with attribute values within the input bounds
+   * may satisfy the condition. Used to skip the tiles whose minimum and
+   * maximum values (see `FragmentMetadata::tile_metadata`) rule out any
+   * result.
+   *
+   * @param array_schema The schema of the array the cells belong to.
+   * @param bounds Maps an attribute to its minimum and maximum values. The
+   *     attributes missing from the map are considered unbounded.
+   * @return `false` if no such cell can satisfy the condition, and `true`
+   *     otherwise.
+   */
+  bool may_satisfy(
+      const ArraySchema* array_schema,
+      const std::unordered_map<
+          std::string,
+          std::pair<const void*, const void*>>& bounds) const;
+
+  /** Returns the names of the attributes the condition refers to. */
+  const std::set<std::string>& field_names() const;
+
+  /**
+   * Initializes the condition as a comparison of an attribute against a
+   * value.
+   *
+   * @param attribute_name The attribute name.
+   * @param value The value to compare against.
+   * @param value_size The size of `value` in bytes.
+   * @param op The comparison operator.
+   * @return Status
+   */
+  Status init(
+      const std::string& attribute_name,
+      const void* value,
+      uint64_t value_size,
+      QueryConditionOp op);
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The compared attribute (empty for combinations of conditions). */
+  std::string attribute_name_;
+
+  /** The value the attribute is compared against. */
+  std::vector<uint8_t> value_;
+
+  /** The comparison operator. */
+  QueryConditionOp op_;
+
+  /** The conditions combined by `combination_op_`. */
+  std::vector<QueryCondition> children_;
+
+  /** The logical operator combining `children_`. */
+  QueryConditionCombinationOp combination_op_;
+
+  /** The names of the attributes the condition refers to. */
+  std::set<std::string> field_names_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /**
+   * Evaluates the condition, storing a `0`/`1` value per cell in `result`,
+   * which must hold `cell_num` values.
+   */
+  Status apply(
+      const ArraySchema* array_schema,
+      const std::unordered_map<std::string, const void*>& values,
+      const std::unordered_map<std::string, VarValues>& var_values,
+      uint64_t cell_num,
+      uint8_t* result) const;
+
+  /** Evaluates a comparison on values of type `T`. */
+  template <class T>
+  void apply_comparison(
+      const T* values, uint64_t cell_num, uint8_t* result) const;
+
+  /** Evaluates an equality comparison on the values of var-sized cells. */
+  void apply_var_comparison(
+      const VarValues& values, uint64_t cell_num, uint8_t* result) const;
+
+  /**
+   * Checks whether a comparison may hold for some value of type `T` in the
+   * range `[min, max]`.
+   */
+  template <class T>
+  bool may_satisfy_comparison(const void* min, const void* max) const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_QUERY_CONDITION_H
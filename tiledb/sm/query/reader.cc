@@ -31,6 +31,7 @@
  */
 
 #include "tiledb/sm/query/reader.h"
+#include "tiledb/sm/filter/dictionary_filter.h"
 #include "tiledb/sm/misc/comparators.h"
 #include "tiledb/sm/misc/logger.h"
 #include "tiledb/sm/misc/parallel_functions.h"
@@ -40,7 +41,9 @@
 #include "tiledb/sm/storage_manager/storage_manager.h"
 #include "tiledb/sm/tile/tile_io.h"
 
+#include <chrono>
 #include <iostream>
+#include <unordered_set>
 
 namespace tiledb {
 namespace sm {
@@ -92,6 +95,7 @@ Reader::Reader() {
   read_state_.initialized_ = false;
   read_state_.overflowed_ = false;
   sparse_mode_ = false;
+  tile_cache_populate_ = true;
   read_state_2_.set_ = false;
 }
 
@@ -103,6 +107,31 @@ Reader::~Reader() {
 /*               API              */
 /* ****************************** */
 
+Status Reader::add_aggregate(const std::string& attribute, AggregateOp op) {
+  if (array_schema_ == nullptr)
+    return LOG_STATUS(
+        Status::ReaderError("Cannot add aggregate; Array schema not set"));
+  if (read_state_.initialized_)
+    return LOG_STATUS(Status::ReaderError(
+        "Cannot add aggregate; Aggregates cannot be added after "
+        "initialization"));
+  RETURN_NOT_OK(Aggregate::check(array_schema_, attribute, op));
+
+  for (const auto& aggregate : aggregates_) {
+    if (aggregate.attribute() == attribute && aggregate.op() == op)
+      return Status::Ok();
+  }
+  aggregates_.emplace_back(attribute, op, array_schema_->type(attribute));
+
+  // Only the tiles of the attributes whose values are aggregated are read
+  if (aggregates_.back().uses_values() &&
+      std::find(attributes_.begin(), attributes_.end(), attribute) ==
+          attributes_.end())
+    attributes_.emplace_back(attribute);
+
+  return Status::Ok();
+}
+
 const ArraySchema* Reader::array_schema() const {
   return array_schema_;
 }
@@ -130,6 +159,18 @@ bool Reader::incomplete() const {
   return ret;
 }
 
+Status Reader::get_aggregate(
+    const std::string& attribute, AggregateOp op, void* result) const {
+  for (const auto& aggregate : aggregates_) {
+    if (aggregate.attribute() == attribute && aggregate.op() == op)
+      return aggregate.result(result);
+  }
+
+  return LOG_STATUS(Status::ReaderError(
+      "Cannot get aggregate; No such aggregate was added on attribute '" +
+      attribute + "'"));
+}
+
 Status Reader::get_buffer(
     const std::string& attribute, void** buffer, uint64_t** buffer_size) const {
   auto it = attr_buffers_.find(attribute);
@@ -174,12 +215,24 @@ Status Reader::init() {
   if (array_schema_ == nullptr)
     return LOG_STATUS(Status::ReaderError(
         "Cannot initialize reader; Array metadata not set"));
-  if (attr_buffers_.empty())
+  if (aggregates_.empty() && attr_buffers_.empty())
     return LOG_STATUS(
         Status::ReaderError("Cannot initialize reader; Buffers not set"));
-  if (attributes_.empty())
+  if (aggregates_.empty() && attributes_.empty())
     return LOG_STATUS(
         Status::ReaderError("Cannot initialize reader; Attributes not set"));
+  if (!aggregates_.empty() && !attr_buffers_.empty())
+    return LOG_STATUS(Status::ReaderError(
+        "Cannot initialize reader; Buffers cannot be set in reads with "
+        "aggregates"));
+  if (!aggregates_.empty() && read_state_2_.set_)
+    return LOG_STATUS(Status::ReaderError(
+        "Cannot initialize reader; Reads with aggregates do not support "
+        "subarray objects"));
+  if (!condition_.empty() && array_schema_->dense() && !sparse_mode_)
+    return LOG_STATUS(Status::ReaderError(
+        "Cannot initialize reader; Query conditions are applicable only to "
+        "sparse reads"));
 
   // Get configuration parameters
   const char *memory_budget, *memory_budget_var;
@@ -243,13 +296,22 @@ Status Reader::next_subarray_partition() {
     return Status::Ok();
   }
 
-  // Prepare buffer sizes map
+  // Prepare buffer sizes map. Reads with aggregates have no buffers; their
+  // partitions are sized so that the tiles they read fit in the memory
+  // budget.
   std::unordered_map<std::string, std::pair<uint64_t, uint64_t>>
       buffer_sizes_map;
   for (const auto& it : attr_buffers_) {
     buffer_sizes_map[it.first] = std::pair<uint64_t, uint64_t>(
         it.second.original_buffer_size_, it.second.original_buffer_var_size_);
   }
+  if (!aggregates_.empty()) {
+    buffer_sizes_map[constants::coords] =
+        std::pair<uint64_t, uint64_t>(memory_budget_, memory_budget_var_);
+    for (const auto& attr : attributes_)
+      buffer_sizes_map[attr] =
+          std::pair<uint64_t, uint64_t>(memory_budget_, memory_budget_var_);
+  }
 
   // Loop until a new partition whose result fit in the buffers is found
   std::unordered_map<std::string, std::pair<double, double>> est_buffer_sizes;
@@ -356,6 +418,9 @@ Status Reader::read() {
   if (read_state_2_.set_)
     return read_2();
 
+  if (!aggregates_.empty())
+    return aggregate_read();
+
   if (fragment_metadata_.empty() ||
       read_state_.cur_subarray_partition_ == nullptr) {
     zero_out_buffer_sizes();
@@ -590,6 +655,13 @@ Status Reader::set_buffer(
   return Status::Ok();
 }
 
+Status Reader::set_condition(const QueryCondition& condition) {
+  RETURN_NOT_OK(condition.check(array_schema_));
+  condition_ = condition;
+
+  return Status::Ok();
+}
+
 void Reader::set_fragment_metadata(
     const std::vector<FragmentMetadata*>& fragment_metadata) {
   fragment_metadata_ = fragment_metadata;
@@ -627,6 +699,10 @@ void Reader::set_storage_manager(StorageManager* storage_manager) {
   storage_manager_ = storage_manager;
 }
 
+void Reader::set_tile_cache_populate(bool populate) {
+  tile_cache_populate_ = populate;
+}
+
 Status Reader::set_subarray(const void* subarray) {
   if (read_state_.subarray_ != nullptr)
     clear_read_state();
@@ -666,6 +742,231 @@ void* Reader::subarray() const {
 /*          PRIVATE METHODS       */
 /* ****************************** */
 
+Status Reader::aggregate_cells(const OverlappingCellRangeList& cell_ranges) {
+  STATS_FUNC_IN(reader_aggregate_cells);
+
+  // For easy reference
+  auto aggregate_num = aggregates_.size();
+  std::vector<uint64_t> cell_sizes(aggregate_num, 0);
+  for (size_t i = 0; i < aggregate_num; ++i) {
+    if (aggregates_[i].uses_values())
+      cell_sizes[i] = array_schema_->cell_size(aggregates_[i].attribute());
+  }
+
+  // Split the cell ranges into chunks of about the same number of cells
+  std::vector<size_t> chunk_starts;
+  uint64_t chunk_cell_num = constants::aggregate_chunk_cell_num;
+  for (size_t i = 0; i < cell_ranges.size(); ++i) {
+    if (chunk_cell_num >= constants::aggregate_chunk_cell_num) {
+      chunk_starts.push_back(i);
+      chunk_cell_num = 0;
+    }
+    chunk_cell_num += cell_ranges[i].end_ - cell_ranges[i].start_ + 1;
+  }
+  auto chunk_num = chunk_starts.size();
+  chunk_starts.push_back(cell_ranges.size());
+
+  // Reduce the chunks in parallel into partial aggregates
+  std::vector<std::vector<Aggregate>> partials(chunk_num, aggregates_);
+  auto statuses = parallel_for(0, chunk_num, [&](uint64_t c) {
+    auto& partial = partials[c];
+    for (auto& aggregate : partial)
+      aggregate.reset();
+
+    for (auto i = chunk_starts[c]; i < chunk_starts[c + 1]; ++i) {
+      const auto& cr = cell_ranges[i];
+      if (cr.tile_ == nullptr)  // Empty range
+        continue;
+
+      auto cell_num = cr.end_ - cr.start_ + 1;
+      for (size_t j = 0; j < aggregate_num; ++j) {
+        const void* values = nullptr;
+        if (partial[j].uses_values()) {
+          const auto& tile =
+              cr.tile_->attr_tiles_.find(partial[j].attribute())->second.first;
+          values =
+              (const unsigned char*)tile.data() + cr.start_ * cell_sizes[j];
+        }
+        partial[j].update(values, cell_num);
+      }
+    }
+
+    return Status::Ok();
+  });
+  for (const auto& st : statuses)
+    RETURN_NOT_OK(st);
+
+  // Merge the partial aggregates in a fixed order, so that the real sums
+  // do not depend on the scheduling of the tasks
+  for (const auto& partial : partials) {
+    for (size_t j = 0; j < aggregate_num; ++j)
+      aggregates_[j].merge(partial[j]);
+  }
+
+  return Status::Ok();
+
+  STATS_FUNC_OUT(reader_aggregate_cells);
+}
+
+Status Reader::aggregate_read() {
+  for (auto& aggregate : aggregates_)
+    aggregate.reset();
+
+  while (!fragment_metadata_.empty() &&
+         read_state_.cur_subarray_partition_ != nullptr) {
+    if (array_schema_->dense() && !sparse_mode_) {
+      RETURN_NOT_OK(dense_read());
+    } else {
+      RETURN_NOT_OK(sparse_read());
+    }
+
+    RETURN_NOT_OK(next_subarray_partition());
+  }
+
+  return Status::Ok();
+}
+
+template <class T>
+Status Reader::aggregate_tiles_from_tile_metadata(OverlappingTileVec* tiles) {
+  auto encryption_key = array_->encryption_key();
+  auto dim_num = array_schema_->dim_num();
+  auto aggregate_num = aggregates_.size();
+  auto get_mbr = [&](const OverlappingTile* tile, const T** mbr) {
+    auto mbrs = (const std::vector<void*>*)nullptr;
+    RETURN_NOT_OK(fragment_metadata_[tile->fragment_idx_]->mbrs(
+        *encryption_key, &mbrs));
+    *mbr = (const T*)(*mbrs)[tile->tile_idx_];
+    return Status::Ok();
+  };
+
+  // Group the tiles by fragment
+  std::vector<std::vector<const OverlappingTile*>> fragment_tiles(
+      fragment_metadata_.size());
+  for (const auto& tile : *tiles)
+    fragment_tiles[tile->fragment_idx_].push_back(tile.get());
+
+  std::vector<const void*> min(aggregate_num), max(aggregate_num),
+      sum(aggregate_num);
+  for (auto& tile : *tiles) {
+    if (!tile->full_overlap_)
+      continue;
+
+    // Every aggregated attribute must have usable tile metadata
+    auto fragment = fragment_metadata_[tile->fragment_idx_];
+    bool usable = true;
+    for (size_t i = 0; i < aggregate_num && usable; ++i) {
+      const auto& aggregate = aggregates_[i];
+      if (!aggregate.uses_values())
+        continue;
+      if (!fragment->has_tile_metadata(aggregate.attribute())) {
+        usable = false;
+        break;
+      }
+      RETURN_NOT_OK(fragment->tile_metadata(
+          *encryption_key,
+          aggregate.attribute(),
+          tile->tile_idx_,
+          &min[i],
+          &max[i],
+          &sum[i]));
+      usable = aggregate.can_update_from_tile_metadata(min[i], max[i]);
+    }
+    if (!usable)
+      continue;
+
+    // The tile must not overlap a tile of another fragment, checking the
+    // non-empty domain of each fragment first
+    const T* mbr = nullptr;
+    RETURN_NOT_OK(get_mbr(tile.get(), &mbr));
+    for (unsigned f = 0; f < fragment_tiles.size() && usable; ++f) {
+      if (f == tile->fragment_idx_ || fragment_tiles[f].empty() ||
+          !utils::geometry::overlap(
+              mbr,
+              (const T*)fragment_metadata_[f]->non_empty_domain(),
+              dim_num))
+        continue;
+      for (auto other : fragment_tiles[f]) {
+        const T* other_mbr = nullptr;
+        RETURN_NOT_OK(get_mbr(other, &other_mbr));
+        if (utils::geometry::overlap(mbr, other_mbr, dim_num)) {
+          usable = false;
+          break;
+        }
+      }
+    }
+    if (!usable)
+      continue;
+
+    // Aggregate and release the tile, so that none of its attributes is read
+    auto cell_num = fragment->cell_num(tile->tile_idx_);
+    for (size_t i = 0; i < aggregate_num; ++i) {
+      auto& aggregate = aggregates_[i];
+      if (aggregate.uses_values())
+        aggregate.update_from_tile_metadata(min[i], max[i], sum[i], cell_num);
+      else
+        aggregate.update(nullptr, cell_num);
+    }
+    tile->attr_tiles_.clear();
+    STATS_COUNTER_ADD(reader_num_tiles_aggregated_from_metadata, 1);
+  }
+
+  return Status::Ok();
+}
+
+template <class T>
+Status Reader::apply_condition(OverlappingCoordsVec<T>* coords) const {
+  STATS_FUNC_IN(reader_apply_condition);
+
+  auto cell_num = (uint64_t)coords->size();
+  if (cell_num == 0)
+    return Status::Ok();
+
+  // Gather the values of the condition attributes of the coordinates
+  const auto& field_names = condition_.field_names();
+  std::vector<std::vector<uint8_t>> buffs(field_names.size());
+  std::unordered_map<std::string, const void*> values;
+  std::unordered_map<std::string, QueryCondition::VarValues> var_values;
+  size_t b = 0;
+  for (const auto& attr : field_names) {
+    if (array_schema_->var_size(attr)) {
+      RETURN_NOT_OK(gather_var_values(*coords, attr, &var_values[attr]));
+      continue;
+    }
+    auto cell_size = array_schema_->cell_size(attr);
+    auto& buff = buffs[b++];
+    buff.resize(cell_num * cell_size);
+    for (uint64_t i = 0; i < cell_num; ++i) {
+      const auto& c = (*coords)[i];
+      const auto& tile = c.tile_->attr_tiles_.find(attr)->second.first;
+      auto data = (const unsigned char*)tile.data();
+      std::memcpy(
+          &buff[i * cell_size], data + c.pos_ * cell_size, cell_size);
+    }
+    values[attr] = buff.data();
+  }
+
+  std::vector<uint8_t> result;
+  RETURN_NOT_OK(condition_.apply(
+      array_schema_, values, var_values, cell_num, &result));
+
+  // Keep only the valid coordinates that satisfy the condition
+  uint64_t num_results = 0, num_filtered = 0;
+  for (uint64_t i = 0; i < cell_num; ++i) {
+    if (!(*coords)[i].valid())
+      continue;
+    if (result[i])
+      (*coords)[num_results++] = (*coords)[i];
+    else
+      ++num_filtered;
+  }
+  coords->erase(coords->begin() + num_results, coords->end());
+  STATS_COUNTER_ADD(reader_num_cells_filtered_by_condition, num_filtered);
+
+  return Status::Ok();
+
+  STATS_FUNC_OUT(reader_apply_condition);
+}
+
 void Reader::clear_read_state() {
   for (auto p : read_state_.subarray_partitions_)
     std::free(p);
@@ -686,6 +987,32 @@ void Reader::clear_tiles(
     tile->attr_tiles_.erase(attr);
 }
 
+Status Reader::compute_tiles_size(
+    const std::string& attribute,
+    const OverlappingTileVec& tiles,
+    uint64_t* size,
+    uint64_t* size_var) const {
+  auto var_size = array_schema_->var_size(attribute);
+  auto encryption_key = array_->encryption_key();
+
+  *size = 0;
+  *size_var = 0;
+  for (const auto& tile : tiles) {
+    if (tile->attr_tiles_.find(attribute) == tile->attr_tiles_.end())
+      continue;
+    auto& fragment = fragment_metadata_[tile->fragment_idx_];
+    *size += fragment->tile_size(attribute, tile->tile_idx_);
+    if (var_size) {
+      uint64_t tile_var_size;
+      RETURN_NOT_OK(fragment->tile_var_size(
+          *encryption_key, attribute, tile->tile_idx_, &tile_var_size));
+      *size_var += tile_var_size;
+    }
+  }
+
+  return Status::Ok();
+}
+
 template <class T>
 Status Reader::compute_cell_ranges(
     const OverlappingCoordsVec<T>& coords,
@@ -1034,7 +1361,10 @@ template <class T>
 Status Reader::compute_overlapping_coords(
     const OverlappingTile* tile, OverlappingCoordsVec<T>* coords) const {
   auto dim_num = array_schema_->dim_num();
-  const auto& t = tile->attr_tiles_.find(constants::coords)->second.first;
+  auto it = tile->attr_tiles_.find(constants::coords);
+  if (it == tile->attr_tiles_.end())  // Pruned tile
+    return Status::Ok();
+  const auto& t = it->second.first;
   auto coords_num = t.cell_num();
   auto subarray = (T*)read_state_.cur_subarray_partition_;
   auto c = (T*)t.data();
@@ -1054,7 +1384,10 @@ Status Reader::compute_overlapping_coords_2(
     OverlappingCoordsVec<T>* coords) const {
   auto dim_num = array_schema_->dim_num();
   assert(dim_num == range.size());
-  const auto& t = tile->attr_tiles_.find(constants::coords)->second.first;
+  auto it = tile->attr_tiles_.find(constants::coords);
+  if (it == tile->attr_tiles_.end())  // Pruned tile
+    return Status::Ok();
+  const auto& t = it->second.first;
   auto coords_num = t.cell_num();
   auto c = (T*)t.data();
 
@@ -1402,6 +1735,7 @@ Status Reader::copy_var_cells(
   auto fill_size = datatype_size(type);
   auto fill_value = constants::fill_value(type);
   assert(fill_value != nullptr);
+  auto dictionary = dictionary_encoded(attribute);
 
   // Compute the destinations of offsets and var-len data in the buffers.
   std::vector<std::vector<uint64_t>> offset_offsets_per_cr;
@@ -1430,18 +1764,11 @@ Status Reader::copy_var_cells(
     const auto& var_offsets = var_offsets_per_cr[cr_idx];
 
     // Get tile information, if the range is nonempty.
-    uint64_t* tile_offsets = nullptr;
-    unsigned char* tile_var_data = nullptr;
-    uint64_t tile_cell_num = 0;
-    uint64_t tile_var_size = 0;
+    DictionaryFilter::VarTileView tile_cells;
     if (cr.tile_ != nullptr) {
       const auto& tile_pair = cr.tile_->attr_tiles_.find(attribute)->second;
-      const auto& tile = tile_pair.first;
-      const auto& tile_var = tile_pair.second;
-      tile_offsets = (uint64_t*)tile.data();
-      tile_var_data = (unsigned char*)tile_var.data();
-      tile_cell_num = tile.cell_num();
-      tile_var_size = tile_var.size();
+      RETURN_NOT_OK(
+          tile_cells.init(&tile_pair.first, &tile_pair.second, dictionary));
     }
 
     // Copy each cell in the range
@@ -1458,14 +1785,9 @@ Status Reader::copy_var_cells(
       if (cr.tile_ == nullptr) {
         std::memcpy(var_dest, &fill_value, fill_size);
       } else {
-        uint64_t cell_var_size =
-            (cell_idx != tile_cell_num - 1) ?
-                tile_offsets[cell_idx + 1] - tile_offsets[cell_idx] :
-                tile_var_size - (tile_offsets[cell_idx] - tile_offsets[0]);
-        std::memcpy(
-            var_dest,
-            &tile_var_data[tile_offsets[cell_idx] - tile_offsets[0]],
-            cell_var_size);
+        uint64_t cell_var_size;
+        auto cell_var_data = tile_cells.cell(cell_idx, &cell_var_size);
+        std::memcpy(var_dest, cell_var_data, cell_var_size);
       }
     }
 
@@ -1499,6 +1821,7 @@ Status Reader::compute_var_cell_destinations(
   auto offset_size = constants::cell_var_offset_size;
   auto type = array_schema_->type(attribute);
   auto fill_size = datatype_size(type);
+  auto dictionary = dictionary_encoded(attribute);
 
   // Resize the output vectors
   offset_offsets_per_cr->resize(num_cr);
@@ -1514,16 +1837,11 @@ Status Reader::compute_var_cell_destinations(
     (*var_offsets_per_cr)[cr_idx].resize(cell_num_in_range);
 
     // Get tile information, if the range is nonempty.
-    uint64_t* tile_offsets = nullptr;
-    uint64_t tile_cell_num = 0;
-    uint64_t tile_var_size = 0;
+    DictionaryFilter::VarTileView tile_cells;
     if (cr.tile_ != nullptr) {
       const auto& tile_pair = cr.tile_->attr_tiles_.find(attribute)->second;
-      const auto& tile = tile_pair.first;
-      const auto& tile_var = tile_pair.second;
-      tile_offsets = (uint64_t*)tile.data();
-      tile_cell_num = tile.cell_num();
-      tile_var_size = tile_var.size();
+      RETURN_NOT_OK(
+          tile_cells.init(&tile_pair.first, &tile_pair.second, dictionary));
     }
 
     // Compute the destinations for each cell in the range.
@@ -1534,10 +1852,7 @@ Status Reader::compute_var_cell_destinations(
       if (cr.tile_ == nullptr) {
         cell_var_size = fill_size;
       } else {
-        cell_var_size =
-            (cell_idx != tile_cell_num - 1) ?
-                tile_offsets[cell_idx + 1] - tile_offsets[cell_idx] :
-                tile_var_size - (tile_offsets[cell_idx] - tile_offsets[0]);
+        tile_cells.cell(cell_idx, &cell_var_size);
       }
 
       // Record destination offsets.
@@ -1681,6 +1996,12 @@ Status Reader::dense_read() {
   // Filter dense tiles
   RETURN_CANCEL_OR_ERROR(filter_all_tiles(&dense_tiles, false));
 
+  // Aggregate cells
+  if (!aggregates_.empty()) {
+    RETURN_CANCEL_OR_ERROR(aggregate_cells(overlapping_cell_ranges));
+    return Status::Ok();
+  }
+
   // Copy cells
   for (const auto& attr : attributes_) {
     if (read_state_.overflowed_)
@@ -1810,6 +2131,12 @@ Status Reader::dense_read_2() {
   STATS_FUNC_OUT(reader_dense_read);
 }
 
+bool Reader::dictionary_encoded(const std::string& attribute) const {
+  return array_schema_->var_size(attribute) &&
+         array_schema_->filters(attribute)->get_filter<DictionaryFilter>() !=
+             nullptr;
+}
+
 template <class T>
 Status Reader::fill_coords() {
   STATS_FUNC_IN(reader_fill_coords);
@@ -1945,54 +2272,100 @@ Status Reader::filter_tiles(
 
   auto var_size = array_schema_->var_size(attribute);
   auto num_tiles = static_cast<uint64_t>(tiles->size());
-  auto encryption_key = array_->encryption_key();
 
   auto statuses = parallel_for(0, num_tiles, [&, this](uint64_t i) {
-    auto& tile = (*tiles)[i];
-    auto it = tile->attr_tiles_.find(attribute);
-    // Skip non-existent attributes (e.g. coords in the dense case).
-    if (it == tile->attr_tiles_.end())
-      return Status::Ok();
+    auto tile = (*tiles)[i].get();
+    RETURN_NOT_OK(filter_tile(attribute, tile, false));
+    if (var_size)
+      RETURN_NOT_OK(filter_tile(attribute, tile, true));
+    return Status::Ok();
+  });
 
-    // Get information about the tile in its fragment
-    auto& fragment = fragment_metadata_[tile->fragment_idx_];
-    auto tile_attr_uri = fragment->attr_uri(attribute);
-    uint64_t tile_attr_offset;
-    RETURN_NOT_OK(fragment->file_offset(
-        *encryption_key, attribute, tile->tile_idx_, &tile_attr_offset));
+  for (const auto& st : statuses)
+    RETURN_CANCEL_OR_ERROR(st);
 
-    auto& tile_pair = it->second;
-    auto& t = tile_pair.first;
-    auto& t_var = tile_pair.second;
+  return Status::Ok();
 
-    if (!t.filtered()) {
-      // Decompress, etc.
-      RETURN_NOT_OK(filter_tile(attribute, &t, var_size));
-      RETURN_NOT_OK(storage_manager_->write_to_cache(
-          tile_attr_uri, tile_attr_offset, t.buffer()));
-    }
+  STATS_FUNC_OUT(reader_filter_tiles);
+}
 
-    if (var_size && !t_var.filtered()) {
-      auto tile_attr_var_uri = fragment->attr_var_uri(attribute);
-      uint64_t tile_attr_var_offset;
-      RETURN_NOT_OK(fragment->file_var_offset(
-          *encryption_key, attribute, tile->tile_idx_, &tile_attr_var_offset));
+Status Reader::filter_tiles(
+    const std::string& attribute,
+    OverlappingTileVec* tiles,
+    std::vector<TileReads>* reads) const {
+  auto reader_thread_pool = storage_manager_->reader_thread_pool();
+
+  // Unfilter the tiles of each file as soon as its reads complete, while
+  // the reads of the following files are still in flight. Upon error, keep
+  // waiting on the remaining reads, as they write into the tile buffers.
+  Status st;
+  for (auto& file_reads : *reads) {
+    auto statuses = reader_thread_pool->wait_all_status(file_reads.tasks_);
+    for (const auto& s : statuses) {
+      if (st.ok() && !s.ok())
+        st = s;
+    }
+    if (!st.ok())
+      continue;
 
-      // Decompress, etc.
-      RETURN_NOT_OK(filter_tile(attribute, &t_var, false));
-      RETURN_NOT_OK(storage_manager_->write_to_cache(
-          tile_attr_var_uri, tile_attr_var_offset, t_var.buffer()));
+    const auto& tile_idxs = file_reads.tile_idxs_;
+    auto var = file_reads.var_;
+    statuses = parallel_for(0, tile_idxs.size(), [&, this](uint64_t i) {
+      return filter_tile(attribute, (*tiles)[tile_idxs[i]].get(), var);
+    });
+    for (const auto& s : statuses) {
+      if (st.ok() && !s.ok())
+        st = s;
     }
+  }
+  reads->clear();
+  RETURN_CANCEL_OR_ERROR(st);
+
+  // Filter the tiles that were not read (e.g., filtered cache hits)
+  return filter_tiles(attribute, tiles);
+}
 
+Status Reader::filter_tile(
+    const std::string& attribute, OverlappingTile* tile, bool var) const {
+  auto it = tile->attr_tiles_.find(attribute);
+  // Skip non-existent attributes (e.g. coords in the dense case).
+  if (it == tile->attr_tiles_.end())
     return Status::Ok();
-  });
 
-  for (const auto& st : statuses)
-    RETURN_CANCEL_OR_ERROR(st);
+  auto& t = var ? it->second.second : it->second.first;
+  if (t.filtered())
+    return Status::Ok();
 
-  return Status::Ok();
+  // Get information about the tile in its fragment
+  auto& fragment = fragment_metadata_[tile->fragment_idx_];
+  auto encryption_key = array_->encryption_key();
+  uint64_t tile_attr_offset;
+  if (var) {
+    RETURN_NOT_OK(fragment->file_var_offset(
+        *encryption_key, attribute, tile->tile_idx_, &tile_attr_offset));
+  } else {
+    RETURN_NOT_OK(fragment->file_offset(
+        *encryption_key, attribute, tile->tile_idx_, &tile_attr_offset));
+  }
 
-  STATS_FUNC_OUT(reader_filter_tiles);
+  auto key = fragment->tile_cache_key(attribute, var, tile_attr_offset);
+  if (tile_cache_populate_)
+    RETURN_NOT_OK(storage_manager_->write_to_filtered_cache(key, t.buffer()));
+
+  // Decompress, etc.
+  auto start = std::chrono::steady_clock::now();
+  auto offsets = !var && array_schema_->var_size(attribute);
+  RETURN_NOT_OK(filter_tile(attribute, &t, offsets));
+  // Dictionary-encoded var tiles are not cached unfiltered, since their
+  // size differs from the recorded var tile size the cache is read with
+  if (tile_cache_populate_ && !(var && dictionary_encoded(attribute))) {
+    uint64_t decode_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+    RETURN_NOT_OK(storage_manager_->write_to_cache(key, t.buffer(), decode_ns));
+  }
+
+  return Status::Ok();
 }
 
 Status Reader::filter_tile(
@@ -2023,11 +2396,64 @@ Status Reader::filter_tile(
   return Status::Ok();
 }
 
+template <class T>
+Status Reader::gather_var_values(
+    const OverlappingCoordsVec<T>& coords,
+    const std::string& attribute,
+    QueryCondition::VarValues* values) const {
+  auto dictionary = dictionary_encoded(attribute);
+  auto cell_num = coords.size();
+  values->codes.resize(cell_num);
+
+  // Maps each tile to a view of its cells and the code of the first value
+  // of its dictionary in `values`
+  std::unordered_map<
+      const OverlappingTile*,
+      std::pair<DictionaryFilter::VarTileView, uint64_t>>
+      tile_cells;
+  for (size_t i = 0; i < cell_num; ++i) {
+    const auto& c = coords[i];
+    auto it = tile_cells.find(c.tile_);
+    if (it == tile_cells.end()) {
+      const auto& tile_pair = c.tile_->attr_tiles_.find(attribute)->second;
+      DictionaryFilter::VarTileView cells;
+      RETURN_NOT_OK(
+          cells.init(&tile_pair.first, &tile_pair.second, dictionary));
+      auto first_code = (uint64_t)values->entries.size();
+      if (cells.dictionary()) {
+        for (uint64_t e = 0; e < cells.entry_num(); ++e) {
+          uint64_t size;
+          auto data = cells.entry(e, &size);
+          values->entries.emplace_back(data, size);
+        }
+      }
+      it = tile_cells.emplace(c.tile_, std::make_pair(cells, first_code)).first;
+    }
+
+    // The cells of the tiles that are not dictionary-encoded are added to
+    // the dictionary one by one
+    const auto& cells = it->second.first;
+    if (cells.dictionary()) {
+      values->codes[i] = it->second.second + cells.code(c.pos_);
+    } else {
+      uint64_t size;
+      auto data = cells.cell(c.pos_, &size);
+      values->codes[i] = values->entries.size();
+      values->entries.emplace_back(data, size);
+    }
+  }
+
+  return Status::Ok();
+}
+
 template <class T>
 Status Reader::get_all_coords(
     const OverlappingTile* tile, OverlappingCoordsVec<T>* coords) const {
   auto dim_num = array_schema_->dim_num();
-  const auto& t = tile->attr_tiles_.find(constants::coords)->second.first;
+  auto it = tile->attr_tiles_.find(constants::coords);
+  if (it == tile->attr_tiles_.end())  // Pruned tile
+    return Status::Ok();
+  const auto& t = it->second.first;
   auto coords_num = t.cell_num();
   auto c = (T*)t.data();
 
@@ -2319,6 +2745,233 @@ Status Reader::read_all_tiles(
   STATS_FUNC_OUT(reader_read_all_tiles);
 }
 
+Status Reader::map_tile(
+    const std::string& attribute,
+    const URI& uri,
+    uint64_t offset,
+    uint64_t persisted_size,
+    bool offsets,
+    Tile* tile,
+    bool* mapped) const {
+  *mapped = false;
+
+  // Only tiles with an empty filter pipeline are persisted as is. Coordinate
+  // tiles are excluded, as they are zipped after reading.
+  if (tile->stores_coords())
+    return Status::Ok();
+  auto filters = offsets ? array_schema_->cell_var_offsets_filters() :
+                           array_schema_->filters(attribute);
+  if (filters->size() != 0 || array_->get_encryption_key().encryption_type() !=
+                                  EncryptionType::NO_ENCRYPTION)
+    return Status::Ok();
+
+  // Get the tile in the mapped file (if the file is mapped)
+  const void* data = nullptr;
+  std::shared_ptr<void> owner;
+  RETURN_NOT_OK(storage_manager_->vfs()->read_mapped(
+      uri, offset, persisted_size, &data, &owner));
+  if (data == nullptr)
+    return Status::Ok();
+
+  // The tile data can be used in place only if it was persisted in a single
+  // chunk without metadata (see FilterPipeline::run_forward), and if it is
+  // aligned for its datatype.
+  const uint64_t header_size = sizeof(uint64_t) + 3 * sizeof(uint32_t);
+  if (persisted_size < header_size)
+    return Status::Ok();
+  auto bytes = static_cast<const char*>(data);
+  uint64_t num_chunks;
+  uint32_t orig_chunk_size, filtered_chunk_size, metadata_size;
+  std::memcpy(&num_chunks, bytes, sizeof(uint64_t));
+  bytes += sizeof(uint64_t);
+  std::memcpy(&orig_chunk_size, bytes, sizeof(uint32_t));
+  bytes += sizeof(uint32_t);
+  std::memcpy(&filtered_chunk_size, bytes, sizeof(uint32_t));
+  bytes += sizeof(uint32_t);
+  std::memcpy(&metadata_size, bytes, sizeof(uint32_t));
+  bytes += sizeof(uint32_t);
+  if (num_chunks != 1 || metadata_size != 0 ||
+      filtered_chunk_size != orig_chunk_size ||
+      header_size + orig_chunk_size != persisted_size ||
+      reinterpret_cast<uintptr_t>(bytes) % datatype_size(tile->type()) != 0)
+    return Status::Ok();
+
+  // Point the tile buffer at the mapped bytes, keeping the mapping alive
+  Buffer buffer(const_cast<char*>(bytes), orig_chunk_size, false);
+  RETURN_NOT_OK(tile->buffer()->swap(buffer));
+  tile->set_data_owner(owner);
+  tile->set_filtered(true);
+  tile->set_pre_filtered_size(persisted_size);
+  *mapped = true;
+
+  STATS_COUNTER_ADD(reader_num_tiles_mapped, 1);
+
+  return Status::Ok();
+}
+
+Status Reader::prefetch_tiles(
+    const std::string& attribute,
+    OverlappingTileVec* tiles,
+    uint64_t* size,
+    uint64_t* size_var,
+    std::vector<TileReads>* reads,
+    bool* prefetched) const {
+  *prefetched = false;
+
+  // The tiles of both attributes must fit in the memory budget
+  uint64_t next_size, next_size_var;
+  RETURN_NOT_OK(
+      compute_tiles_size(attribute, *tiles, &next_size, &next_size_var));
+  if (*size + next_size > memory_budget_ ||
+      *size_var + next_size_var > memory_budget_var_)
+    return Status::Ok();
+
+  RETURN_NOT_OK(read_tiles(attribute, tiles, reads));
+  *size = next_size;
+  *size_var = next_size_var;
+  *prefetched = true;
+  STATS_COUNTER_ADD(reader_num_attr_prefetches, 1);
+
+  return Status::Ok();
+}
+
+void Reader::prune_tiles(
+    const OverlappingCellRangeList& cell_ranges,
+    OverlappingTileVec* tiles) const {
+  std::unordered_set<const OverlappingTile*> result_tiles;
+  for (const auto& cr : cell_ranges)
+    result_tiles.insert(cr.tile_);
+
+  for (auto& tile : *tiles) {
+    if (result_tiles.find(tile.get()) == result_tiles.end()) {
+      tile->attr_tiles_.clear();
+      STATS_COUNTER_ADD(reader_num_tiles_pruned_by_condition, 1);
+    }
+  }
+}
+
+template <class T>
+Status Reader::prune_tiles_by_tile_metadata(OverlappingTileVec* tiles) const {
+  auto encryption_key = array_->encryption_key();
+  auto dim_num = array_schema_->dim_num();
+  auto tile_num = tiles->size();
+
+  // Find the tiles that cannot hold results
+  std::vector<uint8_t> prunable(tile_num, 0);
+  bool any_prunable = false;
+  for (size_t i = 0; i < tile_num; ++i) {
+    const auto& tile = (*tiles)[i];
+    auto& fragment = fragment_metadata_[tile->fragment_idx_];
+    if (fragment->dense())
+      continue;
+
+    std::unordered_map<std::string, std::pair<const void*, const void*>>
+        bounds;
+    for (const auto& attr : condition_.field_names()) {
+      if (!fragment->has_tile_metadata(attr))
+        continue;
+      const void *min, *max, *sum;
+      RETURN_NOT_OK(fragment->tile_metadata(
+          *encryption_key, attr, tile->tile_idx_, &min, &max, &sum));
+      bounds[attr] = std::make_pair(min, max);
+    }
+    if (!bounds.empty() && !condition_.may_satisfy(array_schema_, bounds)) {
+      prunable[i] = 1;
+      any_prunable = true;
+    }
+  }
+  if (!any_prunable)
+    return Status::Ok();
+
+  // Keep the tiles overlapping a kept tile of an older fragment. Visiting
+  // the tiles from the oldest fragment on settles the older tiles first.
+  std::vector<size_t> order(tile_num);
+  for (size_t i = 0; i < tile_num; ++i)
+    order[i] = i;
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return (*tiles)[a]->fragment_idx_ < (*tiles)[b]->fragment_idx_;
+  });
+  auto get_mbr = [&](const OverlappingTile* tile, const T** mbr) {
+    auto mbrs = (const std::vector<void*>*)nullptr;
+    RETURN_NOT_OK(fragment_metadata_[tile->fragment_idx_]->mbrs(
+        *encryption_key, &mbrs));
+    *mbr = (const T*)(*mbrs)[tile->tile_idx_];
+    return Status::Ok();
+  };
+  for (auto i : order) {
+    if (!prunable[i])
+      continue;
+    auto tile = (*tiles)[i].get();
+    const T* mbr;
+    RETURN_NOT_OK(get_mbr(tile, &mbr));
+    for (auto j : order) {
+      auto other = (*tiles)[j].get();
+      if (other->fragment_idx_ >= tile->fragment_idx_)
+        break;
+      if (prunable[j])
+        continue;
+      if (fragment_metadata_[other->fragment_idx_]->dense()) {
+        prunable[i] = 0;
+        break;
+      }
+      const T* other_mbr;
+      RETURN_NOT_OK(get_mbr(other, &other_mbr));
+      if (utils::geometry::overlap(mbr, other_mbr, dim_num)) {
+        prunable[i] = 0;
+        break;
+      }
+    }
+  }
+
+  // Release the tiles, so that none of their attributes is read
+  for (size_t i = 0; i < tile_num; ++i) {
+    if (prunable[i]) {
+      (*tiles)[i]->attr_tiles_.clear();
+      STATS_COUNTER_ADD(reader_num_tiles_pruned_by_tile_metadata, 1);
+    }
+  }
+
+  return Status::Ok();
+}
+
+Status Reader::read_condition_tiles(OverlappingTileVec* tiles) const {
+  // Prepare the tiles of the condition attributes, skipping the pruned tiles
+  std::vector<std::string> attributes = {constants::coords};
+  for (const auto& attr : condition_.field_names()) {
+    attributes.push_back(attr);
+    for (auto& tile : *tiles) {
+      if (tile->attr_tiles_.count(constants::coords) != 0)
+        tile->attr_tiles_.emplace(attr, std::make_pair(Tile(), Tile()));
+    }
+  }
+
+  // Read the tiles asynchronously
+  auto reader_thread_pool = storage_manager_->reader_thread_pool();
+  std::vector<std::future<Status>> tasks;
+  for (const auto& attr : attributes) {
+    RETURN_CANCEL_OR_ERROR_ELSE(
+        read_tiles(attr, tiles, &tasks), reader_thread_pool->wait_all(tasks));
+  }
+
+  // Wait for the reads to finish and check statuses
+  auto statuses = reader_thread_pool->wait_all_status(tasks);
+  for (const auto& st : statuses)
+    RETURN_CANCEL_OR_ERROR(st);
+
+  // Filter the tiles in parallel over the attributes
+  statuses = parallel_for_each(
+      attributes.begin(),
+      attributes.end(),
+      [this, &tiles](const std::string& attr) {
+        RETURN_CANCEL_OR_ERROR(filter_tiles(attr, tiles));
+        return Status::Ok();
+      });
+  for (const auto& st : statuses)
+    RETURN_CANCEL_OR_ERROR(st);
+
+  return Status::Ok();
+}
+
 Status Reader::read_tiles(
     const std::string& attr, OverlappingTileVec* tiles) const {
   // Shortcut for empty tile vec
@@ -2342,6 +2995,20 @@ Status Reader::read_tiles(
     const std::string& attribute,
     OverlappingTileVec* tiles,
     std::vector<std::future<Status>>* tasks) const {
+  std::vector<TileReads> reads;
+  auto st = read_tiles(attribute, tiles, &reads);
+  for (auto& file_reads : reads) {
+    for (auto& task : file_reads.tasks_)
+      tasks->push_back(std::move(task));
+  }
+
+  return st;
+}
+
+Status Reader::read_tiles(
+    const std::string& attribute,
+    OverlappingTileVec* tiles,
+    std::vector<TileReads>* reads) const {
   // For each tile, read from its fragment.
   bool var_size = array_schema_->var_size(attribute);
   auto num_tiles = static_cast<uint64_t>(tiles->size());
@@ -2349,13 +3016,16 @@ Status Reader::read_tiles(
 
   // Populate the list of regions per file to be read.
   std::map<URI, std::vector<std::tuple<uint64_t, void*, uint64_t>>> all_regions;
+  std::map<URI, TileReads> all_reads;
+  uint64_t num_tiles_touched = 0;
   for (uint64_t i = 0; i < num_tiles; i++) {
     auto& tile = (*tiles)[i];
+    // Skip the tiles that do not need the attribute (e.g., tiles pruned by
+    // the query condition) and the tiles already read
     auto it = tile->attr_tiles_.find(attribute);
-    if (it == tile->attr_tiles_.end()) {
-      return LOG_STATUS(
-          Status::ReaderError("Invalid tile map for attribute " + attribute));
-    }
+    if (it == tile->attr_tiles_.end() || it->second.first.filtered())
+      continue;
+    ++num_tiles_touched;
 
     // Initialize the tile(s)
     auto& tile_pair = it->second;
@@ -2382,17 +3052,45 @@ Status Reader::read_tiles(
     // Try the cache first.
     bool cache_hit;
     RETURN_NOT_OK(storage_manager_->read_from_cache(
-        tile_attr_uri, tile_attr_offset, t.buffer(), tile_size, &cache_hit));
+        fragment->tile_cache_key(attribute, false, tile_attr_offset),
+        t.buffer(),
+        tile_size,
+        &cache_hit));
     if (cache_hit) {
       t.set_filtered(true);
       STATS_COUNTER_ADD(reader_attr_tile_cache_hits, 1);
     } else {
-      // Add the region of the fragment to be read.
-      RETURN_NOT_OK(t.buffer()->realloc(tile_persisted_size));
-      t.buffer()->set_size(tile_persisted_size);
-      t.buffer()->reset_offset();
-      all_regions[tile_attr_uri].emplace_back(
-          tile_attr_offset, t.buffer()->data(), tile_persisted_size);
+      RETURN_NOT_OK(storage_manager_->read_from_filtered_cache(
+          fragment->tile_cache_key(attribute, false, tile_attr_offset),
+          t.buffer(),
+          tile_persisted_size,
+          &cache_hit));
+      if (cache_hit)
+        STATS_COUNTER_ADD(reader_attr_tile_filtered_cache_hits, 1);
+    }
+
+    if (!cache_hit) {
+      // Use the tile in place if possible, otherwise add the region of the
+      // fragment to be read.
+      bool mapped;
+      RETURN_NOT_OK(map_tile(
+          attribute,
+          tile_attr_uri,
+          tile_attr_offset,
+          tile_persisted_size,
+          var_size,
+          &t,
+          &mapped));
+      if (!mapped) {
+        RETURN_NOT_OK(t.buffer()->realloc(tile_persisted_size));
+        t.buffer()->set_size(tile_persisted_size);
+        t.buffer()->reset_offset();
+        all_regions[tile_attr_uri].emplace_back(
+            tile_attr_offset, t.buffer()->data(), tile_persisted_size);
+        auto& file_reads = all_reads[tile_attr_uri];
+        file_reads.tile_idxs_.push_back(i);
+        file_reads.var_ = false;
+      }
 
       STATS_COUNTER_ADD(reader_num_tile_bytes_read, tile_persisted_size);
     }
@@ -2412,25 +3110,52 @@ Status Reader::read_tiles(
           tile->tile_idx_,
           &tile_var_persisted_size));
 
-      RETURN_NOT_OK(storage_manager_->read_from_cache(
-          tile_attr_var_uri,
-          tile_attr_var_offset,
-          t_var.buffer(),
-          tile_var_size,
-          &cache_hit));
+      cache_hit = false;
+      if (!dictionary_encoded(attribute)) {
+        RETURN_NOT_OK(storage_manager_->read_from_cache(
+            fragment->tile_cache_key(attribute, true, tile_attr_var_offset),
+            t_var.buffer(),
+            tile_var_size,
+            &cache_hit));
+      }
 
       if (cache_hit) {
         t_var.set_filtered(true);
         STATS_COUNTER_ADD(reader_attr_tile_cache_hits, 1);
       } else {
-        // Add the region of the fragment to be read.
-        RETURN_NOT_OK(t_var.buffer()->realloc(tile_var_persisted_size));
-        t_var.buffer()->set_size(tile_var_persisted_size);
-        t_var.buffer()->reset_offset();
-        all_regions[tile_attr_var_uri].emplace_back(
+        RETURN_NOT_OK(storage_manager_->read_from_filtered_cache(
+            fragment->tile_cache_key(attribute, true, tile_attr_var_offset),
+            t_var.buffer(),
+            tile_var_persisted_size,
+            &cache_hit));
+        if (cache_hit)
+          STATS_COUNTER_ADD(reader_attr_tile_filtered_cache_hits, 1);
+      }
+
+      if (!cache_hit) {
+        // Use the tile in place if possible, otherwise add the region of the
+        // fragment to be read.
+        bool mapped;
+        RETURN_NOT_OK(map_tile(
+            attribute,
+            tile_attr_var_uri,
             tile_attr_var_offset,
-            t_var.buffer()->data(),
-            tile_var_persisted_size);
+            tile_var_persisted_size,
+            false,
+            &t_var,
+            &mapped));
+        if (!mapped) {
+          RETURN_NOT_OK(t_var.buffer()->realloc(tile_var_persisted_size));
+          t_var.buffer()->set_size(tile_var_persisted_size);
+          t_var.buffer()->reset_offset();
+          all_regions[tile_attr_var_uri].emplace_back(
+              tile_attr_var_offset,
+              t_var.buffer()->data(),
+              tile_var_persisted_size);
+          auto& file_reads = all_reads[tile_attr_var_uri];
+          file_reads.tile_idxs_.push_back(i);
+          file_reads.var_ = true;
+        }
 
         STATS_COUNTER_ADD(reader_num_tile_bytes_read, tile_var_persisted_size);
         STATS_COUNTER_ADD(reader_num_var_cell_bytes_read, tile_persisted_size);
@@ -2443,17 +3168,21 @@ Status Reader::read_tiles(
     }
   }
 
-  // Enqueue all regions to be read.
-  for (const auto& item : all_regions) {
-    RETURN_NOT_OK(storage_manager_->vfs()->read_all(
+  // Enqueue all regions to be read, grouping the tasks per file.
+  for (auto& item : all_reads) {
+    auto& file_reads = item.second;
+    auto st = storage_manager_->vfs()->read_all(
         item.first,
-        item.second,
+        all_regions[item.first],
         storage_manager_->reader_thread_pool(),
-        tasks));
+        &file_reads.tasks_);
+    reads->push_back(std::move(file_reads));
+    RETURN_NOT_OK(st);
   }
 
   STATS_COUNTER_ADD(
-      reader_num_attr_tiles_touched, ((var_size ? 2 : 1) * num_tiles));
+      reader_num_attr_tiles_touched,
+      ((var_size ? 2 : 1) * num_tiles_touched));
 
   return Status::Ok();
 }
@@ -2549,11 +3278,17 @@ Status Reader::sparse_read() {
   OverlappingTileVec tiles;
   RETURN_CANCEL_OR_ERROR(compute_overlapping_tiles<T>(&tiles));
 
-  // Read tiles
-  RETURN_CANCEL_OR_ERROR(read_all_tiles(&tiles));
-
-  // Filter tiles
-  RETURN_CANCEL_OR_ERROR(filter_all_tiles(&tiles));
+  // Read and filter tiles. With a query condition, only the coordinate
+  // tiles and the condition attribute tiles are read at this point.
+  if (condition_.empty()) {
+    if (!aggregates_.empty())
+      RETURN_CANCEL_OR_ERROR(aggregate_tiles_from_tile_metadata<T>(&tiles));
+    RETURN_CANCEL_OR_ERROR(read_all_tiles(&tiles));
+    RETURN_CANCEL_OR_ERROR(filter_all_tiles(&tiles));
+  } else {
+    RETURN_CANCEL_OR_ERROR(prune_tiles_by_tile_metadata<T>(&tiles));
+    RETURN_CANCEL_OR_ERROR(read_condition_tiles(&tiles));
+  }
 
   // Compute the read coordinates for all fragments
   OverlappingCoordsVec<T> coords;
@@ -2564,19 +3299,35 @@ Status Reader::sparse_read() {
   RETURN_CANCEL_OR_ERROR(compute_tile_coords<T>(&tile_coords, &coords));
 
   // Sort and dedup the coordinates (not applicable to the global order
-  // layout for a single fragment)
-  if (!(fragment_metadata_.size() == 1 && layout_ == Layout::GLOBAL_ORDER)) {
+  // layout or to aggregates for a single fragment)
+  if (!(fragment_metadata_.size() == 1 &&
+        (layout_ == Layout::GLOBAL_ORDER || !aggregates_.empty()))) {
     RETURN_CANCEL_OR_ERROR(sort_coords<T>(&coords));
     RETURN_CANCEL_OR_ERROR(dedup_coords<T>(&coords));
   }
   tile_coords.reset(nullptr);
 
+  // Apply the query condition
+  if (!condition_.empty())
+    RETURN_CANCEL_OR_ERROR(apply_condition<T>(&coords));
+
   // Compute the maximal cell ranges
   OverlappingCellRangeList cell_ranges;
   RETURN_CANCEL_OR_ERROR(compute_cell_ranges(coords, &cell_ranges));
   coords.clear();
 
-  // Copy cells
+  // Read and filter the remaining tiles that hold results
+  if (!condition_.empty()) {
+    prune_tiles(cell_ranges, &tiles);
+    RETURN_CANCEL_OR_ERROR(read_all_tiles(&tiles));
+    RETURN_CANCEL_OR_ERROR(filter_all_tiles(&tiles));
+  }
+
+  // Aggregate or copy cells
+  if (!aggregates_.empty()) {
+    RETURN_CANCEL_OR_ERROR(aggregate_cells(cell_ranges));
+    return Status::Ok();
+  }
   for (const auto& attr : attributes_) {
     if (read_state_.overflowed_)
       break;
@@ -2599,49 +3350,147 @@ Status Reader::sparse_read_2() {
   RETURN_CANCEL_OR_ERROR(
       compute_overlapping_tiles_2<T>(&tiles, &tile_map, &single_fragment));
 
-  // Read and filter coordinate tiles
-  RETURN_CANCEL_OR_ERROR(read_tiles(constants::coords, &tiles));
-  RETURN_CANCEL_OR_ERROR(filter_tiles(constants::coords, &tiles));
+  // Attributes to read besides the coordinates
+  std::vector<std::string> attrs;
+  for (const auto& attr : attributes_) {
+    if (attr != constants::coords)
+      attrs.push_back(attr);
+  }
+
+  // Read the coordinate tiles, prefetching the tiles of the first attribute
+  // if they fit in the memory budget along with the coordinate tiles. With a
+  // query condition, the tiles of the condition attributes are read instead,
+  // and the other attributes are read only for the tiles that hold results.
+  std::vector<TileReads> reads, next_reads;
+  uint64_t size, size_var;
+  RETURN_CANCEL_OR_ERROR(
+      compute_tiles_size(constants::coords, tiles, &size, &size_var));
+  bool prefetched = false;
+  if (condition_.empty()) {
+    RETURN_CANCEL_OR_ERROR_ELSE(
+        read_tiles(constants::coords, &tiles, &reads),
+        wait_tile_reads(&reads));
+    if (!attrs.empty()) {
+      RETURN_CANCEL_OR_ERROR_ELSE(
+          prefetch_tiles(
+              attrs[0], &tiles, &size, &size_var, &next_reads, &prefetched),
+          wait_tile_reads(&reads); wait_tile_reads(&next_reads));
+    }
+
+    // Filter the coordinate tiles as they arrive
+    RETURN_CANCEL_OR_ERROR_ELSE(
+        filter_tiles(constants::coords, &tiles, &reads),
+        wait_tile_reads(&next_reads));
+  } else {
+    RETURN_CANCEL_OR_ERROR(prune_tiles_by_tile_metadata<T>(&tiles));
+    RETURN_CANCEL_OR_ERROR(read_condition_tiles(&tiles));
+  }
 
   // Compute the read coordinates for all fragments for each subarray range
   std::vector<OverlappingCoordsVec<T>> range_coords;
-  RETURN_CANCEL_OR_ERROR(
-      compute_range_coords<T>(single_fragment, tiles, tile_map, &range_coords));
+  RETURN_CANCEL_OR_ERROR_ELSE(
+      compute_range_coords<T>(single_fragment, tiles, tile_map, &range_coords),
+      wait_tile_reads(&next_reads));
   tile_map.clear();
 
   // Compute final coords (sorted in the result layout) of the whole subarray.
   OverlappingCoordsVec<T> coords;
-  RETURN_CANCEL_OR_ERROR(compute_subarray_coords<T>(&range_coords, &coords));
+  RETURN_CANCEL_OR_ERROR_ELSE(
+      compute_subarray_coords<T>(&range_coords, &coords),
+      wait_tile_reads(&next_reads));
   range_coords.clear();
 
+  // Apply the query condition
+  if (!condition_.empty())
+    RETURN_CANCEL_OR_ERROR(apply_condition<T>(&coords));
+
   // Compute the maximal cell ranges
   OverlappingCellRangeList cell_ranges;
-  RETURN_CANCEL_OR_ERROR(compute_cell_ranges(coords, &cell_ranges));
+  RETURN_CANCEL_OR_ERROR_ELSE(
+      compute_cell_ranges(coords, &cell_ranges), wait_tile_reads(&next_reads));
   coords.clear();
 
+  // Release the tiles without results, along with the condition attribute
+  // tiles that are not copied to the result buffers
+  if (!condition_.empty()) {
+    prune_tiles(cell_ranges, &tiles);
+    for (const auto& attr : condition_.field_names()) {
+      if (std::find(attrs.begin(), attrs.end(), attr) == attrs.end())
+        clear_tiles(attr, &tiles);
+    }
+  }
+
   // Copy coordinates first and clean up coordinate tiles
   if (std::find(attributes_.begin(), attributes_.end(), constants::coords) !=
-      attributes_.end())
-    RETURN_CANCEL_OR_ERROR(copy_cells(constants::coords, cell_ranges));
+      attributes_.end()) {
+    RETURN_CANCEL_OR_ERROR_ELSE(
+        copy_cells(constants::coords, cell_ranges),
+        wait_tile_reads(&next_reads));
+  }
   clear_tiles(constants::coords, &tiles);
 
-  // Copy cells
-  for (const auto& attr : attributes_) {
+  // Copy cells. The tiles of the next attribute are fetched while the
+  // current attribute is being unfiltered and copied, memory budget
+  // permitting.
+  for (size_t i = 0; i < attrs.size(); ++i) {
+    const auto& attr = attrs[i];
     if (read_state_2_.overflowed_)
       break;
-    if (attr == constants::coords)
-      continue;
-    RETURN_CANCEL_OR_ERROR(read_tiles(attr, &tiles));
-    RETURN_CANCEL_OR_ERROR(filter_tiles(attr, &tiles));
-    RETURN_CANCEL_OR_ERROR(copy_cells(attr, cell_ranges));
+
+    // Read the tiles of the attribute, unless they were prefetched
+    if (prefetched) {
+      reads = std::move(next_reads);
+      next_reads.clear();
+    } else {
+      RETURN_CANCEL_OR_ERROR(compute_tiles_size(attr, tiles, &size, &size_var));
+      RETURN_CANCEL_OR_ERROR_ELSE(
+          read_tiles(attr, &tiles, &reads), wait_tile_reads(&reads));
+    }
+
+    // Prefetch the tiles of the next attribute
+    prefetched = false;
+    if (i + 1 < attrs.size()) {
+      RETURN_CANCEL_OR_ERROR_ELSE(
+          prefetch_tiles(
+              attrs[i + 1],
+              &tiles,
+              &size,
+              &size_var,
+              &next_reads,
+              &prefetched),
+          wait_tile_reads(&reads); wait_tile_reads(&next_reads));
+    }
+
+    RETURN_CANCEL_OR_ERROR_ELSE(
+        filter_tiles(attr, &tiles, &reads), wait_tile_reads(&next_reads));
+    RETURN_CANCEL_OR_ERROR_ELSE(
+        copy_cells(attr, cell_ranges), wait_tile_reads(&next_reads));
     clear_tiles(attr, &tiles);
   }
 
+  // The buffers overflowed with the prefetched tiles still in flight
+  RETURN_NOT_OK(wait_tile_reads(&next_reads));
+
   return Status::Ok();
 
   STATS_FUNC_OUT(reader_sparse_read);
 }
 
+Status Reader::wait_tile_reads(std::vector<TileReads>* reads) const {
+  Status st;
+  for (auto& file_reads : *reads) {
+    auto statuses = storage_manager_->reader_thread_pool()->wait_all_status(
+        file_reads.tasks_);
+    for (const auto& s : statuses) {
+      if (st.ok() && !s.ok())
+        st = s;
+    }
+  }
+  reads->clear();
+
+  return st;
+}
+
 void Reader::zero_out_buffer_sizes() {
   for (auto& attr_buffer : attr_buffers_) {
     if (attr_buffer.second.buffer_size_ != nullptr)
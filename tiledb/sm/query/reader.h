@@ -38,6 +38,8 @@
 #include "tiledb/sm/fragment/fragment_metadata.h"
 #include "tiledb/sm/misc/status.h"
 #include "tiledb/sm/query/dense_cell_range_iter.h"
+#include "tiledb/sm/query/aggregate.h"
+#include "tiledb/sm/query/query_condition.h"
 #include "tiledb/sm/query/types.h"
 #include "tiledb/sm/subarray/subarray_partitioner.h"
 #include "tiledb/sm/tile/tile.h"
@@ -180,6 +182,21 @@ class Reader {
   /** A map (fragment_idx, tile_idx) -> pos in OverlappingTileVec. */
   typedef std::map<std::pair<unsigned, uint64_t>, size_t> OverlappingTileMap;
 
+  /**
+   * The in-flight reads of the tiles of an attribute from a single file.
+   * Keeping the reads grouped per file allows the tiles of a file to be
+   * unfiltered as soon as their bytes arrive, while the rest are still
+   * being read.
+   */
+  struct TileReads {
+    /** The read tasks of the file. */
+    std::vector<std::future<Status>> tasks_;
+    /** The positions in the `OverlappingTileVec` of the tiles read. */
+    std::vector<uint64_t> tile_idxs_;
+    /** `true` if the file holds the var-sized values of the attribute. */
+    bool var_;
+  };
+
   /** A cell range belonging to a particular overlapping tile. */
   struct OverlappingCellRange {
     /**
@@ -326,6 +343,17 @@ class Reader {
   /*                 API               */
   /* ********************************* */
 
+  /**
+   * Adds an aggregate to be computed over the cells of the subarray. A
+   * read with aggregates sets no buffers; it reduces the cells as it
+   * scans the tiles, and completes in a single submission.
+   *
+   * @param attribute The aggregated attribute.
+   * @param op The aggregate operator.
+   * @return Status
+   */
+  Status add_aggregate(const std::string& attribute, AggregateOp op);
+
   /** Returns the array schema. */
   const ArraySchema* array_schema() const;
 
@@ -349,6 +377,18 @@ class Reader {
    */
   bool incomplete() const;
 
+  /**
+   * Retrieves the result of an aggregate added with `add_aggregate`, after
+   * the query has completed.
+   *
+   * @param attribute The aggregated attribute.
+   * @param op The aggregate operator.
+   * @param result The result (see `Aggregate` for its type).
+   * @return Status
+   */
+  Status get_aggregate(
+      const std::string& attribute, AggregateOp op, void* result) const;
+
   /**
    * Retrieves the buffer of a fixed-sized attribute.
    *
@@ -460,6 +500,16 @@ class Reader {
       void* buffer_val,
       uint64_t* buffer_val_size);
 
+  /**
+   * Sets a condition on the attribute values of the cells to be read. The
+   * condition is applicable only to sparse reads (i.e., sparse arrays, or
+   * dense arrays read in sparse mode).
+   *
+   * @param condition The condition to be set.
+   * @return Status
+   */
+  Status set_condition(const QueryCondition& condition);
+
   /** Sets the fragment metadata. */
   void set_fragment_metadata(
       const std::vector<FragmentMetadata*>& fragment_metadata);
@@ -493,6 +543,17 @@ class Reader {
   /** Sets the storage manager. */
   void set_storage_manager(StorageManager* storage_manager);
 
+  /**
+   * Sets whether the tiles fetched by this reader are inserted into the
+   * tile cache. Tiles already in the cache are served from it regardless.
+   * Disabling this is useful for reads that touch many tiles only once,
+   * such as bulk scans and consolidation, so that they do not evict the
+   * cached working set.
+   *
+   * @param populate If `false`, fetched tiles are not cached.
+   */
+  void set_tile_cache_populate(bool populate);
+
   /**
    * Sets the query subarray. If it is null, then the subarray will be set to
    * the entire domain.
@@ -527,6 +588,15 @@ class Reader {
   /** The names of the attributes involved in the query. */
   std::vector<std::string> attributes_;
 
+  /** The aggregates computed in place of copying the cells to buffers. */
+  std::vector<Aggregate> aggregates_;
+
+  /**
+   * The condition the read cells must satisfy. Only the cells for which it
+   * evaluates to `true` are returned.
+   */
+  QueryCondition condition_;
+
   /** Maps attribute names to their buffers. */
   std::unordered_map<std::string, AttributeBuffer> attr_buffers_;
 
@@ -556,6 +626,9 @@ class Reader {
   /** The storage manager. */
   StorageManager* storage_manager_;
 
+  /** If `false`, the fetched tiles are not inserted into the tile cache. */
+  bool tile_cache_populate_;
+
   /**
    * The memory budget for the fixed-sized attributes and the offsets
    * of the var-sized attributes.
@@ -569,6 +642,51 @@ class Reader {
   /*           PRIVATE METHODS         */
   /* ********************************* */
 
+  /**
+   * Updates the aggregates with the cells of the input cell ranges, whose
+   * tiles must hold the unfiltered tiles of the aggregated attributes. The
+   * cell ranges are reduced in parallel into partial aggregates, which are
+   * then merged in a fixed order. Empty cell ranges are skipped.
+   *
+   * @param cell_ranges The cell ranges of the results.
+   * @return Status
+   */
+  Status aggregate_cells(const OverlappingCellRangeList& cell_ranges);
+
+  /**
+   * Performs a read with aggregates. It processes all the subarray
+   * partitions, which are sized by the memory budget rather than by the
+   * (unset) buffers, so that the query completes in a single submission.
+   */
+  Status aggregate_read();
+
+  /**
+   * Updates the aggregates with the tiles whose cells are all results,
+   * using the minimum, maximum and sum of each tile stored in the fragment
+   * metadata, and releases them so that they are not read. This applies to
+   * the tiles of sparse fragments that are fully contained in the current
+   * subarray partition and overlap no tile of another fragment, so that
+   * none of their cells is overwritten or overwrites another cell.
+   *
+   * @tparam T The coordinates type.
+   * @param tiles The overlapping tiles.
+   * @return Status
+   */
+  template <class T>
+  Status aggregate_tiles_from_tile_metadata(OverlappingTileVec* tiles);
+
+  /**
+   * Evaluates the query condition on the input coordinates, whose tiles
+   * must hold the unfiltered condition attribute tiles, and removes the
+   * coordinates that do not satisfy it.
+   *
+   * @tparam T The coords type.
+   * @param coords The coordinates to evaluate the condition on.
+   * @return Status
+   */
+  template <class T>
+  Status apply_condition(OverlappingCoordsVec<T>* coords) const;
+
   /** Clears the read state. */
   void clear_read_state();
 
@@ -582,6 +700,22 @@ class Reader {
    */
   void clear_tiles(const std::string& attr, OverlappingTileVec* tiles) const;
 
+  /**
+   * Computes the (unfiltered) size of the tiles of an attribute in `tiles`,
+   * i.e., the memory the tiles will occupy once read and unfiltered.
+   *
+   * @param attribute The attribute name.
+   * @param tiles The overlapping tiles.
+   * @param size The size of the fixed-sized (or offsets) tiles.
+   * @param size_var The size of the var-sized tiles.
+   * @return Status
+   */
+  Status compute_tiles_size(
+      const std::string& attribute,
+      const OverlappingTileVec& tiles,
+      uint64_t* size,
+      uint64_t* size_var) const;
+
   /**
    * Compute the maximal cell ranges of contiguous cell positions.
    *
@@ -880,6 +1014,13 @@ class Reader {
   template <class T>
   Status dense_read_2();
 
+  /**
+   * Returns `true` if the var tiles of the input attribute are
+   * dictionary-encoded (see `DictionaryFilter`), in which case their cells
+   * must be accessed through a `DictionaryFilter::VarTileView`.
+   */
+  bool dictionary_encoded(const std::string& attribute) const;
+
   /**
    * Fills the coordinate buffer with coordinates. Applicable only to dense
    * arrays when the user explicitly requests the coordinates to be
@@ -948,6 +1089,25 @@ class Reader {
   Status filter_tiles(
       const std::string& attribute, OverlappingTileVec* tiles) const;
 
+  /**
+   * Filters the tiles on a particular attribute whose reads are in flight,
+   * waiting on the reads of one file at a time and unfiltering its tiles
+   * while the reads of the following files are still in progress. Any
+   * remaining tiles not covered by `reads` (e.g., filtered cache hits) are
+   * filtered at the end.
+   *
+   * All reads are waited on before returning, even upon error.
+   *
+   * @param attribute Attribute whose tiles will be filtered
+   * @param tiles Vector containing the tiles to be filtered
+   * @param reads The in-flight reads of the tiles, as issued by `read_tiles`.
+   * @return Status
+   */
+  Status filter_tiles(
+      const std::string& attribute,
+      OverlappingTileVec* tiles,
+      std::vector<TileReads>* reads) const;
+
   /**
    * Runs the input tile for the input attribute through the filter pipeline.
    * The tile buffer is modified to contain the output of the pipeline.
@@ -961,6 +1121,37 @@ class Reader {
   Status filter_tile(
       const std::string& attribute, Tile* tile, bool offsets) const;
 
+  /**
+   * Filters the fixed-sized (or offsets) tile or the var-sized tile of
+   * `attribute` in the input overlapping tile, unless it is already filtered,
+   * populating the tile cache along the way.
+   *
+   * @param attribute The attribute the tile belongs to.
+   * @param tile The overlapping tile.
+   * @param var If `true`, the var-sized tile is filtered.
+   * @return Status
+   */
+  Status filter_tile(
+      const std::string& attribute, OverlappingTile* tile, bool var) const;
+
+  /**
+   * Gathers the values of a var-sized attribute of the input coordinates,
+   * for evaluating the query condition. The dictionary of each
+   * dictionary-encoded tile is gathered once, along with the codes of the
+   * cells, so that the condition is evaluated on the codes.
+   *
+   * @tparam T The coords type.
+   * @param coords The coordinates.
+   * @param attribute The var-sized attribute.
+   * @param values The gathered values.
+   * @return Status
+   */
+  template <class T>
+  Status gather_var_values(
+      const OverlappingCoordsVec<T>& coords,
+      const std::string& attribute,
+      QueryCondition::VarValues* values) const;
+
   /**
    * Gets all the coordinates of the input tile into `coords`.
    *
@@ -1080,6 +1271,90 @@ class Reader {
   Status read_all_tiles(
       OverlappingTileVec* tiles, bool ensure_coords = true) const;
 
+  /**
+   * Points the input tile directly at its persisted bytes in a memory-mapped
+   * fragment file (see `vfs.file.enable_mmap`), if the file is mapped and
+   * the tile bytes can be used as is, i.e., the tile is not filtered (empty
+   * filter pipeline, no encryption) and is suitably aligned. In that case,
+   * the tile is marked as filtered and no read or copy is needed.
+   *
+   * @param attribute The attribute the tile belongs to.
+   * @param uri The URI of the fragment file of the tile.
+   * @param offset The offset of the tile in the file.
+   * @param persisted_size The persisted size of the tile.
+   * @param offsets True if the tile contains offsets for a var-sized
+   *    attribute.
+   * @param tile The tile to map.
+   * @param mapped Set to `true` if the tile was mapped.
+   * @return Status
+   */
+  Status map_tile(
+      const std::string& attribute,
+      const URI& uri,
+      uint64_t offset,
+      uint64_t persisted_size,
+      bool offsets,
+      Tile* tile,
+      bool* mapped) const;
+
+  /**
+   * Issues the reads of the tiles of `attribute` ahead of their use, if
+   * the tiles fit in the memory budget along with the tiles currently in
+   * use.
+   *
+   * @param attribute The attribute whose tiles are to be prefetched.
+   * @param tiles The overlapping tiles.
+   * @param size The size of the fixed-sized tiles currently in use. It is
+   *     updated to the size of the prefetched tiles upon prefetching.
+   * @param size_var The size of the var-sized tiles currently in use. It is
+   *     updated to the size of the prefetched tiles upon prefetching.
+   * @param reads The in-flight reads of the prefetched tiles.
+   * @param prefetched Set to `true` if the tiles were prefetched.
+   * @return Status
+   */
+  Status prefetch_tiles(
+      const std::string& attribute,
+      OverlappingTileVec* tiles,
+      uint64_t* size,
+      uint64_t* size_var,
+      std::vector<TileReads>* reads,
+      bool* prefetched) const;
+
+  /**
+   * Releases the tiles that hold no cell of the input cell ranges, so that
+   * the tiles of the attributes that have not been read yet are never
+   * fetched for them.
+   *
+   * @param cell_ranges The cell ranges of the results.
+   * @param tiles The overlapping tiles.
+   */
+  void prune_tiles(
+      const OverlappingCellRangeList& cell_ranges,
+      OverlappingTileVec* tiles) const;
+
+  /**
+   * Releases the tiles whose minimum and maximum attribute values (see
+   * `FragmentMetadata::tile_metadata`) show that none of their cells
+   * satisfies the query condition, before any of them is read. A tile is
+   * kept if it overlaps a tile of an older fragment that is not released,
+   * since its coordinates may overwrite cells of the older tile.
+   *
+   * @tparam T The coordinates type.
+   * @param tiles The overlapping tiles.
+   * @return Status
+   */
+  template <class T>
+  Status prune_tiles_by_tile_metadata(OverlappingTileVec* tiles) const;
+
+  /**
+   * Reads and unfilters the coordinate tiles along with the tiles of the
+   * attributes the query condition refers to.
+   *
+   * @param tiles The overlapping tiles.
+   * @return Status
+   */
+  Status read_condition_tiles(OverlappingTileVec* tiles) const;
+
   /**
    * Retrieves the tiles on a particular attribute from all input fragments
    * based on the tile info in `tiles`.
@@ -1107,6 +1382,23 @@ class Reader {
       OverlappingTileVec* tiles,
       std::vector<std::future<Status>>* tasks) const;
 
+  /**
+   * Retrieves the tiles on a particular attribute from all input fragments
+   * based on the tile info in `tiles`.
+   *
+   * The reads are done asynchronously, and the futures of the read operations
+   * are added to the output parameter grouped by the file they read from.
+   *
+   * @param attribute The attribute name.
+   * @param tiles The retrieved tiles will be stored in `tiles`.
+   * @param reads Vector to hold the read tasks per file.
+   * @return Status
+   */
+  Status read_tiles(
+      const std::string& attribute,
+      OverlappingTileVec* tiles,
+      std::vector<TileReads>* reads) const;
+
   /**
    * Resets the buffer sizes to the original buffer sizes. This is because
    * the read query may alter the buffer sizes to reflect the size of
@@ -1155,6 +1447,14 @@ class Reader {
   template <class T>
   Status sparse_read_2();
 
+  /**
+   * Waits on the input in-flight tile reads without unfiltering the tiles.
+   *
+   * @param reads The in-flight reads. It is cleared upon return.
+   * @return Status The first error of the reads, if any.
+   */
+  Status wait_tile_reads(std::vector<TileReads>* reads) const;
+
   /** Zeroes out the user buffer sizes, indicating an empty result. */
   void zero_out_buffer_sizes();
 };
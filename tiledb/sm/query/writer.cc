@@ -42,7 +42,9 @@
 #include "tiledb/sm/tile/tile_io.h"
 
 #include <iostream>
+#include <limits>
 #include <sstream>
+#include <type_traits>
 
 namespace tiledb {
 namespace sm {
@@ -807,7 +809,9 @@ Status Writer::compute_coord_dups(std::set<uint64_t>* coord_dups) const {
 
 template <class T>
 Status Writer::compute_coords_metadata(
-    const std::vector<Tile>& tiles, FragmentMetadata* meta) const {
+    const std::vector<Tile>& tiles,
+    FragmentMetadata* meta,
+    uint64_t first_tile_id) const {
   STATS_FUNC_IN(writer_compute_coords_metadata);
 
   // Check if tiles are empty
@@ -836,7 +840,7 @@ Status Writer::compute_coords_metadata(
     for (uint64_t i = 1; i < cell_num; ++i)
       utils::geometry::expand_mbr(&mbr[0], &data[i * dim_num], dim_num);
 
-    meta->set_mbr(tile_id, &mbr[0]);
+    meta->set_mbr(first_tile_id + tile_id, &mbr[0]);
   }
 
   // Set last tile cell number
@@ -847,6 +851,97 @@ Status Writer::compute_coords_metadata(
   STATS_FUNC_OUT(writer_compute_coords_metadata);
 }
 
+Status Writer::compute_tile_metadata(
+    const std::string& attribute,
+    const std::vector<Tile>& tiles,
+    FragmentMetadata* meta,
+    uint64_t first_tile_id) const {
+  if (!meta->has_tile_metadata(attribute))
+    return Status::Ok();
+
+  switch (array_schema_->type(attribute)) {
+    case Datatype::INT8:
+      return compute_tile_metadata<int8_t, int64_t>(
+          attribute, tiles, meta, first_tile_id);
+    case Datatype::UINT8:
+      return compute_tile_metadata<uint8_t, uint64_t>(
+          attribute, tiles, meta, first_tile_id);
+    case Datatype::INT16:
+      return compute_tile_metadata<int16_t, int64_t>(
+          attribute, tiles, meta, first_tile_id);
+    case Datatype::UINT16:
+      return compute_tile_metadata<uint16_t, uint64_t>(
+          attribute, tiles, meta, first_tile_id);
+    case Datatype::INT32:
+      return compute_tile_metadata<int32_t, int64_t>(
+          attribute, tiles, meta, first_tile_id);
+    case Datatype::UINT32:
+      return compute_tile_metadata<uint32_t, uint64_t>(
+          attribute, tiles, meta, first_tile_id);
+    case Datatype::INT64:
+      return compute_tile_metadata<int64_t, int64_t>(
+          attribute, tiles, meta, first_tile_id);
+    case Datatype::UINT64:
+      return compute_tile_metadata<uint64_t, uint64_t>(
+          attribute, tiles, meta, first_tile_id);
+    case Datatype::FLOAT32:
+      return compute_tile_metadata<float, double>(
+          attribute, tiles, meta, first_tile_id);
+    case Datatype::FLOAT64:
+      return compute_tile_metadata<double, double>(
+          attribute, tiles, meta, first_tile_id);
+    default:
+      return LOG_STATUS(Status::WriterError(
+          "Cannot compute tile metadata; Unsupported attribute type"));
+  }
+}
+
+template <class T, class SumT>
+Status Writer::compute_tile_metadata(
+    const std::string& attribute,
+    const std::vector<Tile>& tiles,
+    FragmentMetadata* meta,
+    uint64_t first_tile_id) const {
+  STATS_FUNC_IN(writer_compute_tile_metadata);
+
+  for (uint64_t tile_id = 0; tile_id < tiles.size(); ++tile_id) {
+    const auto& tile = tiles[tile_id];
+    auto data = (const T*)tile.data();
+    auto cell_num = tile.size() / sizeof(T);
+    if (cell_num == 0)
+      continue;
+
+    // The integer sums wrap around on overflow
+    T min = data[0], max = data[0];
+    SumT sum = 0;
+    bool has_nan = false;
+    for (uint64_t i = 0; i < cell_num; ++i) {
+      auto v = data[i];
+      min = v < min ? v : min;
+      max = v > max ? v : max;
+      if (std::is_floating_point<T>::value) {
+        has_nan |= (v != v);
+        sum += v;
+      } else {
+        sum = (SumT)((uint64_t)sum + (uint64_t)v);
+      }
+    }
+
+    // NaN values are not ordered; mark the bounds of such tiles as unknown
+    if (has_nan) {
+      min = std::numeric_limits<T>::quiet_NaN();
+      max = std::numeric_limits<T>::quiet_NaN();
+    }
+
+    meta->set_tile_metadata(
+        attribute, first_tile_id + tile_id, &min, &max, &sum);
+  }
+
+  return Status::Ok();
+
+  STATS_FUNC_OUT(writer_compute_tile_metadata);
+}
+
 template <class T>
 Status Writer::compute_write_cell_ranges(
     DenseCellRangeIter<T>* iter, WriteCellRangeVec* write_cell_ranges) const {
@@ -935,9 +1030,14 @@ Status Writer::filter_tiles(
   // Filter all tiles
   auto tile_num = tiles->size();
   for (size_t i = 0; i < tile_num; ++i) {
-    RETURN_NOT_OK(filter_tile(attribute, &(*tiles)[i], var_size));
     if (var_size) {
-      ++i;
+      // The values are filtered first, as some filters (e.g., dictionary
+      // encoding) need the unfiltered offsets
+      auto& offsets_tile = (*tiles)[i];
+      auto& var_tile = (*tiles)[++i];
+      RETURN_NOT_OK(filter_tile(attribute, &var_tile, false, &offsets_tile));
+      RETURN_NOT_OK(filter_tile(attribute, &offsets_tile, true));
+    } else {
       RETURN_NOT_OK(filter_tile(attribute, &(*tiles)[i], false));
     }
   }
@@ -948,7 +1048,10 @@ Status Writer::filter_tiles(
 }
 
 Status Writer::filter_tile(
-    const std::string& attribute, Tile* tile, bool offsets) const {
+    const std::string& attribute,
+    Tile* tile,
+    bool offsets,
+    const Tile* offsets_tile) const {
   auto orig_size = tile->buffer()->size();
 
   // Get a copy of the appropriate filter pipeline.
@@ -965,7 +1068,7 @@ Status Writer::filter_tile(
   RETURN_NOT_OK(FilterPipeline::append_encryption_filter(
       &filters, array_->get_encryption_key()));
 
-  RETURN_NOT_OK(filters.run_forward(tile));
+  RETURN_NOT_OK(filters.run_forward(tile, offsets_tile));
 
   tile->set_filtered(true);
   tile->set_pre_filtered_size(orig_size);
@@ -1162,6 +1265,7 @@ Status Writer::global_write() {
     auto& full_tiles = attribute_tiles[i];
     if (attr == constants::coords)
       RETURN_CANCEL_OR_ERROR(compute_coords_metadata<T>(full_tiles, frag_meta));
+    RETURN_CANCEL_OR_ERROR(compute_tile_metadata(attr, full_tiles, frag_meta));
     RETURN_CANCEL_OR_ERROR(filter_tiles(attr, &full_tiles));
     return Status::Ok();
   });
@@ -1227,6 +1331,7 @@ Status Writer::global_write_handle_last_tile() {
         tiles.push_back(last_tile_var.clone(false));
       if (attr == constants::coords)
         RETURN_NOT_OK(compute_coords_metadata<T>(tiles, meta));
+      RETURN_NOT_OK(compute_tile_metadata(attr, tiles, meta));
       RETURN_NOT_OK(filter_tiles(attr, &tiles));
     }
     return Status::Ok();
@@ -1509,6 +1614,7 @@ Status Writer::ordered_write() {
     const auto& attr = attributes_[i];
     std::vector<Tile>& tiles = attr_tiles[i];
     RETURN_CANCEL_OR_ERROR(prepare_tiles(attr, write_cell_ranges, &tiles));
+    RETURN_CANCEL_OR_ERROR(compute_tile_metadata(attr, tiles, frag_meta.get()));
     RETURN_CANCEL_OR_ERROR(filter_tiles(attr, &tiles));
     return Status::Ok();
   });
@@ -1888,22 +1994,26 @@ Status Writer::prepare_tiles(
 Status Writer::prepare_tiles(
     const std::string& attribute,
     const std::vector<uint64_t>& cell_pos,
-    const std::set<uint64_t>& coord_dups,
+    uint64_t start_tile_id,
+    uint64_t end_tile_id,
     std::vector<Tile>* tiles) const {
   return array_schema_->var_size(attribute) ?
-             prepare_tiles_var(attribute, cell_pos, coord_dups, tiles) :
-             prepare_tiles_fixed(attribute, cell_pos, coord_dups, tiles);
+             prepare_tiles_var(
+                 attribute, cell_pos, start_tile_id, end_tile_id, tiles) :
+             prepare_tiles_fixed(
+                 attribute, cell_pos, start_tile_id, end_tile_id, tiles);
 }
 
 Status Writer::prepare_tiles_fixed(
     const std::string& attribute,
     const std::vector<uint64_t>& cell_pos,
-    const std::set<uint64_t>& coord_dups,
+    uint64_t start_tile_id,
+    uint64_t end_tile_id,
     std::vector<Tile>* tiles) const {
   STATS_FUNC_IN(writer_prepare_tiles_fixed);
 
   // Trivial case
-  if (cell_pos.empty())
+  if (cell_pos.empty() || start_tile_id >= end_tile_id)
     return Status::Ok();
 
   // For easy reference
@@ -1911,35 +2021,22 @@ Status Writer::prepare_tiles_fixed(
   auto buffer = (unsigned char*)it->second.buffer_;
   auto cell_num = (uint64_t)cell_pos.size();
   auto capacity = array_schema_->capacity();
-  auto dups_num = coord_dups.size();
-  auto tile_num = utils::math::ceil(cell_num - dups_num, capacity);
   auto cell_size = array_schema_->cell_size(attribute);
+  auto start = start_tile_id * capacity;
+  auto end = std::min(end_tile_id * capacity, cell_num);
 
   // Initialize tiles
-  tiles->resize(tile_num);
+  tiles->resize(end_tile_id - start_tile_id);
   for (auto& tile : (*tiles))
     RETURN_NOT_OK(init_tile(attribute, &tile));
 
   // Write all cells one by one
-  if (dups_num == 0) {
-    for (uint64_t i = 0, tile_idx = 0; i < cell_num; ++i) {
-      if ((*tiles)[tile_idx].full())
-        ++tile_idx;
-
-      RETURN_NOT_OK((*tiles)[tile_idx].write(
-          buffer + cell_pos[i] * cell_size, cell_size));
-    }
-  } else {
-    for (uint64_t i = 0, tile_idx = 0; i < cell_num; ++i) {
-      if (coord_dups.find(cell_pos[i]) != coord_dups.end())
-        continue;
-
-      if ((*tiles)[tile_idx].full())
-        ++tile_idx;
+  for (uint64_t i = start, tile_idx = 0; i < end; ++i) {
+    if ((*tiles)[tile_idx].full())
+      ++tile_idx;
 
-      RETURN_NOT_OK((*tiles)[tile_idx].write(
-          buffer + cell_pos[i] * cell_size, cell_size));
-    }
+    RETURN_NOT_OK(
+        (*tiles)[tile_idx].write(buffer + cell_pos[i] * cell_size, cell_size));
   }
 
   return Status::Ok();
@@ -1950,64 +2047,49 @@ Status Writer::prepare_tiles_fixed(
 Status Writer::prepare_tiles_var(
     const std::string& attribute,
     const std::vector<uint64_t>& cell_pos,
-    const std::set<uint64_t>& coord_dups,
+    uint64_t start_tile_id,
+    uint64_t end_tile_id,
     std::vector<Tile>* tiles) const {
   STATS_FUNC_IN(writer_prepare_tiles_var);
 
+  // Trivial case
+  if (cell_pos.empty() || start_tile_id >= end_tile_id)
+    return Status::Ok();
+
   // For easy reference
   auto it = attr_buffers_.find(attribute);
   auto buffer = (uint64_t*)it->second.buffer_;
+  auto buffer_cell_num = *it->second.buffer_size_ / sizeof(uint64_t);
   auto buffer_var = (unsigned char*)it->second.buffer_var_;
   auto buffer_var_size = it->second.buffer_var_size_;
   auto cell_num = (uint64_t)cell_pos.size();
   auto capacity = array_schema_->capacity();
-  auto dups_num = coord_dups.size();
-  auto tile_num = utils::math::ceil(cell_num - dups_num, capacity);
+  auto start = start_tile_id * capacity;
+  auto end = std::min(end_tile_id * capacity, cell_num);
   uint64_t offset;
   uint64_t var_size;
 
   // Initialize tiles
-  tiles->resize(2 * tile_num);
+  tiles->resize(2 * (end_tile_id - start_tile_id));
   auto tiles_len = tiles->size();
   for (uint64_t i = 0; i < tiles_len; i += 2)
     RETURN_NOT_OK(init_tile(attribute, &((*tiles)[i]), &((*tiles)[i + 1])));
 
   // Write all cells one by one
-  if (dups_num == 0) {
-    for (uint64_t i = 0, tile_idx = 0; i < cell_num; ++i) {
-      if ((*tiles)[tile_idx].full())
-        tile_idx += 2;
-
-      // Write offset
-      offset = (*tiles)[tile_idx + 1].size();
-      RETURN_NOT_OK((*tiles)[tile_idx].write(&offset, sizeof(offset)));
-
-      // Write var-sized value
-      var_size = (cell_pos[i] == cell_num - 1) ?
-                     *buffer_var_size - buffer[cell_pos[i]] :
-                     buffer[cell_pos[i] + 1] - buffer[cell_pos[i]];
-      RETURN_NOT_OK((*tiles)[tile_idx + 1].write(
-          &buffer_var[buffer[cell_pos[i]]], var_size));
-    }
-  } else {
-    for (uint64_t i = 0, tile_idx = 0; i < cell_num; ++i) {
-      if (coord_dups.find(cell_pos[i]) != coord_dups.end())
-        continue;
-
-      if ((*tiles)[tile_idx].full())
-        tile_idx += 2;
-
-      // Write offset
-      offset = (*tiles)[tile_idx + 1].size();
-      RETURN_NOT_OK((*tiles)[tile_idx].write(&offset, sizeof(offset)));
-
-      // Write var-sized value
-      var_size = (cell_pos[i] == cell_num - 1) ?
-                     *buffer_var_size - buffer[cell_pos[i]] :
-                     buffer[cell_pos[i] + 1] - buffer[cell_pos[i]];
-      RETURN_NOT_OK((*tiles)[tile_idx + 1].write(
-          &buffer_var[buffer[cell_pos[i]]], var_size));
-    }
+  for (uint64_t i = start, tile_idx = 0; i < end; ++i) {
+    if ((*tiles)[tile_idx].full())
+      tile_idx += 2;
+
+    // Write offset
+    offset = (*tiles)[tile_idx + 1].size();
+    RETURN_NOT_OK((*tiles)[tile_idx].write(&offset, sizeof(offset)));
+
+    // Write var-sized value
+    var_size = (cell_pos[i] == buffer_cell_num - 1) ?
+                   *buffer_var_size - buffer[cell_pos[i]] :
+                   buffer[cell_pos[i] + 1] - buffer[cell_pos[i]];
+    RETURN_NOT_OK((*tiles)[tile_idx + 1].write(
+        &buffer_var[buffer[cell_pos[i]]], var_size));
   }
 
   return Status::Ok();
@@ -2102,55 +2184,41 @@ Status Writer::unordered_write() {
   if (dedup_coords_)
     RETURN_CANCEL_OR_ERROR(compute_coord_dups(cell_pos, &coord_dups));
 
+  // Drop the duplicates from the sorted positions, so that each tile
+  // corresponds to a contiguous range of positions
+  if (!coord_dups.empty()) {
+    std::vector<uint64_t> cell_pos_dedup;
+    cell_pos_dedup.reserve(cell_pos.size() - coord_dups.size());
+    for (auto pos : cell_pos) {
+      if (coord_dups.find(pos) == coord_dups.end())
+        cell_pos_dedup.push_back(pos);
+    }
+    cell_pos.swap(cell_pos_dedup);
+    coord_dups.clear();
+  }
+
   // Create new fragment
   std::shared_ptr<FragmentMetadata> frag_meta;
   RETURN_CANCEL_OR_ERROR(create_fragment(false, &frag_meta));
   auto uri = frag_meta->fragment_uri();
 
-  // Prepare tiles for all attributes
-  auto num_attributes = attributes_.size();
-  std::vector<std::vector<Tile>> attribute_tiles(num_attributes);
-  auto statuses = parallel_for(0, num_attributes, [&](uint64_t i) {
-    const auto& attr = attributes_[i];
-    auto& tiles = attribute_tiles[i];
-    RETURN_CANCEL_OR_ERROR(prepare_tiles(attr, cell_pos, coord_dups, &tiles));
-    return Status::Ok();
-  });
-
-  // Clear the boolean vector for coordinate duplicates
-  coord_dups.clear();
-
-  // Check all statuses
-  for (auto& st : statuses)
-    RETURN_NOT_OK_ELSE(st, storage_manager_->vfs()->remove_dir(uri));
-  statuses.clear();
-
   // Set the number of tiles in the metadata
-  uint64_t num_tiles = array_schema_->var_size(attributes_[0]) ?
-                           attribute_tiles[0].size() / 2 :
-                           attribute_tiles[0].size();
+  auto num_tiles =
+      utils::math::ceil(cell_pos.size(), array_schema_->capacity());
   frag_meta->set_num_tiles(num_tiles);
 
-  // Filter all tiles
-  statuses = parallel_for(0, num_attributes, [&](uint64_t i) {
-    const auto& attr = attributes_[i];
-    auto& tiles = attribute_tiles[i];
-    if (attr == constants::coords)
-      RETURN_CANCEL_OR_ERROR(
-          compute_coords_metadata<T>(tiles, frag_meta.get()));
-    RETURN_CANCEL_OR_ERROR(filter_tiles(attr, &tiles));
+  // Prepare, filter and write the tiles of all attributes, streaming the
+  // tiles of each attribute to storage as soon as they are filtered
+  auto num_attributes = attributes_.size();
+  auto statuses = parallel_for(0, num_attributes, [&](uint64_t i) {
+    RETURN_CANCEL_OR_ERROR(
+        stream_tiles<T>(attributes_[i], cell_pos, frag_meta.get()));
     return Status::Ok();
   });
 
   // Check all statuses
   for (auto& st : statuses)
     RETURN_NOT_OK_ELSE(st, storage_manager_->vfs()->remove_dir(uri));
-  statuses.clear();
-
-  // Write tiles for all attributes
-  RETURN_NOT_OK_ELSE(
-      write_all_tiles(frag_meta.get(), attribute_tiles),
-      storage_manager_->vfs()->remove_dir(uri));
 
   // Write the fragment metadata
   RETURN_CANCEL_OR_ERROR_ELSE(
@@ -2225,30 +2293,126 @@ Status Writer::write_cell_range_to_tile_var(
   return Status::Ok();
 }
 
+template <class T>
+Status Writer::stream_tiles(
+    const std::string& attribute,
+    const std::vector<uint64_t>& cell_pos,
+    FragmentMetadata* frag_meta) const {
+  // Handle zero tiles
+  auto num_tiles =
+      utils::math::ceil(cell_pos.size(), array_schema_->capacity());
+  if (num_tiles == 0)
+    return Status::Ok();
+
+  // With writes at offsets, up to one tile per writer thread can be in
+  // flight; otherwise, the tiles must be appended in order, so a tile is
+  // prepared and filtered only while the previous one is being written.
+  auto writer_thread_pool = storage_manager_->writer_thread_pool();
+  auto write_at =
+      storage_manager_->vfs()->supports_write_at(frag_meta->fragment_uri());
+  uint64_t max_writes =
+      write_at ? std::max<uint64_t>(writer_thread_pool->num_threads(), 1) : 1;
+
+  // Each tile is prepared and filtered in one of the buffers, while the
+  // tiles in the other buffers are being written
+  auto buffer_num = max_writes + 1;
+  std::vector<std::vector<Tile>> tiles(buffer_num);
+  std::vector<std::vector<std::future<Status>>> write_tasks(buffer_num);
+  Status st;
+  for (uint64_t tile_id = 0; tile_id < num_tiles; ++tile_id) {
+    // Wait for the previous write from the buffer before reusing it
+    auto b = tile_id % buffer_num;
+    st = writer_thread_pool->wait_all(write_tasks[b]);
+    write_tasks[b].clear();
+
+    auto cur_tiles = &tiles[b];
+    cur_tiles->clear();
+    if (st.ok())
+      st = prepare_tiles(attribute, cell_pos, tile_id, tile_id + 1, cur_tiles);
+    if (st.ok() && attribute == constants::coords)
+      st = compute_coords_metadata<T>(*cur_tiles, frag_meta, tile_id);
+    if (st.ok())
+      st = compute_tile_metadata(attribute, *cur_tiles, frag_meta, tile_id);
+    if (st.ok())
+      st = filter_tiles(attribute, cur_tiles);
+
+    if (st.ok()) {
+      if (write_at) {
+        st = write_tiles_at(
+            attribute, frag_meta, *cur_tiles, tile_id, &write_tasks[b]);
+      } else {
+        // Wait for the previous tile to be appended
+        auto prev_b = (b + buffer_num - 1) % buffer_num;
+        st = writer_thread_pool->wait_all(write_tasks[prev_b]);
+        write_tasks[prev_b].clear();
+        if (st.ok()) {
+          write_tasks[b].push_back(writer_thread_pool->enqueue(
+              [&attribute, cur_tiles, frag_meta, tile_id, this]() {
+                return write_tiles(
+                    attribute, frag_meta, *cur_tiles, tile_id, false);
+              }));
+        }
+      }
+    }
+
+    if (!st.ok())
+      break;
+  }
+
+  // Wait for the remaining writes
+  for (auto& tasks : write_tasks) {
+    auto write_st = writer_thread_pool->wait_all(tasks);
+    if (st.ok())
+      st = write_st;
+  }
+  RETURN_NOT_OK(st);
+
+  // Close files
+  RETURN_NOT_OK(storage_manager_->close_file(frag_meta->attr_uri(attribute)));
+  if (array_schema_->var_size(attribute))
+    RETURN_NOT_OK(
+        storage_manager_->close_file(frag_meta->attr_var_uri(attribute)));
+
+  return Status::Ok();
+}
+
 Status Writer::write_all_tiles(
     FragmentMetadata* frag_meta,
     const std::vector<std::vector<tiledb::sm::Tile>>& attribute_tiles) const {
   STATS_FUNC_IN(writer_write_all_tiles);
 
   std::vector<std::future<Status>> tasks;
+  auto writer_thread_pool = storage_manager_->writer_thread_pool();
+  auto write_at =
+      storage_manager_->vfs()->supports_write_at(frag_meta->fragment_uri());
 
   auto num_attributes = attributes_.size();
   for (uint64_t i = 0; i < num_attributes; i++) {
     const auto& attr = attributes_[i];
     auto& tiles = attribute_tiles[i];
-    tasks.push_back(
-        storage_manager_->writer_thread_pool()->enqueue([&, this]() {
-          RETURN_CANCEL_OR_ERROR(write_tiles(attr, frag_meta, tiles));
-          return Status::Ok();
-        }));
+    if (write_at) {
+      // Write the tiles of all attributes concurrently
+      RETURN_NOT_OK_ELSE(
+          write_tiles_at(attr, frag_meta, tiles, 0, &tasks),
+          writer_thread_pool->wait_all(tasks));
+    } else {
+      // Write the tiles of each attribute one after the other
+      tasks.push_back(writer_thread_pool->enqueue([&, this]() {
+        RETURN_CANCEL_OR_ERROR(write_tiles(attr, frag_meta, tiles));
+        return Status::Ok();
+      }));
+    }
   }
 
   // Wait for writes and check all statuses
-  auto statuses =
-      storage_manager_->writer_thread_pool()->wait_all_status(tasks);
+  auto statuses = writer_thread_pool->wait_all_status(tasks);
   for (auto& st : statuses)
     RETURN_NOT_OK(st);
 
+  // Close files, except in the case of global order
+  if (write_at && layout_ != Layout::GLOBAL_ORDER)
+    RETURN_NOT_OK(close_files(frag_meta));
+
   return Status::Ok();
 
   STATS_FUNC_OUT(writer_write_all_tiles);
@@ -2257,7 +2421,9 @@ Status Writer::write_all_tiles(
 Status Writer::write_tiles(
     const std::string& attribute,
     FragmentMetadata* frag_meta,
-    const std::vector<Tile>& tiles) const {
+    const std::vector<Tile>& tiles,
+    uint64_t first_tile_id,
+    bool close_files) const {
   // Handle zero tiles
   if (tiles.empty())
     return Status::Ok();
@@ -2269,7 +2435,7 @@ Status Writer::write_tiles(
 
   // Write tiles
   auto tile_num = tiles.size();
-  for (size_t i = 0, tile_id = 0; i < tile_num; ++i, ++tile_id) {
+  for (size_t i = 0, tile_id = first_tile_id; i < tile_num; ++i, ++tile_id) {
     RETURN_NOT_OK(storage_manager_->write(attr_uri, tiles[i].buffer()));
     frag_meta->set_tile_offset(attribute, tile_id, tiles[i].buffer()->size());
 
@@ -2289,7 +2455,7 @@ Status Writer::write_tiles(
   }
 
   // Close files, except in the case of global order
-  if (layout_ != Layout::GLOBAL_ORDER) {
+  if (close_files && layout_ != Layout::GLOBAL_ORDER) {
     RETURN_NOT_OK(storage_manager_->close_file(frag_meta->attr_uri(attribute)));
     if (var_size)
       RETURN_NOT_OK(
@@ -2301,5 +2467,57 @@ Status Writer::write_tiles(
   return Status::Ok();
 }
 
+Status Writer::write_tiles_at(
+    const std::string& attribute,
+    FragmentMetadata* frag_meta,
+    const std::vector<Tile>& tiles,
+    uint64_t first_tile_id,
+    std::vector<std::future<Status>>* tasks) const {
+  // Handle zero tiles
+  if (tiles.empty())
+    return Status::Ok();
+
+  // For easy reference
+  bool var_size = array_schema_->var_size(attribute);
+  auto attr_uri = frag_meta->attr_uri(attribute);
+  auto attr_var_uri = var_size ? frag_meta->attr_var_uri(attribute) : URI("");
+  auto vfs = storage_manager_->vfs();
+  auto writer_thread_pool = storage_manager_->writer_thread_pool();
+
+  // Reserve the region of each tile in the file, and write the tiles
+  // concurrently
+  auto tile_num = tiles.size();
+  for (size_t i = 0, tile_id = first_tile_id; i < tile_num; ++i, ++tile_id) {
+    auto buff = tiles[i].buffer();
+    auto offset = frag_meta->next_tile_offset(attribute);
+    frag_meta->set_tile_offset(attribute, tile_id, buff->size());
+    tasks->push_back(writer_thread_pool->enqueue([=]() {
+      return vfs->write_at(attr_uri, offset, buff->data(), buff->size());
+    }));
+
+    STATS_COUNTER_ADD(writer_num_bytes_written, buff->size());
+
+    if (var_size) {
+      ++i;
+
+      auto buff_var = tiles[i].buffer();
+      auto offset_var = frag_meta->next_tile_var_offset(attribute);
+      frag_meta->set_tile_var_offset(attribute, tile_id, buff_var->size());
+      frag_meta->set_tile_var_size(
+          attribute, tile_id, tiles[i].pre_filtered_size());
+      tasks->push_back(writer_thread_pool->enqueue([=]() {
+        return vfs->write_at(
+            attr_var_uri, offset_var, buff_var->data(), buff_var->size());
+      }));
+
+      STATS_COUNTER_ADD(writer_num_bytes_written, buff_var->size());
+    }
+  }
+
+  STATS_COUNTER_ADD(writer_num_attr_tiles_written, tile_num);
+
+  return Status::Ok();
+}
+
 }  // namespace sm
 }  // namespace tiledb
@@ -41,6 +41,7 @@
 #include "tiledb/sm/query/types.h"
 #include "tiledb/sm/tile/tile.h"
 
+#include <future>
 #include <memory>
 #include <set>
 
@@ -430,11 +431,45 @@ class Writer {
    * @tparam T The domain type.
    * @param tiles The tiles to calculate the coords metadata from.
    * @param meta The fragment metadata that will store the coords metadata.
+   * @param first_tile_id The id of the first of the input tiles in the
+   *     fragment.
    * @return Status
    */
   template <class T>
   Status compute_coords_metadata(
-      const std::vector<Tile>& tiles, FragmentMetadata* meta) const;
+      const std::vector<Tile>& tiles,
+      FragmentMetadata* meta,
+      uint64_t first_tile_id = 0) const;
+
+  /**
+   * Computes the minimum, maximum and sum of the values of each input tile
+   * of an attribute, and stores them in the fragment metadata. This is a
+   * no-op for the attributes without tile metadata (see
+   * `FragmentMetadata::has_tile_metadata`).
+   *
+   * @param attribute The attribute the tiles belong to.
+   * @param tiles The (unfiltered) tiles.
+   * @param meta The fragment metadata that will store the tile metadata.
+   * @param first_tile_id The id of the first of the input tiles in the
+   *     fragment.
+   * @return Status
+   */
+  Status compute_tile_metadata(
+      const std::string& attribute,
+      const std::vector<Tile>& tiles,
+      FragmentMetadata* meta,
+      uint64_t first_tile_id = 0) const;
+
+  /**
+   * Computes the tile metadata for values of type `T`, accumulating the
+   * sums in type `SumT`.
+   */
+  template <class T, class SumT>
+  Status compute_tile_metadata(
+      const std::string& attribute,
+      const std::vector<Tile>& tiles,
+      FragmentMetadata* meta,
+      uint64_t first_tile_id) const;
 
   /**
    * Computes the cell ranges to be written, derived from a
@@ -479,10 +514,15 @@ class Writer {
    * @param tile The tile to be filtered.
    * @param offsets True if the tile to be filtered contains offsets for a
    *    var-sized attribute.
+   * @param offsets_tile The unfiltered offsets tile of `tile`, if `tile`
+   *    holds the values of a var-sized attribute, or `nullptr`.
    * @return Status
    */
   Status filter_tile(
-      const std::string& attribute, Tile* tile, bool offsets) const;
+      const std::string& attribute,
+      Tile* tile,
+      bool offsets,
+      const Tile* offsets_tile = nullptr) const;
 
   /** Finalizes the global write state. */
   Status finalize_global_write_state();
@@ -691,59 +731,63 @@ class Writer {
       std::vector<Tile>* tiles) const;
 
   /**
-   * It prepares the tiles, re-organizing the cells from the user
-   * buffers based on the input sorted positions.
+   * It prepares the tiles with ids in `[start_tile_id, end_tile_id)`,
+   * re-organizing the cells from the user buffers based on the input
+   * sorted positions.
    *
    * @param attribute The attribute to prepare the tiles for.
-   * @param cell_pos The positions that resulted from sorting and
-   *     according to which the cells must be re-arranged.
-   * @param coord_dups The set with the positions
-   *     of duplicate coordinates/cells.
+   * @param cell_pos The positions that resulted from sorting (and
+   *     deduplicating) and according to which the cells must be re-arranged.
+   * @param start_tile_id The id of the first tile to prepare.
+   * @param end_tile_id One past the id of the last tile to prepare.
    * @param tiles The tiles to be created.
    * @return Status
    */
   Status prepare_tiles(
       const std::string& attribute,
       const std::vector<uint64_t>& cell_pos,
-      const std::set<uint64_t>& coord_dups,
+      uint64_t start_tile_id,
+      uint64_t end_tile_id,
       std::vector<Tile>* tiles) const;
 
   /**
-   * It prepares the tiles, re-organizing the cells from the user
-   * buffers based on the input sorted positions. Applicable only
-   * to fixed-sized attributes.
+   * It prepares the tiles with ids in `[start_tile_id, end_tile_id)`,
+   * re-organizing the cells from the user buffers based on the input
+   * sorted positions. Applicable only to fixed-sized attributes.
    *
    * @param attribute The attribute to prepare the tiles for.
-   * @param cell_pos The positions that resulted from sorting and
-   *     according to which the cells must be re-arranged.
-   * @param coord_dups The set with the positions
-   *     of duplicate coordinates/cells.
+   * @param cell_pos The positions that resulted from sorting (and
+   *     deduplicating) and according to which the cells must be re-arranged.
+   * @param start_tile_id The id of the first tile to prepare.
+   * @param end_tile_id One past the id of the last tile to prepare.
    * @param tiles The tiles to be created.
    * @return Status
    */
   Status prepare_tiles_fixed(
       const std::string& attribute,
       const std::vector<uint64_t>& cell_pos,
-      const std::set<uint64_t>& coord_dups,
+      uint64_t start_tile_id,
+      uint64_t end_tile_id,
       std::vector<Tile>* tiles) const;
 
   /**
-   * It prepares the tiles, re-organizing the cells from the user
-   * buffers based on the input sorted positions. Applicable only
-   * to var-sized attributes.
+   * It prepares the tiles with ids in `[start_tile_id, end_tile_id)`,
+   * re-organizing the cells from the user buffers based on the input
+   * sorted positions. Applicable only to var-sized attributes.
    *
    * @param attribute The attribute to prepare the tiles for.
-   * @param cell_pos The positions that resulted from sorting and
-   *     according to which the cells must be re-arranged.
-   * @param coord_dups The set with the positions
-   *     of duplicate coordinates/cells.
+   * @param cell_pos The positions that resulted from sorting (and
+   *     deduplicating) and according to which the cells must be re-arranged.
+   * @param start_tile_id The id of the first tile to prepare.
+   * @param end_tile_id One past the id of the last tile to prepare.
    * @param tiles The tiles to be created.
    * @return Status
    */
   Status prepare_tiles_var(
       const std::string& attribute,
       const std::vector<uint64_t>& cell_pos,
-      const std::set<uint64_t>& coord_dups,
+      uint64_t start_tile_id,
+      uint64_t end_tile_id,
       std::vector<Tile>* tiles) const;
 
   /** Resets the writer object, rendering it incomplete. */
@@ -830,6 +874,28 @@ class Writer {
       Tile* tile,
       Tile* tile_var) const;
 
+  /**
+   * Prepares, filters and writes the tiles of an attribute one at a time,
+   * in the order of the input sorted positions. A tile is prepared and
+   * filtered while the previous ones are being written. If the VFS supports
+   * writing at offsets, up to one tile per writer thread is written
+   * concurrently; otherwise the tiles are appended one after the other.
+   * Either way, the number of tiles of the attribute held in memory is
+   * bounded.
+   *
+   * @tparam T The domain type.
+   * @param attribute The attribute to write the tiles of.
+   * @param cell_pos The positions that resulted from sorting and
+   *     deduplicating and according to which the cells must be re-arranged.
+   * @param frag_meta The fragment metadata.
+   * @return Status
+   */
+  template <class T>
+  Status stream_tiles(
+      const std::string& attribute,
+      const std::vector<uint64_t>& cell_pos,
+      FragmentMetadata* frag_meta) const;
+
   /**
    * Writes all the input tiles to storage.
    *
@@ -846,12 +912,43 @@ class Writer {
    * @param attribute The attribute the tiles belong to.
    * @param frag_meta The fragment metadata.
    * @param tiles The tiles to be written.
+   * @param first_tile_id The id of the first of the input tiles in the
+   *     fragment.
+   * @param close_files If `true`, the attribute files are closed after
+   *     writing (except in the case of global order writes).
    * @return Status
    */
   Status write_tiles(
       const std::string& attribute,
       FragmentMetadata* frag_meta,
-      const std::vector<Tile>& tiles) const;
+      const std::vector<Tile>& tiles,
+      uint64_t first_tile_id = 0,
+      bool close_files = true) const;
+
+  /**
+   * Writes the input tiles for the input attribute to storage, each at its
+   * offset in the attribute files. The offsets are computed upfront from the
+   * (filtered) tile sizes, so that the tiles can be written concurrently.
+   * The writes are enqueued in the writer thread pool and their futures are
+   * added to `tasks`. The attribute files are not closed.
+   *
+   * Applicable only if the VFS supports writing at offsets for the fragment
+   * URI. The input tiles must outlive the tasks.
+   *
+   * @param attribute The attribute the tiles belong to.
+   * @param frag_meta The fragment metadata.
+   * @param tiles The tiles to be written.
+   * @param first_tile_id The id of the first of the input tiles in the
+   *     fragment.
+   * @param tasks The futures of the write tasks.
+   * @return Status
+   */
+  Status write_tiles_at(
+      const std::string& attribute,
+      FragmentMetadata* frag_meta,
+      const std::vector<Tile>& tiles,
+      uint64_t first_tile_id,
+      std::vector<std::future<Status>>* tasks) const;
 };
 
 }  // namespace sm
@@ -0,0 +1,206 @@
+/**
+ * @file   auto_consolidator.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * This file implements class AutoConsolidator.
+ */
+
+#include "tiledb/sm/storage_manager/auto_consolidator.h"
+#include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/stats.h"
+#include "tiledb/sm/storage_manager/consolidator.h"
+#include "tiledb/sm/storage_manager/storage_manager.h"
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+AutoConsolidator::AutoConsolidator(StorageManager* storage_manager)
+    : stop_(false)
+    , storage_manager_(storage_manager) {
+}
+
+AutoConsolidator::~AutoConsolidator() {
+  stop();
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status AutoConsolidator::start(const Config::ConsolidationParams& params) {
+  params_ = params;
+  if (!params_.auto_)
+    return Status::Ok();
+
+  if (params_.auto_frag_num_ < 2)
+    return LOG_STATUS(Status::ConsolidatorError(
+        "Cannot start background consolidation; The number of fragments "
+        "triggering consolidation must be at least 2"));
+
+  try {
+    thread_ = std::thread(&AutoConsolidator::run, this);
+  } catch (const std::exception& e) {
+    return LOG_STATUS(Status::ConsolidatorError(
+        std::string("Cannot start background consolidation; ") + e.what()));
+  }
+
+  return Status::Ok();
+}
+
+void AutoConsolidator::stop() {
+  {
+    std::unique_lock<std::mutex> lck(mtx_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+
+  if (thread_.joinable())
+    thread_.join();
+}
+
+void AutoConsolidator::watch(
+    const URI& array_uri, const EncryptionKey& encryption_key) {
+  if (!params_.auto_)
+    return;
+
+  auto key = encryption_key.key();
+  std::shared_ptr<EncryptionKey> array_key(new EncryptionKey());
+  if (!array_key
+           ->set_key(
+               encryption_key.encryption_type(),
+               key.data(),
+               static_cast<uint32_t>(key.size()))
+           .ok())
+    return;
+
+  std::unique_lock<std::mutex> lck(mtx_);
+  arrays_[array_uri.to_string()] = array_key;
+}
+
+void AutoConsolidator::unwatch(const URI& array_uri) {
+  if (!params_.auto_)
+    return;
+
+  std::unique_lock<std::mutex> lck(mtx_);
+  arrays_.erase(array_uri.to_string());
+}
+
+/* ****************************** */
+/*        PRIVATE METHODS         */
+/* ****************************** */
+
+Status AutoConsolidator::consolidate(
+    const URI& array_uri, const EncryptionKey& encryption_key) {
+  // Consolidate only if enough fragments have accumulated
+  std::vector<URI> fragment_uris;
+  RETURN_NOT_OK(storage_manager_->get_fragment_uris(array_uri, &fragment_uris));
+  if (fragment_uris.size() < params_.auto_frag_num_)
+    return Status::Ok();
+
+  // Always consolidate fragments, which also keeps any consolidated
+  // fragment metadata up to date
+  auto start = std::chrono::steady_clock::now();
+  auto config = storage_manager_->config();
+  RETURN_NOT_OK(config.set("sm.consolidation.mode", "fragments"));
+  auto key = encryption_key.key();
+  Consolidator consolidator(storage_manager_);
+  consolidator.set_nonblocking(&stop_, params_.auto_interval_ms_);
+  auto st = consolidator.consolidate(
+      array_uri.c_str(),
+      encryption_key.encryption_type(),
+      key.data(),
+      static_cast<uint32_t>(key.size()),
+      &config);
+
+  // Move on to the next array if its readers kept it open for too long
+  if (!st.ok() && consolidator.xlock_abandoned())
+    return Status::Ok();
+  RETURN_NOT_OK(st);
+
+  STATS_COUNTER_ADD(consolidator_num_auto_consolidations, 1);
+  STATS_COUNTER_ADD(consolidator_num_auto_io_bytes, consolidator.io_bytes());
+
+  throttle(consolidator.io_bytes(), start);
+
+  return Status::Ok();
+}
+
+void AutoConsolidator::run() {
+  std::unique_lock<std::mutex> lck(mtx_);
+  auto interval = std::chrono::milliseconds(params_.auto_interval_ms_);
+  for (;;) {
+    cv_.wait_for(lck, interval, [this]() { return stop_.load(); });
+    if (stop_)
+      return;
+
+    // Consolidate a snapshot of the watched arrays, without holding the
+    // mutex, so that arrays can be opened for writes in the meantime
+    auto arrays = arrays_;
+    lck.unlock();
+    std::vector<std::string> failed;
+    for (const auto& it : arrays) {
+      if (stop_)
+        break;
+      if (!consolidate(URI(it.first), *it.second).ok())
+        failed.push_back(it.first);
+    }
+    lck.lock();
+
+    // Stop watching the arrays that failed, e.g., because they were removed
+    if (!stop_) {
+      for (const auto& uri : failed)
+        arrays_.erase(uri);
+    }
+  }
+}
+
+void AutoConsolidator::throttle(
+    uint64_t io_bytes, std::chrono::steady_clock::time_point start) {
+  if (params_.auto_io_budget_ == 0)
+    return;
+
+  auto budget_ns = std::chrono::nanoseconds(static_cast<int64_t>(
+      1e9 * io_bytes / params_.auto_io_budget_));
+  auto end = start + budget_ns;
+  auto now = std::chrono::steady_clock::now();
+  if (now >= end)
+    return;
+
+  STATS_COUNTER_ADD(
+      consolidator_auto_throttle_ns,
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - now).count());
+
+  std::unique_lock<std::mutex> lck(mtx_);
+  cv_.wait_until(lck, end, [this]() { return stop_.load(); });
+}
+
+}  // namespace sm
+}  // namespace tiledb
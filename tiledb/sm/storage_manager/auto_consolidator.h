@@ -0,0 +1,174 @@
+/**
+ * @file   auto_consolidator.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2019 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * This file defines class AutoConsolidator.
+ */
+
+#ifndef TILEDB_AUTO_CONSOLIDATOR_H
+#define TILEDB_AUTO_CONSOLIDATOR_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tiledb/sm/encryption/encryption_key.h"
+#include "tiledb/sm/misc/status.h"
+#include "tiledb/sm/misc/uri.h"
+#include "tiledb/sm/storage_manager/config.h"
+
+namespace tiledb {
+namespace sm {
+
+class StorageManager;
+
+/**
+ * Consolidates in the background the arrays opened for writes, whenever
+ * their number of fragments reaches a threshold. The fragments to
+ * consolidate are selected by the consolidation policy of `Consolidator`,
+ * the I/O rate is bounded by a configurable budget, and the readers of
+ * the arrays are never blocked.
+ */
+class AutoConsolidator {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param storage_manager The storage manager.
+   */
+  explicit AutoConsolidator(StorageManager* storage_manager);
+
+  /** Destructor. Stops the background thread. */
+  ~AutoConsolidator();
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Starts the background thread, if background consolidation is enabled
+   * in the input parameters.
+   *
+   * @param params The consolidation parameters.
+   * @return Status
+   */
+  Status start(const Config::ConsolidationParams& params);
+
+  /**
+   * Stops the background thread, cancelling an ongoing consolidation that
+   * waits for the readers of its array.
+   */
+  void stop();
+
+  /**
+   * Adds an array to the arrays checked for background consolidation.
+   * This is a no-op if background consolidation is disabled.
+   *
+   * @param array_uri The array URI.
+   * @param encryption_key The encryption key of the array.
+   */
+  void watch(const URI& array_uri, const EncryptionKey& encryption_key);
+
+  /**
+   * Removes an array from the arrays checked for background consolidation,
+   * once it is no longer open for writes. Its copy of the encryption key
+   * is wiped as soon as no ongoing consolidation uses it.
+   *
+   * @param array_uri The array URI.
+   */
+  void unwatch(const URI& array_uri);
+
+ private:
+  /* ********************************* */
+  /*        PRIVATE ATTRIBUTES         */
+  /* ********************************* */
+
+  /**
+   * The arrays checked for background consolidation, keyed by URI, along
+   * with their encryption keys (which are wiped on destruction).
+   */
+  std::map<std::string, std::shared_ptr<EncryptionKey>> arrays_;
+
+  /** Notifies the background thread to stop waiting. */
+  std::condition_variable cv_;
+
+  /** Protects `arrays_` and guards `cv_`. */
+  std::mutex mtx_;
+
+  /** The consolidation parameters. */
+  Config::ConsolidationParams params_;
+
+  /** Set to `true` to stop the background thread. */
+  std::atomic<bool> stop_;
+
+  /** The storage manager. */
+  StorageManager* storage_manager_;
+
+  /** The background thread. */
+  std::thread thread_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /**
+   * Consolidates the input array if its number of fragments reaches
+   * the threshold, and then waits as long as the I/O budget requires.
+   * If the readers of the array keep it open for longer than the
+   * consolidation interval, the consolidation is skipped until the next
+   * interval.
+   *
+   * @param array_uri The array URI.
+   * @param encryption_key The encryption key of the array.
+   * @return Status
+   */
+  Status consolidate(const URI& array_uri, const EncryptionKey& encryption_key);
+
+  /** The body of the background thread. */
+  void run();
+
+  /**
+   * Waits until reading and writing `io_bytes` since `start` complies
+   * with the I/O budget, or until the background thread is stopped.
+   */
+  void throttle(uint64_t io_bytes, std::chrono::steady_clock::time_point start);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_AUTO_CONSOLIDATOR_H
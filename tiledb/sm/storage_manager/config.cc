@@ -174,6 +174,10 @@ Status Config::set(const std::string& param, const std::string& value) {
     RETURN_NOT_OK(set_sm_check_global_order(value));
   } else if (param == "sm.tile_cache_size") {
     RETURN_NOT_OK(set_sm_tile_cache_size(value));
+  } else if (param == "sm.tile_cache_policy") {
+    RETURN_NOT_OK(set_sm_tile_cache_policy(value));
+  } else if (param == "sm.tile_cache_decoded_ratio") {
+    RETURN_NOT_OK(set_sm_tile_cache_decoded_ratio(value));
   } else if (param == "sm.memory_budget") {
     RETURN_NOT_OK(set_sm_memory_budget(value));
   } else if (param == "sm.memory_budget_var") {
@@ -200,6 +204,16 @@ Status Config::set(const std::string& param, const std::string& value) {
     RETURN_NOT_OK(set_consolidation_step_max_frags(value));
   } else if (param == "sm.consolidation.step_size_ratio") {
     RETURN_NOT_OK(set_consolidation_step_size_ratio(value));
+  } else if (param == "sm.consolidation.mode") {
+    RETURN_NOT_OK(set_consolidation_mode(value));
+  } else if (param == "sm.consolidation.auto") {
+    RETURN_NOT_OK(set_consolidation_auto(value));
+  } else if (param == "sm.consolidation.auto_frag_num") {
+    RETURN_NOT_OK(set_consolidation_auto_frag_num(value));
+  } else if (param == "sm.consolidation.auto_interval_ms") {
+    RETURN_NOT_OK(set_consolidation_auto_interval_ms(value));
+  } else if (param == "sm.consolidation.auto_io_budget") {
+    RETURN_NOT_OK(set_consolidation_auto_io_budget(value));
   } else if (param == "vfs.num_threads") {
     RETURN_NOT_OK(set_vfs_num_threads(value));
   } else if (param == "vfs.min_parallel_size") {
@@ -210,6 +224,12 @@ Status Config::set(const std::string& param, const std::string& value) {
     RETURN_NOT_OK(set_vfs_min_batch_size(value));
   } else if (param == "vfs.file.max_parallel_ops") {
     RETURN_NOT_OK(set_vfs_file_max_parallel_ops(value));
+  } else if (param == "vfs.file.max_open_handles") {
+    RETURN_NOT_OK(set_vfs_file_max_open_handles(value));
+  } else if (param == "vfs.file.enable_io_uring") {
+    RETURN_NOT_OK(set_vfs_file_enable_io_uring(value));
+  } else if (param == "vfs.file.enable_mmap") {
+    RETURN_NOT_OK(set_vfs_file_enable_mmap(value));
   } else if (param == "vfs.s3.region") {
     RETURN_NOT_OK(set_vfs_s3_region(value));
   } else if (param == "vfs.s3.aws_access_key_id") {
@@ -308,6 +328,16 @@ Status Config::unset(const std::string& param) {
     value << sm_params_.tile_cache_size_;
     param_values_["sm.tile_cache_size"] = value.str();
     value.str(std::string());
+  } else if (param == "sm.tile_cache_policy") {
+    sm_params_.tile_cache_policy_ = constants::tile_cache_policy;
+    value << sm_params_.tile_cache_policy_;
+    param_values_["sm.tile_cache_policy"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.tile_cache_decoded_ratio") {
+    sm_params_.tile_cache_decoded_ratio_ = constants::tile_cache_decoded_ratio;
+    value << sm_params_.tile_cache_decoded_ratio_;
+    param_values_["sm.tile_cache_decoded_ratio"] = value.str();
+    value.str(std::string());
   } else if (param == "sm.memory_budget") {
     sm_params_.memory_budget_ = constants::memory_budget_fixed;
     value << sm_params_.memory_budget_;
@@ -378,6 +408,34 @@ Status Config::unset(const std::string& param) {
     value << sm_params_.consolidation_params_.step_size_ratio_;
     param_values_["sm.consolidation.step_size_ratio"] = value.str();
     value.str(std::string());
+  } else if (param == "sm.consolidation.mode") {
+    sm_params_.consolidation_params_.mode_ = constants::consolidation_mode;
+    value << sm_params_.consolidation_params_.mode_;
+    param_values_["sm.consolidation.mode"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.consolidation.auto") {
+    sm_params_.consolidation_params_.auto_ = constants::consolidation_auto;
+    value << (sm_params_.consolidation_params_.auto_ ? "true" : "false");
+    param_values_["sm.consolidation.auto"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.consolidation.auto_frag_num") {
+    sm_params_.consolidation_params_.auto_frag_num_ =
+        constants::consolidation_auto_frag_num;
+    value << sm_params_.consolidation_params_.auto_frag_num_;
+    param_values_["sm.consolidation.auto_frag_num"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.consolidation.auto_interval_ms") {
+    sm_params_.consolidation_params_.auto_interval_ms_ =
+        constants::consolidation_auto_interval_ms;
+    value << sm_params_.consolidation_params_.auto_interval_ms_;
+    param_values_["sm.consolidation.auto_interval_ms"] = value.str();
+    value.str(std::string());
+  } else if (param == "sm.consolidation.auto_io_budget") {
+    sm_params_.consolidation_params_.auto_io_budget_ =
+        constants::consolidation_auto_io_budget;
+    value << sm_params_.consolidation_params_.auto_io_budget_;
+    param_values_["sm.consolidation.auto_io_budget"] = value.str();
+    value.str(std::string());
   } else if (param == "vfs.num_threads") {
     vfs_params_.num_threads_ = constants::vfs_num_threads;
     value << vfs_params_.num_threads_;
@@ -404,6 +462,23 @@ Status Config::unset(const std::string& param) {
     value << vfs_params_.file_params_.max_parallel_ops_;
     param_values_["vfs.file.max_parallel_ops"] = value.str();
     value.str(std::string());
+  } else if (param == "vfs.file.max_open_handles") {
+    vfs_params_.file_params_.max_open_handles_ =
+        constants::vfs_file_max_open_handles;
+    value << vfs_params_.file_params_.max_open_handles_;
+    param_values_["vfs.file.max_open_handles"] = value.str();
+    value.str(std::string());
+  } else if (param == "vfs.file.enable_io_uring") {
+    vfs_params_.file_params_.enable_io_uring_ =
+        constants::vfs_file_enable_io_uring;
+    value << ((vfs_params_.file_params_.enable_io_uring_) ? "true" : "false");
+    param_values_["vfs.file.enable_io_uring"] = value.str();
+    value.str(std::string());
+  } else if (param == "vfs.file.enable_mmap") {
+    vfs_params_.file_params_.enable_mmap_ = constants::vfs_file_enable_mmap;
+    value << ((vfs_params_.file_params_.enable_mmap_) ? "true" : "false");
+    param_values_["vfs.file.enable_mmap"] = value.str();
+    value.str(std::string());
   } else if (param == "vfs.s3.region") {
     vfs_params_.s3_params_.region_ = constants::s3_region;
     value << vfs_params_.s3_params_.region_;
@@ -551,6 +626,14 @@ void Config::set_default_param_values() {
   param_values_["sm.tile_cache_size"] = value.str();
   value.str(std::string());
 
+  value << sm_params_.tile_cache_policy_;
+  param_values_["sm.tile_cache_policy"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.tile_cache_decoded_ratio_;
+  param_values_["sm.tile_cache_decoded_ratio"] = value.str();
+  value.str(std::string());
+
   value << sm_params_.memory_budget_;
   param_values_["sm.memory_budget"] = value.str();
   value.str(std::string());
@@ -603,6 +686,26 @@ void Config::set_default_param_values() {
   param_values_["sm.consolidation.step_size_ratio"] = value.str();
   value.str(std::string());
 
+  value << sm_params_.consolidation_params_.mode_;
+  param_values_["sm.consolidation.mode"] = value.str();
+  value.str(std::string());
+
+  value << (sm_params_.consolidation_params_.auto_ ? "true" : "false");
+  param_values_["sm.consolidation.auto"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.consolidation_params_.auto_frag_num_;
+  param_values_["sm.consolidation.auto_frag_num"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.consolidation_params_.auto_interval_ms_;
+  param_values_["sm.consolidation.auto_interval_ms"] = value.str();
+  value.str(std::string());
+
+  value << sm_params_.consolidation_params_.auto_io_budget_;
+  param_values_["sm.consolidation.auto_io_budget"] = value.str();
+  value.str(std::string());
+
   value << vfs_params_.num_threads_;
   param_values_["vfs.num_threads"] = value.str();
   value.str(std::string());
@@ -623,6 +726,18 @@ void Config::set_default_param_values() {
   param_values_["vfs.file.max_parallel_ops"] = value.str();
   value.str(std::string());
 
+  value << vfs_params_.file_params_.max_open_handles_;
+  param_values_["vfs.file.max_open_handles"] = value.str();
+  value.str(std::string());
+
+  value << ((vfs_params_.file_params_.enable_io_uring_) ? "true" : "false");
+  param_values_["vfs.file.enable_io_uring"] = value.str();
+  value.str(std::string());
+
+  value << ((vfs_params_.file_params_.enable_mmap_) ? "true" : "false");
+  param_values_["vfs.file.enable_mmap"] = value.str();
+  value.str(std::string());
+
   value << vfs_params_.s3_params_.region_;
   param_values_["vfs.s3.region"] = value.str();
   value.str(std::string());
@@ -842,6 +957,26 @@ Status Config::set_sm_tile_cache_size(const std::string& value) {
   return Status::Ok();
 }
 
+Status Config::set_sm_tile_cache_policy(const std::string& value) {
+  if (value != "lru" && value != "2q" && value != "wtinylfu")
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter; Invalid tile cache policy"));
+  sm_params_.tile_cache_policy_ = value;
+
+  return Status::Ok();
+}
+
+Status Config::set_sm_tile_cache_decoded_ratio(const std::string& value) {
+  float v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  if (v < 0.0f || v > 1.0f)
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter; Tile cache decoded ratio must be in [0, 1]"));
+  sm_params_.tile_cache_decoded_ratio_ = v;
+
+  return Status::Ok();
+}
+
 Status Config::set_sm_memory_budget(const std::string& value) {
   uint64_t v;
   RETURN_NOT_OK(utils::parse::convert(value, &v));
@@ -874,6 +1009,50 @@ Status Config::set_consolidation_buffer_size(const std::string& value) {
   return Status::Ok();
 }
 
+Status Config::set_consolidation_mode(const std::string& value) {
+  if (value != "fragments" && value != "fragment_meta")
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter; Invalid consolidation mode"));
+  sm_params_.consolidation_params_.mode_ = value;
+
+  return Status::Ok();
+}
+
+Status Config::set_consolidation_auto(const std::string& value) {
+  bool v = false;
+  if (!parse_bool(value, &v).ok()) {
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter; Invalid auto consolidation value"));
+  }
+  sm_params_.consolidation_params_.auto_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_consolidation_auto_frag_num(const std::string& value) {
+  uint32_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.consolidation_params_.auto_frag_num_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_consolidation_auto_interval_ms(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.consolidation_params_.auto_interval_ms_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_consolidation_auto_io_budget(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  sm_params_.consolidation_params_.auto_io_budget_ = v;
+
+  return Status::Ok();
+}
+
 Status Config::set_vfs_num_threads(const std::string& value) {
   uint64_t v;
   RETURN_NOT_OK(utils::parse::convert(value, &v));
@@ -914,6 +1093,34 @@ Status Config::set_vfs_file_max_parallel_ops(const std::string& value) {
   return Status::Ok();
 }
 
+Status Config::set_vfs_file_max_open_handles(const std::string& value) {
+  uint64_t v;
+  RETURN_NOT_OK(utils::parse::convert(value, &v));
+  vfs_params_.file_params_.max_open_handles_ = v;
+
+  return Status::Ok();
+}
+
+Status Config::set_vfs_file_enable_io_uring(const std::string& value) {
+  bool v = false;
+  if (!parse_bool(value, &v).ok()) {
+    return LOG_STATUS(Status::ConfigError(
+        "Cannot set parameter; Invalid io_uring enable value"));
+  }
+  vfs_params_.file_params_.enable_io_uring_ = v;
+  return Status::Ok();
+}
+
+Status Config::set_vfs_file_enable_mmap(const std::string& value) {
+  bool v = false;
+  if (!parse_bool(value, &v).ok()) {
+    return LOG_STATUS(
+        Status::ConfigError("Cannot set parameter; Invalid mmap enable value"));
+  }
+  vfs_params_.file_params_.enable_mmap_ = v;
+  return Status::Ok();
+}
+
 Status Config::set_vfs_s3_region(const std::string& value) {
   vfs_params_.s3_params_.region_ = value;
   return Status::Ok();
@@ -58,6 +58,11 @@ class Config {
     uint32_t step_min_frags_;
     uint32_t step_max_frags_;
     float step_size_ratio_;
+    std::string mode_;
+    bool auto_;
+    uint32_t auto_frag_num_;
+    uint64_t auto_interval_ms_;
+    uint64_t auto_io_budget_;
 
     ConsolidationParams() {
       amplification_ = constants::consolidation_amplification;
@@ -66,6 +71,11 @@ class Config {
       step_min_frags_ = constants::consolidation_step_min_frags;
       step_max_frags_ = constants::consolidation_step_max_frags;
       step_size_ratio_ = constants::consolidation_step_size_ratio;
+      mode_ = constants::consolidation_mode;
+      auto_ = constants::consolidation_auto;
+      auto_frag_num_ = constants::consolidation_auto_frag_num;
+      auto_interval_ms_ = constants::consolidation_auto_interval_ms;
+      auto_io_budget_ = constants::consolidation_auto_io_budget;
     }
   };
 
@@ -79,6 +89,8 @@ class Config {
     uint64_t num_writer_threads_;
     int num_tbb_threads_;
     uint64_t tile_cache_size_;
+    std::string tile_cache_policy_;
+    float tile_cache_decoded_ratio_;
     bool dedup_coords_;
     bool check_coord_dups_;
     bool check_coord_oob_;
@@ -94,6 +106,8 @@ class Config {
       num_writer_threads_ = constants::num_writer_threads;
       num_tbb_threads_ = constants::num_tbb_threads;
       tile_cache_size_ = constants::tile_cache_size;
+      tile_cache_policy_ = constants::tile_cache_policy;
+      tile_cache_decoded_ratio_ = constants::tile_cache_decoded_ratio;
       dedup_coords_ = false;
       check_coord_dups_ = true;
       check_coord_oob_ = true;
@@ -157,9 +171,15 @@ class Config {
 
   struct FileParams {
     uint64_t max_parallel_ops_;
+    uint64_t max_open_handles_;
+    bool enable_io_uring_;
+    bool enable_mmap_;
 
     FileParams() {
       max_parallel_ops_ = constants::vfs_file_max_parallel_ops;
+      max_open_handles_ = constants::vfs_file_max_open_handles;
+      enable_io_uring_ = constants::vfs_file_enable_io_uring;
+      enable_mmap_ = constants::vfs_file_enable_mmap;
     }
   };
 
@@ -242,6 +262,18 @@ class Config {
    * - `sm.tile_cache_size` <br>
    *    The tile cache size in bytes. Any `uint64_t` value is acceptable. <br>
    *    **Default**: 10,000,000
+   * - `sm.tile_cache_policy` <br>
+   *    The tile cache eviction policy. `lru` evicts the least recently used
+   *    tiles. `2q` and `wtinylfu` (W-TinyLFU) only let tiles that are accessed
+   *    repeatedly displace the cached working set, so that large scans do not
+   *    flush the cache. <br>
+   *    **Default**: lru
+   * - `sm.tile_cache_decoded_ratio` <br>
+   *    The fraction of the tile cache that holds decoded (unfiltered) tiles,
+   *    in [0, 1]. The rest of the cache holds tiles as they are stored
+   *    (e.g., compressed), which avoids I/O on a hit but still requires
+   *    decoding the tile. <br>
+   *    **Default**: 1
    * - `sm.enable_signal_handlers` <br>
    *    Whether or not TileDB will install signal handlers. <br>
    *    **Default**: true
@@ -316,6 +348,23 @@ class Config {
    *    The maximum number of parallel operations on objects with `file:///`
    *    URIs. <br>
    *    **Default**: `vfs.num_threads`
+   * - `vfs.file.max_open_handles` <br>
+   *    The maximum number of read-only `file:///` handles (and file sizes)
+   *    that are kept open and reused across reads. The handles are closed
+   *    upon removing or moving the files. `0` disables the caching. <br>
+   *    **Default**: 128
+   * - `vfs.file.enable_io_uring` <br>
+   *    If `true`, the batched reads of a `file:///` object (e.g., the tiles
+   *    of a query) are submitted together through Linux io_uring, instead of
+   *    one `pread` per batch. Ignored if io_uring is not available. <br>
+   *    **Default**: false
+   * - `vfs.file.enable_mmap` <br>
+   *    If `true`, `file:///` objects are memory-mapped when first read (the
+   *    mapping is kept along with the open file handle) and reads are served
+   *    from the mapped pages. Unfiltered tiles are then used in place, without
+   *    any copy. This takes precedence over `vfs.file.enable_io_uring`. The
+   *    mapped files must not be truncated by other processes. <br>
+   *    **Default**: false
    * - `vfs.s3.region` <br>
    *    The S3 region, if S3 is enabled. <br>
    *    **Default**: us-east-1
@@ -487,6 +536,21 @@ class Config {
   /** Sets the consolidation buffer size, properly parsing the input value. */
   Status set_consolidation_buffer_size(const std::string& value);
 
+  /** Sets what gets consolidated, checking the input value. */
+  Status set_consolidation_mode(const std::string& value);
+
+  /** Sets whether arrays are consolidated in the background. */
+  Status set_consolidation_auto(const std::string& value);
+
+  /** Sets the number of fragments that triggers background consolidation. */
+  Status set_consolidation_auto_frag_num(const std::string& value);
+
+  /** Sets the interval at which background consolidation checks arrays. */
+  Status set_consolidation_auto_interval_ms(const std::string& value);
+
+  /** Sets the I/O rate limit of background consolidation. */
+  Status set_consolidation_auto_io_budget(const std::string& value);
+
   /** Sets the memory_budget, properly parsing the input value. */
   Status set_sm_memory_budget(const std::string& value);
 
@@ -499,6 +563,15 @@ class Config {
   /** Sets the tile cache size, properly parsing the input value. */
   Status set_sm_tile_cache_size(const std::string& value);
 
+  /** Sets the tile cache eviction policy. */
+  Status set_sm_tile_cache_policy(const std::string& value);
+
+  /**
+   * Sets the fraction of the tile cache holding decoded tiles, properly
+   * parsing the input value.
+   */
+  Status set_sm_tile_cache_decoded_ratio(const std::string& value);
+
   /** Sets the number of VFS threads. */
   Status set_vfs_num_threads(const std::string& value);
 
@@ -514,6 +587,15 @@ class Config {
   /** Sets the max number of allowed file:/// parallel operations. */
   Status set_vfs_file_max_parallel_ops(const std::string& value);
 
+  /** Sets the max number of cached open file:/// handles. */
+  Status set_vfs_file_max_open_handles(const std::string& value);
+
+  /** Sets whether io_uring is used for batched file:/// reads. */
+  Status set_vfs_file_enable_io_uring(const std::string& value);
+
+  /** Sets whether file:/// reads are served from memory-mapped files. */
+  Status set_vfs_file_enable_mmap(const std::string& value);
+
   /** Sets the S3 region. */
   Status set_vfs_s3_region(const std::string& value);
 
@@ -32,13 +32,23 @@
 
 #include "tiledb/sm/storage_manager/consolidator.h"
 #include "tiledb/sm/fragment/fragment_info.h"
+#include "tiledb/sm/fragment/fragment_metadata.h"
 #include "tiledb/sm/misc/logger.h"
+#include "tiledb/sm/misc/parallel_functions.h"
+#include "tiledb/sm/misc/stats.h"
+#include "tiledb/sm/misc/thread_pool.h"
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/misc/uuid.h"
 #include "tiledb/sm/storage_manager/storage_manager.h"
+#include "tiledb/sm/tile/tile_io.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <iostream>
+#include <queue>
 #include <sstream>
+#include <thread>
 
 /* ****************************** */
 /*             MACROS             */
@@ -55,12 +65,67 @@
 namespace tiledb {
 namespace sm {
 
+/* ****************************** */
+/*        TYPE DEFINITIONS        */
+/* ****************************** */
+
+struct Consolidator::MergeCursor {
+  /** The array, opened for reading only the fragment of the cursor. */
+  Array array_;
+  /** The global order read query on the fragment. */
+  std::unique_ptr<Query> query_;
+  /** The result buffers, in the order of `set_query_buffers`. */
+  std::vector<std::vector<uint8_t>> buffers_;
+  /** The result buffer sizes. */
+  std::vector<uint64_t> buffer_sizes_;
+  /** The number of cells in the current chunk. */
+  uint64_t cell_num_;
+  /** The position of the current cell in the current chunk. */
+  uint64_t cell_;
+  /**
+   * The position of the fragment in timestamp order. Among cells with the
+   * same coordinates, the one with the largest position is kept.
+   */
+  size_t fragment_idx_;
+
+  /** Constructor. */
+  MergeCursor(
+      const URI& array_uri, StorageManager* storage_manager, size_t idx)
+      : array_(array_uri, storage_manager)
+      , cell_num_(0)
+      , cell_(0)
+      , fragment_idx_(idx) {
+  }
+
+  /** Destructor. Closes the array if it is open. */
+  ~MergeCursor() {
+    query_.reset(nullptr);
+    if (array_.is_open())
+      array_.close();
+  }
+
+  /** Returns the coordinates of the current cell. */
+  const void* coords() const {
+    return buffers_.back().data() +
+           cell_ * array_.array_schema()->coords_size();
+  }
+
+  /** Returns `true` if all the cells of the fragment have been consumed. */
+  bool done() const {
+    return cell_ >= cell_num_;
+  }
+};
+
 /* ****************************** */
 /*   CONSTRUCTORS & DESTRUCTORS   */
 /* ****************************** */
 
 Consolidator::Consolidator(StorageManager* storage_manager)
-    : storage_manager_(storage_manager) {
+    : storage_manager_(storage_manager)
+    , cancel_(nullptr)
+    , io_bytes_(0)
+    , xlock_abandoned_(false)
+    , xlock_timeout_ms_(0) {
 }
 
 Consolidator::~Consolidator() = default;
@@ -77,11 +142,23 @@ Status Consolidator::consolidate(
     const Config* config) {
   // Set config parameters
   RETURN_NOT_OK(set_config(config));
+  xlock_abandoned_ = false;
 
   URI array_uri = URI(array_name);
   EncryptionKey enc_key;
   RETURN_NOT_OK(enc_key.set_key(encryption_type, encryption_key, key_length));
 
+  if (config_.mode_ == "fragment_meta")
+    return consolidate_fragment_meta(
+        array_uri, encryption_type, encryption_key, key_length);
+
+  // Deleting consolidated fragments removes the consolidated fragment
+  // metadata, which must then be written again
+  auto meta_uri =
+      array_uri.join_path(constants::consolidated_fragment_metadata_filename);
+  bool meta_consolidated = false;
+  RETURN_NOT_OK(storage_manager_->vfs()->is_file(meta_uri, &meta_consolidated));
+
   // Get array schema
   ObjectType object_type;
   RETURN_NOT_OK(storage_manager_->object_type(array_uri, &object_type));
@@ -95,9 +172,31 @@ Status Consolidator::consolidate(
 
   delete array_schema;
 
+  if (meta_consolidated) {
+    bool exists = false;
+    RETURN_NOT_OK(storage_manager_->vfs()->is_file(meta_uri, &exists));
+    if (!exists)
+      return consolidate_fragment_meta(
+          array_uri, encryption_type, encryption_key, key_length);
+  }
+
   return Status::Ok();
 }
 
+uint64_t Consolidator::io_bytes() const {
+  return io_bytes_;
+}
+
+void Consolidator::set_nonblocking(
+    const std::atomic<bool>* cancel, uint64_t xlock_timeout_ms) {
+  cancel_ = cancel;
+  xlock_timeout_ms_ = xlock_timeout_ms;
+}
+
+bool Consolidator::xlock_abandoned() const {
+  return xlock_abandoned_;
+}
+
 /* ****************************** */
 /*        PRIVATE METHODS         */
 /* ****************************** */
@@ -114,6 +213,94 @@ bool Consolidator::all_sparse(
   return true;
 }
 
+Status Consolidator::array_xlock(const URI& array_uri) {
+  if (cancel_ == nullptr)
+    return storage_manager_->array_xlock(array_uri);
+
+  // Wait until no reader has the array open, without blocking new readers
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(xlock_timeout_ms_);
+  bool locked = false;
+  for (;;) {
+    RETURN_NOT_OK(storage_manager_->array_try_xlock(array_uri, &locked));
+    if (locked)
+      return Status::Ok();
+    if (*cancel_) {
+      xlock_abandoned_ = true;
+      return LOG_STATUS(Status::ConsolidatorError(
+          "Cannot lock array exclusively; Consolidation cancelled"));
+    }
+    if (std::chrono::steady_clock::now() >= deadline) {
+      xlock_abandoned_ = true;
+      return LOG_STATUS(Status::ConsolidatorError(
+          "Cannot lock array exclusively; Timed out waiting for readers"));
+    }
+    std::this_thread::sleep_for(
+        std::chrono::milliseconds(constants::consolidation_xlock_retry_ms));
+  }
+}
+
+Status Consolidator::append_file(
+    const URI& src, uint64_t size, const URI& dst) const {
+  Buffer buff;
+  for (uint64_t offset = 0; offset < size; offset += buff.size()) {
+    auto nbytes = MIN(size - offset, config_.buffer_size_);
+    RETURN_NOT_OK(storage_manager_->read(src, offset, &buff, nbytes));
+    RETURN_NOT_OK(storage_manager_->write(dst, &buff));
+  }
+
+  STATS_COUNTER_ADD(consolidator_num_bytes_copied, size);
+
+  return Status::Ok();
+}
+
+bool Consolidator::append_cell(
+    const MergeCursor& cursor,
+    const std::vector<uint64_t>& cell_sizes,
+    void** buffers,
+    uint64_t* buffer_sizes) const {
+  // Compute the bytes to append to each buffer
+  auto buffer_num = cell_sizes.size();
+  std::vector<const uint8_t*> cell(buffer_num);
+  std::vector<uint64_t> nbytes(buffer_num);
+  for (size_t b = 0; b < buffer_num; ++b) {
+    const auto& buff = cursor.buffers_[b];
+    if (cell_sizes[b] == constants::var_size) {
+      auto offsets = (const uint64_t*)buff.data();
+      auto offset = offsets[cursor.cell_];
+      auto end = (cursor.cell_ + 1 < cursor.cell_num_) ?
+                     offsets[cursor.cell_ + 1] :
+                     cursor.buffer_sizes_[b + 1];
+      nbytes[b] = sizeof(uint64_t);
+      cell[b + 1] = cursor.buffers_[b + 1].data() + offset;
+      nbytes[b + 1] = end - offset;
+      ++b;
+    } else {
+      cell[b] = buff.data() + cursor.cell_ * cell_sizes[b];
+      nbytes[b] = cell_sizes[b];
+    }
+  }
+
+  // Check if the cell fits
+  for (size_t b = 0; b < buffer_num; ++b) {
+    if (buffer_sizes[b] + nbytes[b] > config_.buffer_size_)
+      return false;
+  }
+
+  // Append the cell. The offset of a var-sized cell is the current size of
+  // the buffer of its values.
+  for (size_t b = 0; b < buffer_num; ++b) {
+    auto dst = (uint8_t*)buffers[b] + buffer_sizes[b];
+    if (cell_sizes[b] == constants::var_size)
+      std::memcpy(dst, &buffer_sizes[b + 1], sizeof(uint64_t));
+    else
+      std::memcpy(dst, cell[b], nbytes[b]);
+    buffer_sizes[b] += nbytes[b];
+  }
+
+  return true;
+}
+
 template <class T>
 bool Consolidator::are_consolidatable(
     const std::vector<FragmentInfo>& fragments,
@@ -146,6 +333,62 @@ bool Consolidator::are_consolidatable(
   return (double(union_cell_num) / sum_cell_num) <= config_.amplification_;
 }
 
+template <class T>
+Status Consolidator::can_copy_tiles(
+    const ArraySchema* array_schema,
+    std::vector<FragmentMetadata*>* fragments,
+    bool* copyable) const {
+  *copyable = false;
+
+  // Only sparse fragments written with the current format version
+  for (auto f : *fragments) {
+    if (f->dense() || f->format_version() != constants::format_version)
+      return Status::Ok();
+  }
+
+  // Sort the fragments on the global order of their first cells, i.e.,
+  // of the lower corners of their non-empty domains. The global order is
+  // lexicographic on monotone transformations of each coordinate, so the
+  // corners bound the cells of the fragments in the global order.
+  auto domain = array_schema->domain();
+  auto dim_num = array_schema->dim_num();
+  auto precedes = [domain](const T* a, const T* b) {
+    auto tile_cmp = domain->tile_order_cmp<T>(a, b);
+    return tile_cmp < 0 ||
+           (tile_cmp == 0 && domain->cell_order_cmp<T>(a, b) < 0);
+  };
+  auto fragment_num = fragments->size();
+  std::vector<std::vector<T>> lo(fragment_num), hi(fragment_num);
+  std::vector<size_t> order(fragment_num);
+  for (size_t f = 0; f < fragment_num; ++f) {
+    auto non_empty_domain = (const T*)(*fragments)[f]->non_empty_domain();
+    lo[f].resize(dim_num);
+    hi[f].resize(dim_num);
+    for (unsigned d = 0; d < dim_num; ++d) {
+      lo[f][d] = non_empty_domain[2 * d];
+      hi[f][d] = non_empty_domain[2 * d + 1];
+    }
+    order[f] = f;
+  }
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return precedes(&lo[a][0], &lo[b][0]);
+  });
+
+  // The fragments must not interleave
+  for (size_t i = 1; i < fragment_num; ++i) {
+    if (!precedes(&hi[order[i - 1]][0], &lo[order[i]][0]))
+      return Status::Ok();
+  }
+
+  std::vector<FragmentMetadata*> sorted(fragment_num);
+  for (size_t i = 0; i < fragment_num; ++i)
+    sorted[i] = (*fragments)[order[i]];
+  *fragments = std::move(sorted);
+  *copyable = true;
+
+  return Status::Ok();
+}
+
 Status Consolidator::consolidate(
     const ArraySchema* array_schema,
     EncryptionType encryption_type,
@@ -198,6 +441,7 @@ Status Consolidator::consolidate(
     uint32_t key_length) {
   std::vector<FragmentInfo> to_consolidate;
   auto timestamp = utils::time::timestamp_now_ms();
+  io_bytes_ = 0;
   auto array_uri = array_schema->array_uri();
   EncryptionKey enc_key;
   RETURN_NOT_OK(enc_key.set_key(encryption_type, encryption_key, key_length));
@@ -250,6 +494,11 @@ Status Consolidator::consolidate(
     RETURN_NOT_OK(storage_manager_->get_fragment_info(
         array_schema, enc_key, new_fragment_uri, &new_fragment_info));
 
+    // Account for the bytes read and written
+    for (const auto& f : to_consolidate)
+      io_bytes_ += f.fragment_size_;
+    io_bytes_ += new_fragment_info.fragment_size_;
+
     // Update fragment info
     update_fragment_info(to_consolidate, new_fragment_info, &fragment_info);
 
@@ -284,6 +533,67 @@ Status Consolidator::consolidate(
     return Status::Ok();
   }
 
+  // Copy the tiles of the fragments if possible, instead of reading and
+  // writing their cells. Otherwise, the fragments of sparse arrays are
+  // merged on the global order without going through the generic reader.
+  auto fragments = array_for_reads.fragment_metadata();
+  bool copyable = false;
+  RETURN_NOT_OK_ELSE(
+      can_copy_tiles<T>(
+          array_for_reads.array_schema(), &fragments, &copyable),
+      array_for_reads.close());
+  if (copyable || !array_for_reads.array_schema()->dense()) {
+    // The consolidated fragment gets the timestamp of the last fragment
+    *new_fragment_uri =
+        array_for_reads.fragment_metadata().back()->fragment_uri();
+    RETURN_NOT_OK_ELSE(
+        rename_new_fragment_uri(new_fragment_uri), array_for_reads.close());
+
+    // Storing the new fragment metadata waits until the array is no longer
+    // open for reads, hence the array is closed before that happens
+    Status st;
+    if (copyable) {
+      st = copy_tiles(&array_for_reads, fragments, *new_fragment_uri);
+    } else {
+      // The merge opens the fragments on its own
+      st = array_for_reads.close();
+      if (st.ok()) {
+        st = merge_fragments<T>(
+            array_uri,
+            to_consolidate,
+            encryption_type,
+            encryption_key,
+            key_length,
+            *new_fragment_uri);
+      }
+    }
+    auto st2 = array_for_reads.close();
+    if (st.ok())
+      st = st2;
+    if (!st.ok()) {
+      bool is_dir = false;
+      st2 = storage_manager_->vfs()->is_dir(*new_fragment_uri, &is_dir);
+      (void)st2;  // Perhaps report this once we support an error stack
+      if (is_dir)
+        storage_manager_->vfs()->remove_dir(*new_fragment_uri);
+      return st;
+    }
+
+    std::vector<URI> to_delete;
+    for (const auto& f : to_consolidate)
+      to_delete.emplace_back(f.uri_);
+
+    // Delete old fragment metadata. This makes the old fragments invisible
+    st = delete_fragment_metadata(array_uri, to_delete);
+    if (!st.ok()) {
+      delete_fragment_metadata_failed(*new_fragment_uri, to_delete);
+      return st;
+    }
+
+    // Delete old fragments. The array does not need to be locked.
+    return delete_fragments(to_delete);
+  }
+
   // Open array for writing
   Array array_for_writes(array_uri, storage_manager_);
   RETURN_NOT_OK_ELSE(
@@ -302,12 +612,13 @@ Status Consolidator::consolidate(
   // Compute layout and subarray
   void* subarray = (all_sparse) ? nullptr : union_non_empty_domains;
 
-  // Prepare buffers
+  // Prepare two sets of buffers, to read a chunk of cells into one while
+  // writing the previous chunk from the other
   void** buffers;
   uint64_t* buffer_sizes;
   unsigned int buffer_num;
   Status st = create_buffers(
-      array_schema, all_sparse, &buffers, &buffer_sizes, &buffer_num);
+      array_schema, all_sparse, 2, &buffers, &buffer_sizes, &buffer_num);
   if (!st.ok()) {
     array_for_reads.close();
     array_for_writes.close();
@@ -335,7 +646,8 @@ Status Consolidator::consolidate(
   }
 
   // Read from one array and write to the other
-  st = copy_array(query_r, query_w);
+  st = copy_array(
+      query_r, query_w, all_sparse, buffers, buffer_sizes, buffer_num);
   if (!st.ok()) {
     array_for_reads.close();
     array_for_writes.close();
@@ -384,7 +696,7 @@ Status Consolidator::consolidate(
   // Delete old fragment metadata. This makes the old fragments invisible
   st = delete_fragment_metadata(array_uri, to_delete);
   if (!st.ok()) {
-    delete_fragments(to_delete);
+    delete_fragment_metadata_failed(*new_fragment_uri, to_delete);
     clean_up(buffer_num, buffers, buffer_sizes, query_r, query_w);
     return st;
   }
@@ -398,11 +710,493 @@ Status Consolidator::consolidate(
   return st;
 }
 
-Status Consolidator::copy_array(Query* query_r, Query* query_w) {
+Status Consolidator::consolidate_fragment_meta(
+    const URI& array_uri,
+    EncryptionType encryption_type,
+    const void* encryption_key,
+    uint32_t key_length) {
+  EncryptionKey enc_key;
+  RETURN_NOT_OK(enc_key.set_key(encryption_type, encryption_key, key_length));
+
+  // Open the array, loading the metadata of all fragments
+  Array array(array_uri, storage_manager_);
+  RETURN_NOT_OK(array.open(
+      QueryType::READ, encryption_type, encryption_key, key_length));
+
+  // Pack the fragments of format version 3 or later; the rest are
+  // still loaded individually
+  std::vector<FragmentMetadata*> to_pack;
+  for (auto metadata : array.fragment_metadata()) {
+    if (metadata->format_version() >= 3)
+      to_pack.push_back(metadata);
+  }
+
+  Buffer buff;
+  std::vector<URI> fragment_uris;
+  auto version = constants::format_version;
+  uint64_t fragment_num = to_pack.size();
+  RETURN_NOT_OK_ELSE(buff.write(&version, sizeof(uint32_t)), array.close());
+  RETURN_NOT_OK_ELSE(
+      buff.write(&fragment_num, sizeof(uint64_t)), array.close());
+  for (auto metadata : to_pack) {
+    const auto& uri = metadata->fragment_uri();
+    fragment_uris.push_back(uri);
+    auto name = uri.remove_trailing_slash().last_path_part();
+    uint64_t name_size = name.size();
+    char dense = metadata->dense() ? 1 : 0;
+    RETURN_NOT_OK_ELSE(buff.write(&name_size, sizeof(uint64_t)), array.close());
+    RETURN_NOT_OK_ELSE(buff.write(name.data(), name_size), array.close());
+    RETURN_NOT_OK_ELSE(buff.write(&dense, sizeof(char)), array.close());
+    RETURN_NOT_OK_ELSE(
+        metadata->write_consolidated(enc_key, &buff), array.close());
+  }
+  RETURN_NOT_OK(array.close());
+
+  // Fails if a packed fragment got deleted by a concurrent consolidation
+  auto check_fragments = [this, &fragment_uris]() {
+    for (const auto& uri : fragment_uris) {
+      bool is_fragment = false;
+      RETURN_NOT_OK(storage_manager_->is_fragment(uri, &is_fragment));
+      if (!is_fragment)
+        return LOG_STATUS(Status::ConsolidatorError(
+            "Cannot consolidate fragment metadata; Fragment " +
+            uri.to_string() + " was deleted"));
+    }
+    return Status::Ok();
+  };
+  RETURN_NOT_OK(check_fragments());
+
+  // Write the new file under a temporary name, which is ignored when
+  // listing the fragments as it starts with a dot
+  std::string uuid;
+  RETURN_NOT_OK(uuid::generate_uuid(&uuid, false));
+  auto tmp_uri = array_uri.join_path(
+      "." + uuid + constants::consolidated_fragment_metadata_filename);
+  buff.reset_offset();
+  Tile tile(
+      constants::generic_tile_datatype,
+      constants::generic_tile_cell_size,
+      0,
+      &buff,
+      false);
+  TileIO tile_io(storage_manager_, tmp_uri);
+  auto st = tile_io.write_generic(&tile, enc_key);
+  if (st.ok())
+    st = storage_manager_->close_file(tmp_uri);
+  if (!st.ok()) {
+    storage_manager_->vfs()->remove_file(tmp_uri);
+    return st;
+  }
+
+  // Under the exclusive lock, check again that no packed fragment got
+  // deleted and move the new file in place of the previous one
+  st = array_xlock(array_uri);
+  if (!st.ok()) {
+    storage_manager_->vfs()->remove_file(tmp_uri);
+    return st;
+  }
+  st = check_fragments();
+  if (st.ok()) {
+    auto consolidated_uri =
+        array_uri.join_path(constants::consolidated_fragment_metadata_filename);
+    st = storage_manager_->vfs()->move_file(tmp_uri, consolidated_uri);
+  }
+  if (!st.ok())
+    storage_manager_->vfs()->remove_file(tmp_uri);
+  auto st2 = storage_manager_->array_xunlock(array_uri);
+  if (st.ok())
+    st = st2;
+
+  STATS_COUNTER_ADD_IF(
+      st.ok(), consolidator_num_fragment_meta_packed, fragment_num);
+
+  return st;
+}
+
+Status Consolidator::copy_array(
+    Query* query_r,
+    Query* query_w,
+    bool sparse_mode,
+    void** buffers,
+    uint64_t* buffer_sizes,
+    unsigned int buffer_num) {
+  STATS_FUNC_IN(consolidator_copy_array);
+
+  // The writes are submitted to a dedicated thread, as the writer itself
+  // waits on the tasks it submits to the writer thread pool
+  ThreadPool write_thread;
+  RETURN_NOT_OK(write_thread.init(1));
+
+  auto start = std::chrono::steady_clock::now();
+  uint64_t read_ns = 0, write_ns = 0;
+  auto submit_r = [query_r, &read_ns]() {
+    auto read_start = std::chrono::steady_clock::now();
+    auto st = query_r->submit();
+    read_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - read_start)
+                   .count();
+    return st;
+  };
+
+  // Read the first chunk into the first set of buffers, which is already
+  // set to both queries
+  RETURN_NOT_OK(submit_r());
+
+  auto set_buffer_num = buffer_num / 2;
+  unsigned set = 0;
+  uint64_t chunk_num = 0;
+  bool incomplete;
   do {
-    RETURN_NOT_OK(query_r->submit());
-    RETURN_NOT_OK(query_w->submit());
-  } while (query_r->status() == QueryStatus::INCOMPLETE);
+    incomplete = query_r->status() == QueryStatus::INCOMPLETE;
+
+    // Write the chunk just read in the background
+    RETURN_NOT_OK(set_query_buffers(
+        query_w,
+        sparse_mode,
+        &buffers[set * set_buffer_num],
+        &buffer_sizes[set * set_buffer_num]));
+    auto write_task = write_thread.enqueue([query_w, &write_ns]() {
+      auto write_start = std::chrono::steady_clock::now();
+      auto st = query_w->submit();
+      write_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now() - write_start)
+                      .count();
+      return st;
+    });
+    if (!write_task.valid()) {
+      return LOG_STATUS(Status::ConsolidatorError(
+          "Cannot consolidate; Failed to submit write"));
+    }
+
+    // Meanwhile, read the next chunk into the other set of buffers
+    Status st = Status::Ok();
+    if (incomplete) {
+      set = 1 - set;
+      std::fill(
+          &buffer_sizes[set * set_buffer_num],
+          &buffer_sizes[(set + 1) * set_buffer_num],
+          config_.buffer_size_);
+      st = set_query_buffers(
+          query_r,
+          sparse_mode,
+          &buffers[set * set_buffer_num],
+          &buffer_sizes[set * set_buffer_num]);
+      if (st.ok())
+        st = submit_r();
+    }
+
+    // The write must be over before returning or reusing its buffers
+    auto st_w = write_task.get();
+    RETURN_NOT_OK(st_w);
+    RETURN_NOT_OK(st);
+    ++chunk_num;
+  } while (incomplete);
+
+  // The time reads and writes overlapped is the time they took in total,
+  // beyond the time spent in copying
+  uint64_t copy_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+  uint64_t overlap_ns =
+      (read_ns + write_ns > copy_ns) ? read_ns + write_ns - copy_ns : 0;
+  (void)overlap_ns;  // Unused if stats are disabled
+  STATS_COUNTER_ADD(consolidator_num_copy_chunks, chunk_num);
+  STATS_COUNTER_ADD(consolidator_copy_read_ns, read_ns);
+  STATS_COUNTER_ADD(consolidator_copy_write_ns, write_ns);
+  STATS_COUNTER_ADD(consolidator_copy_overlap_ns, overlap_ns);
+
+  return Status::Ok();
+
+  STATS_FUNC_OUT(consolidator_copy_array);
+}
+
+Status Consolidator::copy_tiles(
+    Array* array,
+    const std::vector<FragmentMetadata*>& fragments,
+    const URI& new_fragment_uri) {
+  // The array is closed for reads before storing the new fragment metadata,
+  // which must therefore refer to its own copy of the schema
+  ArraySchema array_schema(array->array_schema());
+  const auto& encryption_key = array->get_encryption_key();
+  auto attribute_num = array_schema.attribute_num();
+  auto fragment_num = fragments.size();
+
+  // The attributes to copy, including the coordinates
+  std::vector<std::string> attributes;
+  for (unsigned i = 0; i < attribute_num; ++i)
+    attributes.emplace_back(array_schema.attribute(i)->name());
+  attributes.emplace_back(constants::coords);
+
+  // Create the metadata of the new fragment
+  uint64_t timestamp = 0;
+  uint64_t tile_num = 0;
+  for (auto f : fragments) {
+    timestamp = MAX(timestamp, f->timestamp());
+    tile_num += f->tile_num();
+  }
+  FragmentMetadata meta(
+      storage_manager_, &array_schema, false, new_fragment_uri, timestamp);
+  RETURN_NOT_OK(meta.init(array_schema.domain()->domain()));
+  RETURN_NOT_OK(meta.set_num_tiles(tile_num));
+
+  // Set the metadata of the tiles, computing the sizes of the files to copy
+  std::vector<std::vector<uint64_t>> file_sizes(
+      fragment_num, std::vector<uint64_t>(attributes.size(), 0));
+  std::vector<std::vector<uint64_t>> file_var_sizes(
+      fragment_num, std::vector<uint64_t>(attributes.size(), 0));
+  uint64_t tile_id = 0;
+  for (size_t f = 0; f < fragment_num; ++f) {
+    auto frag = fragments[f];
+    const std::vector<void*>* mbrs;
+    RETURN_NOT_OK(frag->mbrs(encryption_key, &mbrs));
+    for (uint64_t t = 0; t < frag->tile_num(); ++t, ++tile_id) {
+      RETURN_NOT_OK(meta.set_mbr(tile_id, (*mbrs)[t]));
+      if (tile_id == tile_num - 1)
+        meta.set_last_tile_cell_num(frag->cell_num(t));
+      else
+        meta.set_tile_cell_num(tile_id, frag->cell_num(t));
+
+      for (size_t a = 0; a < attributes.size(); ++a) {
+        const auto& attribute = attributes[a];
+        uint64_t size;
+        RETURN_NOT_OK(
+            frag->persisted_tile_size(encryption_key, attribute, t, &size));
+        meta.set_tile_offset(attribute, tile_id, size);
+        file_sizes[f][a] += size;
+
+        if (array_schema.var_size(attribute)) {
+          RETURN_NOT_OK(frag->persisted_tile_var_size(
+              encryption_key, attribute, t, &size));
+          meta.set_tile_var_offset(attribute, tile_id, size);
+          file_var_sizes[f][a] += size;
+          RETURN_NOT_OK(
+              frag->tile_var_size(encryption_key, attribute, t, &size));
+          meta.set_tile_var_size(attribute, tile_id, size);
+        }
+
+        if (frag->has_tile_metadata(attribute)) {
+          const void *min, *max, *sum;
+          RETURN_NOT_OK(frag->tile_metadata(
+              encryption_key, attribute, t, &min, &max, &sum));
+          meta.set_tile_metadata(attribute, tile_id, min, max, sum);
+        }
+      }
+    }
+  }
+
+  // Copy the attribute files of the fragments in parallel
+  RETURN_NOT_OK(storage_manager_->create_dir(new_fragment_uri));
+  auto statuses = parallel_for(0, attributes.size(), [&](uint64_t a) {
+    const auto& attribute = attributes[a];
+    auto var_size = array_schema.var_size(attribute);
+    for (size_t f = 0; f < fragment_num; ++f) {
+      RETURN_NOT_OK(append_file(
+          fragments[f]->attr_uri(attribute),
+          file_sizes[f][a],
+          meta.attr_uri(attribute)));
+      if (var_size) {
+        RETURN_NOT_OK(append_file(
+            fragments[f]->attr_var_uri(attribute),
+            file_var_sizes[f][a],
+            meta.attr_var_uri(attribute)));
+      }
+    }
+
+    RETURN_NOT_OK(storage_manager_->close_file(meta.attr_uri(attribute)));
+    if (var_size)
+      RETURN_NOT_OK(storage_manager_->close_file(meta.attr_var_uri(attribute)));
+
+    return Status::Ok();
+  });
+  for (auto& st : statuses)
+    RETURN_NOT_OK(st);
+
+  // Storing the metadata waits until the array is no longer open for reads
+  RETURN_NOT_OK(array->close());
+  RETURN_NOT_OK(meta.store(encryption_key));
+
+  STATS_COUNTER_ADD(consolidator_num_tile_copy_steps, 1);
+  STATS_COUNTER_ADD(consolidator_num_tiles_copied, tile_num);
+
+  return Status::Ok();
+}
+
+template <class T>
+Status Consolidator::merge_fragments(
+    const URI& array_uri,
+    const std::vector<FragmentInfo>& to_consolidate,
+    EncryptionType encryption_type,
+    const void* encryption_key,
+    uint32_t key_length,
+    const URI& new_fragment_uri) {
+  // Open a cursor on each fragment. The consolidation buffer size is split
+  // among the cursors, so that memory does not grow with their number.
+  auto fragment_num = to_consolidate.size();
+  uint64_t buffer_size = MAX(config_.buffer_size_ / fragment_num, 1);
+  std::vector<std::unique_ptr<MergeCursor>> cursors;
+  for (size_t f = 0; f < fragment_num; ++f) {
+    cursors.emplace_back(new MergeCursor(array_uri, storage_manager_, f));
+    auto cursor = cursors.back().get();
+    RETURN_NOT_OK(cursor->array_.open(
+        QueryType::READ,
+        std::vector<FragmentInfo>(1, to_consolidate[f]),
+        encryption_type,
+        encryption_key,
+        key_length));
+    cursor->query_.reset(new Query(storage_manager_, &cursor->array_));
+    RETURN_NOT_OK(cursor->query_->set_layout(Layout::GLOBAL_ORDER));
+    RETURN_NOT_OK(resize_cursor_buffers(cursor, buffer_size));
+    RETURN_NOT_OK(cursor->query_->set_subarray(nullptr));
+    RETURN_NOT_OK(cursor->query_->set_tile_cache_populate(false));
+    RETURN_NOT_OK(read_next_chunk(cursor));
+  }
+
+  // For easy reference
+  auto array_schema = cursors[0]->array_.array_schema();
+  auto domain = array_schema->domain();
+  auto coords_size = array_schema->coords_size();
+
+  // Compute the cell size of each buffer
+  std::vector<uint64_t> cell_sizes;
+  for (const auto& attr : array_schema->attributes()) {
+    cell_sizes.push_back(attr->cell_size());
+    if (attr->var_size())
+      cell_sizes.push_back(0);
+  }
+  cell_sizes.push_back(coords_size);
+
+  // Open array for writing
+  Array array_for_writes(array_uri, storage_manager_);
+  RETURN_NOT_OK(array_for_writes.open(
+      QueryType::WRITE, encryption_type, encryption_key, key_length));
+
+  // Prepare the buffers of the write query
+  void** buffers;
+  uint64_t* buffer_sizes;
+  unsigned int buffer_num;
+  Status st = create_buffers(
+      array_schema, false, 1, &buffers, &buffer_sizes, &buffer_num);
+  if (!st.ok()) {
+    array_for_writes.close();
+    return st;
+  }
+  assert(buffer_num == cell_sizes.size());
+  std::memset(buffer_sizes, 0, buffer_num * sizeof(uint64_t));
+
+  // Create the write query
+  auto query_w =
+      new Query(storage_manager_, &array_for_writes, new_fragment_uri);
+  st = query_w->set_layout(Layout::GLOBAL_ORDER);
+  if (st.ok())
+    st = set_query_buffers(query_w, false, buffers, buffer_sizes);
+  if (!st.ok()) {
+    array_for_writes.close();
+    clean_up(buffer_num, buffers, buffer_sizes, nullptr, query_w);
+    return st;
+  }
+
+  // Merge the cursors with a heap, whose top is the cursor with the first
+  // cell in the global order. Among cells with the same coordinates, the
+  // one of the latest fragment comes first and the others are dropped.
+  auto cmp = [domain](const MergeCursor* a, const MergeCursor* b) {
+    auto coords_a = (const T*)a->coords();
+    auto coords_b = (const T*)b->coords();
+    auto tile_cmp = domain->tile_order_cmp<T>(coords_a, coords_b);
+    if (tile_cmp != 0)
+      return tile_cmp > 0;
+    auto cell_cmp = domain->cell_order_cmp<T>(coords_a, coords_b);
+    if (cell_cmp != 0)
+      return cell_cmp > 0;
+    return a->fragment_idx_ < b->fragment_idx_;
+  };
+  std::priority_queue<MergeCursor*, std::vector<MergeCursor*>, decltype(cmp)>
+      heap(cmp);
+  for (auto& cursor : cursors) {
+    if (!cursor->done())
+      heap.push(cursor.get());
+  }
+
+  std::vector<uint8_t> last_coords(coords_size);
+  bool has_last_coords = false;
+  uint64_t cell_num = 0, dedup_num = 0;
+  while (st.ok() && !heap.empty()) {
+    auto cursor = heap.top();
+    heap.pop();
+
+    if (has_last_coords &&
+        !std::memcmp(cursor->coords(), &last_coords[0], coords_size)) {
+      ++dedup_num;
+    } else {
+      // Write the buffers when the cell does not fit in them
+      if (!append_cell(*cursor, cell_sizes, buffers, buffer_sizes)) {
+        st = query_w->submit();
+        std::memset(buffer_sizes, 0, buffer_num * sizeof(uint64_t));
+        if (st.ok() &&
+            !append_cell(*cursor, cell_sizes, buffers, buffer_sizes)) {
+          st = LOG_STATUS(Status::ConsolidatorError(
+              "Cannot consolidate; A cell is larger than the consolidation "
+              "buffer size"));
+        }
+        if (!st.ok())
+          break;
+      }
+      std::memcpy(&last_coords[0], cursor->coords(), coords_size);
+      has_last_coords = true;
+      ++cell_num;
+    }
+
+    // Advance the cursor, reading its next chunk if needed
+    ++cursor->cell_;
+    if (cursor->done() && cursor->query_->status() == QueryStatus::INCOMPLETE)
+      st = read_next_chunk(cursor);
+    if (st.ok() && !cursor->done())
+      heap.push(cursor);
+  }
+
+  // Write the last cells and finalize. The fragments are closed first, as
+  // finalizing stores the new fragment metadata, which waits until the
+  // array is no longer open for reads.
+  if (st.ok() && buffer_sizes[buffer_num - 1] != 0)
+    st = query_w->submit();
+  for (auto& cursor : cursors) {
+    cursor->query_.reset(nullptr);
+    auto st_c = cursor->array_.close();
+    if (st.ok())
+      st = st_c;
+  }
+  if (st.ok())
+    st = query_w->finalize();
+  auto st2 = array_for_writes.close();
+  if (st.ok())
+    st = st2;
+  clean_up(buffer_num, buffers, buffer_sizes, nullptr, query_w);
+
+  STATS_COUNTER_ADD(consolidator_num_merge_steps, 1);
+  STATS_COUNTER_ADD(consolidator_num_cells_merged, cell_num);
+  STATS_COUNTER_ADD(consolidator_num_cells_deduped, dedup_num);
+
+  return st;
+}
+
+Status Consolidator::read_next_chunk(MergeCursor* cursor) const {
+  auto coords_size = cursor->array_.array_schema()->coords_size();
+  auto query = cursor->query_.get();
+  do {
+    auto buffer_size = cursor->buffers_[0].size();
+    if (cursor->cell_num_ == 0 &&
+        query->status() == QueryStatus::INCOMPLETE) {
+      RETURN_NOT_OK(resize_cursor_buffers(cursor, 2 * buffer_size));
+    } else {
+      std::fill(
+          cursor->buffer_sizes_.begin(),
+          cursor->buffer_sizes_.end(),
+          buffer_size);
+    }
+    RETURN_NOT_OK(query->submit());
+    cursor->cell_num_ = cursor->buffer_sizes_.back() / coords_size;
+    cursor->cell_ = 0;
+  } while (cursor->cell_num_ == 0 &&
+           query->status() == QueryStatus::INCOMPLETE);
 
   return Status::Ok();
 }
@@ -421,6 +1215,7 @@ void Consolidator::clean_up(
 Status Consolidator::create_buffers(
     const ArraySchema* array_schema,
     bool sparse_mode,
+    unsigned set_num,
     void*** buffers,
     uint64_t** buffer_sizes,
     unsigned int* buffer_num) {
@@ -433,6 +1228,7 @@ Status Consolidator::create_buffers(
   for (unsigned int i = 0; i < attribute_num; ++i)
     *buffer_num += (array_schema->attributes()[i]->var_size()) ? 2 : 1;
   *buffer_num += (sparse) ? 1 : 0;
+  *buffer_num *= set_num;
 
   // Create buffers
   *buffers = (void**)std::malloc(*buffer_num * sizeof(void*));
@@ -486,6 +1282,7 @@ Status Consolidator::create_queries(
   RETURN_NOT_OK((*query_r)->set_subarray(subarray));
   if (array_for_reads->array_schema()->dense() && sparse_mode)
     RETURN_NOT_OK((*query_r)->set_sparse_mode(true));
+  RETURN_NOT_OK((*query_r)->set_tile_cache_populate(false));
 
   // Get last fragment URI, which will be the URI of the consolidated fragment
   *new_fragment_uri = (*query_r)->last_fragment_uri();
@@ -503,7 +1300,19 @@ Status Consolidator::create_queries(
 
 Status Consolidator::delete_fragment_metadata(
     const URI& array_uri, const std::vector<URI>& fragments) {
-  RETURN_NOT_OK(storage_manager_->array_xlock(array_uri));
+  RETURN_NOT_OK(array_xlock(array_uri));
+
+  // The consolidated fragment metadata must not outlive the fragments
+  auto consolidated_uri =
+      array_uri.join_path(constants::consolidated_fragment_metadata_filename);
+  bool is_file = false;
+  RETURN_NOT_OK_ELSE(
+      storage_manager_->vfs()->is_file(consolidated_uri, &is_file),
+      storage_manager_->array_xunlock(array_uri));
+  if (is_file)
+    RETURN_NOT_OK_ELSE(
+        storage_manager_->vfs()->remove_file(consolidated_uri),
+        storage_manager_->array_xunlock(array_uri));
 
   for (auto& uri : fragments) {
     auto meta_uri = uri.join_path(constants::fragment_metadata_filename);
@@ -515,6 +1324,16 @@ Status Consolidator::delete_fragment_metadata(
   return Status::Ok();
 }
 
+void Consolidator::delete_fragment_metadata_failed(
+    const URI& new_fragment_uri, const std::vector<URI>& to_delete) {
+  if (xlock_abandoned_) {
+    storage_manager_->vfs()->remove_dir(new_fragment_uri);
+    return;
+  }
+
+  delete_fragments(to_delete);
+}
+
 Status Consolidator::delete_fragments(const std::vector<URI>& fragments) {
   for (auto& uri : fragments)
     RETURN_NOT_OK(storage_manager_->vfs()->remove_dir(uri));
@@ -785,6 +1604,27 @@ void Consolidator::update_fragment_info(
   *fragment_info = std::move(updated_fragment_info);
 }
 
+Status Consolidator::resize_cursor_buffers(
+    MergeCursor* cursor, uint64_t size) const {
+  auto array_schema = cursor->array_.array_schema();
+  if (cursor->buffers_.empty()) {
+    size_t buffer_num = 1;
+    for (const auto& attr : array_schema->attributes())
+      buffer_num += (attr->var_size()) ? 2 : 1;
+    cursor->buffers_.resize(buffer_num);
+  }
+
+  std::vector<void*> buffers;
+  for (auto& buff : cursor->buffers_) {
+    buff.resize(size);
+    buffers.push_back(buff.data());
+  }
+  cursor->buffer_sizes_.assign(buffers.size(), size);
+
+  return set_query_buffers(
+      cursor->query_.get(), false, &buffers[0], &cursor->buffer_sizes_[0]);
+}
+
 Status Consolidator::set_config(const Config* config) {
   if (config != nullptr) {
     auto params = config->consolidation_params();
@@ -794,6 +1634,7 @@ Status Consolidator::set_config(const Config* config) {
     config_.size_ratio_ = params.step_size_ratio_;
     config_.min_frags_ = params.step_min_frags_;
     config_.max_frags_ = params.step_max_frags_;
+    config_.mode_ = params.mode_;
   }
 
   // Sanity checks
@@ -809,6 +1650,10 @@ Status Consolidator::set_config(const Config* config) {
     return LOG_STATUS(
         Status::ConsolidatorError("Invalid configuration; Amplification config "
                                   "parameter must be non-negative"));
+  if (config_.mode_ != "fragments" && config_.mode_ != "fragment_meta")
+    return LOG_STATUS(Status::ConsolidatorError(
+        "Invalid configuration; Mode config parameter must be 'fragments' or "
+        "'fragment_meta'"));
 
   return Status::Ok();
 }
@@ -37,12 +37,14 @@
 #include "tiledb/sm/misc/status.h"
 #include "tiledb/sm/storage_manager/open_array.h"
 
+#include <atomic>
 #include <vector>
 
 namespace tiledb {
 namespace sm {
 
 class ArraySchema;
+class FragmentMetadata;
 class Query;
 class StorageManager;
 class URI;
@@ -82,6 +84,11 @@ class Consolidator {
      * consolidation.
      */
     float size_ratio_;
+    /**
+     * What gets consolidated, "fragments" or "fragment_meta" (the basic
+     * metadata of all fragments).
+     */
+    std::string mode_;
 
     /** Constructor. */
     ConsolidationConfig() {
@@ -91,6 +98,7 @@ class Consolidator {
       min_frags_ = constants::consolidation_step_min_frags;
       max_frags_ = constants::consolidation_step_max_frags;
       size_ratio_ = constants::consolidation_step_size_ratio;
+      mode_ = constants::consolidation_mode;
     }
   };
 
@@ -131,7 +139,45 @@ class Consolidator {
       uint32_t key_length,
       const Config* config);
 
+  /**
+   * Returns the number of bytes of the fragments read and written by the
+   * last invocation of `consolidate`.
+   */
+  uint64_t io_bytes() const;
+
+  /**
+   * Makes the consolidator never block the readers of the array. The
+   * exclusive array lock, needed for deleting the metadata of the
+   * consolidated fragments, is then taken only when the array is not open
+   * for reads, and is retried until `*cancel` becomes `true` or for at
+   * most `xlock_timeout_ms` milliseconds. If the lock cannot be taken,
+   * the new fragment is removed and the old fragments are left intact.
+   *
+   * @param cancel Flag cancelling the consolidation while waiting for
+   *     the exclusive array lock.
+   * @param xlock_timeout_ms The maximum time to wait for the exclusive
+   *     array lock.
+   */
+  void set_nonblocking(
+      const std::atomic<bool>* cancel, uint64_t xlock_timeout_ms);
+
+  /**
+   * Returns `true` if the last invocation of `consolidate` gave up waiting
+   * for the exclusive array lock, in non-blocking mode.
+   */
+  bool xlock_abandoned() const;
+
  private:
+  /* ********************************* */
+  /*      PRIVATE TYPE DEFINITIONS     */
+  /* ********************************* */
+
+  /**
+   * A cursor over the cells of a single sparse fragment, which are read
+   * in the global order in chunks bounded by the size of its buffers.
+   */
+  struct MergeCursor;
+
   /* ********************************* */
   /*        PRIVATE ATTRIBUTES         */
   /* ********************************* */
@@ -142,6 +188,24 @@ class Consolidator {
   /** The storage manager. */
   StorageManager* storage_manager_;
 
+  /**
+   * If not `nullptr`, the readers of the array are never blocked and
+   * the consolidation is cancelled when the pointed flag becomes `true`.
+   */
+  const std::atomic<bool>* cancel_;
+
+  /** The number of fragment bytes read and written by `consolidate`. */
+  uint64_t io_bytes_;
+
+  /** Whether waiting for the exclusive array lock was given up. */
+  bool xlock_abandoned_;
+
+  /**
+   * The maximum time in milliseconds to wait for the exclusive array lock,
+   * in non-blocking mode.
+   */
+  uint64_t xlock_timeout_ms_;
+
   /* ********************************* */
   /*          PRIVATE METHODS           */
   /* ********************************* */
@@ -155,6 +219,42 @@ class Consolidator {
       size_t start,
       size_t end) const;
 
+  /**
+   * Exclusively locks the array. In non-blocking mode (see
+   * `set_nonblocking`), the lock is retried until no reader has the
+   * array open, until the consolidation is cancelled or until the lock
+   * timeout expires.
+   *
+   * @param array_uri The array URI.
+   * @return Status
+   */
+  Status array_xlock(const URI& array_uri);
+
+  /**
+   * Appends the first `size` bytes of file `src` to file `dst`, in chunks
+   * of at most the consolidation buffer size.
+   */
+  Status append_file(const URI& src, uint64_t size, const URI& dst) const;
+
+  /**
+   * Appends the current cell of the input cursor to the input buffers,
+   * if there is enough space left in all of them.
+   *
+   * @param cursor The cursor whose current cell is appended.
+   * @param cell_sizes The cell size of each buffer, in the order of
+   *     `set_query_buffers`. It is `constants::var_size` for the offsets
+   *     of a var-sized attribute and ignored for its values.
+   * @param buffers The buffers to append to, each of the consolidation
+   *     buffer size.
+   * @param buffer_sizes The used sizes of the buffers, which are updated.
+   * @return `true` if the cell was appended and `false` otherwise.
+   */
+  bool append_cell(
+      const MergeCursor& cursor,
+      const std::vector<uint64_t>& cell_sizes,
+      void** buffers,
+      uint64_t* buffer_sizes) const;
+
   /**
    * Checks if the fragments between `start` and `end` (inclusive)
    * in `fragments` are allowed to be consolidated. A set of fragments
@@ -185,6 +285,28 @@ class Consolidator {
       const T* union_non_empty_domains,
       unsigned dim_num) const;
 
+  /**
+   * Checks if the input fragments can be consolidated by copying their
+   * tiles, i.e., if they are all sparse, have the current format version,
+   * and do not interleave in the global order: once sorted on the global
+   * order, the last cell of each fragment precedes the first cell of the
+   * next one. In that case, the concatenation of their tiles is a valid
+   * sparse fragment.
+   *
+   * @tparam T The domain type.
+   * @param array_schema The array schema.
+   * @param fragments The fragments to check. If the function succeeds,
+   *     they are sorted on the global order of their first cells.
+   * @param copyable Set to `true` if the tiles of the fragments can be
+   *     copied, and `false` otherwise.
+   * @return Status
+   */
+  template <class T>
+  Status can_copy_tiles(
+      const ArraySchema* array_schema,
+      std::vector<FragmentMetadata*>* fragments,
+      bool* copyable) const;
+
   /**
    * Consolidates the fragments of the input array.
    *
@@ -248,15 +370,67 @@ class Consolidator {
       uint32_t key_length,
       URI* new_fragment_uri);
 
+  /**
+   * Packs the basic metadata of all the fragments of the array into its
+   * consolidated fragment metadata file, which replaces any previous one.
+   * The array is then opened reading only that file, plus the metadata of
+   * the fragments written later. The file is written under a temporary
+   * name, and only moved in place under the exclusive lock of the array.
+   *
+   * @param array_uri URI of the array.
+   * @param encryption_type The encryption type of the array
+   * @param encryption_key If the array is encrypted, the private encryption
+   *    key. For unencrypted arrays, pass `nullptr`.
+   * @param key_length The length in bytes of the encryption key.
+   * @return Status
+   */
+  Status consolidate_fragment_meta(
+      const URI& array_uri,
+      EncryptionType encryption_type,
+      const void* encryption_key,
+      uint32_t key_length);
+
   /**
    * Copies the array by reading from the fragments to be consolidated
    * (with `query_r`) and writing to the new fragment (with `query_w`).
+   * The buffers consist of two sets, so that the next chunk of cells is
+   * read into one set while the previous chunk is written from the other.
    *
    * @param query_r The read query.
    * @param query_w The write query.
+   * @param sparse_mode This indicates whether a dense array must be opened
+   *     in special sparse mode. This is ignored for sparse arrays.
+   * @param buffers The two sets of buffers, the first of which is set to
+   *     the queries.
+   * @param buffer_sizes The corresponding buffer sizes.
+   * @param buffer_num The total number of buffers in the two sets.
+   * @return Status
+   */
+  Status copy_array(
+      Query* query_r,
+      Query* query_w,
+      bool sparse_mode,
+      void** buffers,
+      uint64_t* buffer_sizes,
+      unsigned int buffer_num);
+
+  /**
+   * Creates a new fragment by concatenating the (filtered) tiles of the
+   * input fragments, which must satisfy `can_copy_tiles`. The tiles are
+   * copied as they are stored, without being unfiltered and filtered
+   * again.
+   *
+   * @param array The array the fragments belong to, opened for reads. It
+   *     is closed before the metadata of the new fragment is stored.
+   * @param fragments The fragments to consolidate, sorted on the global
+   *     order.
+   * @param new_fragment_uri The URI of the new fragment.
    * @return Status
    */
-  Status copy_array(Query* query_r, Query* query_w);
+  Status copy_tiles(
+      Array* array,
+      const std::vector<FragmentMetadata*>& fragments,
+      const URI& new_fragment_uri);
 
   /** Cleans up the inputs. */
   void clean_up(
@@ -274,14 +448,17 @@ class Consolidator {
    * @param array_schema The array schema.
    * @param sparse_mode This indicates whether a dense array must be opened
    *     in special sparse mode. This is ignored for sparse arrays.
+   * @param set_num The number of buffer sets to create, one after the
+   *     other, each with a buffer per attribute (and coordinates).
    * @param buffers The buffers to be created.
    * @param buffer_sizes The corresponding buffer sizes.
-   * @param buffer_num The number of buffers to be retrieved.
+   * @param buffer_num The number of buffers to be retrieved, over all sets.
    * @return Status
    */
   Status create_buffers(
       const ArraySchema* array_schema,
       bool sparse_mode,
+      unsigned set_num,
       void*** buffers,
       uint64_t** buffer_sizes,
       unsigned int* buffer_num);
@@ -328,6 +505,18 @@ class Consolidator {
   Status delete_fragment_metadata(
       const URI& array_uri, const std::vector<URI>& fragments);
 
+  /**
+   * Handles a failure to delete the metadata of the consolidated fragments.
+   * If waiting for the exclusive array lock was given up, the old fragments
+   * are intact and the new fragment is removed. Otherwise, the old
+   * fragments are removed.
+   *
+   * @param new_fragment_uri The URI of the new fragment.
+   * @param to_delete The URIs of the consolidated fragments.
+   */
+  void delete_fragment_metadata_failed(
+      const URI& new_fragment_uri, const std::vector<URI>& to_delete);
+
   /**
    * Deletes the entire directories of the input fragments.
    *
@@ -384,6 +573,41 @@ class Consolidator {
       std::vector<FragmentInfo>* to_consolidate,
       T* union_non_empty_domains) const;
 
+  /**
+   * Creates a new fragment by merging the cells of the input sparse
+   * fragments, each read through its own cursor in the global order.
+   * Since every fragment is already sorted, the cells are merged with a
+   * heap over the cursors instead of being sorted, and they are streamed
+   * into a global order write query. The memory used is bounded by the
+   * consolidation buffer size, regardless of the number of cells.
+   * Among cells with the same coordinates, only the one of the latest
+   * fragment is kept.
+   *
+   * @tparam T The domain type.
+   * @param array_uri The array URI.
+   * @param to_consolidate The fragments to consolidate, in timestamp order.
+   * @param encryption_type The encryption type of the array.
+   * @param encryption_key The encryption key of the array.
+   * @param key_length The length in bytes of the encryption key.
+   * @param new_fragment_uri The URI of the new fragment.
+   * @return Status
+   */
+  template <class T>
+  Status merge_fragments(
+      const URI& array_uri,
+      const std::vector<FragmentInfo>& to_consolidate,
+      EncryptionType encryption_type,
+      const void* encryption_key,
+      uint32_t key_length,
+      const URI& new_fragment_uri);
+
+  /**
+   * Reads the next chunk of cells of the input cursor. If not even a
+   * single cell fits in the cursor buffers, they are doubled in size
+   * until it does.
+   */
+  Status read_next_chunk(MergeCursor* cursor) const;
+
   /**
    * Renames the new fragment URI. The new name has the format
    * `__<thread_id>_<timestamp>_<last_fragment_timestamp>`, where
@@ -394,6 +618,11 @@ class Consolidator {
    */
   Status rename_new_fragment_uri(URI* uri) const;
 
+  /**
+   * Resizes the buffers of the input cursor and sets them to its query.
+   */
+  Status resize_cursor_buffers(MergeCursor* cursor, uint64_t size) const;
+
   /** Checks and sets the input configuration parameters. */
   Status set_config(const Config* config);
 
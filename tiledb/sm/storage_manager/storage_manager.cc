@@ -36,11 +36,13 @@
 #include <sstream>
 
 #include "tiledb/sm/array/array.h"
+#include "tiledb/sm/buffer/const_buffer.h"
 #include "tiledb/sm/global_state/global_state.h"
 #include "tiledb/sm/misc/logger.h"
 #include "tiledb/sm/misc/parallel_functions.h"
 #include "tiledb/sm/misc/stats.h"
 #include "tiledb/sm/misc/utils.h"
+#include "tiledb/sm/storage_manager/auto_consolidator.h"
 #include "tiledb/sm/storage_manager/storage_manager.h"
 #include "tiledb/sm/tile/tile_io.h"
 
@@ -64,17 +66,23 @@ namespace sm {
 /* ****************************** */
 
 StorageManager::StorageManager() {
+  auto_consolidator_ = nullptr;
   tile_cache_ = nullptr;
+  filtered_tile_cache_ = nullptr;
   vfs_ = nullptr;
   cancellation_in_progress_ = false;
   queries_in_progress_ = 0;
 }
 
 StorageManager::~StorageManager() {
+  // Stop background consolidation before releasing any resource it uses
+  delete auto_consolidator_;
+
   global_state::GlobalState::GetGlobalState().unregister_storage_manager(this);
   cancel_all_tasks();
 
   delete tile_cache_;
+  delete filtered_tile_cache_;
 
   // Release all filelocks and delete all opened arrays for reads
   for (auto& open_array_it : open_arrays_for_reads_) {
@@ -167,11 +175,13 @@ Status StorageManager::array_close_for_writes(const URI& array_uri) {
   open_array->mtx_lock();
   open_array->cnt_decr();
 
-  // Close the array if the counter reaches 0
+  // Close the array if the counter reaches 0, and stop checking it for
+  // background consolidation
   if (open_array->cnt() == 0) {
     open_array->mtx_unlock();
     delete open_array;
     open_arrays_for_writes_.erase(it);
+    auto_consolidator_->unwatch(array_uri);
   } else {  // Just unlock the array mutex
     open_array->mtx_unlock();
   }
@@ -197,16 +207,31 @@ Status StorageManager::array_open_for_reads(
   // Retrieve array schema
   *array_schema = open_array->array_schema();
 
+  // Read the consolidated fragment metadata, if any. If it cannot be read
+  // (the error is logged), the fragment metadata is loaded from the files
+  // of each fragment instead.
+  ConsolidatedFragmentMetadata consolidated;
+  if (!load_consolidated_fragment_metadata(
+           array_uri, encryption_key, &consolidated)
+           .ok()) {
+    consolidated.buff_.clear();
+    consolidated.fragments_.clear();
+  }
+
   // Determine which fragments to load
   std::vector<std::pair<uint64_t, URI>> fragments_to_load;  // (timestamp, URI)
   std::vector<URI> fragment_uris;
-  RETURN_NOT_OK(get_fragment_uris(array_uri, &fragment_uris));
+  RETURN_NOT_OK(get_fragment_uris(array_uri, &consolidated, &fragment_uris));
   RETURN_NOT_OK(
       get_sorted_fragment_uris(fragment_uris, timestamp, &fragments_to_load));
 
   // Get fragment metadata in the case of reads, if not fetched already
   Status st = load_fragment_metadata(
-      open_array, encryption_key, fragments_to_load, fragment_metadata);
+      open_array,
+      encryption_key,
+      consolidated,
+      fragments_to_load,
+      fragment_metadata);
   if (!st.ok()) {
     open_array->mtx_unlock();
     array_close_for_reads(array_uri);
@@ -240,6 +265,17 @@ Status StorageManager::array_open_for_reads(
   // Retrieve array schema
   *array_schema = open_array->array_schema();
 
+  // Read the consolidated fragment metadata, if any. If it cannot be read
+  // (the error is logged), the fragment metadata is loaded from the files
+  // of each fragment instead.
+  ConsolidatedFragmentMetadata consolidated;
+  if (!load_consolidated_fragment_metadata(
+           array_uri, encryption_key, &consolidated)
+           .ok()) {
+    consolidated.buff_.clear();
+    consolidated.fragments_.clear();
+  }
+
   // Determine which fragments to load
   std::vector<std::pair<uint64_t, URI>> fragments_to_load;  // (timestamp, URI)
   for (const auto& fragment : fragments)
@@ -247,7 +283,11 @@ Status StorageManager::array_open_for_reads(
 
   // Get fragment metadata in the case of reads, if not fetched already
   Status st = load_fragment_metadata(
-      open_array, encryption_key, fragments_to_load, fragment_metadata);
+      open_array,
+      encryption_key,
+      consolidated,
+      fragments_to_load,
+      fragment_metadata);
   if (!st.ok()) {
     open_array->mtx_unlock();
     array_close_for_reads(array_uri);
@@ -325,6 +365,9 @@ Status StorageManager::array_open_for_writes(
   // Unlock the array mutex
   open_array->mtx_unlock();
 
+  // Check the array for background consolidation
+  auto_consolidator_->watch(array_uri, encryption_key);
+
   return Status::Ok();
 
   STATS_FUNC_OUT(sm_array_open_for_writes);
@@ -358,16 +401,31 @@ Status StorageManager::array_reopen(
     open_array->mtx_lock();
   }
 
+  // Read the consolidated fragment metadata, if any. If it cannot be read
+  // (the error is logged), the fragment metadata is loaded from the files
+  // of each fragment instead.
+  ConsolidatedFragmentMetadata consolidated;
+  if (!load_consolidated_fragment_metadata(
+           array_uri, encryption_key, &consolidated)
+           .ok()) {
+    consolidated.buff_.clear();
+    consolidated.fragments_.clear();
+  }
+
   // Determine which fragments to load
   std::vector<std::pair<uint64_t, URI>> fragments_to_load;  // (timestamp, URI)
   std::vector<URI> fragment_uris;
-  RETURN_NOT_OK(get_fragment_uris(array_uri, &fragment_uris));
+  RETURN_NOT_OK(get_fragment_uris(array_uri, &consolidated, &fragment_uris));
   RETURN_NOT_OK(
       get_sorted_fragment_uris(fragment_uris, timestamp, &fragments_to_load));
 
   // Get fragment metadata in the case of reads, if not fetched already
   auto st = load_fragment_metadata(
-      open_array, encryption_key, fragments_to_load, fragment_metadata);
+      open_array,
+      encryption_key,
+      consolidated,
+      fragments_to_load,
+      fragment_metadata);
   if (!st.ok()) {
     open_array->mtx_unlock();
     array_close_for_reads(array_uri);
@@ -666,6 +724,35 @@ Status StorageManager::array_xlock(const URI& array_uri) {
   return Status::Ok();
 }
 
+Status StorageManager::array_try_xlock(const URI& array_uri, bool* locked) {
+  *locked = false;
+
+  // Get exclusive lock for threads, if the array is closed for reads
+  {
+    std::lock_guard<std::mutex> lk(open_array_for_reads_mtx_);
+    if (open_arrays_for_reads_.find(array_uri.to_string()) !=
+        open_arrays_for_reads_.end())
+      return Status::Ok();
+    if (!xlock_mtx_.try_lock())
+      return Status::Ok();
+  }
+
+  // Get exclusive lock for processes through a filelock, if no other
+  // process holds it
+  filelock_t filelock = INVALID_FILELOCK;
+  auto lock_uri = array_uri.join_path(constants::filelock_name);
+  RETURN_NOT_OK_ELSE(
+      vfs_->filelock_try_lock(lock_uri, &filelock, false, locked),
+      xlock_mtx_.unlock());
+  if (!*locked) {
+    xlock_mtx_.unlock();
+    return Status::Ok();
+  }
+  xfilelocks_[array_uri.to_string()] = filelock;
+
+  return Status::Ok();
+}
+
 Status StorageManager::array_xunlock(const URI& array_uri) {
   // Get filelock if it exists
   auto it = xfilelocks_.find(array_uri.to_string());
@@ -945,12 +1032,24 @@ Status StorageManager::init(Config* config) {
   RETURN_NOT_OK(async_thread_pool_.init(sm_params.num_async_threads_));
   RETURN_NOT_OK(reader_thread_pool_.init(sm_params.num_reader_threads_));
   RETURN_NOT_OK(writer_thread_pool_.init(sm_params.num_writer_threads_));
-  tile_cache_ = new LRUCache(sm_params.tile_cache_size_);
+  TileCache::Policy tile_cache_policy;
+  RETURN_NOT_OK(TileCache::policy_from_str(
+      sm_params.tile_cache_policy_, &tile_cache_policy));
+  auto decoded_size = static_cast<uint64_t>(
+      sm_params.tile_cache_decoded_ratio_ * sm_params.tile_cache_size_);
+  tile_cache_ = new TileCache(
+      decoded_size, constants::tile_cache_shard_num, tile_cache_policy);
+  filtered_tile_cache_ = new TileCache(
+      sm_params.tile_cache_size_ - decoded_size,
+      constants::tile_cache_shard_num,
+      tile_cache_policy);
   vfs_ = new VFS();
   RETURN_NOT_OK(vfs_->init(config_.vfs_params()));
   auto& global_state = global_state::GlobalState::GetGlobalState();
   RETURN_NOT_OK(global_state.initialize(config));
   global_state.register_storage_manager(this);
+  auto_consolidator_ = new AutoConsolidator(this);
+  RETURN_NOT_OK(auto_consolidator_->start(sm_params.consolidation_params_));
 
   STATS_COUNTER_ADD(sm_contexts_created, 1);
 
@@ -1268,16 +1367,13 @@ Status StorageManager::query_submit_async(Query* query) {
 }
 
 Status StorageManager::read_from_cache(
-    const URI& uri,
-    uint64_t offset,
+    const TileCacheKey& key,
     Buffer* buffer,
     uint64_t nbytes,
     bool* in_cache) const {
   STATS_FUNC_IN(sm_read_from_cache);
 
-  std::stringstream key;
-  key << uri.to_string() << "+" << offset;
-  RETURN_NOT_OK(tile_cache_->read(key.str(), buffer, 0, nbytes, in_cache));
+  RETURN_NOT_OK(tile_cache_->read(key, buffer, nbytes, in_cache));
   buffer->set_size(nbytes);
   buffer->reset_offset();
 
@@ -1286,6 +1382,22 @@ Status StorageManager::read_from_cache(
   STATS_FUNC_OUT(sm_read_from_cache);
 }
 
+Status StorageManager::read_from_filtered_cache(
+    const TileCacheKey& key,
+    Buffer* buffer,
+    uint64_t nbytes,
+    bool* in_cache) const {
+  *in_cache = false;
+  if (filtered_tile_cache_->max_size() == 0)
+    return Status::Ok();
+
+  RETURN_NOT_OK(filtered_tile_cache_->read(key, buffer, nbytes, in_cache));
+  buffer->set_size(nbytes);
+  buffer->reset_offset();
+
+  return Status::Ok();
+}
+
 Status StorageManager::read(
     const URI& uri, uint64_t offset, Buffer* buffer, uint64_t nbytes) const {
   RETURN_NOT_OK(buffer->realloc(nbytes));
@@ -1360,7 +1472,7 @@ void StorageManager::wait_for_zero_in_progress() {
 }
 
 Status StorageManager::write_to_cache(
-    const URI& uri, uint64_t offset, Buffer* buffer) const {
+    const TileCacheKey& key, Buffer* buffer, uint64_t decode_ns) const {
   STATS_FUNC_IN(sm_write_to_cache);
 
   // Do nothing if the object size is larger than the cache size
@@ -1368,31 +1480,25 @@ Status StorageManager::write_to_cache(
   if (object_size > tile_cache_->max_size())
     return Status::Ok();
 
-  // Do not write metadata to cache
-  std::string filename = uri.last_path_part();
-  if (filename == constants::fragment_metadata_filename ||
-      filename == constants::array_schema_filename ||
-      filename == constants::kv_schema_filename) {
-    return Status::Ok();
-  }
-
-  // Generate key (uri + offset)
-  std::stringstream key;
-  key << uri.to_string() << "+" << offset;
-
   // Insert to cache
-  void* object = std::malloc(object_size);
-  if (object == nullptr)
-    return LOG_STATUS(Status::StorageManagerError(
-        "Cannot write to cache; Object memory allocation failed"));
-  std::memcpy(object, buffer->data(), object_size);
-  RETURN_NOT_OK(tile_cache_->insert(key.str(), object, object_size, false));
+  RETURN_NOT_OK(
+      tile_cache_->insert(key, buffer->data(), object_size, decode_ns));
 
   return Status::Ok();
 
   STATS_FUNC_OUT(sm_write_to_cache);
 }
 
+Status StorageManager::write_to_filtered_cache(
+    const TileCacheKey& key, Buffer* buffer) const {
+  // Do nothing if the object size is larger than the cache size
+  uint64_t object_size = buffer->size();
+  if (object_size > filtered_tile_cache_->max_size())
+    return Status::Ok();
+
+  return filtered_tile_cache_->insert(key, buffer->data(), object_size);
+}
+
 Status StorageManager::write(const URI& uri, Buffer* buffer) const {
   return vfs_->write(uri, buffer->data(), buffer->size());
 }
@@ -1551,6 +1657,13 @@ Status StorageManager::array_open_without_fragments(
 
 Status StorageManager::get_fragment_uris(
     const URI& array_uri, std::vector<URI>* fragment_uris) const {
+  return get_fragment_uris(array_uri, nullptr, fragment_uris);
+}
+
+Status StorageManager::get_fragment_uris(
+    const URI& array_uri,
+    const ConsolidatedFragmentMetadata* consolidated,
+    std::vector<URI>* fragment_uris) const {
   // Get all uris in the array directory
   std::vector<URI> uris;
   RETURN_NOT_OK(vfs_->ls(array_uri.add_trailing_slash(), &uris));
@@ -1561,6 +1674,13 @@ Status StorageManager::get_fragment_uris(
     if (utils::parse::starts_with(uri.last_path_part(), "."))
       continue;
 
+    if (consolidated != nullptr &&
+        consolidated->fragments_.count(
+            uri.remove_trailing_slash().last_path_part()) != 0) {
+      fragment_uris->push_back(uri);
+      continue;
+    }
+
     RETURN_NOT_OK(is_fragment(uri, &exists))
     if (exists)
       fragment_uris->push_back(uri);
@@ -1586,9 +1706,73 @@ Status StorageManager::load_array_schema(
   return Status::Ok();
 }
 
+Status StorageManager::load_consolidated_fragment_metadata(
+    const URI& array_uri,
+    const EncryptionKey& encryption_key,
+    ConsolidatedFragmentMetadata* consolidated) {
+  auto uri =
+      array_uri.join_path(constants::consolidated_fragment_metadata_filename);
+  bool exists = false;
+  RETURN_NOT_OK(vfs_->is_file(uri, &exists));
+  if (!exists)
+    return Status::Ok();
+
+  // Read the file
+  TileIO tile_io(this, uri);
+  auto tile = (Tile*)nullptr;
+  RETURN_NOT_OK(tile_io.read_generic(&tile, 0, encryption_key));
+  tile->buffer()->swap(consolidated->buff_);
+  delete tile;
+  STATS_COUNTER_ADD(fragment_metadata_bytes_read, tile_io.file_size());
+
+  // Check the version
+  ConstBuffer cbuff(&consolidated->buff_);
+  uint32_t version;
+  RETURN_NOT_OK(cbuff.read(&version, sizeof(uint32_t)));
+  if (version > constants::format_version)
+    return LOG_STATUS(Status::StorageManagerError(
+        "Cannot load consolidated fragment metadata; Unsupported version " +
+        std::to_string(version)));
+
+  // Index the entries of the fragments
+  std::unordered_map<std::string, std::pair<bool, uint64_t>> fragments;
+  uint64_t fragment_num;
+  RETURN_NOT_OK(cbuff.read(&fragment_num, sizeof(uint64_t)));
+  for (uint64_t i = 0; i < fragment_num; ++i) {
+    uint64_t name_size;
+    RETURN_NOT_OK(cbuff.read(&name_size, sizeof(uint64_t)));
+    if (name_size > cbuff.nbytes_left_to_read())
+      return LOG_STATUS(Status::StorageManagerError(
+          "Cannot load consolidated fragment metadata; Invalid name size"));
+    std::string name(name_size, '\0');
+    RETURN_NOT_OK(cbuff.read(&name[0], name_size));
+    char dense;
+    RETURN_NOT_OK(cbuff.read(&dense, sizeof(char)));
+    fragments[name] = {dense != 0, cbuff.offset()};
+
+    // Skip the basic metadata and the generic tile offsets
+    uint64_t size;
+    RETURN_NOT_OK(cbuff.read(&size, sizeof(uint64_t)));
+    if (size > cbuff.nbytes_left_to_read())
+      return LOG_STATUS(Status::StorageManagerError(
+          "Cannot load consolidated fragment metadata; Invalid basic size"));
+    cbuff.advance_offset(size);
+    RETURN_NOT_OK(cbuff.read(&size, sizeof(uint64_t)));
+    if (size > cbuff.nbytes_left_to_read() / sizeof(uint64_t))
+      return LOG_STATUS(Status::StorageManagerError(
+          "Cannot load consolidated fragment metadata; Invalid number of "
+          "generic tile offsets"));
+    cbuff.advance_offset(size * sizeof(uint64_t));
+  }
+  consolidated->fragments_.swap(fragments);
+
+  return Status::Ok();
+}
+
 Status StorageManager::load_fragment_metadata(
     OpenArray* open_array,
     const EncryptionKey& encryption_key,
+    const ConsolidatedFragmentMetadata& consolidated,
     const std::vector<std::pair<uint64_t, URI>>& fragments_to_load,
     std::vector<FragmentMetadata*>* fragment_metadata) {
   // Load the metadata for each fragment, only if they are not already loaded
@@ -1599,13 +1783,32 @@ Status StorageManager::load_fragment_metadata(
     auto frag_timestamp = sf.first;
     const auto& frag_uri = sf.second;
     auto metadata = open_array->fragment_metadata(frag_uri);
-    if (metadata == nullptr) {  // Fragment metadata does not exist - load it
+    auto it = consolidated.fragments_.find(
+        frag_uri.remove_trailing_slash().last_path_part());
+    if (metadata == nullptr && it != consolidated.fragments_.end()) {
+      // Load the fragment metadata from the consolidated fragment metadata
+      metadata = new FragmentMetadata(
+          this,
+          open_array->array_schema(),
+          it->second.first,
+          frag_uri,
+          frag_timestamp);
+      metadata->set_tile_cache_id(
+          tile_cache_->fragment_id(frag_uri.to_string()));
+      ConstBuffer cbuff(consolidated.buff_.data(), consolidated.buff_.size());
+      cbuff.set_offset(it->second.second);
+      RETURN_NOT_OK_ELSE(metadata->load_consolidated(&cbuff), delete metadata);
+      open_array->insert_fragment_metadata(metadata);
+      STATS_COUNTER_ADD(fragment_metadata_num_consolidated, 1);
+    } else if (metadata == nullptr) {  // Fragment metadata does not exist
       URI coords_uri =
           frag_uri.join_path(constants::coords + constants::file_suffix);
       bool sparse;
       RETURN_NOT_OK(vfs_->is_file(coords_uri, &sparse));
       metadata = new FragmentMetadata(
           this, open_array->array_schema(), !sparse, frag_uri, frag_timestamp);
+      metadata->set_tile_cache_id(
+          tile_cache_->fragment_id(frag_uri.to_string()));
       RETURN_NOT_OK_ELSE(metadata->load(encryption_key), delete metadata);
       open_array->insert_fragment_metadata(metadata);
     }
@@ -44,7 +44,8 @@
 #include <thread>
 
 #include "tiledb/sm/array_schema/array_schema.h"
-#include "tiledb/sm/cache/lru_cache.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/cache/tile_cache.h"
 #include "tiledb/sm/encryption/encryption.h"
 #include "tiledb/sm/encryption/encryption_key_validation.h"
 #include "tiledb/sm/enums/object_type.h"
@@ -63,6 +64,7 @@ namespace tiledb {
 namespace sm {
 
 class Array;
+class AutoConsolidator;
 class Consolidator;
 
 /** The storage manager that manages pretty much everything in TileDB. */
@@ -297,6 +299,18 @@ class StorageManager {
    */
   Status array_xlock(const URI& array_uri);
 
+  /**
+   * Exclusively locks an array, like `array_xlock`, but only if the array
+   * is not open for reads, no other thread holds an exclusive lock and no
+   * other process holds the array filelock. Otherwise, it returns
+   * immediately without blocking any reader.
+   *
+   * @param array_uri The array URI.
+   * @param locked Set to `true` if the array got exclusively locked.
+   * @return Status
+   */
+  Status array_try_xlock(const URI& array_uri, bool* locked);
+
   /** Releases an exclusive lock for the input array. */
   Status array_xunlock(const URI& array_uri);
 
@@ -356,6 +370,10 @@ class StorageManager {
       const URI& fragment_uri,
       FragmentInfo* fragment_info);
 
+  /** Retrieves all the fragment URI's of an array. */
+  Status get_fragment_uris(
+      const URI& array_uri, std::vector<URI>* fragment_uris) const;
+
   /**
    * Creates a TileDB group.
    *
@@ -549,14 +567,12 @@ class StorageManager {
   Status query_submit_async(Query* query);
 
   /**
-   * Reads from the cache into the input buffer. `uri` and `offset` collectively
-   * form the key of the cached object to be read. Essentially, this is used
-   * to read potentially cached tiles. `uri` is the URI of the attribute the
-   * tile belongs to, and `offset` is the offset in the attribute file where
-   * the tile is located. Observe that the `uri`, `offset` pair is unique.
+   * Reads from the cache into the input buffer. Essentially, this is used
+   * to read potentially cached tiles. `key` identifies the fragment and
+   * attribute file the tile belongs to, and the offset in the attribute file
+   * where the tile is located.
    *
-   * @param uri The URI of the cached object.
-   * @param offset The offset of the cached object.
+   * @param key The key of the cached object.
    * @param buffer The buffer to write into. The function reallocates memory
    *     for the buffer, sets its size to *nbytes* and resets its offset.
    * @param nbytes Number of bytes to be read.
@@ -565,8 +581,26 @@ class StorageManager {
    * @return Status.
    */
   Status read_from_cache(
-      const URI& uri,
-      uint64_t offset,
+      const TileCacheKey& key,
+      Buffer* buffer,
+      uint64_t nbytes,
+      bool* in_cache) const;
+
+  /**
+   * Reads a filtered tile from the cache into the input buffer. This is
+   * the same as `read_from_cache`, but for the part of the tile cache that
+   * holds tiles as they are stored, before unfiltering.
+   *
+   * @param key The key of the cached object.
+   * @param buffer The buffer to write into. The function reallocates memory
+   *     for the buffer, sets its size to *nbytes* and resets its offset.
+   * @param nbytes Number of bytes to be read.
+   * @param in_cache This is set to `true` if the object is in the cache,
+   *     and `false` otherwise.
+   * @return Status.
+   */
+  Status read_from_filtered_cache(
+      const TileCacheKey& key,
       Buffer* buffer,
       uint64_t nbytes,
       bool* in_cache) const;
@@ -610,18 +644,29 @@ class StorageManager {
   VFS* vfs() const;
 
   /**
-   * Writes the contents of a buffer into the cache. `uri` and `offset`
-   * collectively form the key of the object to be cached. Essentially, this is
-   * used to cach tiles. `uri` is the URI of the attribute the
-   * tile belongs to, and `offset` is the offset in the attribute file where
-   * the tile is located. Observe that the `uri`, `offset` pair is unique.
+   * Writes the contents of a buffer into the cache. Essentially, this is
+   * used to cache tiles. `key` identifies the fragment and attribute file the
+   * tile belongs to, and the offset in the attribute file where the tile is
+   * located.
+   *
+   * @param key The key of the cached object.
+   * @param buffer The buffer whose contents will be cached.
+   * @param decode_ns The time in nanoseconds it took to unfilter the tile,
+   *     reported as saved time whenever the cached tile is read.
+   * @return Status.
+   */
+  Status write_to_cache(
+      const TileCacheKey& key, Buffer* buffer, uint64_t decode_ns = 0) const;
+
+  /**
+   * Writes the contents of a buffer into the part of the tile cache that
+   * holds tiles as they are stored, before unfiltering.
    *
-   * @param uri The URI of the cached object.
-   * @param offset The offset of the cached object.
+   * @param key The key of the cached object.
    * @param buffer The buffer whose contents will be cached.
    * @return Status.
    */
-  Status write_to_cache(const URI& uri, uint64_t offset, Buffer* buffer) const;
+  Status write_to_filtered_cache(const TileCacheKey& key, Buffer* buffer) const;
 
   /**
    * Writes the contents of a buffer into a URI file.
@@ -670,10 +715,29 @@ class StorageManager {
     }
   };
 
+  /**
+   * The contents of the consolidated fragment metadata file of an array,
+   * indexed by fragment name.
+   */
+  struct ConsolidatedFragmentMetadata {
+    /** The contents of the file. */
+    Buffer buff_;
+
+    /**
+     * Maps a fragment name to whether the fragment is dense and the offset
+     * of its entry in `buff_`, to be passed to
+     * `FragmentMetadata::load_consolidated`.
+     */
+    std::unordered_map<std::string, std::pair<bool, uint64_t>> fragments_;
+  };
+
   /* ********************************* */
   /*        PRIVATE ATTRIBUTES         */
   /* ********************************* */
 
+  /** Consolidates the arrays opened for writes in the background. */
+  AutoConsolidator* auto_consolidator_;
+
   /** Set to true when tasks are being cancelled. */
   bool cancellation_in_progress_;
 
@@ -733,8 +797,14 @@ class StorageManager {
    */
   CancelableTasks cancelable_tasks_;
 
-  /** A tile cache. */
-  LRUCache* tile_cache_;
+  /** A tile cache, holding decoded (unfiltered) tiles. */
+  TileCache* tile_cache_;
+
+  /**
+   * A tile cache holding tiles as they are stored (filtered). Its size is
+   * the part of the tile cache size not given to `tile_cache_`.
+   */
+  TileCache* filtered_tile_cache_;
 
   /**
    * Virtual filesystem handler. It directs queries to the appropriate
@@ -806,9 +876,15 @@ class StorageManager {
   /** Decrement the count of in-progress queries. */
   void decrement_in_progress();
 
-  /** Retrieves all the fragment URI's of an array. */
+  /**
+   * Retrieves all the fragment URI's of an array. The fragments in
+   * `consolidated` (if not `nullptr`) are known to exist, so their
+   * fragment metadata files are not checked.
+   */
   Status get_fragment_uris(
-      const URI& array_uri, std::vector<URI>* fragment_uris) const;
+      const URI& array_uri,
+      const ConsolidatedFragmentMetadata* consolidated,
+      std::vector<URI>* fragment_uris) const;
 
   /** Increment the count of in-progress queries. */
   void increment_in_progress();
@@ -838,6 +914,8 @@ class StorageManager {
    *
    * @param open_array The open array object.
    * @param encryption_key The encryption key to use.
+   * @param consolidated The consolidated fragment metadata of the array.
+   *     The fragments found there are loaded without accessing them.
    * @param fragments_to_load The fragments whose metadata to load. This
    *     is a vector of pairs (timestamp, URI).
    * @param fragment_metadata The fragment metadata retrieved in a
@@ -847,9 +925,25 @@ class StorageManager {
   Status load_fragment_metadata(
       OpenArray* open_array,
       const EncryptionKey& encryption_key,
+      const ConsolidatedFragmentMetadata& consolidated,
       const std::vector<std::pair<uint64_t, URI>>& fragments_to_load,
       std::vector<FragmentMetadata*>* fragment_metadata);
 
+  /**
+   * Loads the consolidated fragment metadata file of an array, if it
+   * exists, with a single read.
+   *
+   * @param array_uri The array URI.
+   * @param encryption_key The encryption key to use.
+   * @param consolidated The contents of the file, left empty if the file
+   *     does not exist.
+   * @return Status
+   */
+  Status load_consolidated_fragment_metadata(
+      const URI& array_uri,
+      const EncryptionKey& encryption_key,
+      ConsolidatedFragmentMetadata* consolidated);
+
   /**
    * Gets the sorted fragment URIs based on the first input
    * in ascending timestamp order, breaking ties with lexicographic sorting
@@ -177,6 +177,7 @@ Tile Tile::clone(bool deep_copy) const {
   Tile clone;
   clone.cell_size_ = cell_size_;
   clone.dim_num_ = dim_num_;
+  clone.data_owner_ = data_owner_;
   clone.filtered_ = filtered_;
   clone.format_version_ = format_version_;
   clone.pre_filtered_size_ = pre_filtered_size_;
@@ -268,6 +269,10 @@ void Tile::reset_size() {
   buffer_->reset_size();
 }
 
+void Tile::set_data_owner(const std::shared_ptr<void>& data_owner) {
+  data_owner_ = data_owner;
+}
+
 void Tile::set_filtered(bool filtered) {
   filtered_ = filtered;
 }
@@ -382,6 +387,7 @@ void Tile::swap(Tile& tile) {
   std::swap(buffer_, tile.buffer_);
   std::swap(cell_size_, tile.cell_size_);
   std::swap(dim_num_, tile.dim_num_);
+  std::swap(data_owner_, tile.data_owner_);
   std::swap(filtered_, tile.filtered_);
   std::swap(format_version_, tile.format_version_);
   std::swap(owns_buff_, tile.owns_buff_);
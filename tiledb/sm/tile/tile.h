@@ -39,6 +39,7 @@
 #include "tiledb/sm/misc/status.h"
 
 #include <cinttypes>
+#include <memory>
 
 namespace tiledb {
 namespace sm {
@@ -230,6 +231,13 @@ class Tile {
   /** Resets the tile size. */
   void reset_size();
 
+  /**
+   * Sets a handle on the memory that the tile buffer points to, when the
+   * buffer does not own its data (e.g., it points into a memory-mapped
+   * file). The handle is held for as long as the tile (or a copy of it).
+   */
+  void set_data_owner(const std::shared_ptr<void>& data_owner);
+
   /** Set the filtered state of the tile. */
   void set_filtered(bool filtered);
 
@@ -312,6 +320,12 @@ class Tile {
    */
   unsigned int dim_num_;
 
+  /**
+   * Keeps the data of `buffer_` valid if the buffer does not own it (see
+   * `set_data_owner`).
+   */
+  std::shared_ptr<void> data_owner_;
+
   /** The current state of the in-memory tile data with respect to filtering. */
   bool filtered_;
 